@@ -0,0 +1,87 @@
+#ifndef LPCOMP_DRIVER_H
+#define LPCOMP_DRIVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrfx_lpcomp.h"
+
+// The LPCOMP references are fractions of the supply, the SAADC ones are not
+#define LPCOMP_SUPPLY_MV 3000              // VDD of the board in millivolts
+#define LPCOMP_REFERENCE_STEPS 16          // References are 1/16 to 15/16 of VDD
+#define LPCOMP_HYSTERESIS_MV 50            // Comparator hysteresis, centred on the reference
+#define LPCOMP_WAKE_TIMER_INSTANCE 3       // TIMER started by the crossing, timestamps the wake
+
+/**
+ * @brief Side of the idle level watched by the comparator.
+ */
+typedef enum {
+    LPCOMP_WAKE_DOWN = -1, // The input falls through a reference below the idle level
+    LPCOMP_WAKE_UP = 1     // The input rises through a reference above the idle level
+} lpcomp_wake_side_t;
+
+/**
+ * @brief Callback invoked from the LPCOMP interrupt when the input crossed the reference.
+ */
+typedef void (*lpcomp_wake_callback_t)(void);
+
+/**
+ * @brief Initialize the wake timestamp TIMER and its PPI channel.
+ *
+ * @return ret_code_t NRF_SUCCESS on success, otherwise the error from the TIMER or PPI driver.
+ */
+ret_code_t lpcomp_init(void);
+
+/**
+ * @brief Select the reference for an idle level.
+ *
+ * The comparator sees a single reference, so only one side of the idle level
+ * is watched. Selects the supply fraction nearest to `level_mv` on that side
+ * whose crossing is at least `margin_mv` and at most `reach_mv` away from it,
+ * the hysteresis included.
+ *
+ * @param level_mv Idle level of the input in millivolts.
+ * @param margin_mv Smallest distance between the idle level and the crossing.
+ * @param reach_mv Largest distance between the idle level and the crossing.
+ * @param side Side of the idle level the input moves to on a wake.
+ * @return int The step k of the k/16 VDD reference, 0 if none fits.
+ */
+int lpcomp_reference_step(int32_t level_mv, int32_t margin_mv, int32_t reach_mv, lpcomp_wake_side_t side);
+
+/**
+ * @brief Watch an analog input with the low-power comparator.
+ *
+ * Reports the first crossing of the k/16 VDD reference towards `side`; a
+ * move of the input to the other side is not seen.
+ *
+ * @param input Analog input to watch (AIN0 to AIN7).
+ * @param step The step k of the reference, from lpcomp_reference_step().
+ * @param side Direction of the crossing that wakes.
+ * @param callback Callback invoked once on the first crossing.
+ * @return ret_code_t NRF_SUCCESS if the comparator runs, NRF_ERROR_INVALID_PARAM if
+ *                    the step is out of range or the comparator already runs,
+ *                    otherwise the error from the LPCOMP driver.
+ */
+ret_code_t lpcomp_wake_arm(nrf_lpcomp_input_t input, int step, lpcomp_wake_side_t side,
+                           lpcomp_wake_callback_t callback);
+
+/**
+ * @brief Stop watching the input.
+ */
+void lpcomp_wake_disarm(void);
+
+/**
+ * @brief Get the time elapsed since the crossing.
+ *
+ * @return uint32_t Microseconds since the comparator crossed its reference.
+ */
+uint32_t lpcomp_wake_elapsed_us(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LPCOMP_DRIVER_H
@@ -0,0 +1,232 @@
+/**
+ * @file lpcomp_driver.c
+ * @brief Low-power comparator wake-up with a hardware wake timestamp.
+ * 
+ * This module watches a sensing electrode with the LPCOMP comparator while
+ * the SAADC and its timers are stopped. The comparator has a single
+ * reference, so it watches one side of the idle level of the input: the
+ * reference is the supply fraction nearest to the idle level on that side, a
+ * margin away from it and within reach of the wake threshold. The crossing
+ * starts a TIMER through PPI, so the wake is timestamped in hardware and the
+ * time to the first processed sample can be measured.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "lpcomp_driver.h"
+
+#include "nrf_log.h"
+#include "app_error.h"
+#include "nrfx_timer.h"
+#include "nrfx_ppi.h"
+
+/*
+ * Global variables:
+ */
+static const nrfx_timer_t wake_timer = NRFX_TIMER_INSTANCE(LPCOMP_WAKE_TIMER_INSTANCE);
+static nrf_ppi_channel_t wake_ppi_channel;
+static lpcomp_wake_callback_t wake_callback_ref = NULL; // Callback notified of the crossing
+static bool armed = false;                              // The comparator is running
+
+// Supply fraction reference for k / 16 of VDD, k from 1 to 15
+static const nrf_lpcomp_ref_t reference_steps[LPCOMP_REFERENCE_STEPS] = {
+    NRF_LPCOMP_REF_SUPPLY_1_8, // Unused (k = 0)
+    NRF_LPCOMP_REF_SUPPLY_1_16,  NRF_LPCOMP_REF_SUPPLY_1_8,  NRF_LPCOMP_REF_SUPPLY_3_16,
+    NRF_LPCOMP_REF_SUPPLY_2_8,   NRF_LPCOMP_REF_SUPPLY_5_16, NRF_LPCOMP_REF_SUPPLY_3_8,
+    NRF_LPCOMP_REF_SUPPLY_7_16,  NRF_LPCOMP_REF_SUPPLY_4_8,  NRF_LPCOMP_REF_SUPPLY_9_16,
+    NRF_LPCOMP_REF_SUPPLY_5_8,   NRF_LPCOMP_REF_SUPPLY_11_16, NRF_LPCOMP_REF_SUPPLY_6_8,
+    NRF_LPCOMP_REF_SUPPLY_13_16, NRF_LPCOMP_REF_SUPPLY_7_8,  NRF_LPCOMP_REF_SUPPLY_15_16
+};
+
+/*
+ * Prototypes for internal functions:
+ */
+static void lpcomp_event_handler(nrf_lpcomp_event_t event);
+static void wake_timer_handler(nrf_timer_event_t event_type, void * p_context);
+
+/**
+ * @brief Initialize the wake timestamp TIMER and its PPI channel.
+ *
+ * The TIMER counts microseconds on 32 bits (over an hour) and is started by
+ * the crossing event itself, so neither the interrupt latency nor the clock
+ * start-up delay the timestamp. The event is assigned when arming, with the side.
+ *
+ * @return ret_code_t NRF_SUCCESS on success, otherwise the error from the TIMER or PPI driver.
+ */
+ret_code_t lpcomp_init(void)
+{
+    ret_code_t err_code;
+
+    nrfx_timer_config_t timer_cfg = NRFX_TIMER_DEFAULT_CONFIG;
+    timer_cfg.frequency = NRF_TIMER_FREQ_1MHz;
+    timer_cfg.bit_width = NRF_TIMER_BIT_WIDTH_32;
+    err_code = nrfx_timer_init(&wake_timer, &timer_cfg, wake_timer_handler);
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+
+    return nrfx_ppi_channel_alloc(&wake_ppi_channel);
+}
+
+/**
+ * @brief Select the reference for an idle level.
+ *
+ * The comparator sees a single reference, so only one side of the idle level
+ * is watched; the caller picks it from the proximity polarity. The idle level
+ * must stay clear of the hysteresis band, and the wake happens at its far edge.
+ *
+ * @param level_mv Idle level of the input in millivolts.
+ * @param margin_mv Smallest distance between the idle level and the crossing.
+ * @param reach_mv Largest distance between the idle level and the crossing.
+ * @param side Side of the idle level the input moves to on a wake.
+ * @return int The step k of the k/16 VDD reference, 0 if none fits.
+ */
+int lpcomp_reference_step(int32_t level_mv, int32_t margin_mv, int32_t reach_mv, lpcomp_wake_side_t side)
+{
+    int32_t nearest_mv = margin_mv + LPCOMP_HYSTERESIS_MV / 2;
+    int32_t farthest_mv = reach_mv - LPCOMP_HYSTERESIS_MV / 2;
+    int32_t step;
+    int32_t distance; // In sixteenths of a millivolt, so odd steps stay exact
+
+    if (side == LPCOMP_WAKE_UP) {
+        // Nearest step at or above level + nearest
+        step = ((level_mv + nearest_mv) * LPCOMP_REFERENCE_STEPS + LPCOMP_SUPPLY_MV - 1) / LPCOMP_SUPPLY_MV;
+        distance = step * LPCOMP_SUPPLY_MV - level_mv * LPCOMP_REFERENCE_STEPS;
+    } else {
+        // Nearest step at or below level - nearest
+        step = ((level_mv - nearest_mv) * LPCOMP_REFERENCE_STEPS) / LPCOMP_SUPPLY_MV;
+        distance = level_mv * LPCOMP_REFERENCE_STEPS - step * LPCOMP_SUPPLY_MV;
+    }
+    if (step < 1 || step >= LPCOMP_REFERENCE_STEPS || distance > farthest_mv * LPCOMP_REFERENCE_STEPS) {
+        return 0;
+    }
+    return (int)step;
+}
+
+/**
+ * @brief Watch an analog input with the low-power comparator.
+ *
+ * The comparator runs with its 50 mV hysteresis and only detects crossings
+ * towards `side`, which both interrupt and start the wake TIMER through PPI;
+ * a move of the input to the other side goes unnoticed. The wake TIMER is
+ * stopped and cleared so that the crossing restarts it from zero.
+ *
+ * @param input Analog input to watch (AIN0 to AIN7).
+ * @param step The step k of the reference, from lpcomp_reference_step().
+ * @param side Direction of the crossing that wakes.
+ * @param callback Callback invoked once on the first crossing.
+ * @return ret_code_t NRF_SUCCESS if the comparator runs, NRF_ERROR_INVALID_PARAM if
+ *                    the step is out of range or the comparator already runs,
+ *                    otherwise the error from the LPCOMP driver.
+ */
+ret_code_t lpcomp_wake_arm(nrf_lpcomp_input_t input, int step, lpcomp_wake_side_t side,
+                           lpcomp_wake_callback_t callback)
+{
+    ret_code_t err_code;
+    nrf_lpcomp_event_t event = (side == LPCOMP_WAKE_UP) ? NRF_LPCOMP_EVENT_UP : NRF_LPCOMP_EVENT_DOWN;
+
+    if (step < 1 || step >= LPCOMP_REFERENCE_STEPS || armed) {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    nrfx_lpcomp_config_t config = NRFX_LPCOMP_DEFAULT_CONFIG;
+    config.hal.reference = reference_steps[step];
+    config.hal.detection = (side == LPCOMP_WAKE_UP) ? NRF_LPCOMP_DETECT_UP : NRF_LPCOMP_DETECT_DOWN;
+    config.hal.hyst = NRF_LPCOMP_HYST_50mV;
+    config.input = input;
+    err_code = nrfx_lpcomp_init(&config, lpcomp_event_handler);
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+
+    nrfx_timer_disable(&wake_timer);
+    nrfx_timer_clear(&wake_timer);
+    wake_callback_ref = callback;
+    armed = true;
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(wake_ppi_channel, nrf_lpcomp_event_address_get(event),
+                                            nrfx_timer_task_address_get(&wake_timer, NRF_TIMER_TASK_START)));
+    APP_ERROR_CHECK(nrfx_ppi_channel_enable(wake_ppi_channel));
+    nrfx_lpcomp_enable();
+
+    NRF_LOG_DEBUG("LPCOMP reference %d/16 VDD, wake %s", step, (side == LPCOMP_WAKE_UP) ? "up" : "down");
+    return NRF_SUCCESS;
+}
+
+/**
+ * @brief Stop watching the input.
+ *
+ * The wake TIMER keeps running so the elapsed time can still be read.
+ */
+void lpcomp_wake_disarm(void)
+{
+    if (!armed) {
+        return;
+    }
+    armed = false;
+    APP_ERROR_CHECK(nrfx_ppi_channel_disable(wake_ppi_channel));
+    nrfx_lpcomp_disable();
+    nrfx_lpcomp_uninit();
+}
+
+/**
+ * @brief Get the time elapsed since the crossing.
+ *
+ * @return uint32_t Microseconds since the comparator crossed its reference.
+ */
+uint32_t lpcomp_wake_elapsed_us(void)
+{
+    return nrfx_timer_capture(&wake_timer, NRF_TIMER_CC_CHANNEL0);
+}
+
+/**
+ * @brief LPCOMP event handler.
+ *
+ * Stops the comparator on the first crossing and notifies the callback.
+ *
+ * @param event The LPCOMP event (UP or DOWN).
+ */
+static void lpcomp_event_handler(nrf_lpcomp_event_t event)
+{
+    if (!armed) {
+        return;
+    }
+    lpcomp_wake_disarm();
+    if (wake_callback_ref != NULL) {
+        wake_callback_ref();
+    }
+}
+
+/**
+ * @brief Wake TIMER event handler.
+ *
+ * No compare interrupt is enabled, the TIMER is only captured.
+ *
+ * @param event_type Type of the timer event (unused).
+ * @param p_context Context for the timer event (unused).
+ */
+static void wake_timer_handler(nrf_timer_event_t event_type, void * p_context)
+{
+}
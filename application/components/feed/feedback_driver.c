@@ -0,0 +1,105 @@
+/**
+ * @file feedback_driver.c
+ * @brief Proximity feedback on the RGB LEDs.
+ * 
+ * This module turns the state changes reported by the sensor driver into
+ * feedback: the zone of the feedback channel is reported through the LED
+ * driver and its intensity is sent to the Arduino over UART. It is kept out
+ * of main.c so the host build can drive and time it with the rest of the
+ * sensor pipeline.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "feedback_driver.h"
+#include "led_driver.h"
+#include "uart_driver.h"
+#include "uart_frame.h"
+
+// Feedback status and RGB intensity of each proximity zone, indexed by sensor_zone_id_t
+static const sensor_feedback_t zone_feedback[SENSOR_ZONE_COUNT] = {
+    SENSOR_STATUS_SYST_INITZ_0000,
+    SENSOR_STATUS_ZONE_OUTER_0001,
+    SENSOR_STATUS_ZONE_INNER_0003,
+    SENSOR_STATUS_ZONE_TOUCH_0007
+};
+static const uint16_t zone_intensity[SENSOR_ZONE_COUNT] = {
+    LOW_INTENSITY, HIGH_INTENSITY / 4, HIGH_INTENSITY / 2, HIGH_INTENSITY
+};
+
+/**
+ * @brief Set the intensity of RGB LEDs and send the data via UART.
+ *
+ * Constructs a message with the specified RGB intensities and transmits it over UART.
+ * The message format (start byte, RGB values, checksum, and stop byte) is built
+ * by `uart_frame_rgb_build()`.
+ *
+ * @param red Intensity of the red LED component.
+ * @param green Intensity of the green LED component.
+ * @param blue Intensity of the blue LED component.
+ */
+void set_rgb_intensity(uint16_t red, uint16_t green, uint16_t blue) {
+    uint8_t message[UART_FRAME_RGB_SIZE];
+    // assuming 8-bit color intensity
+    size_t length = uart_frame_rgb_build(message, (uint8_t)(red & 0xFF), (uint8_t)(green & 0xFF), (uint8_t)(blue & 0xFF));
+    // TOSO: Currently we are only sensing data using the UART to Arduino
+    uart_send(message, (uint8_t)length);
+}
+
+/**
+ * @brief Feedback handler for sensor state changes.
+ *
+ * Called by the sensor driver when the proximity zone or the active change
+ * event of an instance changes, never while the state is steady. Only the
+ * FEEDBACK_CHANNEL instance drives the feedback: the zone is reported through
+ * `trigger_feedback()` and sets the RGB intensity, blue when the reading is
+ * below the golden reference and green when it is above.
+ *
+ * @param sensor_data Pointer to the latest sensor data structure.
+ */
+void sensor_feedback(sensor_data_t* sensor_data)
+{
+    if (sensor_data->channel != FEEDBACK_CHANNEL)
+    {
+        return;
+    }
+
+    trigger_feedback(zone_feedback[sensor_data->zone]);
+
+    uint16_t intensity = zone_intensity[sensor_data->zone];
+    // The change detector gives the direction; after its release the zone may still be dwelling
+    bool below = (sensor_data->change_state != 0) ? (sensor_data->change_state < 0)
+                                                  : (sensor_data->sensor_reading < sensor_data->golden_reference);
+
+    if (below)
+    {
+        set_rgb_intensity(LOW_INTENSITY, LOW_INTENSITY, intensity);
+    }
+    else
+    {
+        set_rgb_intensity(LOW_INTENSITY, intensity, LOW_INTENSITY);
+    }
+}
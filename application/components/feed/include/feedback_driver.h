@@ -0,0 +1,39 @@
+#ifndef FEEDBACK_DRIVER_H
+#define FEEDBACK_DRIVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "sensor_driver.h"
+
+#define HIGH_INTENSITY 255
+#define LOW_INTENSITY 0
+
+// Sensing channel driving the RGB feedback
+#define FEEDBACK_CHANNEL 0
+
+/**
+ * @brief Set the intensity of RGB LEDs and send the data via UART.
+ *
+ * @param red Intensity of the red LED component.
+ * @param green Intensity of the green LED component.
+ * @param blue Intensity of the blue LED component.
+ */
+void set_rgb_intensity(uint16_t red, uint16_t green, uint16_t blue);
+
+/**
+ * @brief Feedback handler for sensor state changes (sensor_callback_t).
+ *
+ * Only the FEEDBACK_CHANNEL instance drives the feedback.
+ *
+ * @param sensor_data Pointer to the latest sensor data structure.
+ */
+void sensor_feedback(sensor_data_t* sensor_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FEEDBACK_DRIVER_H
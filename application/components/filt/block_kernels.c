@@ -0,0 +1,201 @@
+/**
+ * @file block_kernels.c
+ * @brief Block kernels for 16-bit sample buffers.
+ * 
+ * This module provides the block kernels used on 16-bit sample buffers: sum,
+ * minimum/maximum, sum of squares and averaging decimation. The limit watch
+ * uses the minimum/maximum to check an idle buffer against its limits. On the
+ * Cortex-M4 the kernels load two samples per word and process them with the
+ * DSP instructions (SMLAD, SMLALD, SSUB16/SEL); elsewhere, or with
+ * BLOCK_KERNELS_DSP set to 0, the portable C loops are compiled instead. Both
+ * paths produce bit-identical results.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <string.h>
+
+#include "block_kernels.h"
+
+#if BLOCK_KERNELS_DSP
+#include "nrf.h"
+
+// Both halfwords set to one: SMLAD/SMUAD with it add the two samples of a word
+#define BLOCK_KERNELS_ONES 0x00010001u
+
+/*
+ * Prototypes for internal functions:
+ */ 
+static uint32_t load_pair(const int16_t *p_samples);
+
+/**
+ * @brief Load two consecutive samples as one word.
+ *
+ * The Cortex-M4 handles unaligned word loads, so the buffer only needs
+ * halfword alignment; memcpy compiles to a single LDR.
+ *
+ * @param p_samples Pointer to the first sample.
+ * @return uint32_t The two samples, the first one in the low halfword.
+ */
+static uint32_t load_pair(const int16_t *p_samples)
+{
+    uint32_t pair;
+    memcpy(&pair, p_samples, sizeof(pair));
+    return pair;
+}
+#endif
+
+/**
+ * @brief Sum a block of samples.
+ *
+ * @param p_samples Pointer to the samples.
+ * @param n Number of samples, up to BLOCK_KERNELS_MAX_SUM_LENGTH.
+ * @return int32_t The sum.
+ */
+int32_t block_sum(const int16_t *p_samples, size_t n)
+{
+    int32_t sum = 0;
+    size_t i = 0;
+
+#if BLOCK_KERNELS_DSP
+    for (; i + 1 < n; i += 2) {
+        sum = (int32_t)__SMLAD(load_pair(&p_samples[i]), BLOCK_KERNELS_ONES, (uint32_t)sum);
+    }
+#endif
+    for (; i < n; i++) {
+        sum += p_samples[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Find the minimum and maximum of a block of samples.
+ *
+ * The DSP path keeps a running minimum and maximum per halfword lane: SSUB16
+ * sets the GE flags of the lanes where the sample is not below the running
+ * value and SEL picks each lane accordingly. The two lanes are merged at the end.
+ *
+ * @param p_samples Pointer to the samples.
+ * @param n Number of samples.
+ * @param p_min Filled with the minimum (INT16_MAX for an empty block).
+ * @param p_max Filled with the maximum (INT16_MIN for an empty block).
+ */
+void block_min_max(const int16_t *p_samples, size_t n, int16_t *p_min, int16_t *p_max)
+{
+    int16_t min = INT16_MAX;
+    int16_t max = INT16_MIN;
+    size_t i = 0;
+
+#if BLOCK_KERNELS_DSP
+    if (n >= 2) {
+        uint32_t lane_min = load_pair(p_samples);
+        uint32_t lane_max = lane_min;
+        for (i = 2; i + 1 < n; i += 2) {
+            uint32_t pair = load_pair(&p_samples[i]);
+            (void)__SSUB16(pair, lane_max);
+            lane_max = __SEL(pair, lane_max);
+            (void)__SSUB16(pair, lane_min);
+            lane_min = __SEL(lane_min, pair);
+        }
+        int16_t low = (int16_t)(lane_min & 0xFFFF), high = (int16_t)(lane_min >> 16);
+        min = (low < high) ? low : high;
+        low = (int16_t)(lane_max & 0xFFFF), high = (int16_t)(lane_max >> 16);
+        max = (low > high) ? low : high;
+    }
+#endif
+    for (; i < n; i++) {
+        if (p_samples[i] < min) {
+            min = p_samples[i];
+        }
+        if (p_samples[i] > max) {
+            max = p_samples[i];
+        }
+    }
+    *p_min = min;
+    *p_max = max;
+}
+
+/**
+ * @brief Sum the squares of a block of samples (signal energy).
+ *
+ * @param p_samples Pointer to the samples.
+ * @param n Number of samples.
+ * @return int64_t The sum of squares.
+ */
+int64_t block_sum_squares(const int16_t *p_samples, size_t n)
+{
+    int64_t sum = 0;
+    size_t i = 0;
+
+#if BLOCK_KERNELS_DSP
+    for (; i + 1 < n; i += 2) {
+        uint32_t pair = load_pair(&p_samples[i]);
+        sum = (int64_t)__SMLALD(pair, pair, (uint64_t)sum);
+    }
+#endif
+    for (; i < n; i++) {
+        sum += (int32_t)p_samples[i] * p_samples[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Decimate a block by averaging groups of 2^ratio_log2 samples.
+ *
+ * Each output is the sum of its group shifted right by ratio_log2 (rounded
+ * toward minus infinity). A trailing partial group is ignored.
+ *
+ * @param p_input Pointer to the input samples.
+ * @param n Number of input samples.
+ * @param ratio_log2 Log2 of the decimation ratio, 0 to BLOCK_KERNELS_MAX_DECIMATION_LOG2.
+ * @param p_output Pointer to the output buffer, at least n >> ratio_log2 samples.
+ * @return size_t Number of output samples written.
+ */
+size_t block_decimate(const int16_t *p_input, size_t n, uint8_t ratio_log2, int16_t *p_output)
+{
+    if (ratio_log2 > BLOCK_KERNELS_MAX_DECIMATION_LOG2) {
+        return 0;
+    }
+
+    const size_t ratio = (size_t)1 << ratio_log2;
+    const size_t outputs = n >> ratio_log2;
+
+    for (size_t out = 0; out < outputs; out++) {
+        const int16_t *p_group = &p_input[out * ratio];
+        int32_t sum = 0;
+        size_t i = 0;
+#if BLOCK_KERNELS_DSP
+        for (; i + 1 < ratio; i += 2) {
+            sum = (int32_t)__SMLAD(load_pair(&p_group[i]), BLOCK_KERNELS_ONES, (uint32_t)sum);
+        }
+#endif
+        for (; i < ratio; i++) {
+            sum += p_group[i];
+        }
+        p_output[out] = (int16_t)(sum >> ratio_log2);
+    }
+    return outputs;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file cic_decimator.c
+ * @brief CIC decimation filter with optional FIR compensation.
+ * 
+ * This module reduces the oversampled SAADC stream to a lower-rate, lower-noise
+ * stream with a cascaded integrator-comb (CIC) filter, optionally followed by a
+ * short FIR that compensates the CIC passband droop. It works on whole DMA
+ * blocks and uses integer arithmetic only.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "cic_decimator.h"
+
+/*
+ * Prototypes for internal functions:
+ */ 
+static int16_t saturate_int16(int32_t value);
+
+/**
+ * @brief Initialize a CIC decimator.
+ *
+ * Clears the filter state of every channel and precomputes the gain
+ * normalization shift. Inputs and outputs share the same scale.
+ *
+ * @param p_decimator Pointer to the decimator.
+ * @param ratio Decimation ratio, a power of two from 1 to CIC_DECIMATOR_MAX_RATIO.
+ * @param channel_count Number of interleaved channels, 1 to CIC_DECIMATOR_MAX_CHANNELS.
+ * @param compensate True to apply the compensating FIR on the decimated output.
+ * @return bool True if the decimator was initialized, false if a parameter is invalid.
+ */
+bool cic_decimator_init(cic_decimator_t *p_decimator, uint16_t ratio, uint8_t channel_count, bool compensate)
+{
+    if (p_decimator == NULL || ratio == 0 || ratio > CIC_DECIMATOR_MAX_RATIO || (ratio & (ratio - 1)) != 0) {
+        return false;
+    }
+    if (channel_count == 0 || channel_count > CIC_DECIMATOR_MAX_CHANNELS) {
+        return false;
+    }
+
+    uint8_t ratio_log2 = 0;
+    while ((1u << ratio_log2) < ratio) {
+        ratio_log2++;
+    }
+
+    for (int ch = 0; ch < CIC_DECIMATOR_MAX_CHANNELS; ch++) {
+        cic_decimator_channel_t *p_channel = &p_decimator->channels[ch];
+        for (int i = 0; i < CIC_DECIMATOR_ORDER; i++) {
+            p_channel->integrators[i] = 0;
+            p_channel->combs[i] = 0;
+        }
+        p_channel->fir_history[0] = 0;
+        p_channel->fir_history[1] = 0;
+    }
+    p_decimator->channel_count = channel_count;
+    p_decimator->ratio      = ratio;
+    p_decimator->gain_shift = CIC_DECIMATOR_ORDER * ratio_log2;
+    p_decimator->scale_shift = 0;
+    p_decimator->phase      = 0;
+    p_decimator->compensate = compensate;
+    return true;
+}
+
+/**
+ * @brief Decimate a block of interleaved samples.
+ *
+ * The integrators run at the input rate and the combs at the output rate, so the
+ * cost is ORDER additions per input sample plus ORDER subtractions (and three
+ * multiplies with compensation) per output sample. The integrators are allowed
+ * to wrap: the comb differences are exact as long as the output fits 32 bits,
+ * which CIC_DECIMATOR_MAX_RATIO guarantees. The block is walked once, frame by
+ * frame, so the scan buffer is never de-interleaved into a copy.
+ *
+ * @param p_decimator Pointer to the decimator.
+ * @param p_input Pointer to the interleaved input samples.
+ * @param n Number of input samples, a multiple of the channel count.
+ * @param p_output Pointer to the output buffer, at least (n / channels / ratio + 1) frames.
+ * @return size_t Number of output frames written.
+ */
+size_t cic_decimator_process(cic_decimator_t *p_decimator, const int16_t *p_input, size_t n, int16_t *p_output)
+{
+    const uint8_t channel_count = p_decimator->channel_count;
+    const size_t frames = n / channel_count;
+    uint16_t phase = p_decimator->phase;
+    size_t produced = 0;
+    const int8_t output_shift = (int8_t)(p_decimator->gain_shift + p_decimator->scale_shift);
+
+    for (size_t frame = 0; frame < frames; frame++)
+    {
+        const int16_t *p_frame = &p_input[frame * channel_count];
+        bool output_due = (++phase >= p_decimator->ratio);
+
+        for (uint8_t ch = 0; ch < channel_count; ch++)
+        {
+            cic_decimator_channel_t *p_channel = &p_decimator->channels[ch];
+
+            // Integrator section at the input rate
+            uint32_t value = (uint32_t)(int32_t)p_frame[ch];
+            for (int stage = 0; stage < CIC_DECIMATOR_ORDER; stage++) {
+                p_channel->integrators[stage] += value;
+                value = p_channel->integrators[stage];
+            }
+
+            if (!output_due) {
+                continue;
+            }
+
+            // Comb section at the output rate
+            for (int stage = 0; stage < CIC_DECIMATOR_ORDER; stage++) {
+                uint32_t delayed = p_channel->combs[stage];
+                p_channel->combs[stage] = value;
+                value -= delayed;
+            }
+            int32_t output = (output_shift >= 0) ? ((int32_t)value >> output_shift)
+                                                 : ((int32_t)value * (1 << -output_shift));
+
+            if (p_decimator->compensate) {
+                int32_t *p_history = p_channel->fir_history;
+                int32_t compensated = CIC_COMPENSATOR_EDGE_Q15 * (output + p_history[1])
+                                    + CIC_COMPENSATOR_CENTER_Q15 * p_history[0];
+                p_history[1] = p_history[0];
+                p_history[0] = output;
+                output = compensated >> 15;
+            }
+
+            p_output[produced * channel_count + ch] = saturate_int16(output);
+        }
+
+        if (output_due) {
+            phase = 0;
+            produced++;
+        }
+    }
+
+    p_decimator->phase = phase;
+    return produced;
+}
+
+/**
+ * @brief Change the decimation ratio and input scale without an output transient.
+ *
+ * The frame is brought to the new input scale and the filter settled on it
+ * with cic_decimator_settle().
+ *
+ * @param p_decimator Pointer to an initialized decimator.
+ * @param ratio New decimation ratio, a power of two from 1 to CIC_DECIMATOR_MAX_RATIO.
+ * @param scale_shift Input bits above the output scale, within +/-CIC_DECIMATOR_MAX_SCALE_SHIFT.
+ * @param p_frame Pointer to one interleaved output-scale frame the filter settles on (typically the last output).
+ * @return bool True if the decimator was reconfigured, false if a parameter is invalid.
+ */
+bool cic_decimator_reconfigure(cic_decimator_t *p_decimator, uint16_t ratio, int8_t scale_shift, const int16_t *p_frame)
+{
+    int16_t input[CIC_DECIMATOR_MAX_CHANNELS];
+
+    if (scale_shift > CIC_DECIMATOR_MAX_SCALE_SHIFT || scale_shift < -CIC_DECIMATOR_MAX_SCALE_SHIFT) {
+        return false;
+    }
+    if (!cic_decimator_init(p_decimator, ratio, p_decimator->channel_count, p_decimator->compensate)) {
+        return false;
+    }
+    p_decimator->scale_shift = scale_shift;
+
+    for (uint8_t ch = 0; ch < p_decimator->channel_count; ch++) {
+        int32_t level = (scale_shift >= 0) ? ((int32_t)p_frame[ch] * (1 << scale_shift))
+                                           : ((int32_t)p_frame[ch] >> -scale_shift);
+        input[ch] = saturate_int16(level);
+    }
+    cic_decimator_settle(p_decimator, input);
+    return true;
+}
+
+/**
+ * @brief Settle every channel on a constant input frame.
+ *
+ * The impulse response of the CIC spans ORDER * (ratio - 1) + 1 input frames;
+ * feeding (ORDER + 1) * ratio copies of the frame also fills the two-sample
+ * compensator history, after which the state is exactly that of a filter that
+ * has seen the constant input forever, whatever it held before. At most 128
+ * frames are fed. At the start of a stream, settling on its first input frame
+ * keeps the outputs from ramping up from zero.
+ *
+ * @param p_decimator Pointer to an initialized decimator.
+ * @param p_frame Pointer to one interleaved input-scale frame.
+ */
+void cic_decimator_settle(cic_decimator_t *p_decimator, const int16_t *p_frame)
+{
+    int16_t discard[CIC_DECIMATOR_MAX_CHANNELS];
+
+    for (uint32_t i = 0; i < (uint32_t)(CIC_DECIMATOR_ORDER + 1) * p_decimator->ratio; i++) {
+        cic_decimator_process(p_decimator, p_frame, p_decimator->channel_count, discard);
+    }
+    p_decimator->phase = 0;
+}
+
+/**
+ * @brief Saturate a value to the int16_t range.
+ *
+ * @param value The value to saturate.
+ * @return int16_t The saturated value.
+ */
+static int16_t saturate_int16(int32_t value)
+{
+    if (value > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)value;
+}
@@ -0,0 +1,367 @@
+/**
+ * @file hampel_filter.c
+ * @brief Hampel outlier rejection over a two-heap running median.
+ * 
+ * This module removes single-sample spikes (ESD, EMI) before they reach the
+ * sensor statistics. A running median is kept in two indexed heaps so each
+ * update costs O(log n), and a sample is only replaced when it lies far from
+ * the median relative to a running deviation scale, so clean signal edges pass
+ * through without added latency.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "hampel_filter.h"
+
+/*
+ * Prototypes for internal functions:
+ */ 
+static bool heap_less(const hampel_filter_t *p_filter, int i, int j);
+static void heap_swap(hampel_filter_t *p_filter, int i, int j);
+static void min_sift_down(hampel_filter_t *p_filter, int i);
+static void max_sift_down(hampel_filter_t *p_filter, int i);
+static bool min_sift_up(hampel_filter_t *p_filter, int i);
+static bool max_sift_up(hampel_filter_t *p_filter, int i);
+static void median_fix_below(hampel_filter_t *p_filter);
+static void median_fix_above(hampel_filter_t *p_filter);
+static void median_insert(hampel_filter_t *p_filter, int16_t sample);
+static int32_t window_scale(const hampel_filter_t *p_filter, int32_t median);
+
+/**
+ * @brief Initialize a Hampel filter.
+ *
+ * The heaps are laid out around the median at heap index 0: indices 1..half
+ * form a min-heap of the larger samples and -1..-half a max-heap of the smaller
+ * ones, with the children of node i at 2i and 2i+1 (2i and 2i-1 below).
+ *
+ * @param p_filter Pointer to the filter.
+ * @param window Running median length, odd, 1 to HAMPEL_FILTER_MAX_WINDOW.
+ * @param threshold Rejection threshold in mean absolute deviations.
+ * @param scale_shift Smoothing shift of the deviation scale (time constant of 2^shift samples).
+ * @param min_deviation Deviation in counts that is always accepted (quantization noise floor).
+ * @return bool True if the filter was initialized, false if the window is invalid.
+ */
+bool hampel_filter_init(hampel_filter_t *p_filter, uint8_t window, uint8_t threshold,
+                        uint8_t scale_shift, int16_t min_deviation)
+{
+    if (p_filter == NULL || window == 0 || window > HAMPEL_FILTER_MAX_WINDOW || (window & 1) == 0) {
+        return false;
+    }
+
+    p_filter->window = window;
+    p_filter->half   = window / 2;
+    for (uint8_t slot = 0; slot < window; slot++) {
+        // Alternate the slots around the median: 0, -1, 1, -2, 2, ...
+        int position = ((slot + 1) / 2) * ((slot & 1) ? -1 : 1);
+        p_filter->positions[slot] = (int8_t)position;
+        p_filter->heap[position + p_filter->half] = slot;
+        p_filter->values[slot] = 0;
+    }
+    p_filter->oldest         = 0;
+    p_filter->filled         = 0;
+    p_filter->threshold      = threshold;
+    p_filter->scale_shift    = scale_shift;
+    p_filter->min_deviation  = min_deviation;
+    p_filter->scale          = 0;
+    p_filter->rejected_count = 0;
+    return true;
+}
+
+/**
+ * @brief Filter one sample.
+ *
+ * The sample enters the running median first, so the decision is taken on the
+ * window ending with it and the output is not delayed. The deviation scale is
+ * updated with the deviation clipped at the rejection limit, which keeps a
+ * burst of spikes from inflating it.
+ *
+ * The first sample fills the whole window, so the median is defined at once,
+ * but nothing is rejected until a full window of real samples has been seen:
+ * until then the samples pass through, and the deviation scale starts from
+ * the mean absolute deviation of that first window. A start-up transient
+ * therefore cannot lock the output onto itself.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param sample The new sample.
+ * @return int16_t The sample, or the running median if the sample is an outlier.
+ */
+int16_t hampel_filter_process(hampel_filter_t *p_filter, int16_t sample)
+{
+    if (p_filter->filled == 0) {
+        // Start from a window full of the first sample
+        for (uint8_t slot = 0; slot < p_filter->window; slot++) {
+            p_filter->values[slot] = sample;
+        }
+        p_filter->filled = 1;
+        return sample;
+    }
+
+    median_insert(p_filter, sample);
+
+    int32_t median = hampel_filter_median(p_filter);
+    if (p_filter->filled < p_filter->window) {
+        // Warm-up: pass through until the window holds real samples only
+        if (++p_filter->filled == p_filter->window) {
+            p_filter->scale = window_scale(p_filter, median);
+        }
+        return sample;
+    }
+
+    int32_t deviation = (sample > median) ? sample - median : median - sample;
+    int32_t deviation_q4 = deviation << HAMPEL_FILTER_SCALE_SHIFT;
+    int32_t limit_q4 = p_filter->scale * p_filter->threshold;
+    int32_t floor_q4 = (int32_t)p_filter->min_deviation << HAMPEL_FILTER_SCALE_SHIFT;
+
+    if (limit_q4 < floor_q4) {
+        limit_q4 = floor_q4;
+    }
+    bool outlier = deviation_q4 > limit_q4;
+    if (outlier) {
+        deviation_q4 = limit_q4;
+    }
+    p_filter->scale += (deviation_q4 - p_filter->scale) >> p_filter->scale_shift;
+
+    if (outlier) {
+        p_filter->rejected_count++;
+        return (int16_t)median;
+    }
+    return sample;
+}
+
+/**
+ * @brief Get the running median of the window.
+ *
+ * @param p_filter Pointer to a primed filter.
+ * @return int16_t The median of the last `window` samples.
+ */
+int16_t hampel_filter_median(const hampel_filter_t *p_filter)
+{
+    return p_filter->values[p_filter->heap[p_filter->half]];
+}
+
+/**
+ * @brief Get the number of samples replaced by the median.
+ *
+ * @param p_filter Pointer to the filter.
+ * @return uint32_t The rejection counter.
+ */
+uint32_t hampel_filter_rejected(const hampel_filter_t *p_filter)
+{
+    return p_filter->rejected_count;
+}
+
+/**
+ * @brief Replace the oldest sample of the window and restore the heap order.
+ *
+ * Only the path between the replaced slot and the median (and at most one
+ * heap below or above it) is walked, O(log window) comparisons.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param sample The new sample.
+ */
+static void median_insert(hampel_filter_t *p_filter, int16_t sample)
+{
+    uint8_t slot = p_filter->oldest;
+    int position = p_filter->positions[slot];
+    int16_t previous = p_filter->values[slot];
+
+    p_filter->values[slot] = sample;
+    p_filter->oldest = (slot + 1 == p_filter->window) ? 0 : slot + 1;
+
+    if (position > 0) {
+        // Slot in the min-heap of the larger samples
+        if (sample > previous) {
+            min_sift_down(p_filter, position);
+        } else if (min_sift_up(p_filter, position)) {
+            median_fix_below(p_filter);
+        }
+    } else if (position < 0) {
+        // Slot in the max-heap of the smaller samples
+        if (sample < previous) {
+            max_sift_down(p_filter, position);
+        } else if (max_sift_up(p_filter, position)) {
+            median_fix_above(p_filter);
+        }
+    } else {
+        // The median itself was replaced
+        median_fix_below(p_filter);
+        median_fix_above(p_filter);
+    }
+}
+
+/**
+ * @brief Compare the samples at two heap indices.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param i First heap index.
+ * @param j Second heap index.
+ * @return bool True if the sample at i is smaller than the sample at j.
+ */
+static bool heap_less(const hampel_filter_t *p_filter, int i, int j)
+{
+    const uint8_t *p_heap = &p_filter->heap[p_filter->half];
+    return p_filter->values[p_heap[i]] < p_filter->values[p_heap[j]];
+}
+
+/**
+ * @brief Swap two heap entries and update the slot positions.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param i First heap index.
+ * @param j Second heap index.
+ */
+static void heap_swap(hampel_filter_t *p_filter, int i, int j)
+{
+    uint8_t *p_heap = &p_filter->heap[p_filter->half];
+    uint8_t slot = p_heap[i];
+
+    p_heap[i] = p_heap[j];
+    p_heap[j] = slot;
+    p_filter->positions[p_heap[i]] = (int8_t)i;
+    p_filter->positions[p_heap[j]] = (int8_t)j;
+}
+
+/**
+ * @brief Move a grown min-heap entry down to its place.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param i Heap index (1..half).
+ */
+static void min_sift_down(hampel_filter_t *p_filter, int i)
+{
+    int last = p_filter->half;
+
+    for (int child = 2 * i; child <= last; child = 2 * i) {
+        if (child < last && heap_less(p_filter, child + 1, child)) {
+            child++;
+        }
+        if (!heap_less(p_filter, child, i)) {
+            break;
+        }
+        heap_swap(p_filter, child, i);
+        i = child;
+    }
+}
+
+/**
+ * @brief Move a shrunk max-heap entry down to its place.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param i Heap index (-1..-half).
+ */
+static void max_sift_down(hampel_filter_t *p_filter, int i)
+{
+    int last = -p_filter->half;
+
+    for (int child = 2 * i; child >= last; child = 2 * i) {
+        if (child > last && heap_less(p_filter, child, child - 1)) {
+            child--;
+        }
+        if (!heap_less(p_filter, i, child)) {
+            break;
+        }
+        heap_swap(p_filter, child, i);
+        i = child;
+    }
+}
+
+/**
+ * @brief Move a shrunk min-heap entry up, possibly into the median.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param i Heap index (1..half).
+ * @return bool True if the entry became the median.
+ */
+static bool min_sift_up(hampel_filter_t *p_filter, int i)
+{
+    while (i > 0 && heap_less(p_filter, i, i / 2)) {
+        heap_swap(p_filter, i, i / 2);
+        i /= 2;
+    }
+    return i == 0;
+}
+
+/**
+ * @brief Move a grown max-heap entry up, possibly into the median.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param i Heap index (-1..-half).
+ * @return bool True if the entry became the median.
+ */
+static bool max_sift_up(hampel_filter_t *p_filter, int i)
+{
+    while (i < 0 && heap_less(p_filter, i / 2, i)) {
+        heap_swap(p_filter, i, i / 2);
+        i /= 2;
+    }
+    return i == 0;
+}
+
+/**
+ * @brief Restore the order between the median and the max-heap below it.
+ *
+ * @param p_filter Pointer to the filter.
+ */
+static void median_fix_below(hampel_filter_t *p_filter)
+{
+    if (p_filter->half > 0 && heap_less(p_filter, 0, -1)) {
+        heap_swap(p_filter, 0, -1);
+        max_sift_down(p_filter, -1);
+    }
+}
+
+/**
+ * @brief Restore the order between the median and the min-heap above it.
+ *
+ * @param p_filter Pointer to the filter.
+ */
+static void median_fix_above(hampel_filter_t *p_filter)
+{
+    if (p_filter->half > 0 && heap_less(p_filter, 1, 0)) {
+        heap_swap(p_filter, 1, 0);
+        min_sift_down(p_filter, 1);
+    }
+}
+
+/**
+ * @brief Mean absolute deviation of the window from its median.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param median The median of the window.
+ * @return int32_t The deviation scale (Q4 counts).
+ */
+static int32_t window_scale(const hampel_filter_t *p_filter, int32_t median)
+{
+    int32_t total = 0;
+
+    for (uint8_t slot = 0; slot < p_filter->window; slot++) {
+        int32_t deviation = p_filter->values[slot] - median;
+        total += (deviation < 0) ? -deviation : deviation;
+    }
+    return (total << HAMPEL_FILTER_SCALE_SHIFT) / p_filter->window;
+}
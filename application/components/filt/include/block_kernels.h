@@ -0,0 +1,73 @@
+#ifndef BLOCK_KERNELS_H
+#define BLOCK_KERNELS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Kernel implementation: 1 uses the Cortex-M4 DSP instructions (two 16-bit
+// samples per instruction), 0 the portable C loops. Both give identical results.
+#ifndef BLOCK_KERNELS_DSP
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define BLOCK_KERNELS_DSP 1
+#else
+#define BLOCK_KERNELS_DSP 0
+#endif
+#endif
+
+// Longest block accepted by block_sum() without overflowing the 32-bit total
+#define BLOCK_KERNELS_MAX_SUM_LENGTH 65536
+
+// Largest decimation ratio of block_decimate() (2^5 samples per output)
+#define BLOCK_KERNELS_MAX_DECIMATION_LOG2 5
+
+/**
+ * @brief Sum a block of samples.
+ *
+ * @param p_samples Pointer to the samples.
+ * @param n Number of samples, up to BLOCK_KERNELS_MAX_SUM_LENGTH.
+ * @return int32_t The sum.
+ */
+int32_t block_sum(const int16_t *p_samples, size_t n);
+
+/**
+ * @brief Find the minimum and maximum of a block of samples.
+ *
+ * @param p_samples Pointer to the samples.
+ * @param n Number of samples.
+ * @param p_min Filled with the minimum (INT16_MAX for an empty block).
+ * @param p_max Filled with the maximum (INT16_MIN for an empty block).
+ */
+void block_min_max(const int16_t *p_samples, size_t n, int16_t *p_min, int16_t *p_max);
+
+/**
+ * @brief Sum the squares of a block of samples (signal energy).
+ *
+ * @param p_samples Pointer to the samples.
+ * @param n Number of samples.
+ * @return int64_t The sum of squares.
+ */
+int64_t block_sum_squares(const int16_t *p_samples, size_t n);
+
+/**
+ * @brief Decimate a block by averaging groups of 2^ratio_log2 samples.
+ *
+ * Each output is the sum of its group shifted right by ratio_log2 (rounded
+ * toward minus infinity). A trailing partial group is ignored.
+ *
+ * @param p_input Pointer to the input samples.
+ * @param n Number of input samples.
+ * @param ratio_log2 Log2 of the decimation ratio, 0 to BLOCK_KERNELS_MAX_DECIMATION_LOG2.
+ * @param p_output Pointer to the output buffer, at least n >> ratio_log2 samples.
+ * @return size_t Number of output samples written.
+ */
+size_t block_decimate(const int16_t *p_input, size_t n, uint8_t ratio_log2, int16_t *p_output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLOCK_KERNELS_H
@@ -0,0 +1,115 @@
+#ifndef CIC_DECIMATOR_H
+#define CIC_DECIMATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Number of integrator and comb stages of the CIC filter
+#define CIC_DECIMATOR_ORDER 3
+
+// Largest supported decimation ratio: 16-bit input plus ORDER * log2(ratio)
+// bits of growth must fit in the 32-bit integrators.
+#define CIC_DECIMATOR_MAX_RATIO 32
+
+// Largest number of interleaved channels decimated by one decimator
+#define CIC_DECIMATOR_MAX_CHANNELS 8
+
+// Largest input scale difference removed with the CIC gain, in bits
+#define CIC_DECIMATOR_MAX_SCALE_SHIFT 8
+
+// Compensating FIR taps [-a, 1 + 2a, -a] in Q15 (a = 0.14), flattening the CIC
+// droop of an order 3 filter over the lower quarter of the output band.
+#define CIC_COMPENSATOR_EDGE_Q15   (-4588)
+#define CIC_COMPENSATOR_CENTER_Q15 41944
+
+/**
+ * @brief Filter state of one decimated channel.
+ */
+typedef struct {
+    uint32_t integrators[CIC_DECIMATOR_ORDER]; // Integrator registers (modular arithmetic)
+    uint32_t combs[CIC_DECIMATOR_ORDER];       // Delayed comb inputs
+    int32_t fir_history[2];                    // Previous two CIC outputs for the compensator
+} cic_decimator_channel_t;
+
+/**
+ * @brief State of a CIC decimator with optional droop compensation.
+ *
+ * Decimates `channel_count` interleaved channels in lockstep, one filter state
+ * per channel.
+ */
+typedef struct {
+    cic_decimator_channel_t channels[CIC_DECIMATOR_MAX_CHANNELS]; // Per-channel filter state
+    uint8_t channel_count;                     // Number of interleaved channels
+    uint16_t ratio;                            // Decimation ratio (power of two)
+    uint8_t gain_shift;                        // ORDER * log2(ratio), removes the CIC gain
+    int8_t scale_shift;                        // Input scale above the output scale in bits
+    uint16_t phase;                            // Input frames since the last output
+    bool compensate;                           // Apply the compensating FIR
+} cic_decimator_t;
+
+/**
+ * @brief Initialize a CIC decimator.
+ *
+ * @param p_decimator Pointer to the decimator.
+ * @param ratio Decimation ratio, a power of two from 1 to CIC_DECIMATOR_MAX_RATIO.
+ * @param channel_count Number of interleaved channels, 1 to CIC_DECIMATOR_MAX_CHANNELS.
+ * @param compensate True to apply the compensating FIR on the decimated output.
+ * @return bool True if the decimator was initialized, false if a parameter is invalid.
+ */
+bool cic_decimator_init(cic_decimator_t *p_decimator, uint16_t ratio, uint8_t channel_count, bool compensate);
+
+/**
+ * @brief Decimate a block of interleaved samples.
+ *
+ * Runs every input frame (one sample per channel) through the integrators and
+ * produces one output frame every `ratio` input frames. The state carries over
+ * between blocks, so blocks of any number of frames can be fed. Outputs are
+ * normalized back to the input scale and keep the channel interleaving.
+ *
+ * @param p_decimator Pointer to the decimator.
+ * @param p_input Pointer to the interleaved input samples.
+ * @param n Number of input samples, a multiple of the channel count.
+ * @param p_output Pointer to the output buffer, at least (n / channels / ratio + 1) frames.
+ * @return size_t Number of output frames written.
+ */
+size_t cic_decimator_process(cic_decimator_t *p_decimator, const int16_t *p_input, size_t n, int16_t *p_output);
+
+/**
+ * @brief Change the decimation ratio and input scale without an output transient.
+ *
+ * Restarts the filter at the new ratio and settles every channel on a constant
+ * input frame, so the first outputs at the new settings continue from that level.
+ * Inputs `scale_shift` bits finer than the output scale are brought down with
+ * the CIC gain, after the averaging, so their extra resolution lowers the
+ * quantization noise of the outputs; coarser inputs (negative shift) are scaled up.
+ *
+ * @param p_decimator Pointer to an initialized decimator.
+ * @param ratio New decimation ratio, a power of two from 1 to CIC_DECIMATOR_MAX_RATIO.
+ * @param scale_shift Input bits above the output scale, within +/-CIC_DECIMATOR_MAX_SCALE_SHIFT.
+ * @param p_frame Pointer to one interleaved output-scale frame the filter settles on (typically the last output).
+ * @return bool True if the decimator was reconfigured, false if a parameter is invalid.
+ */
+bool cic_decimator_reconfigure(cic_decimator_t *p_decimator, uint16_t ratio, int8_t scale_shift, const int16_t *p_frame);
+
+/**
+ * @brief Settle every channel on a constant input frame.
+ *
+ * The following outputs continue from that level as if the input had been
+ * constant forever; used on the first frame of a stream, which has no output
+ * to continue from.
+ *
+ * @param p_decimator Pointer to an initialized decimator.
+ * @param p_frame Pointer to one interleaved input-scale frame (the first scan frame).
+ */
+void cic_decimator_settle(cic_decimator_t *p_decimator, const int16_t *p_frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CIC_DECIMATOR_H
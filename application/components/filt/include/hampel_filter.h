@@ -0,0 +1,82 @@
+#ifndef HAMPEL_FILTER_H
+#define HAMPEL_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Largest running median window (odd, heap indices must fit int8_t)
+#define HAMPEL_FILTER_MAX_WINDOW 31
+
+// Fraction bits of the running deviation scale
+#define HAMPEL_FILTER_SCALE_SHIFT 4
+
+/**
+ * @brief Causal Hampel spike filter over a running median.
+ *
+ * The median of the last `window` samples is kept in two indexed heaps around a
+ * center slot (max-heap below, min-heap above), so replacing the oldest sample
+ * costs O(log window). A sample further than `threshold` times the running mean
+ * absolute deviation from the median is replaced by the median.
+ */
+typedef struct {
+    int16_t values[HAMPEL_FILTER_MAX_WINDOW];  // Ring of the last `window` samples
+    int8_t positions[HAMPEL_FILTER_MAX_WINDOW]; // Heap index of every ring slot
+    uint8_t heap[HAMPEL_FILTER_MAX_WINDOW];    // Ring slots, heap index -half..half stored at +half
+    uint8_t window;                            // Window length (odd)
+    uint8_t half;                              // Number of samples in each heap
+    uint8_t oldest;                            // Ring slot replaced by the next sample
+    uint8_t filled;                            // Real samples in the window, up to `window` (copies of the first fill the rest)
+    uint8_t threshold;                         // Rejection threshold in mean absolute deviations
+    uint8_t scale_shift;                       // Smoothing shift of the deviation scale
+    int16_t min_deviation;                     // Deviations up to this many counts are never rejected
+    int32_t scale;                             // Running mean absolute deviation (Q4 counts)
+    uint32_t rejected_count;                   // Number of samples replaced by the median
+} hampel_filter_t;
+
+/**
+ * @brief Initialize a Hampel filter.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param window Running median length, odd, 1 to HAMPEL_FILTER_MAX_WINDOW.
+ * @param threshold Rejection threshold in mean absolute deviations.
+ * @param scale_shift Smoothing shift of the deviation scale (time constant of 2^shift samples).
+ * @param min_deviation Deviation in counts that is always accepted (quantization noise floor).
+ * @return bool True if the filter was initialized, false if the window is invalid.
+ */
+bool hampel_filter_init(hampel_filter_t *p_filter, uint8_t window, uint8_t threshold,
+                        uint8_t scale_shift, int16_t min_deviation);
+
+/**
+ * @brief Filter one sample.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param sample The new sample.
+ * @return int16_t The sample, or the running median if the sample is an outlier.
+ */
+int16_t hampel_filter_process(hampel_filter_t *p_filter, int16_t sample);
+
+/**
+ * @brief Get the running median of the window.
+ *
+ * @param p_filter Pointer to a filter that has seen at least one sample.
+ * @return int16_t The median of the last `window` samples.
+ */
+int16_t hampel_filter_median(const hampel_filter_t *p_filter);
+
+/**
+ * @brief Get the number of samples replaced by the median.
+ *
+ * @param p_filter Pointer to the filter.
+ * @return uint32_t The rejection counter.
+ */
+uint32_t hampel_filter_rejected(const hampel_filter_t *p_filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAMPEL_FILTER_H
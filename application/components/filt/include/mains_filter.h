@@ -0,0 +1,113 @@
+#ifndef MAINS_FILTER_H
+#define MAINS_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Notched harmonics of the mains frequency (fundamental included)
+#define MAINS_FILTER_HARMONICS 3
+
+// Fraction bits of the notch and Goertzel coefficients
+#define MAINS_FILTER_COEFF_SHIFT 14
+
+// Pole radius of the notches (-3 dB width of about (1 - r) * fs / pi)
+#define MAINS_FILTER_POLE_RADIUS 0.98f
+
+// Goertzel frames per second: one mains estimate every 1/5 s with 5 Hz bins
+#define MAINS_FILTER_ESTIMATES_PER_SECOND 5
+
+/**
+ * @brief Candidate mains frequencies.
+ */
+typedef enum {
+    MAINS_FILTER_50HZ = 0,
+    MAINS_FILTER_60HZ,
+    MAINS_FILTER_CANDIDATES
+} mains_filter_candidate_t;
+
+/**
+ * @brief Fixed-point biquad section (direct form I, fractional feedback state).
+ */
+typedef struct {
+    int32_t x1, x2;   // Previous inputs
+    int32_t y1, y2;   // Previous outputs with MAINS_FILTER_COEFF_SHIFT fraction bits
+    int32_t error;    // Output truncation remainder carried to the next sample
+} mains_filter_biquad_t;
+
+/**
+ * @brief Coefficients of one notch section, Q2.14.
+ */
+typedef struct {
+    int32_t b0, b1, b2; // Feed-forward (b0 == b2)
+    int32_t a1, a2;     // Feedback (a0 == 1)
+} mains_filter_coeffs_t;
+
+/**
+ * @brief Mains hum detector and notch cascade.
+ *
+ * Two Goertzel resonators measure the 50 Hz and 60 Hz content of the stream
+ * over frames of sample_rate / MAINS_FILTER_ESTIMATES_PER_SECOND samples. Once
+ * a candidate exceeds the minimum amplitude, a notch cascade on its harmonics
+ * is applied to every sample; until then samples pass through unchanged.
+ */
+typedef struct {
+    mains_filter_coeffs_t coeffs[MAINS_FILTER_CANDIDATES][MAINS_FILTER_HARMONICS]; // Precomputed notches
+    mains_filter_biquad_t sections[MAINS_FILTER_HARMONICS]; // Notch states
+    uint8_t section_count;                    // Harmonics below the Nyquist frequency
+    int8_t active;                            // Notched candidate, -1 while no hum is detected
+    uint16_t amplitude;                       // Estimated amplitude of the detected fundamental (counts)
+    int32_t goertzel_coeff[MAINS_FILTER_CANDIDATES]; // 2cos(w) of each candidate, Q2.14
+    int32_t goertzel_s1[MAINS_FILTER_CANDIDATES];    // Resonator state s[n-1]
+    int32_t goertzel_s2[MAINS_FILTER_CANDIDATES];    // Resonator state s[n-2]
+    uint16_t frame_length;                    // Samples per Goertzel frame
+    uint16_t frame_count;                     // Samples accumulated in the current frame
+    uint16_t min_amplitude;                   // Amplitude (counts) needed to enable a notch
+} mains_filter_t;
+
+/**
+ * @brief Initialize a mains filter.
+ *
+ * Computes the Goertzel and notch coefficients for both candidates once, so
+ * the per-sample path is integer only.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param sample_rate_hz Sample rate of the filtered stream, a multiple of 2 * MAINS_FILTER_ESTIMATES_PER_SECOND above 120 Hz.
+ * @param min_amplitude Fundamental amplitude in counts that enables the notches.
+ * @return bool True if the filter was initialized, false if the sample rate is unsupported.
+ */
+bool mains_filter_init(mains_filter_t *p_filter, uint32_t sample_rate_hz, uint16_t min_amplitude);
+
+/**
+ * @brief Filter one sample.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param sample The new sample.
+ * @return int16_t The sample with the detected mains harmonics removed.
+ */
+int16_t mains_filter_process(mains_filter_t *p_filter, int16_t sample);
+
+/**
+ * @brief Get the detected mains frequency.
+ *
+ * @param p_filter Pointer to the filter.
+ * @return uint16_t 50 or 60 (Hz), or 0 while no hum is detected.
+ */
+uint16_t mains_filter_frequency(const mains_filter_t *p_filter);
+
+/**
+ * @brief Get the estimated amplitude of the detected mains fundamental.
+ *
+ * @param p_filter Pointer to the filter.
+ * @return uint16_t The amplitude in counts, updated once per Goertzel frame.
+ */
+uint16_t mains_filter_amplitude(const mains_filter_t *p_filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MAINS_FILTER_H
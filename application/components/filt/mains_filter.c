@@ -0,0 +1,316 @@
+/**
+ * @file mains_filter.c
+ * @brief Goertzel mains hum detector and notch cascade.
+ * 
+ * This module estimates the mains hum (50 Hz or 60 Hz) picked up by the
+ * electrodes with two Goertzel resonators and removes it, together with its
+ * harmonics, with a fixed-point biquad notch cascade. The notches have unity
+ * gain at DC, so the slowly varying sensor level passes through unchanged.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+#include <math.h>
+
+#include "mains_filter.h"
+
+// M_PI is a POSIX extension, not ISO C
+#define MAINS_PI 3.14159265358979f
+
+// Candidate mains fundamentals in Hz, indexed by mains_filter_candidate_t
+static const uint16_t candidate_hz[MAINS_FILTER_CANDIDATES] = { 50, 60 };
+
+/*
+ * Prototypes for internal functions:
+ */ 
+static void notch_design(mains_filter_coeffs_t *p_coeffs, float frequency, float sample_rate);
+static void notch_reset(mains_filter_t *p_filter, int16_t sample);
+static int32_t biquad_process(mains_filter_biquad_t *p_section, const mains_filter_coeffs_t *p_coeffs, int32_t x);
+static void goertzel_evaluate(mains_filter_t *p_filter, int16_t sample);
+static uint32_t isqrt64(uint64_t value);
+static int16_t saturate_int16(int32_t value);
+
+/**
+ * @brief Initialize a mains filter.
+ *
+ * Computes the Goertzel and notch coefficients for both candidates once, so
+ * the per-sample path is integer only.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param sample_rate_hz Sample rate of the filtered stream, a multiple of 2 * MAINS_FILTER_ESTIMATES_PER_SECOND above 120 Hz.
+ * @param min_amplitude Fundamental amplitude in counts that enables the notches.
+ * @return bool True if the filter was initialized, false if the sample rate is unsupported.
+ */
+bool mains_filter_init(mains_filter_t *p_filter, uint32_t sample_rate_hz, uint16_t min_amplitude)
+{
+    // Both fundamentals must fall on exact Goertzel bins below the Nyquist frequency
+    if (p_filter == NULL || sample_rate_hz <= 2 * 60 ||
+        (sample_rate_hz % (2 * MAINS_FILTER_ESTIMATES_PER_SECOND)) != 0) {
+        return false;
+    }
+
+    float sample_rate = (float)sample_rate_hz;
+    p_filter->section_count = 0;
+    for (uint8_t h = 1; h <= MAINS_FILTER_HARMONICS; h++) {
+        if (2u * h * candidate_hz[MAINS_FILTER_60HZ] >= sample_rate_hz) {
+            break;
+        }
+        p_filter->section_count = h;
+    }
+
+    for (int c = 0; c < MAINS_FILTER_CANDIDATES; c++) {
+        for (uint8_t h = 0; h < p_filter->section_count; h++) {
+            notch_design(&p_filter->coeffs[c][h], (float)(candidate_hz[c] * (h + 1)), sample_rate);
+        }
+        float w = 2.0f * MAINS_PI * (float)candidate_hz[c] / sample_rate;
+        p_filter->goertzel_coeff[c] = (int32_t)lroundf(2.0f * cosf(w) * (1 << MAINS_FILTER_COEFF_SHIFT));
+        p_filter->goertzel_s1[c] = 0;
+        p_filter->goertzel_s2[c] = 0;
+    }
+
+    p_filter->active        = -1;
+    p_filter->amplitude     = 0;
+    p_filter->frame_length  = (uint16_t)(sample_rate_hz / MAINS_FILTER_ESTIMATES_PER_SECOND);
+    p_filter->frame_count   = 0;
+    p_filter->min_amplitude = min_amplitude;
+    return true;
+}
+
+/**
+ * @brief Filter one sample.
+ *
+ * Feeds both Goertzel resonators (one multiply each) and, once hum has been
+ * detected, runs the sample through the notch cascade (five multiplies per
+ * section). The detection is re-evaluated at the end of every frame.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param sample The new sample.
+ * @return int16_t The sample with the detected mains harmonics removed.
+ */
+int16_t mains_filter_process(mains_filter_t *p_filter, int16_t sample)
+{
+    for (int c = 0; c < MAINS_FILTER_CANDIDATES; c++) {
+        int32_t s0 = sample + (int32_t)(((int64_t)p_filter->goertzel_coeff[c] * p_filter->goertzel_s1[c])
+                                        >> MAINS_FILTER_COEFF_SHIFT) - p_filter->goertzel_s2[c];
+        p_filter->goertzel_s2[c] = p_filter->goertzel_s1[c];
+        p_filter->goertzel_s1[c] = s0;
+    }
+    if (++p_filter->frame_count == p_filter->frame_length) {
+        goertzel_evaluate(p_filter, sample);
+    }
+
+    if (p_filter->active < 0) {
+        return sample;
+    }
+
+    int32_t value = sample;
+    for (uint8_t h = 0; h < p_filter->section_count; h++) {
+        value = biquad_process(&p_filter->sections[h], &p_filter->coeffs[p_filter->active][h], value);
+    }
+    return saturate_int16(value);
+}
+
+/**
+ * @brief Get the detected mains frequency.
+ *
+ * @param p_filter Pointer to the filter.
+ * @return uint16_t 50 or 60 (Hz), or 0 while no hum is detected.
+ */
+uint16_t mains_filter_frequency(const mains_filter_t *p_filter)
+{
+    return (p_filter->active < 0) ? 0 : candidate_hz[p_filter->active];
+}
+
+/**
+ * @brief Get the estimated amplitude of the detected mains fundamental.
+ *
+ * @param p_filter Pointer to the filter.
+ * @return uint16_t The amplitude in counts, updated once per Goertzel frame.
+ */
+uint16_t mains_filter_amplitude(const mains_filter_t *p_filter)
+{
+    return p_filter->amplitude;
+}
+
+/**
+ * @brief Close a Goertzel frame and update the detection.
+ *
+ * The frame spans a whole number of periods of both candidates, so each sits
+ * on an exact bin and the DC level does not leak into them. The stronger
+ * candidate is notched once its amplitude reaches the minimum; a detected
+ * candidate is only replaced when the other one is clearly (2x) stronger, and
+ * frames below the minimum keep the current notch instead of toggling it.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param sample The last sample of the frame, used to settle a newly enabled notch.
+ */
+static void goertzel_evaluate(mains_filter_t *p_filter, int16_t sample)
+{
+    uint32_t amplitude[MAINS_FILTER_CANDIDATES];
+
+    for (int c = 0; c < MAINS_FILTER_CANDIDATES; c++) {
+        int64_t s1 = p_filter->goertzel_s1[c];
+        int64_t s2 = p_filter->goertzel_s2[c];
+        int64_t power = s1 * s1 + s2 * s2 - ((p_filter->goertzel_coeff[c] * s1 * s2) >> MAINS_FILTER_COEFF_SHIFT);
+        // |X| = sqrt(power), amplitude = 2 |X| / N
+        amplitude[c] = 2 * isqrt64(power > 0 ? (uint64_t)power : 0) / p_filter->frame_length;
+        p_filter->goertzel_s1[c] = 0;
+        p_filter->goertzel_s2[c] = 0;
+    }
+    p_filter->frame_count = 0;
+
+    int strongest = (amplitude[MAINS_FILTER_60HZ] > amplitude[MAINS_FILTER_50HZ]) ? MAINS_FILTER_60HZ : MAINS_FILTER_50HZ;
+    int other = 1 - strongest;
+
+    if (amplitude[strongest] >= p_filter->min_amplitude &&
+        (p_filter->active < 0 || (strongest != p_filter->active && amplitude[strongest] > 2 * amplitude[other]))) {
+        p_filter->active = (int8_t)strongest;
+        notch_reset(p_filter, sample);
+    }
+    if (p_filter->active >= 0) {
+        uint32_t detected = amplitude[p_filter->active];
+        p_filter->amplitude = (detected > UINT16_MAX) ? UINT16_MAX : (uint16_t)detected;
+    }
+}
+
+/**
+ * @brief Design one notch section with unity DC gain.
+ *
+ * H(z) = g (1 - 2cos(w) z^-1 + z^-2) / (1 - 2r cos(w) z^-1 + r^2 z^-2). After
+ * quantization, b1 absorbs the rounding so that b0 + b1 + b2 == 1 + a1 + a2
+ * exactly and the DC gain stays exactly one.
+ *
+ * @param p_coeffs Pointer to the coefficients to fill.
+ * @param frequency Notch frequency in Hz.
+ * @param sample_rate Sample rate in Hz.
+ */
+static void notch_design(mains_filter_coeffs_t *p_coeffs, float frequency, float sample_rate)
+{
+    const float one = (float)(1 << MAINS_FILTER_COEFF_SHIFT);
+    float r = MAINS_FILTER_POLE_RADIUS;
+    float c = cosf(2.0f * MAINS_PI * frequency / sample_rate);
+    float gain = (1.0f - 2.0f * r * c + r * r) / (2.0f - 2.0f * c);
+
+    p_coeffs->a1 = (int32_t)lroundf(-2.0f * r * c * one);
+    p_coeffs->a2 = (int32_t)lroundf(r * r * one);
+    p_coeffs->b0 = (int32_t)lroundf(gain * one);
+    p_coeffs->b2 = p_coeffs->b0;
+    p_coeffs->b1 = (1 << MAINS_FILTER_COEFF_SHIFT) + p_coeffs->a1 + p_coeffs->a2 - 2 * p_coeffs->b0;
+}
+
+/**
+ * @brief Settle every notch section on a constant input.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param sample The level the sections start from.
+ */
+static void notch_reset(mains_filter_t *p_filter, int16_t sample)
+{
+    for (uint8_t h = 0; h < MAINS_FILTER_HARMONICS; h++) {
+        mains_filter_biquad_t *p_section = &p_filter->sections[h];
+        p_section->x1 = p_section->x2 = sample;
+        p_section->y1 = p_section->y2 = sample * (1 << MAINS_FILTER_COEFF_SHIFT);
+        p_section->error = 0;
+    }
+}
+
+/**
+ * @brief Run one sample through a biquad section.
+ *
+ * Direct form I in a 64-bit accumulator. The poles sit close to the unit
+ * circle, so the recursion keeps the outputs with their fraction bits: an
+ * error made inside the loop would come back amplified about 1 / (1 - r)
+ * times right at the notch frequency and fill the notch. Only the returned
+ * sample is truncated, and its remainder is carried into the next one so no
+ * DC offset builds up.
+ *
+ * @param p_section Pointer to the section state.
+ * @param p_coeffs Pointer to the section coefficients.
+ * @param x The input sample.
+ * @return int32_t The output sample.
+ */
+static int32_t biquad_process(mains_filter_biquad_t *p_section, const mains_filter_coeffs_t *p_coeffs, int32_t x)
+{
+    int64_t feedback = (int64_t)p_coeffs->a1 * p_section->y1 + (int64_t)p_coeffs->a2 * p_section->y2;
+    int64_t acc = (int64_t)p_coeffs->b0 * x
+                + (int64_t)p_coeffs->b1 * p_section->x1
+                + (int64_t)p_coeffs->b2 * p_section->x2
+                - (feedback >> MAINS_FILTER_COEFF_SHIFT);
+
+    p_section->x2 = p_section->x1;
+    p_section->x1 = x;
+    p_section->y2 = p_section->y1;
+    p_section->y1 = (int32_t)acc;
+
+    acc += p_section->error;
+    int32_t y = (int32_t)(acc >> MAINS_FILTER_COEFF_SHIFT);
+    p_section->error = (int32_t)(acc - ((int64_t)y << MAINS_FILTER_COEFF_SHIFT));
+    return y;
+}
+
+/**
+ * @brief Integer square root.
+ *
+ * @param value The value.
+ * @return uint32_t floor(sqrt(value)).
+ */
+static uint32_t isqrt64(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+/**
+ * @brief Saturate a value to the int16_t range.
+ *
+ * @param value The value to saturate.
+ * @return int16_t The saturated value.
+ */
+static int16_t saturate_int16(int32_t value)
+{
+    if (value > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)value;
+}
@@ -8,6 +8,8 @@ extern "C" {
 #include <stdint.h>
 #include <stdbool.h>
 #include "nrfx_saadc.h"
+#include "sadc_queue.h"
+#include "sensor_config.h"
 
 /**
  * @brief Error codes for SAADC operations.
@@ -26,65 +28,182 @@ typedef enum {
  */
 typedef sadc_error_t sadc_ret_code_t;
 
+/**
+ * @brief Callback invoked from the SAADC interrupt when a completed buffer is queued.
+ */
+typedef void (*sadc_callback_t)(void);
+
+/**
+ * @brief Limit watch events.
+ */
+typedef enum {
+    SADC_WATCH_REFRESH = 0,  // Another SADC_WATCH_REFRESH_FRAMES scans went by, the limits may be re-centred
+    SADC_WATCH_WAKE          // A limit was crossed, buffered sampling resumed at the full rate
+} sadc_watch_evt_t;
+
+/**
+ * @brief Callback invoked from interrupt context on limit watch events.
+ */
+typedef void (*sadc_watch_callback_t)(sadc_watch_evt_t event);
+
 // ADC channel definition for sensor readings
 #define SADC_SENSOR_CHANNEL NRF_SAADC_INPUT_AIN0
 
+// Scan configuration: number of sensing channels and their inputs in scan order
+#define SADC_MAX_CHANNEL_COUNT 8 // SAADC channels available on the nRF52840
+#define SADC_CHANNEL_COUNT SENSOR_CHANNEL_COUNT // Set in sensor_config.h
+#ifndef SADC_CHANNEL_INPUTS
+#define SADC_CHANNEL_INPUTS { SADC_SENSOR_CHANNEL }
+#endif
+#define SADC_CHANNEL_MASK ((1u << SADC_CHANNEL_COUNT) - 1) // Channels enabled in advanced mode
+#define SADC_SCAN_TIMER_INSTANCE 1 // TIMER triggering the scans when more than one channel is used, the rate is governed or buffers are timestamped
+
+// SAADC conversion settings, shared by the driver and every consumer of the samples.
+// Raw samples keep the resolution of their acquisition profile; the decimator
+// brings every profile to SADC_SCALE_BITS, the scale all levels are given in.
+#define SADC_SCALE_BITS      (8 + 2 * NRFX_SAADC_CONFIG_RESOLUTION) // Scale of the decimated samples (app_config.h: 8, 10, 12 or 14 bits)
+#define SADC_DEFAULT_PROFILE ((sadc_profile_id_t)SENSOR_SAADC_PROFILE) // Set in sensor_config.h
+#define SADC_GAIN            NRF_SAADC_GAIN1_6  // Input gain of the sensor channel
+#define SADC_GAIN_RECIPROCAL 6                  // Reciprocal of SADC_GAIN
+#define SADC_REFERENCE_MV    600                // Internal reference voltage in millivolts
+#define SADC_FULL_SCALE_MV   (SADC_REFERENCE_MV * SADC_GAIN_RECIPROCAL) // Input voltage at full scale
+#define SADC_ACQ_TIME_US     10                 // Acquisition time of every channel (NRFX_SAADC_DEFAULT_CHANNEL_SE)
+#define SADC_CONV_TIME_US    2                  // Conversion time following the acquisition
+
 // SAADC configuration constants
 #define SADC_MAX_BUFFER_SIZE 256   // Maximum buffer size for ADC readings
-#define SAADC_BUF_COUNT        2   // Number of buffers for SAADC
-#define SAADC_BUF_SIZE         100 // Size of each buffer for SAADC
-#define SAADC_SAMPLE_FREQUENCY 8000 // Sampling frequency in Hz
+#define SAADC_BUF_COUNT        4   // Number of buffers in the SAADC pool
+#define SAADC_BUF_FRAMES       64  // Scan frames per buffer (8 ms at 8 kHz)
+#define SAADC_BUF_SIZE         (SAADC_BUF_FRAMES * SADC_CHANNEL_COUNT) // Interleaved samples per buffer
+#define SAADC_SAMPLE_FREQUENCY 8000 // Scan frequency in Hz (per channel)
+
+// Buffer timestamps: the END event of every buffer is captured through PPI by a
+// free-running 1 MHz TIMER (SENSOR_SAMPLE_TIMESTAMPS in sensor_config.h). The
+// scans are then paced by the scan TIMER, so they share its clock source.
+#define SADC_TIMESTAMPS SENSOR_SAMPLE_TIMESTAMPS
+#define SADC_TIMESTAMP_TIMER_INSTANCE 4 // TIMER holding the timebase, wraps after about 71 minutes
+
+// Activity-adaptive sampling rate. The SAADC internal timer cannot pace slower
+// than 16 MHz / 2047 (7.8 kHz), so a governed rate is paced by the scan TIMER.
+#define SAADC_IDLE_DIVIDER   SENSOR_IDLE_RATE_DIVIDER // Set in sensor_config.h
+#define SAADC_IDLE_FREQUENCY (SAADC_SAMPLE_FREQUENCY / SAADC_IDLE_DIVIDER) // Scan frequency in Hz while quiet
+#define SADC_RATE_GOVERNOR   (SAADC_IDLE_DIVIDER > 1)
+#define SADC_TIMER_TRIGGER   ((SADC_CHANNEL_COUNT > 1) || SADC_RATE_GOVERNOR || SADC_TIMESTAMPS) // Scans paced by the scan TIMER through PPI
+
+// Gap marking: the first buffer after the stream stopped and restarted (offset
+// calibration, exhausted pool) carries the number of scan frames lost in the gap
+#define SADC_SKIPPED_UNKNOWN UINT16_MAX // Gap of unknown length, without SADC_TIMESTAMPS
+
+// Limit watch: quiet idle-rate sampling with no interrupt per buffer, woken by
+// the SAADC channel limit events (SENSOR_LIMIT_WAKE in sensor_config.h)
+#define SADC_LIMIT_WATCH (SENSOR_LIMIT_WAKE && SADC_RATE_GOVERNOR)
+#define SADC_WATCH_COUNTER_INSTANCE 2                 // TIMER counting the watch scans
+#define SADC_WATCH_REFRESH_FRAMES SAADC_IDLE_FREQUENCY // Watch scans between two refresh events (1 s)
 
 /**
- * @brief Set the data ready flag.
- *
- * Controls the state of a flag indicating whether new SAADC data is ready to be processed.
+ * @brief Sampling rates selectable with `sadc_rate_set()`.
+ */
+typedef enum {
+    SADC_RATE_FULL = 0,      // SAADC_SAMPLE_FREQUENCY
+    SADC_RATE_IDLE,          // SAADC_IDLE_FREQUENCY
+    SADC_RATE_COUNT
+} sadc_rate_t;
+
+/**
+ * @brief Acquisition profiles selectable with `sadc_profile_set()`.
+ */
+typedef enum {
+    SADC_PROFILE_FAST = 0,   // 10-bit, one conversion per sample
+    SADC_PROFILE_BALANCED,   // 12-bit, one conversion per sample
+    SADC_PROFILE_PRECISE,    // 14-bit, 4x oversampled in a burst (single channel, one conversion otherwise)
+    SADC_PROFILE_COUNT
+} sadc_profile_id_t;
+
+/**
+ * @brief Conversion settings of an acquisition profile.
  *
- * @param state The new state of the data ready flag.
+ * Gain and reference are shared by every profile (SADC_FULL_SCALE_MV), so a
+ * profile only changes the count scale of the raw samples.
  */
-void set_data_ready_flag(bool state);
+typedef struct {
+    nrf_saadc_resolution_t resolution; // Resolution of the raw samples
+    nrf_saadc_oversample_t oversample; // Conversions averaged in hardware per sample
+    uint8_t resolution_bits;           // Bits of the raw samples
+    uint8_t conversions;               // Conversions per sample, sets the scan time
+    int8_t scale_shift;                // resolution_bits - SADC_SCALE_BITS, removed by the decimator
+} sadc_profile_t;
 
 /**
  * @brief Get the current state of the data ready flag.
  *
- * Retrieves the current state of the flag indicating if new SAADC data is ready.
+ * Indicates whether completed SAADC buffers are waiting to be processed.
  *
- * @return bool The current state of the data ready flag.
+ * @return bool True if at least one buffer is pending.
  */
 bool get_data_ready_flag(void);
 
 /**
- * @brief Set the current buffer for SAADC data.
+ * @brief Get the oldest completed SAADC buffer.
+ *
+ * Pops the descriptor (buffer pointer, sample count, sequence number, rate and
+ * END timestamp) of the oldest completed buffer. A gap in the sequence numbers indicates dropped buffers.
+ * The caller owns the buffer until it is given back with `sadc_buffer_release()`.
+ *
+ * @param p_desc Pointer where the buffer descriptor is copied.
+ * @return bool True if a buffer was available, false otherwise (counted as underrun).
+ */
+bool sadc_buffer_get(sadc_buffer_desc_t *p_desc);
+
+/**
+ * @brief Release a buffer obtained from `sadc_buffer_get()`.
+ *
+ * Returns ownership of the buffer to the pool so it can be re-armed for EasyDMA.
+ * The samples must not be accessed after the buffer has been released.
  *
- * Specifies the buffer to be used for storing the next set of SAADC data.
+ * @param p_buffer Pointer to the samples of the buffer being released.
+ */
+void sadc_buffer_release(nrf_saadc_value_t* p_buffer);
+
+/**
+ * @brief Get the number of buffer requests that found the pool exhausted.
  *
- * @param buffer Pointer to the SAADC data buffer.
+ * @return uint32_t The back-pressure counter.
  */
-void set_current_buffer(nrf_saadc_value_t* buffer);
+uint32_t get_sadc_backpressure_count(void);
 
 /**
- * @brief Get the current buffer used for SAADC data.
+ * @brief Get the number of completed buffers dropped because the main loop was late.
  *
- * Retrieves the pointer to the current buffer being used for SAADC data.
+ * @return uint32_t The overrun counter.
+ */
+uint32_t get_sadc_overrun_count(void);
+
+/**
+ * @brief Get the number of buffer requests made while no buffer was pending.
  *
- * @return nrf_saadc_value_t* Pointer to the current SAADC data buffer.
+ * @return uint32_t The underrun counter.
  */
-nrf_saadc_value_t* get_current_buffer(void);
+uint32_t get_sadc_underrun_count(void);
 
 /**
  * @brief Initialize the SAADC module.
  *
  * Prepares the SAADC module for operation, setting up necessary hardware configurations.
+ * Every input of SADC_CHANNEL_INPUTS is configured as one scan channel.
+ * The callback runs in interrupt context and should only schedule the processing.
  *
+ * @param callback The callback function to be called when a buffer is ready (may be NULL).
  * @return ret_code_t Returns NRF_SUCCESS if initialization is successful,
  *                    otherwise returns an error code indicating the type of failure.
  */
-ret_code_t sadc_init(void);
+ret_code_t sadc_init(sadc_callback_t callback);
 
 /**
  * @brief Start the SAADC sampling.
  *
  * Begins the SAADC sampling process, using the specified capture-compare value for timing.
+ * Buffers hold whole scan frames, interleaved channel by channel: sample `c` of
+ * frame `f` is at index `f * SADC_CHANNEL_COUNT + c`.
  *
  * @param cc_value The capture-compare value for timing SAADC sampling.
  * @return ret_code_t Returns NRF_SUCCESS if the start operation is successful,
@@ -92,6 +211,183 @@ ret_code_t sadc_init(void);
  */
 ret_code_t sadc_start(uint32_t cc_value);
 
+/**
+ * @brief Request a sampling rate.
+ *
+ * The rate is changed at the next buffer boundary, so every buffer is acquired
+ * at a single rate, reported in its descriptor. Has no effect unless
+ * SADC_RATE_GOVERNOR is enabled.
+ *
+ * @param rate The requested sampling rate.
+ */
+void sadc_rate_set(sadc_rate_t rate);
+
+/**
+ * @brief Get the scan frequency of a sampling rate.
+ *
+ * @param rate The sampling rate.
+ * @return uint32_t The scan frequency in Hz.
+ */
+uint32_t sadc_rate_frequency(sadc_rate_t rate);
+
+/**
+ * @brief Request an acquisition profile.
+ *
+ * Only records the request; the SAADC interrupt applies it at the next buffer
+ * boundary, so a buffer is never converted with two profiles. Each buffer
+ * descriptor names its profile.
+ *
+ * @param profile The requested acquisition profile.
+ * @return ret_code_t NRF_SUCCESS if the profile was requested, NRF_ERROR_INVALID_PARAM
+ *                    if it is unknown or its scan does not fit the full-rate period.
+ */
+ret_code_t sadc_profile_set(sadc_profile_id_t profile);
+
+/**
+ * @brief Get the conversion settings of an acquisition profile.
+ *
+ * @param profile The acquisition profile.
+ * @return const sadc_profile_t* The profile settings, NULL if the profile is unknown.
+ */
+const sadc_profile_t *sadc_profile_get(sadc_profile_id_t profile);
+
+/**
+ * @brief Convert a level on the SADC_SCALE_BITS scale to raw counts of a profile.
+ *
+ * @param level The level on the SADC_SCALE_BITS scale.
+ * @param profile The acquisition profile.
+ * @return int16_t The level in raw counts, saturated to the int16_t range.
+ */
+int16_t sadc_level_to_raw(int16_t level, sadc_profile_id_t profile);
+
+/**
+ * @brief Recalibrate the SAADC offset in the gap between two buffers.
+ *
+ * Non-blocking: the driver stops arming buffers, and once the armed ones have
+ * completed the offset calibration runs and the buffered sampling restarts at
+ * the requested rate and profile. No buffer is cut short; the first buffer after the
+ * calibration reports the scan frames lost meanwhile in its `skipped` field.
+ *
+ * @return ret_code_t NRF_SUCCESS if the calibration was scheduled, NRF_ERROR_INVALID_STATE
+ *                    while a calibration, a limit watch or a suspension is in progress.
+ */
+ret_code_t sadc_calibrate(void);
+
+/**
+ * @brief Get the number of completed offset calibrations.
+ *
+ * @return uint32_t The calibration counter.
+ */
+uint32_t get_sadc_calibration_count(void);
+
+/**
+ * @brief Get the number of scan frames lost in gaps of the buffered stream.
+ *
+ * Gaps of unknown length (SADC_SKIPPED_UNKNOWN) are not counted.
+ *
+ * @return uint32_t The skipped frame counter.
+ */
+uint32_t get_sadc_skipped_count(void);
+
+/**
+ * @brief Get the current time of the buffer timebase.
+ *
+ * Buffer descriptors carry the time of their END event on the same timebase,
+ * so the difference is the age of a buffer. The timebase stops while the
+ * sampling is suspended. Call from the main loop only.
+ *
+ * @return uint32_t The time in microseconds, 0 without SADC_TIMESTAMPS.
+ */
+uint32_t sadc_timestamp_now(void);
+
+/**
+ * @brief Get the time of a scan frame of a timestamped buffer.
+ *
+ * Counts back from the END event of the buffer at the rate it was acquired
+ * at, so the time refers to the end of the conversion of the frame.
+ *
+ * @param p_desc Descriptor of the buffer.
+ * @param frame Index of the scan frame in the buffer.
+ * @return uint32_t The time in microseconds on the buffer timebase.
+ */
+uint32_t sadc_frame_timestamp(const sadc_buffer_desc_t *p_desc, uint16_t frame);
+
+/**
+ * @brief Hand the sampling over to the SAADC limit events.
+ *
+ * No further buffer is armed; once the armed ones have completed, the scans
+ * continue at the current rate into a single frame that EasyDMA overwrites
+ * without waking the CPU, and each channel raises a limit event when a sample
+ * leaves [low, high]. The first such event stops the watch and resumes the
+ * buffered sampling at the full rate. Needs SADC_LIMIT_WATCH.
+ *
+ * @param p_low Low limit of each channel on the SADC_SCALE_BITS scale.
+ * @param p_high High limit of each channel on the SADC_SCALE_BITS scale.
+ * @param callback Callback notified of refresh and wake events.
+ * @return ret_code_t NRF_SUCCESS if the watch was requested, NRF_ERROR_INVALID_STATE
+ *                    if one or an offset calibration is in progress, NRF_ERROR_NOT_SUPPORTED without SADC_LIMIT_WATCH.
+ */
+ret_code_t sadc_watch_start(const int16_t *p_low, const int16_t *p_high, sadc_watch_callback_t callback);
+
+/**
+ * @brief Re-centre the limits of a running watch.
+ *
+ * @param p_low Low limit of each channel on the SADC_SCALE_BITS scale.
+ * @param p_high High limit of each channel on the SADC_SCALE_BITS scale.
+ * @return ret_code_t NRF_SUCCESS if the limits were set, NRF_ERROR_INVALID_STATE if no watch is running.
+ */
+ret_code_t sadc_watch_limits_set(const int16_t *p_low, const int16_t *p_high);
+
+/**
+ * @brief Stop the SAADC and its TIMERs from a running limit watch.
+ *
+ * Nothing is sampled until `sadc_resume()`; another wake source must take over.
+ * The buffer timebase is paused meanwhile, so timestamps only count sampling time.
+ *
+ * @return ret_code_t NRF_SUCCESS if the sampling stopped, NRF_ERROR_INVALID_STATE
+ *                    if no watch is running, NRF_ERROR_NOT_SUPPORTED without SADC_LIMIT_WATCH.
+ */
+ret_code_t sadc_suspend(void);
+
+/**
+ * @brief Restart the buffered sampling at the full rate after `sadc_suspend()`.
+ *
+ * May be called from interrupt context.
+ *
+ * @return ret_code_t NRF_SUCCESS if the sampling restarted, NRF_ERROR_INVALID_STATE
+ *                    if it was not suspended, NRF_ERROR_NOT_SUPPORTED without SADC_LIMIT_WATCH.
+ */
+ret_code_t sadc_resume(void);
+
+/**
+ * @brief Check whether a limit watch is requested or running.
+ *
+ * @return bool True from `sadc_watch_start()` until the wake.
+ */
+bool sadc_watch_active(void);
+
+/**
+ * @brief Get the analog input of a scan channel.
+ *
+ * @param channel Scan channel index.
+ * @return nrf_saadc_input_t The input of the channel, NRF_SAADC_INPUT_DISABLED if out of range.
+ */
+nrf_saadc_input_t sadc_channel_input(uint8_t channel);
+
+/**
+ * @brief Get the number of limit watches ended by a limit event.
+ *
+ * @return uint32_t The wake counter.
+ */
+uint32_t get_sadc_watch_wake_count(void);
+
+/**
+ * @brief Get the time spent in completed limit watches.
+ *
+ * @return uint32_t The watch time in milliseconds.
+ */
+uint32_t get_sadc_watch_time_ms(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,77 @@
+#ifndef SADC_GOVERNOR_H
+#define SADC_GOVERNOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sadc_driver.h"
+
+/**
+ * @brief Activity-adaptive sampling rate governor.
+ *
+ * Runs at the full rate while any channel is active and for a quiet period
+ * afterwards, then drops to the idle rate. The first active block requests the
+ * full rate again, which the driver applies at the next buffer boundary. The
+ * frames acquired at each rate are counted to report the time spent there.
+ */
+typedef struct {
+    sadc_rate_t rate;                    // Rate currently requested
+    uint32_t quiet_frames;               // Quiet time at the full rate, in full-rate frames
+    uint32_t quiet_limit;                // Quiet time before dropping to the idle rate, in full-rate frames
+    uint64_t rate_frames[SADC_RATE_COUNT]; // Frames acquired at each rate
+    uint32_t switch_count;               // Rate changes requested
+} sadc_governor_t;
+
+/**
+ * @brief Initialize the governor at the full rate.
+ *
+ * @param p_governor Pointer to the governor.
+ * @param quiet_time_ms Quiet time at the full rate before dropping to the idle rate.
+ */
+void sadc_governor_init(sadc_governor_t *p_governor, uint32_t quiet_time_ms);
+
+/**
+ * @brief Account for a processed buffer and decide the next rate.
+ *
+ * @param p_governor Pointer to the governor.
+ * @param buffer_rate Rate the buffer was acquired at (from its descriptor).
+ * @param frames Number of scan frames in the buffer.
+ * @param active True if any channel showed activity in the buffer.
+ * @return sadc_rate_t The rate to request from the driver.
+ */
+sadc_rate_t sadc_governor_update(sadc_governor_t *p_governor, sadc_rate_t buffer_rate, uint32_t frames, bool active);
+
+/**
+ * @brief Record that the driver went back to the full rate on its own.
+ *
+ * Called when a limit watch wakes, which resumes the sampling at the full rate.
+ *
+ * @param p_governor Pointer to the governor.
+ */
+void sadc_governor_wake(sadc_governor_t *p_governor);
+
+/**
+ * @brief Get the time spent acquiring at a rate.
+ *
+ * @param p_governor Pointer to the governor.
+ * @param rate The sampling rate.
+ * @return uint32_t The acquisition time at that rate in milliseconds.
+ */
+uint32_t sadc_governor_time_ms(const sadc_governor_t *p_governor, sadc_rate_t rate);
+
+/**
+ * @brief Get the number of rate changes requested.
+ *
+ * @param p_governor Pointer to the governor.
+ * @return uint32_t The rate change counter.
+ */
+uint32_t sadc_governor_switches(const sadc_governor_t *p_governor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SADC_GOVERNOR_H
@@ -0,0 +1,79 @@
+#ifndef SADC_POOL_H
+#define SADC_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Maximum number of buffers managed by a pool (must be a power of two)
+#define SADC_POOL_MAX_BUFFERS 8
+
+/**
+ * @brief Pool of sample buffer indices with explicit ownership handoff.
+ *
+ * Free buffer indices travel through a lock-free ring from the side releasing
+ * buffers (main loop) to the side acquiring them (SAADC interrupt). A buffer
+ * index is either in the ring (free) or owned by exactly one of the DMA, the
+ * completed-buffer queue or the consumer.
+ */
+typedef struct {
+    uint8_t free_slots[SADC_POOL_MAX_BUFFERS];   // Ring of free buffer indices
+    atomic_uint_least32_t head;                   // Next free index to acquire
+    atomic_uint_least32_t tail;                   // Next position to release into
+    atomic_uint_least32_t exhausted_count;        // Acquire attempts on an empty pool (back-pressure)
+    uint8_t buffer_count;                         // Number of buffers in the pool
+} sadc_pool_t;
+
+/**
+ * @brief Initialize the pool with all buffers free.
+ *
+ * @param p_pool Pointer to the pool.
+ * @param buffer_count Number of buffers (1 to SADC_POOL_MAX_BUFFERS).
+ * @return bool True if the pool was initialized, false if the count is invalid.
+ */
+bool sadc_pool_init(sadc_pool_t *p_pool, uint8_t buffer_count);
+
+/**
+ * @brief Take ownership of a free buffer.
+ *
+ * When no buffer is free the back-pressure counter is incremented.
+ *
+ * @param p_pool Pointer to the pool.
+ * @param p_index Pointer where the buffer index is stored.
+ * @return bool True if a buffer was acquired, false if the pool is exhausted.
+ */
+bool sadc_pool_acquire(sadc_pool_t *p_pool, uint8_t *p_index);
+
+/**
+ * @brief Give a buffer back to the pool.
+ *
+ * @param p_pool Pointer to the pool.
+ * @param index Index of a buffer previously acquired.
+ */
+void sadc_pool_release(sadc_pool_t *p_pool, uint8_t index);
+
+/**
+ * @brief Get the number of free buffers.
+ *
+ * @param p_pool Pointer to the pool.
+ * @return uint32_t The number of buffers available for acquisition.
+ */
+uint32_t sadc_pool_available(sadc_pool_t *p_pool);
+
+/**
+ * @brief Get the number of acquire attempts made while the pool was exhausted.
+ *
+ * @param p_pool Pointer to the pool.
+ * @return uint32_t The back-pressure counter.
+ */
+uint32_t sadc_pool_exhausted(sadc_pool_t *p_pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SADC_POOL_H
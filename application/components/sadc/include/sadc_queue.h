@@ -0,0 +1,110 @@
+#ifndef SADC_QUEUE_H
+#define SADC_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Number of descriptors in the queue (must be a power of two)
+#ifndef SADC_QUEUE_SIZE
+#define SADC_QUEUE_SIZE 4
+#endif
+
+#if (SADC_QUEUE_SIZE & (SADC_QUEUE_SIZE - 1)) != 0
+#error "SADC_QUEUE_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief Descriptor of a completed SAADC buffer.
+ */
+typedef struct {
+    int16_t *p_buffer;  // Pointer to the samples (nrf_saadc_value_t)
+    uint16_t size;      // Number of samples in the buffer
+    uint16_t skipped;   // Scan frames lost right before the buffer, 0 in a continuous stream
+    uint32_t sequence;  // Sequence number of the buffer, gaps mark dropped buffers
+    uint32_t timestamp; // Time of the END event of the buffer in microseconds (0 when not timestamped)
+    uint8_t rate;       // Sampling rate the buffer was acquired at (sadc_rate_t)
+    uint8_t profile;    // Acquisition profile the buffer was converted with (sadc_profile_id_t)
+} sadc_buffer_desc_t;
+
+/**
+ * @brief Lock-free single-producer/single-consumer queue of buffer descriptors.
+ *
+ * The producer (SAADC interrupt) only writes `tail` and `overrun_count`, the
+ * consumer (main loop) only writes `head` and `underrun_count`. Both indices
+ * run freely and are masked on access.
+ */
+typedef struct {
+    sadc_buffer_desc_t entries[SADC_QUEUE_SIZE]; // Descriptor storage
+    atomic_uint_least32_t head;                   // Next descriptor to consume
+    atomic_uint_least32_t tail;                   // Next descriptor to produce
+    atomic_uint_least32_t overrun_count;          // Descriptors dropped because the queue was full
+    atomic_uint_least32_t underrun_count;         // Pops attempted on an empty queue
+    uint32_t next_sequence;                       // Sequence number of the next produced buffer
+} sadc_queue_t;
+
+/**
+ * @brief Initialize the queue.
+ *
+ * Must be called before the producer or the consumer is started.
+ *
+ * @param p_queue Pointer to the queue.
+ */
+void sadc_queue_init(sadc_queue_t *p_queue);
+
+/**
+ * @brief Push a completed buffer (producer side).
+ *
+ * Copies the descriptor and assigns it the next sequence number (the
+ * `sequence` field of `p_desc` is ignored). When the queue is full the buffer
+ * is dropped and the overrun counter is incremented; the sequence number is
+ * consumed anyway so the consumer can see the gap.
+ *
+ * @param p_queue Pointer to the queue.
+ * @param p_desc Pointer to the descriptor of the completed buffer.
+ * @return bool True if the descriptor was queued, false on overrun.
+ */
+bool sadc_queue_push(sadc_queue_t *p_queue, const sadc_buffer_desc_t *p_desc);
+
+/**
+ * @brief Pop the oldest buffer descriptor (consumer side).
+ *
+ * @param p_queue Pointer to the queue.
+ * @param p_desc Pointer where the descriptor is copied.
+ * @return bool True if a descriptor was popped, false on underrun.
+ */
+bool sadc_queue_pop(sadc_queue_t *p_queue, sadc_buffer_desc_t *p_desc);
+
+/**
+ * @brief Get the number of descriptors waiting in the queue.
+ *
+ * @param p_queue Pointer to the queue.
+ * @return uint32_t The number of pending descriptors.
+ */
+uint32_t sadc_queue_pending(sadc_queue_t *p_queue);
+
+/**
+ * @brief Get the number of descriptors dropped because the queue was full.
+ *
+ * @param p_queue Pointer to the queue.
+ * @return uint32_t The overrun counter.
+ */
+uint32_t sadc_queue_overruns(sadc_queue_t *p_queue);
+
+/**
+ * @brief Get the number of pops attempted on an empty queue.
+ *
+ * @param p_queue Pointer to the queue.
+ * @return uint32_t The underrun counter.
+ */
+uint32_t sadc_queue_underruns(sadc_queue_t *p_queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SADC_QUEUE_H
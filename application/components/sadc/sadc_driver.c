@@ -33,25 +33,133 @@
  * SOFTWARE.
  */
 #include "sadc_driver.h"
+#include "sadc_queue.h"
+#include "sadc_pool.h"
 
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
 #include "app_error.h"
+#include "app_util_platform.h"
+#include "nrfx_timer.h"
+#include "nrfx_ppi.h"
+
+#if (SAADC_BUF_COUNT > SADC_POOL_MAX_BUFFERS) || (SAADC_BUF_COUNT > SADC_QUEUE_SIZE)
+#error "SAADC_BUF_COUNT must fit in both the buffer pool and the buffer queue"
+#endif
+
+#if (SADC_CHANNEL_COUNT < 1) || (SADC_CHANNEL_COUNT > SADC_MAX_CHANNEL_COUNT)
+#error "SADC_CHANNEL_COUNT must be between 1 and SADC_MAX_CHANNEL_COUNT"
+#endif
 
 static nrf_saadc_value_t samples[SAADC_BUF_COUNT][SAADC_BUF_SIZE];
-static nrfx_saadc_channel_t channel_config = NRFX_SAADC_DEFAULT_CHANNEL_SE(SADC_SENSOR_CHANNEL, 0);
+static const nrf_saadc_input_t channel_inputs[SADC_CHANNEL_COUNT] = SADC_CHANNEL_INPUTS;
+static nrfx_saadc_channel_t channel_configs[SADC_CHANNEL_COUNT];
+
+// Oversampling averages every enabled channel together, so it needs a single channel
+#define SADC_PRECISE_OVERSAMPLE ((SADC_CHANNEL_COUNT == 1) ? NRF_SAADC_OVERSAMPLE_4X : NRF_SAADC_OVERSAMPLE_DISABLED)
+#define SADC_PRECISE_CONVERSIONS ((SADC_CHANNEL_COUNT == 1) ? 4 : 1)
+
+// Acquisition profiles. Channels run in burst mode, so one SAMPLE task yields
+// one (possibly oversampled) result per channel whatever the profile.
+static const sadc_profile_t profiles[SADC_PROFILE_COUNT] = {
+    [SADC_PROFILE_FAST]     = { NRF_SAADC_RESOLUTION_10BIT, NRF_SAADC_OVERSAMPLE_DISABLED, 10, 1, 10 - SADC_SCALE_BITS },
+    [SADC_PROFILE_BALANCED] = { NRF_SAADC_RESOLUTION_12BIT, NRF_SAADC_OVERSAMPLE_DISABLED, 12, 1, 12 - SADC_SCALE_BITS },
+    [SADC_PROFILE_PRECISE]  = { NRF_SAADC_RESOLUTION_14BIT, SADC_PRECISE_OVERSAMPLE, 14, SADC_PRECISE_CONVERSIONS, 14 - SADC_SCALE_BITS },
+};
+
+#if SADC_TIMER_TRIGGER
+// The SAADC internal timer only supports one channel and rates above 7.8 kHz,
+// and runs from a clock nothing else can see; scans are otherwise triggered by
+// a TIMER through PPI.
+static const nrfx_timer_t scan_timer = NRFX_TIMER_INSTANCE(SADC_SCAN_TIMER_INSTANCE);
+static nrf_ppi_channel_t scan_ppi_channel;
+#endif
+
+#if SADC_TIMESTAMPS
+// Free-running timebase, captured in hardware by the END event of every buffer.
+static const nrfx_timer_t timestamp_timer = NRFX_TIMER_INSTANCE(SADC_TIMESTAMP_TIMER_INSTANCE);
+static nrf_ppi_channel_t timestamp_ppi_channel;
+#endif
+
+#if SADC_LIMIT_WATCH
+// Limit watch: the END event restarts EasyDMA on the same frame through PPI and
+// is counted by a TIMER, so the CPU only wakes on a limit event or a refresh.
+typedef enum {
+    WATCH_OFF = 0,           // Buffered sampling
+    WATCH_PENDING,           // No more buffers armed, the watch starts when they run out
+    WATCH_ACTIVE             // Sampling into watch_frame, limits armed
+} watch_state_t;
+
+static const nrfx_timer_t watch_counter = NRFX_TIMER_INSTANCE(SADC_WATCH_COUNTER_INSTANCE);
+static nrf_ppi_channel_t watch_ppi_channel;
+static nrf_saadc_value_t watch_frame[SADC_CHANNEL_COUNT];  // Overwritten by every watch scan
+static int16_t watch_low[SADC_CHANNEL_COUNT];              // Low limit of each channel (SADC_SCALE_BITS)
+static int16_t watch_high[SADC_CHANNEL_COUNT];             // High limit of each channel (SADC_SCALE_BITS)
+static volatile watch_state_t watch_state = WATCH_OFF;
+static uint32_t watch_int_mask;                            // SAADC interrupts masked during the watch
+static uint32_t watch_refresh_count;                       // Refresh events of the running watch
+static uint32_t watch_wake_count;                          // Watches ended by a limit event
+static uint32_t watch_time_ms;                             // Time spent in completed watches
+static sadc_watch_callback_t watch_callback_ref = NULL;    // Callback notified of watch events
+static volatile bool sampling_suspended = false;           // SAADC and its TIMERs stopped by sadc_suspend()
+#endif
+
+// Background offset calibration, run while the driver is idle between two buffers
+typedef enum {
+    CALIB_OFF = 0,           // Buffered sampling
+    CALIB_PENDING,           // No more buffers armed, the calibration starts when they run out
+    CALIB_RUNNING            // Offset calibration in progress
+} calib_state_t;
 
 /* 
  * Global variables used for managing SAADC state and data.
  */ 
-static volatile bool data_ready_flag = false;  // Flag indicating if new data is ready.
-static nrf_saadc_value_t* current_buffer = NULL;  // Pointer to the current SAADC buffer.
+static sadc_queue_t buffer_queue;  // Completed buffers handed from the SAADC interrupt to the main loop.
+static sadc_pool_t buffer_pool;    // Buffers free to be handed to EasyDMA.
+static volatile bool buffer_request_pending = false;  // EasyDMA asked for a buffer while the pool was exhausted.
+static volatile bool sampling_finished = false;       // SAADC stopped because it ran out of buffers.
+static sadc_callback_t sadc_callback_ref = NULL;      // Callback notified when a completed buffer is queued.
+static uint32_t rate_cc_values[SADC_RATE_COUNT];      // 16 MHz ticks between two scans at each rate.
+static sadc_rate_t active_rate = SADC_RATE_FULL;      // Rate of the buffer being acquired.
+static volatile sadc_rate_t requested_rate = SADC_RATE_FULL; // Rate applied at the next buffer boundary.
+static sadc_profile_id_t active_profile = SADC_DEFAULT_PROFILE; // Profile of the buffer being converted.
+static volatile sadc_profile_id_t requested_profile = SADC_DEFAULT_PROFILE; // Profile applied at the next buffer boundary.
+static volatile calib_state_t calib_state = CALIB_OFF; // Background offset calibration state.
+static uint32_t calib_count;                          // Completed offset calibrations.
+static volatile bool stream_restarted = false;        // Sampling restarted after a gap, the next buffer is marked.
+static uint32_t skipped_count;                        // Scan frames lost in marked gaps.
+#if SADC_TIMESTAMPS
+static uint32_t last_end_timestamp;                   // END timestamp of the last completed buffer.
+#endif
 
 /* 
  * Prototypes for internal functions.
  */ 
 static void sadc_event_handler(nrfx_saadc_evt_t const * p_event);
-static uint32_t next_free_buf_index(void);
+static ret_code_t arm_next_buffer(void);
+static void apply_requested_rate(void);
+static void apply_requested_profile(void);
+static bool profile_fits(sadc_profile_id_t profile);
+static ret_code_t advanced_mode_set(void);
+static void buffers_restart(void);
+static void calibration_start(void);
+static void calibration_end(bool calibrated);
+static uint16_t gap_frames(const sadc_buffer_desc_t *p_desc);
+#if SADC_LIMIT_WATCH
+static ret_code_t watch_trigger_init(void);
+static void watch_enter(void);
+static void watch_stop(void);
+static void watch_exit(uint8_t channel);
+static void sampling_resume(void);
+static void watch_counter_handler(nrf_timer_event_t event_type, void * p_context);
+#endif
+#if SADC_TIMER_TRIGGER
+static ret_code_t scan_trigger_start(uint32_t cc_value);
+static void scan_timer_handler(nrf_timer_event_t event_type, void * p_context);
+#endif
+#if SADC_TIMESTAMPS
+static ret_code_t timestamp_start(void);
+#endif
 
 /**
  * @brief Initialize the SAADC module.
@@ -59,18 +167,37 @@ static uint32_t next_free_buf_index(void);
  * Sets up the SAADC interface with specific hardware settings. This function must
  * be called before any other SAADC operations.
  *
+ * @param callback The callback function to be called when a buffer is ready (may be NULL).
  * @return ret_code_t Returns NRF_SUCCESS if initialization is successful,
  *                    otherwise returns an error code indicating the type of failure.
  */
-ret_code_t sadc_init(void) {
+ret_code_t sadc_init(sadc_callback_t callback) {
     ret_code_t err_code;
 
+    // Store the function callback reference
+    sadc_callback_ref = callback;
+
+    // Reset the completed buffer queue and the buffer pool before any SAADC event can fire
+    sadc_queue_init(&buffer_queue);
+    sadc_pool_init(&buffer_pool, SAADC_BUF_COUNT);
+    buffer_request_pending = false;
+    sampling_finished = false;
+
     // Initialize SAADC
     err_code = nrfx_saadc_init(NRFX_SAADC_CONFIG_IRQ_PRIORITY);
     APP_ERROR_CHECK(err_code);
  
-    // Configure SAADC channel
-    err_code = nrfx_saadc_channels_config(&channel_config, 1);
+    // Configure one SAADC channel per sensing input, in scan order
+    for (uint8_t i = 0; i < SADC_CHANNEL_COUNT; i++) {
+        if (channel_inputs[i] == NRF_SAADC_INPUT_DISABLED) {
+            NRF_LOG_ERROR("SADC channel %d has no input", i);
+            return NRF_ERROR_INVALID_PARAM;
+        }
+        channel_configs[i] = (nrfx_saadc_channel_t)NRFX_SAADC_DEFAULT_CHANNEL_SE(channel_inputs[i], i);
+        channel_configs[i].channel_config.gain = SADC_GAIN;
+        channel_configs[i].channel_config.reference = NRF_SAADC_REFERENCE_INTERNAL;
+    }
+    err_code = nrfx_saadc_channels_config(channel_configs, SADC_CHANNEL_COUNT);
     APP_ERROR_CHECK(err_code);
 
     if (err_code != NRFX_SUCCESS) {
@@ -84,9 +211,14 @@ ret_code_t sadc_init(void) {
  * @brief Start the SAADC sampling.
  * 
  * Configures and starts the SAADC sampling with advanced mode settings.
- * This function sets up double buffering to manage high sampling frequencies.
+ * This function arms two buffers from the pool to manage high sampling frequencies.
+ * A single channel is paced by the SAADC internal timer; a multi-channel scan,
+ * a governed rate or timestamped buffers are paced by a 16 MHz TIMER triggering
+ * the SAMPLE task through PPI, so the capture-compare value has the same meaning
+ * in both cases.
+ * Sampling starts at the full rate with the SADC_DEFAULT_PROFILE acquisition profile.
  *
- * @param cc_value The capture-compare value for the SAADC internal timer.
+ * @param cc_value The capture-compare value at the full rate (16 MHz ticks between two scans).
  * @return ret_code_t Returns NRF_SUCCESS if the start operation is successful,
  *                    otherwise returns an error code indicating the type of failure.
  */
@@ -94,28 +226,57 @@ ret_code_t sadc_start(uint32_t cc_value)
 {
     ret_code_t err_code;
 
-    // Configure advanced SAADC settings
-    nrfx_saadc_adv_config_t saadc_adv_config = NRFX_SAADC_DEFAULT_ADV_CONFIG;
-    saadc_adv_config.internal_timer_cc = cc_value;
-    saadc_adv_config.start_on_end = true;
+    // The idle rate must still fit the 16-bit scan TIMER
+    rate_cc_values[SADC_RATE_FULL] = cc_value;
+    rate_cc_values[SADC_RATE_IDLE] = cc_value * SAADC_IDLE_DIVIDER;
+    if (rate_cc_values[SADC_RATE_IDLE] > UINT16_MAX) {
+        NRF_LOG_ERROR("SADC idle rate outside legal range");
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    active_rate = SADC_RATE_FULL;
+    requested_rate = SADC_RATE_FULL;
+
+    // The scan of the default profile must fit the full-rate period
+    if (!profile_fits(SADC_DEFAULT_PROFILE)) {
+        NRF_LOG_ERROR("SADC profile %d too slow for the sampling rate", SADC_DEFAULT_PROFILE);
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    active_profile = SADC_DEFAULT_PROFILE;
+    requested_profile = SADC_DEFAULT_PROFILE;
 
     // Set SAADC to advanced mode
-    err_code = nrfx_saadc_advanced_mode_set((1<<0), NRF_SAADC_RESOLUTION_10BIT,
-                                            &saadc_adv_config,
-                                            sadc_event_handler);
+    err_code = advanced_mode_set();
     APP_ERROR_CHECK(err_code);
+
+#if SADC_TIMESTAMPS
+    // Run the timebase before the first END event can be captured
+    err_code = timestamp_start();
+    APP_ERROR_CHECK(err_code);
+#endif
                                             
     // Configure double buffering
-    err_code = nrfx_saadc_buffer_set(&samples[next_free_buf_index()][0], SAADC_BUF_SIZE);
+    err_code = arm_next_buffer();
     APP_ERROR_CHECK(err_code);
 
-    err_code = nrfx_saadc_buffer_set(&samples[next_free_buf_index()][0], SAADC_BUF_SIZE);
+    err_code = arm_next_buffer();
     APP_ERROR_CHECK(err_code);
 
     // Start SAADC sampling
     err_code = nrfx_saadc_mode_trigger();
     APP_ERROR_CHECK(err_code);
 
+#if SADC_TIMER_TRIGGER
+    // Start the scan trigger once the SAADC is waiting for SAMPLE tasks
+    err_code = scan_trigger_start(cc_value);
+    APP_ERROR_CHECK(err_code);
+#endif
+
+#if SADC_LIMIT_WATCH
+    // Prepare the watch loop, left disabled until a watch starts
+    err_code = watch_trigger_init();
+    APP_ERROR_CHECK(err_code);
+#endif
+
     if (err_code != NRFX_SUCCESS) {
         NRF_LOG_ERROR("SADC start failed: %d", err_code);
         return err_code;
@@ -137,19 +298,95 @@ static void sadc_event_handler(nrfx_saadc_evt_t const * p_event)
     switch (p_event->type)
     {
         case NRFX_SAADC_EVT_DONE:
-            // Data acquisition completed; update buffer and flag
-            set_current_buffer(p_event->data.done.p_buffer);
-            set_data_ready_flag(true);
+        {
+            // Data acquisition completed; hand the buffer over to the main loop
+            sadc_buffer_desc_t desc = {
+                .p_buffer = p_event->data.done.p_buffer,
+                .size     = p_event->data.done.size,
+                .rate     = (uint8_t)active_rate,
+                .profile  = (uint8_t)active_profile,
+            };
+#if SADC_TIMESTAMPS
+            // Captured by the END event of this buffer, the next one is a buffer period away
+            desc.timestamp = nrfx_timer_capture_get(&timestamp_timer, NRF_TIMER_CC_CHANNEL0);
+#endif
+            if (stream_restarted) {
+                // First buffer after a gap: mark the discontinuity for the consumer
+                stream_restarted = false;
+                desc.skipped = gap_frames(&desc);
+                if (desc.skipped != SADC_SKIPPED_UNKNOWN) {
+                    skipped_count += desc.skipped;
+                }
+            }
+#if SADC_TIMESTAMPS
+            last_end_timestamp = desc.timestamp;
+#endif
+            if (!sadc_queue_push(&buffer_queue, &desc)) {
+                // Nobody will consume the dropped buffer: hand it back to the pool
+                sadc_buffer_release(desc.p_buffer);
+                NRF_LOG_WARNING("SAADC buffer queue overrun: %d", sadc_queue_overruns(&buffer_queue));
+            } else if (sadc_callback_ref != NULL) {
+                sadc_callback_ref();
+            }
+            // The next buffer has just been started: change the rate and profile before its first scan
+            apply_requested_rate();
+            apply_requested_profile();
             break;
+        }
 
         case NRFX_SAADC_EVT_BUF_REQ:
-            // Request for new buffer; set up next available buffer
-            err_code = nrfx_saadc_buffer_set(&samples[next_free_buf_index()][0], SAADC_BUF_SIZE);
-            if (err_code != NRF_SUCCESS) {
+            if (calib_state == CALIB_PENDING) {
+                // Let the armed buffers run out; FINISHED then starts the calibration
+                break;
+            }
+#if SADC_LIMIT_WATCH
+            if (watch_state == WATCH_PENDING) {
+                // Let the armed buffers run out; FINISHED then starts the watch
+                break;
+            }
+#endif
+            // Request for new buffer; set up a buffer released by the consumer
+            err_code = arm_next_buffer();
+            if (err_code == NRF_ERROR_NO_MEM) {
+                // Back-pressure: the buffer is armed as soon as the consumer releases one
+                buffer_request_pending = true;
+                NRF_LOG_WARNING("SAADC buffer pool exhausted: %d", sadc_pool_exhausted(&buffer_pool));
+            } else if (err_code != NRF_SUCCESS) {
                 NRF_LOG_ERROR("Error in NRFX_SAADC_EVT_BUF_REQ: %d", err_code);
             }
             break;
 
+        case NRFX_SAADC_EVT_FINISHED:
+            if (calib_state == CALIB_PENDING) {
+                calibration_start();
+                break;
+            }
+#if SADC_LIMIT_WATCH
+            if (watch_state == WATCH_PENDING) {
+                watch_enter();
+                break;
+            }
+#endif
+            // Sampling stopped because no buffer was available in time
+            sampling_finished = true;
+            break;
+
+        case NRFX_SAADC_EVT_CALIBRATEDONE:
+            // The calibration handler is this one, so advanced mode events keep coming here
+            if (calib_state == CALIB_RUNNING) {
+                calibration_end(true);
+            }
+            break;
+
+        case NRFX_SAADC_EVT_LIMIT:
+#if SADC_LIMIT_WATCH
+            // Several limits may fire in the same scan, only the first one wakes
+            if (watch_state == WATCH_ACTIVE) {
+                watch_exit(p_event->data.limit.channel);
+            }
+#endif
+            break;
+
         default:
             // Log unexpected event types as internal errors
             NRF_LOG_ERROR("Unexpected SAADC event: NRF_ERROR_INTERNAL");
@@ -158,57 +395,846 @@ static void sadc_event_handler(nrfx_saadc_evt_t const * p_event)
 }
 
 /**
- * @brief Provides the index of the next available SAADC buffer.
- * 
- * @return uint32_t Index of the next available buffer.
+ * @brief Apply a pending rate request at a buffer boundary.
+ *
+ * Called on the END event, when EasyDMA has just switched to the next buffer
+ * and the SAADC waits for its first SAMPLE task. The scan TIMER gets its new
+ * period and is restarted, so no scan interval mixes the two rates and the
+ * counter cannot run past a shortened compare value.
  */
-static uint32_t next_free_buf_index(void)
+static void apply_requested_rate(void)
 {
-    static uint32_t buffer_index = -1;
-    buffer_index = (buffer_index + 1) % SAADC_BUF_COUNT;
-    return buffer_index;
+    sadc_rate_t rate = requested_rate;
+
+    if (rate == active_rate) {
+        return;
+    }
+#if SADC_RATE_GOVERNOR
+    nrfx_timer_compare(&scan_timer, NRF_TIMER_CC_CHANNEL0, rate_cc_values[rate], false);
+    nrfx_timer_clear(&scan_timer);
+    active_rate = rate;
+#endif
 }
 
 /**
- * @brief Set the data ready flag.
+ * @brief Apply a pending profile request at a buffer boundary.
  *
- * Controls the state of a flag indicating whether new SAADC data is ready to be processed.
+ * Called next to `apply_requested_rate()`, between the last conversion of a
+ * buffer and the first one of the next. Burst mode stays enabled on every
+ * channel, so only the resolution and oversampling registers change.
+ */
+static void apply_requested_profile(void)
+{
+    sadc_profile_id_t profile = requested_profile;
+
+    if (profile == active_profile) {
+        return;
+    }
+    nrf_saadc_resolution_set(profiles[profile].resolution);
+    nrf_saadc_oversample_set(profiles[profile].oversample);
+    active_profile = profile;
+}
+
+/**
+ * @brief Check that a scan of a profile fits the full-rate scan period.
+ *
+ * @param profile The acquisition profile.
+ * @return bool True if every channel is converted before the next SAMPLE task.
+ */
+static bool profile_fits(sadc_profile_id_t profile)
+{
+    uint32_t scan_us = SADC_CHANNEL_COUNT * profiles[profile].conversions * (SADC_ACQ_TIME_US + SADC_CONV_TIME_US);
+
+    return scan_us < 1000000UL / SAADC_SAMPLE_FREQUENCY;
+}
+
+/**
+ * @brief Put the SAADC driver in advanced mode with the active profile.
+ *
+ * @return ret_code_t The result of nrfx_saadc_advanced_mode_set().
+ */
+static ret_code_t advanced_mode_set(void)
+{
+    nrfx_saadc_adv_config_t saadc_adv_config = NRFX_SAADC_DEFAULT_ADV_CONFIG;
+#if !SADC_TIMER_TRIGGER
+    saadc_adv_config.internal_timer_cc = rate_cc_values[active_rate];
+#endif
+    saadc_adv_config.oversampling = profiles[active_profile].oversample;
+    saadc_adv_config.burst = NRF_SAADC_BURST_ENABLED;
+    saadc_adv_config.start_on_end = true;
+
+    return nrfx_saadc_advanced_mode_set(SADC_CHANNEL_MASK, profiles[active_profile].resolution,
+                                        &saadc_adv_config,
+                                        sadc_event_handler);
+}
+
+/**
+ * @brief Arm a buffer and restart the buffered sampling.
+ *
+ * Runs in the SAADC interrupt or with it masked, while the driver is idle in
+ * advanced mode and no buffer is armed. If the consumer still holds every
+ * buffer, the first release restarts the sampling.
+ */
+static void buffers_restart(void)
+{
+    if (arm_next_buffer() == NRF_SUCCESS) {
+        APP_ERROR_CHECK(nrfx_saadc_mode_trigger());
+    } else {
+        buffer_request_pending = true;
+        sampling_finished = true;
+    }
+}
+
+/**
+ * @brief Start the offset calibration once the last armed buffer has completed.
+ *
+ * Runs in the SAADC interrupt or with it masked. The scan TIMER is paused so no
+ * SAMPLE task reaches the SAADC while it calibrates. If the driver refuses the
+ * calibration, the sampling restarts right away.
+ */
+static void calibration_start(void)
+{
+#if SADC_TIMER_TRIGGER
+    nrfx_timer_pause(&scan_timer);
+#endif
+    calib_state = CALIB_RUNNING;
+    ret_code_t err_code = nrfx_saadc_offset_calibrate(sadc_event_handler);
+    if (err_code != NRFX_SUCCESS) {
+        NRF_LOG_WARNING("SAADC offset calibration failed: %d", err_code);
+        calibration_end(false);
+    }
+}
+
+/**
+ * @brief Restart the buffered sampling after the offset calibration.
+ *
+ * The calibration leaves the driver out of advanced mode, so it is set again
+ * with the rate and profile requested meanwhile. The first buffer is marked
+ * with the frames lost during the gap.
  *
- * @param state The new state of the data ready flag.
+ * @param calibrated True if the calibration completed.
  */
-void set_data_ready_flag(bool state) {
-    data_ready_flag = state;
+static void calibration_end(bool calibrated)
+{
+    calib_state = CALIB_OFF;
+    if (calibrated) {
+        calib_count++;
+    }
+    stream_restarted = true;
+    apply_requested_rate();
+    apply_requested_profile();
+    APP_ERROR_CHECK(advanced_mode_set());
+    buffers_restart();
+#if SADC_TIMER_TRIGGER
+    nrfx_timer_resume(&scan_timer);
+#endif
+}
+
+/**
+ * @brief Count the scan frames lost between the last buffer and a new one.
+ *
+ * The gap runs from the END of the last buffer to the first frame of the new
+ * one, dated back from its END timestamp, in scan periods of the new buffer.
+ *
+ * @param p_desc Descriptor of the first buffer after the gap.
+ * @return uint16_t The lost frames, SADC_SKIPPED_UNKNOWN without SADC_TIMESTAMPS.
+ */
+static uint16_t gap_frames(const sadc_buffer_desc_t *p_desc)
+{
+#if SADC_TIMESTAMPS
+    uint32_t gap_us = sadc_frame_timestamp(p_desc, 0) - last_end_timestamp;
+    uint32_t frequency = sadc_rate_frequency((sadc_rate_t)p_desc->rate);
+    uint64_t periods = ((uint64_t)gap_us * frequency + 500000) / 1000000;
+
+    if (periods <= 1) {
+        return 0;
+    }
+    return (periods - 1 >= SADC_SKIPPED_UNKNOWN) ? (SADC_SKIPPED_UNKNOWN - 1) : (uint16_t)(periods - 1);
+#else
+    (void)p_desc;
+    return SADC_SKIPPED_UNKNOWN;
+#endif
+}
+
+#if SADC_LIMIT_WATCH
+/**
+ * @brief Set up the TIMER and PPI channel of the limit watch.
+ *
+ * The PPI channel restarts EasyDMA on every END event and forks it to the
+ * COUNT task of a counter TIMER, whose compare interrupt marks a refresh every
+ * SADC_WATCH_REFRESH_FRAMES scans. Both stay disabled until a watch starts.
+ *
+ * @return ret_code_t NRF_SUCCESS on success, otherwise the error from the TIMER or PPI driver.
+ */
+static ret_code_t watch_trigger_init(void)
+{
+    ret_code_t err_code;
+
+    nrfx_timer_config_t timer_cfg = NRFX_TIMER_DEFAULT_CONFIG;
+    timer_cfg.mode = NRF_TIMER_MODE_LOW_POWER_COUNTER;
+    timer_cfg.bit_width = NRF_TIMER_BIT_WIDTH_32;
+    err_code = nrfx_timer_init(&watch_counter, &timer_cfg, watch_counter_handler);
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+    nrfx_timer_extended_compare(&watch_counter, NRF_TIMER_CC_CHANNEL0, SADC_WATCH_REFRESH_FRAMES,
+                                NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK, true);
+
+    err_code = nrfx_ppi_channel_alloc(&watch_ppi_channel);
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+    err_code = nrfx_ppi_channel_assign(watch_ppi_channel,
+                                       nrf_saadc_event_address_get(NRF_SAADC_EVENT_END),
+                                       nrf_saadc_task_address_get(NRF_SAADC_TASK_START));
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+    return nrfx_ppi_channel_fork_assign(watch_ppi_channel,
+                                        nrfx_timer_task_address_get(&watch_counter, NRF_TIMER_TASK_COUNT));
+}
+
+/**
+ * @brief Start the limit watch once the last armed buffer has completed.
+ *
+ * Runs in the SAADC interrupt (or with it masked). The driver is idle in
+ * advanced mode and only the limit interrupts are left enabled, so EasyDMA
+ * loops on watch_frame behind it without any END or STARTED interrupt.
+ */
+static void watch_enter(void)
+{
+    watch_int_mask = nrf_saadc_int_enable_check(NRF_SAADC_INT_STARTED | NRF_SAADC_INT_END | NRF_SAADC_INT_STOPPED);
+    nrf_saadc_int_disable(watch_int_mask);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+
+    nrf_saadc_buffer_init(watch_frame, SADC_CHANNEL_COUNT);
+    for (uint8_t ch = 0; ch < SADC_CHANNEL_COUNT; ch++) {
+        APP_ERROR_CHECK(nrfx_saadc_limits_set(ch, sadc_level_to_raw(watch_low[ch], active_profile), sadc_level_to_raw(watch_high[ch], active_profile)));
+    }
+
+    watch_refresh_count = 0;
+    nrfx_timer_clear(&watch_counter);
+    nrfx_timer_enable(&watch_counter);
+    APP_ERROR_CHECK(nrfx_ppi_channel_enable(watch_ppi_channel));
+    watch_state = WATCH_ACTIVE;
+    nrf_saadc_task_trigger(NRF_SAADC_TASK_START);
+}
+
+/**
+ * @brief Stop the limit watch loop and hand the SAADC back to the driver.
+ *
+ * Runs in the SAADC interrupt or with it masked. The limits are disarmed
+ * first, they would otherwise fire on every scan outside them.
+ */
+static void watch_stop(void)
+{
+    for (uint8_t ch = 0; ch < SADC_CHANNEL_COUNT; ch++) {
+        APP_ERROR_CHECK(nrfx_saadc_limits_set(ch, INT16_MIN, INT16_MAX));
+    }
+    APP_ERROR_CHECK(nrfx_ppi_channel_disable(watch_ppi_channel));
+
+    uint32_t frames = nrfx_timer_capture(&watch_counter, NRF_TIMER_CC_CHANNEL1);
+    nrfx_timer_disable(&watch_counter);
+    uint64_t watch_frames = (uint64_t)watch_refresh_count * SADC_WATCH_REFRESH_FRAMES + frames;
+    watch_time_ms += (uint32_t)((watch_frames * 1000) / sadc_rate_frequency(active_rate));
+
+    // Stop the looping conversion before the driver takes the SAADC back
+    nrf_saadc_task_trigger(NRF_SAADC_TASK_STOP);
+    while (!nrf_saadc_event_check(NRF_SAADC_EVENT_STOPPED)) {
+    }
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STOPPED);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+    nrf_saadc_int_enable(watch_int_mask);
+    watch_state = WATCH_OFF;
+}
+
+/**
+ * @brief End the limit watch and resume the buffered sampling at the full rate.
+ *
+ * Runs in the SAADC interrupt.
+ *
+ * @param channel Channel whose limit was crossed.
+ */
+static void watch_exit(uint8_t channel)
+{
+    watch_stop();
+    watch_wake_count++;
+    NRF_LOG_DEBUG("SAADC limit crossed on channel %d", channel);
+
+    // Whatever crossed the limit is worth the full rate
+    sampling_resume();
+
+    if (watch_callback_ref != NULL) {
+        watch_callback_ref(SADC_WATCH_WAKE);
+    }
+}
+
+/**
+ * @brief Restart the buffered sampling at the full rate.
+ *
+ * Runs in the SAADC interrupt or with it masked, while the driver is idle in
+ * advanced mode and no buffer is armed.
+ */
+static void sampling_resume(void)
+{
+    requested_rate = SADC_RATE_FULL;
+    apply_requested_rate();
+    apply_requested_profile();
+    buffers_restart();
+}
+
+/**
+ * @brief Watch counter event handler.
+ *
+ * Fires every SADC_WATCH_REFRESH_FRAMES scans of a running watch.
+ *
+ * @param event_type Type of the timer event (unused).
+ * @param p_context Context for the timer event (unused).
+ */
+static void watch_counter_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    if (watch_state != WATCH_ACTIVE) {
+        return;
+    }
+    watch_refresh_count++;
+    if (watch_callback_ref != NULL) {
+        watch_callback_ref(SADC_WATCH_REFRESH);
+    }
+}
+#endif
+
+#if SADC_TIMER_TRIGGER
+/**
+ * @brief Start the TIMER and PPI channel triggering the multi-channel scans.
+ *
+ * The TIMER compare event is wired to the SAADC SAMPLE task, so each scan is
+ * started in hardware without any CPU involvement.
+ *
+ * @param cc_value The number of 16 MHz ticks between two scans.
+ * @return ret_code_t NRF_SUCCESS on success, otherwise the error from the TIMER or PPI driver.
+ */
+static ret_code_t scan_trigger_start(uint32_t cc_value)
+{
+    ret_code_t err_code;
+
+    nrfx_timer_config_t timer_cfg = NRFX_TIMER_DEFAULT_CONFIG;
+    timer_cfg.frequency = NRF_TIMER_FREQ_16MHz;
+    timer_cfg.bit_width = NRF_TIMER_BIT_WIDTH_16;
+    err_code = nrfx_timer_init(&scan_timer, &timer_cfg, scan_timer_handler);
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+    nrfx_timer_extended_compare(&scan_timer, NRF_TIMER_CC_CHANNEL0, cc_value,
+                                NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK, false);
+
+    err_code = nrfx_ppi_channel_alloc(&scan_ppi_channel);
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+    err_code = nrfx_ppi_channel_assign(scan_ppi_channel,
+                                       nrfx_timer_compare_event_address_get(&scan_timer, NRF_TIMER_CC_CHANNEL0),
+                                       nrf_saadc_task_address_get(NRF_SAADC_TASK_SAMPLE));
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+    err_code = nrfx_ppi_channel_enable(scan_ppi_channel);
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+
+    nrfx_timer_enable(&scan_timer);
+    return NRF_SUCCESS;
+}
+
+/**
+ * @brief Scan and timestamp TIMER event handler.
+ *
+ * The compare interrupts are disabled, the TIMERs only drive PPI channels.
+ *
+ * @param event_type Type of the timer event (unused).
+ * @param p_context Context for the timer event (unused).
+ */
+static void scan_timer_handler(nrf_timer_event_t event_type, void * p_context)
+{
+}
+#endif
+
+#if SADC_TIMESTAMPS
+/**
+ * @brief Start the buffer timebase and its END capture.
+ *
+ * A free-running 32-bit TIMER counts microseconds and the PPI channel copies it
+ * to its CC0 register on every SAADC END event, so a buffer is timestamped in
+ * hardware whatever the interrupt latency. The END events of the limit watch
+ * loop are captured as well; nothing reads them.
+ *
+ * @return ret_code_t NRF_SUCCESS on success, otherwise the error from the TIMER or PPI driver.
+ */
+static ret_code_t timestamp_start(void)
+{
+    ret_code_t err_code;
+
+    nrfx_timer_config_t timer_cfg = NRFX_TIMER_DEFAULT_CONFIG;
+    timer_cfg.frequency = NRF_TIMER_FREQ_1MHz;
+    timer_cfg.bit_width = NRF_TIMER_BIT_WIDTH_32;
+    err_code = nrfx_timer_init(&timestamp_timer, &timer_cfg, scan_timer_handler);
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+
+    err_code = nrfx_ppi_channel_alloc(&timestamp_ppi_channel);
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+    err_code = nrfx_ppi_channel_assign(timestamp_ppi_channel,
+                                       nrf_saadc_event_address_get(NRF_SAADC_EVENT_END),
+                                       nrfx_timer_capture_task_address_get(&timestamp_timer, NRF_TIMER_CC_CHANNEL0));
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+    err_code = nrfx_ppi_channel_enable(timestamp_ppi_channel);
+    if (err_code != NRFX_SUCCESS) {
+        return err_code;
+    }
+
+    nrfx_timer_enable(&timestamp_timer);
+    return NRF_SUCCESS;
+}
+#endif
+
+/**
+ * @brief Hand the next free pool buffer to EasyDMA.
+ * 
+ * @return ret_code_t NRF_SUCCESS if a buffer was armed, NRF_ERROR_NO_MEM if the
+ *                    pool is exhausted, otherwise the error from the SAADC driver.
+ */
+static ret_code_t arm_next_buffer(void)
+{
+    uint8_t index;
+
+    if (!sadc_pool_acquire(&buffer_pool, &index)) {
+        return NRF_ERROR_NO_MEM;
+    }
+    return nrfx_saadc_buffer_set(&samples[index][0], SAADC_BUF_SIZE);
 }
 
 /**
  * @brief Get the current state of the data ready flag.
  *
- * Retrieves the current state of the flag indicating if new SAADC data is ready.
+ * Indicates whether completed SAADC buffers are waiting to be processed.
  *
- * @return bool The current state of the data ready flag.
+ * @return bool True if at least one buffer is pending.
  */
 bool get_data_ready_flag(void) {
-    return data_ready_flag;
+    return sadc_queue_pending(&buffer_queue) > 0;
+}
+
+/**
+ * @brief Get the oldest completed SAADC buffer.
+ *
+ * Pops the descriptor of the oldest completed buffer from the queue filled by
+ * the SAADC interrupt. Buffers are returned in acquisition order.
+ *
+ * @param p_desc Pointer where the buffer descriptor is copied.
+ * @return bool True if a buffer was available, false otherwise (counted as underrun).
+ */
+bool sadc_buffer_get(sadc_buffer_desc_t *p_desc) {
+    return sadc_queue_pop(&buffer_queue, p_desc);
+}
+
+/**
+ * @brief Release a buffer obtained from `sadc_buffer_get()`.
+ *
+ * Returns ownership of the buffer to the pool so it can be re-armed for EasyDMA.
+ * If the SAADC is waiting for a buffer, the released buffer is armed right away
+ * and sampling is restarted if it had stopped.
+ *
+ * @param p_buffer Pointer to the samples of the buffer being released.
+ */
+void sadc_buffer_release(nrf_saadc_value_t* p_buffer) {
+    ptrdiff_t offset = p_buffer - &samples[0][0];
+
+    if (offset < 0 || offset >= SAADC_BUF_COUNT * SAADC_BUF_SIZE || (offset % SAADC_BUF_SIZE) != 0) {
+        NRF_LOG_ERROR("Released buffer does not belong to the SAADC pool");
+        return;
+    }
+
+    // The SAADC interrupt is masked: it releases overrun buffers itself, and
+    // the main loop may act as the pool consumer to re-arm a pending request
+    CRITICAL_REGION_ENTER();
+    sadc_pool_release(&buffer_pool, (uint8_t)(offset / SAADC_BUF_SIZE));
+    if (buffer_request_pending && arm_next_buffer() == NRF_SUCCESS) {
+        buffer_request_pending = false;
+        if (sampling_finished) {
+            // The stream stopped for lack of buffers: mark the gap
+            sampling_finished = false;
+            stream_restarted = true;
+            APP_ERROR_CHECK(nrfx_saadc_mode_trigger());
+        }
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Request a sampling rate.
+ *
+ * Only records the request; the SAADC interrupt applies it at the next buffer
+ * boundary, so a buffer is never acquired at two rates.
+ *
+ * @param rate The requested sampling rate.
+ */
+void sadc_rate_set(sadc_rate_t rate) {
+    if (rate < SADC_RATE_COUNT) {
+        requested_rate = rate;
+    }
+}
+
+/**
+ * @brief Get the scan frequency of a sampling rate.
+ *
+ * @param rate The sampling rate.
+ * @return uint32_t The scan frequency in Hz.
+ */
+uint32_t sadc_rate_frequency(sadc_rate_t rate) {
+    return (rate == SADC_RATE_IDLE) ? SAADC_IDLE_FREQUENCY : SAADC_SAMPLE_FREQUENCY;
+}
+
+/**
+ * @brief Request an acquisition profile.
+ *
+ * Only records the request; the SAADC interrupt applies it at the next buffer
+ * boundary, or when a limit watch ends.
+ *
+ * @param profile The requested acquisition profile.
+ * @return ret_code_t NRF_SUCCESS if the profile was requested, NRF_ERROR_INVALID_PARAM
+ *                    if it is unknown or its scan does not fit the full-rate period.
+ */
+ret_code_t sadc_profile_set(sadc_profile_id_t profile) {
+    if (profile >= SADC_PROFILE_COUNT || !profile_fits(profile)) {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    requested_profile = profile;
+    return NRF_SUCCESS;
+}
+
+/**
+ * @brief Get the conversion settings of an acquisition profile.
+ *
+ * @param profile The acquisition profile.
+ * @return const sadc_profile_t* The profile settings, NULL if the profile is unknown.
+ */
+const sadc_profile_t *sadc_profile_get(sadc_profile_id_t profile) {
+    return (profile < SADC_PROFILE_COUNT) ? &profiles[profile] : NULL;
+}
+
+/**
+ * @brief Convert a level on the SADC_SCALE_BITS scale to raw counts of a profile.
+ *
+ * This is how the limit watch programs the SAADC limits.
+ *
+ * @param level The level on the SADC_SCALE_BITS scale.
+ * @param profile The acquisition profile.
+ * @return int16_t The level in raw counts, saturated to the int16_t range.
+ */
+int16_t sadc_level_to_raw(int16_t level, sadc_profile_id_t profile) {
+    int8_t shift = (profile < SADC_PROFILE_COUNT) ? profiles[profile].scale_shift : 0;
+    int32_t raw = (shift >= 0) ? (int32_t)level * (1 << shift) : (int32_t)level / (1 << -shift);
+
+    if (raw > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (raw < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)raw;
+}
+
+/**
+ * @brief Get the current time of the buffer timebase.
+ *
+ * Uses its own capture register, CC0 belongs to the END events.
+ *
+ * @return uint32_t The time in microseconds, 0 without SADC_TIMESTAMPS.
+ */
+uint32_t sadc_timestamp_now(void) {
+#if SADC_TIMESTAMPS
+    return nrfx_timer_capture(&timestamp_timer, NRF_TIMER_CC_CHANNEL1);
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Get the time of a scan frame of a timestamped buffer.
+ *
+ * The END event follows the conversion of the last frame, earlier frames are
+ * one scan period apart.
+ *
+ * @param p_desc Descriptor of the buffer.
+ * @param frame Index of the scan frame in the buffer.
+ * @return uint32_t The time in microseconds on the buffer timebase.
+ */
+uint32_t sadc_frame_timestamp(const sadc_buffer_desc_t *p_desc, uint16_t frame) {
+    uint16_t frames = p_desc->size / SADC_CHANNEL_COUNT;
+    uint32_t frames_before_end = (frame < frames) ? (uint32_t)(frames - 1 - frame) : 0;
+
+    return p_desc->timestamp -
+           (uint32_t)(((uint64_t)frames_before_end * 1000000) / sadc_rate_frequency((sadc_rate_t)p_desc->rate));
+}
+
+/**
+ * @brief Hand the sampling over to the SAADC limit events.
+ *
+ * If the sampling already stopped for lack of buffers the watch starts at
+ * once, otherwise when the armed buffers have completed.
+ *
+ * @param p_low Low limit of each channel on the SADC_SCALE_BITS scale.
+ * @param p_high High limit of each channel on the SADC_SCALE_BITS scale.
+ * @param callback Callback notified of refresh and wake events.
+ * @return ret_code_t NRF_SUCCESS if the watch was requested, NRF_ERROR_INVALID_STATE
+ *                    if one or an offset calibration is in progress, NRF_ERROR_NOT_SUPPORTED without SADC_LIMIT_WATCH.
+ */
+ret_code_t sadc_watch_start(const int16_t *p_low, const int16_t *p_high, sadc_watch_callback_t callback) {
+#if SADC_LIMIT_WATCH
+    ret_code_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if (watch_state != WATCH_OFF || calib_state != CALIB_OFF) {
+        err_code = NRF_ERROR_INVALID_STATE;
+    } else {
+        for (uint8_t ch = 0; ch < SADC_CHANNEL_COUNT; ch++) {
+            watch_low[ch] = p_low[ch];
+            watch_high[ch] = p_high[ch];
+        }
+        watch_callback_ref = callback;
+        watch_state = WATCH_PENDING;
+        // A buffer request left pending is dropped, the watch replaces it
+        buffer_request_pending = false;
+        if (sampling_finished) {
+            sampling_finished = false;
+            watch_enter();
+        }
+    }
+    CRITICAL_REGION_EXIT();
+    return err_code;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief Recalibrate the SAADC offset in the gap between two buffers.
+ *
+ * If the sampling already stopped for lack of buffers the calibration starts
+ * at once, otherwise when the armed buffers have completed.
+ *
+ * @return ret_code_t NRF_SUCCESS if the calibration was scheduled, NRF_ERROR_INVALID_STATE
+ *                    while a calibration, a limit watch or a suspension is in progress.
+ */
+ret_code_t sadc_calibrate(void) {
+    ret_code_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    bool busy = (calib_state != CALIB_OFF);
+#if SADC_LIMIT_WATCH
+    busy = busy || (watch_state != WATCH_OFF) || sampling_suspended;
+#endif
+    if (busy) {
+        err_code = NRF_ERROR_INVALID_STATE;
+    } else {
+        calib_state = CALIB_PENDING;
+        // A buffer request left pending is dropped, the calibration restarts the sampling
+        buffer_request_pending = false;
+        if (sampling_finished) {
+            sampling_finished = false;
+            calibration_start();
+        }
+    }
+    CRITICAL_REGION_EXIT();
+    return err_code;
+}
+
+/**
+ * @brief Re-centre the limits of a running watch.
+ *
+ * @param p_low Low limit of each channel on the SADC_SCALE_BITS scale.
+ * @param p_high High limit of each channel on the SADC_SCALE_BITS scale.
+ * @return ret_code_t NRF_SUCCESS if the limits were set, NRF_ERROR_INVALID_STATE if no watch is running.
+ */
+ret_code_t sadc_watch_limits_set(const int16_t *p_low, const int16_t *p_high) {
+#if SADC_LIMIT_WATCH
+    ret_code_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if (watch_state == WATCH_OFF) {
+        err_code = NRF_ERROR_INVALID_STATE;
+    } else {
+        for (uint8_t ch = 0; ch < SADC_CHANNEL_COUNT; ch++) {
+            watch_low[ch] = p_low[ch];
+            watch_high[ch] = p_high[ch];
+            if (watch_state == WATCH_ACTIVE) {
+                APP_ERROR_CHECK(nrfx_saadc_limits_set(ch, sadc_level_to_raw(watch_low[ch], active_profile), sadc_level_to_raw(watch_high[ch], active_profile)));
+            }
+        }
+    }
+    CRITICAL_REGION_EXIT();
+    return err_code;
+#else
+    return NRF_ERROR_INVALID_STATE;
+#endif
+}
+
+/**
+ * @brief Stop the SAADC and its TIMERs from a running limit watch.
+ *
+ * The watch is the only state in which no buffer is armed and the driver is
+ * idle, so the scan TIMER can be stopped without cutting a buffer short.
+ *
+ * @return ret_code_t NRF_SUCCESS if the sampling stopped, NRF_ERROR_INVALID_STATE if no watch is running.
+ */
+ret_code_t sadc_suspend(void) {
+#if SADC_LIMIT_WATCH
+    ret_code_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if (watch_state != WATCH_ACTIVE) {
+        err_code = NRF_ERROR_INVALID_STATE;
+    } else {
+        watch_stop();
+        nrfx_timer_disable(&scan_timer);
+#if SADC_TIMESTAMPS
+        nrfx_timer_pause(&timestamp_timer);
+#endif
+        sampling_suspended = true;
+    }
+    CRITICAL_REGION_EXIT();
+    return err_code;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief Restart the buffered sampling at the full rate after `sadc_suspend()`.
+ *
+ * May be called from interrupt context.
+ *
+ * @return ret_code_t NRF_SUCCESS if the sampling restarted, NRF_ERROR_INVALID_STATE if it was not suspended.
+ */
+ret_code_t sadc_resume(void) {
+#if SADC_LIMIT_WATCH
+    ret_code_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if (!sampling_suspended) {
+        err_code = NRF_ERROR_INVALID_STATE;
+    } else {
+        sampling_suspended = false;
+#if SADC_TIMESTAMPS
+        nrfx_timer_resume(&timestamp_timer);
+#endif
+        sampling_resume();
+        nrfx_timer_enable(&scan_timer);
+    }
+    CRITICAL_REGION_EXIT();
+    return err_code;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief Check whether a limit watch is requested or running.
+ *
+ * @return bool True from `sadc_watch_start()` until the wake.
+ */
+bool sadc_watch_active(void) {
+#if SADC_LIMIT_WATCH
+    return watch_state != WATCH_OFF;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Get the analog input of a scan channel.
+ *
+ * @param channel Scan channel index.
+ * @return nrf_saadc_input_t The input of the channel, NRF_SAADC_INPUT_DISABLED if out of range.
+ */
+nrf_saadc_input_t sadc_channel_input(uint8_t channel) {
+    return (channel < SADC_CHANNEL_COUNT) ? channel_inputs[channel] : NRF_SAADC_INPUT_DISABLED;
+}
+
+/**
+ * @brief Get the number of limit watches ended by a limit event.
+ *
+ * @return uint32_t The wake counter.
+ */
+uint32_t get_sadc_watch_wake_count(void) {
+#if SADC_LIMIT_WATCH
+    return watch_wake_count;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Get the time spent in completed limit watches.
+ *
+ * @return uint32_t The watch time in milliseconds.
+ */
+uint32_t get_sadc_watch_time_ms(void) {
+#if SADC_LIMIT_WATCH
+    return watch_time_ms;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Get the number of completed offset calibrations.
+ *
+ * @return uint32_t The calibration counter.
+ */
+uint32_t get_sadc_calibration_count(void) {
+    return calib_count;
 }
 
 /**
- * @brief Set the current buffer for SAADC data.
+ * @brief Get the number of scan frames lost in gaps of the buffered stream.
  *
- * Specifies the buffer to be used for storing the next set of SAADC data.
+ * @return uint32_t The skipped frame counter.
+ */
+uint32_t get_sadc_skipped_count(void) {
+    return skipped_count;
+}
+
+/**
+ * @brief Get the number of buffer requests that found the pool exhausted.
  *
- * @param buffer Pointer to the SAADC data buffer.
+ * @return uint32_t The back-pressure counter.
  */
-void set_current_buffer(nrf_saadc_value_t* buffer) {
-    current_buffer = buffer;
+uint32_t get_sadc_backpressure_count(void) {
+    return sadc_pool_exhausted(&buffer_pool);
 }
 
 /**
- * @brief Get the current buffer used for SAADC data.
+ * @brief Get the number of completed buffers dropped because the main loop was late.
  *
- * Retrieves the pointer to the current buffer being used for SAADC data.
+ * @return uint32_t The overrun counter.
+ */
+uint32_t get_sadc_overrun_count(void) {
+    return sadc_queue_overruns(&buffer_queue);
+}
+
+/**
+ * @brief Get the number of buffer requests made while no buffer was pending.
  *
- * @return nrf_saadc_value_t* Pointer to the current SAADC data buffer.
+ * @return uint32_t The underrun counter.
  */
-nrf_saadc_value_t* get_current_buffer(void) {
-    return current_buffer;
+uint32_t get_sadc_underrun_count(void) {
+    return sadc_queue_underruns(&buffer_queue);
 }
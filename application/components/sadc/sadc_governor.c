@@ -0,0 +1,138 @@
+/**
+ * @file sadc_governor.c
+ * @brief Activity-adaptive SAADC sampling rate governor.
+ * 
+ * This module decides the SAADC sampling rate from the activity of the sensing
+ * channels. Sampling drops to the idle rate after a quiet period at the full
+ * rate and returns to it as soon as a block shows activity. The frames acquired
+ * at each rate are counted so the time spent at each rate can be reported.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "sadc_governor.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Initialize the governor at the full rate.
+ *
+ * @param p_governor Pointer to the governor.
+ * @param quiet_time_ms Quiet time at the full rate before dropping to the idle rate.
+ */
+void sadc_governor_init(sadc_governor_t *p_governor, uint32_t quiet_time_ms)
+{
+    p_governor->rate = SADC_RATE_FULL;
+    p_governor->quiet_frames = 0;
+    p_governor->quiet_limit = (uint32_t)(((uint64_t)quiet_time_ms * SAADC_SAMPLE_FREQUENCY) / 1000);
+    for (int rate = 0; rate < SADC_RATE_COUNT; rate++) {
+        p_governor->rate_frames[rate] = 0;
+    }
+    p_governor->switch_count = 0;
+}
+
+/**
+ * @brief Account for a processed buffer and decide the next rate.
+ *
+ * Activity requests the full rate at once; the idle rate is only requested
+ * after quiet_limit of uninterrupted quiet time at the full rate, so a brief
+ * pause in an interaction does not toggle the rate. Buffers already acquired
+ * at the idle rate when the full rate was requested do not count as quiet.
+ *
+ * @param p_governor Pointer to the governor.
+ * @param buffer_rate Rate the buffer was acquired at (from its descriptor).
+ * @param frames Number of scan frames in the buffer.
+ * @param active True if any channel showed activity in the buffer.
+ * @return sadc_rate_t The rate to request from the driver.
+ */
+sadc_rate_t sadc_governor_update(sadc_governor_t *p_governor, sadc_rate_t buffer_rate, uint32_t frames, bool active)
+{
+    sadc_rate_t rate = p_governor->rate;
+
+    if (buffer_rate < SADC_RATE_COUNT) {
+        p_governor->rate_frames[buffer_rate] += frames;
+    }
+
+    if (active) {
+        p_governor->quiet_frames = 0;
+        rate = SADC_RATE_FULL;
+    } else if (rate == SADC_RATE_FULL && buffer_rate == SADC_RATE_FULL) {
+        p_governor->quiet_frames += frames;
+        if (p_governor->quiet_frames >= p_governor->quiet_limit) {
+            p_governor->quiet_frames = 0;
+            rate = SADC_RATE_IDLE;
+        }
+    }
+
+    if (rate != p_governor->rate) {
+        p_governor->rate = rate;
+        p_governor->switch_count++;
+    }
+    return rate;
+}
+
+/**
+ * @brief Record that the driver went back to the full rate on its own.
+ *
+ * Called when a limit watch wakes, which resumes the sampling at the full
+ * rate; the quiet time starts over from there.
+ *
+ * @param p_governor Pointer to the governor.
+ */
+void sadc_governor_wake(sadc_governor_t *p_governor)
+{
+    p_governor->quiet_frames = 0;
+    if (p_governor->rate != SADC_RATE_FULL) {
+        p_governor->rate = SADC_RATE_FULL;
+        p_governor->switch_count++;
+    }
+}
+
+/**
+ * @brief Get the time spent acquiring at a rate.
+ *
+ * @param p_governor Pointer to the governor.
+ * @param rate The sampling rate.
+ * @return uint32_t The acquisition time at that rate in milliseconds.
+ */
+uint32_t sadc_governor_time_ms(const sadc_governor_t *p_governor, sadc_rate_t rate)
+{
+    if (rate >= SADC_RATE_COUNT) {
+        return 0;
+    }
+    return (uint32_t)((p_governor->rate_frames[rate] * 1000) / sadc_rate_frequency(rate));
+}
+
+/**
+ * @brief Get the number of rate changes requested.
+ *
+ * @param p_governor Pointer to the governor.
+ * @return uint32_t The rate change counter.
+ */
+uint32_t sadc_governor_switches(const sadc_governor_t *p_governor)
+{
+    return p_governor->switch_count;
+}
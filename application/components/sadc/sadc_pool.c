@@ -0,0 +1,127 @@
+/**
+ * @file sadc_pool.c
+ * @brief Ownership-tracking pool of SAADC sample buffers.
+ * 
+ * This module tracks which SAADC sample buffers are free so that a buffer is
+ * only handed back to EasyDMA once the consumer has released it. Free indices
+ * are passed through a lock-free ring, and running out of buffers is counted
+ * as a back-pressure event.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "sadc_pool.h"
+
+/**
+ * @brief Initialize the pool with all buffers free.
+ *
+ * @param p_pool Pointer to the pool.
+ * @param buffer_count Number of buffers (1 to SADC_POOL_MAX_BUFFERS).
+ * @return bool True if the pool was initialized, false if the count is invalid.
+ */
+bool sadc_pool_init(sadc_pool_t *p_pool, uint8_t buffer_count)
+{
+    if (p_pool == NULL || buffer_count == 0 || buffer_count > SADC_POOL_MAX_BUFFERS) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < buffer_count; i++) {
+        p_pool->free_slots[i] = i;
+    }
+    p_pool->buffer_count = buffer_count;
+    atomic_init(&p_pool->head, 0);
+    atomic_init(&p_pool->tail, buffer_count);
+    atomic_init(&p_pool->exhausted_count, 0);
+    return true;
+}
+
+/**
+ * @brief Take ownership of a free buffer.
+ *
+ * Single consumer side of the free ring (SAADC interrupt, or the main loop
+ * with the interrupt masked).
+ *
+ * @param p_pool Pointer to the pool.
+ * @param p_index Pointer where the buffer index is stored.
+ * @return bool True if a buffer was acquired, false if the pool is exhausted.
+ */
+bool sadc_pool_acquire(sadc_pool_t *p_pool, uint8_t *p_index)
+{
+    uint32_t head = atomic_load_explicit(&p_pool->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&p_pool->tail, memory_order_acquire);
+
+    if (head == tail) {
+        atomic_fetch_add_explicit(&p_pool->exhausted_count, 1, memory_order_relaxed);
+        return false;
+    }
+
+    *p_index = p_pool->free_slots[head & (SADC_POOL_MAX_BUFFERS - 1)];
+    atomic_store_explicit(&p_pool->head, head + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Give a buffer back to the pool.
+ *
+ * Single producer side of the free ring (main loop). The ring can never
+ * overflow because it only ever holds indices that were acquired before.
+ *
+ * @param p_pool Pointer to the pool.
+ * @param index Index of a buffer previously acquired.
+ */
+void sadc_pool_release(sadc_pool_t *p_pool, uint8_t index)
+{
+    uint32_t tail = atomic_load_explicit(&p_pool->tail, memory_order_relaxed);
+
+    p_pool->free_slots[tail & (SADC_POOL_MAX_BUFFERS - 1)] = index;
+    atomic_store_explicit(&p_pool->tail, tail + 1, memory_order_release);
+}
+
+/**
+ * @brief Get the number of free buffers.
+ *
+ * @param p_pool Pointer to the pool.
+ * @return uint32_t The number of buffers available for acquisition.
+ */
+uint32_t sadc_pool_available(sadc_pool_t *p_pool)
+{
+    uint32_t tail = atomic_load_explicit(&p_pool->tail, memory_order_acquire);
+    uint32_t head = atomic_load_explicit(&p_pool->head, memory_order_acquire);
+    return tail - head;
+}
+
+/**
+ * @brief Get the number of acquire attempts made while the pool was exhausted.
+ *
+ * @param p_pool Pointer to the pool.
+ * @return uint32_t The back-pressure counter.
+ */
+uint32_t sadc_pool_exhausted(sadc_pool_t *p_pool)
+{
+    return atomic_load_explicit(&p_pool->exhausted_count, memory_order_relaxed);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file sadc_queue.c
+ * @brief Single-producer/single-consumer queue of SAADC buffer descriptors.
+ * 
+ * This module passes descriptors of completed SAADC buffers from the SAADC
+ * interrupt to the main loop without locks, counting buffers dropped because
+ * the consumer fell behind. It has no hardware dependencies.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "sadc_queue.h"
+
+/**
+ * @brief Initialize the queue.
+ *
+ * Must be called before the producer or the consumer is started.
+ *
+ * @param p_queue Pointer to the queue.
+ */
+void sadc_queue_init(sadc_queue_t *p_queue)
+{
+    atomic_init(&p_queue->head, 0);
+    atomic_init(&p_queue->tail, 0);
+    atomic_init(&p_queue->overrun_count, 0);
+    atomic_init(&p_queue->underrun_count, 0);
+    p_queue->next_sequence = 0;
+}
+
+/**
+ * @brief Push a completed buffer (producer side).
+ *
+ * The descriptor is written before the tail is published with release
+ * semantics, so the consumer never observes a partially written entry.
+ *
+ * @param p_queue Pointer to the queue.
+ * @param p_desc Pointer to the descriptor of the completed buffer.
+ * @return bool True if the descriptor was queued, false on overrun.
+ */
+bool sadc_queue_push(sadc_queue_t *p_queue, const sadc_buffer_desc_t *p_desc)
+{
+    uint32_t tail = atomic_load_explicit(&p_queue->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&p_queue->head, memory_order_acquire);
+    uint32_t sequence = p_queue->next_sequence++;
+
+    if ((uint32_t)(tail - head) >= SADC_QUEUE_SIZE) {
+        // Consumer is late, drop the newest buffer and record it
+        atomic_fetch_add_explicit(&p_queue->overrun_count, 1, memory_order_relaxed);
+        return false;
+    }
+
+    sadc_buffer_desc_t *p_entry = &p_queue->entries[tail & (SADC_QUEUE_SIZE - 1)];
+    *p_entry = *p_desc;
+    p_entry->sequence = sequence;
+
+    atomic_store_explicit(&p_queue->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Pop the oldest buffer descriptor (consumer side).
+ *
+ * The descriptor is copied out before the head is released back to the
+ * producer.
+ *
+ * @param p_queue Pointer to the queue.
+ * @param p_desc Pointer where the descriptor is copied.
+ * @return bool True if a descriptor was popped, false on underrun.
+ */
+bool sadc_queue_pop(sadc_queue_t *p_queue, sadc_buffer_desc_t *p_desc)
+{
+    uint32_t head = atomic_load_explicit(&p_queue->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&p_queue->tail, memory_order_acquire);
+
+    if (head == tail) {
+        atomic_fetch_add_explicit(&p_queue->underrun_count, 1, memory_order_relaxed);
+        return false;
+    }
+
+    *p_desc = p_queue->entries[head & (SADC_QUEUE_SIZE - 1)];
+
+    atomic_store_explicit(&p_queue->head, head + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Get the number of descriptors waiting in the queue.
+ *
+ * @param p_queue Pointer to the queue.
+ * @return uint32_t The number of pending descriptors.
+ */
+uint32_t sadc_queue_pending(sadc_queue_t *p_queue)
+{
+    uint32_t tail = atomic_load_explicit(&p_queue->tail, memory_order_acquire);
+    uint32_t head = atomic_load_explicit(&p_queue->head, memory_order_acquire);
+    return tail - head;
+}
+
+/**
+ * @brief Get the number of descriptors dropped because the queue was full.
+ *
+ * @param p_queue Pointer to the queue.
+ * @return uint32_t The overrun counter.
+ */
+uint32_t sadc_queue_overruns(sadc_queue_t *p_queue)
+{
+    return atomic_load_explicit(&p_queue->overrun_count, memory_order_relaxed);
+}
+
+/**
+ * @brief Get the number of pops attempted on an empty queue.
+ *
+ * @param p_queue Pointer to the queue.
+ * @return uint32_t The underrun counter.
+ */
+uint32_t sadc_queue_underruns(sadc_queue_t *p_queue)
+{
+    return atomic_load_explicit(&p_queue->underrun_count, memory_order_relaxed);
+}
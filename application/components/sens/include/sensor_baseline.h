@@ -0,0 +1,86 @@
+#ifndef SENSOR_BASELINE_H
+#define SENSOR_BASELINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fraction bits of the baseline (readings up to 15 bits fit the Q16.16 range)
+#define SENSOR_BASELINE_Q16_SHIFT 16
+#define SENSOR_BASELINE_MAX_READING INT16_MAX // Larger readings are clamped
+
+/**
+ * @brief Slow exponential moving average of the idle sensor level.
+ *
+ * Tracks temperature and humidity drift per sample in Q16.16 fixed point and
+ * freezes while an event (touch or proximity) moves the reading away from it.
+ */
+typedef struct {
+    int32_t baseline_q16;   // Idle level in ADC counts (Q16.16)
+    uint8_t shift;          // Smoothing shift, time constant of 2^shift samples
+    int32_t freeze_band;    // Deviation in ADC counts that freezes the tracking
+    uint32_t freeze_limit;  // Frozen samples before re-seeding to the reading
+    uint32_t frozen_count;  // Consecutive samples outside the freeze band
+} sensor_baseline_t;
+
+/**
+ * @brief Initialize a baseline tracker.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @param initial Initial baseline in ADC counts.
+ * @param shift Smoothing shift, the average moves by 1/2^shift of the error per sample.
+ * @param freeze_band Deviation in ADC counts above which an event is considered active.
+ * @param freeze_limit Number of consecutive frozen samples after which the baseline is re-seeded.
+ */
+void sensor_baseline_init(sensor_baseline_t *p_baseline, int32_t initial, uint8_t shift,
+                          int32_t freeze_band, uint32_t freeze_limit);
+
+/**
+ * @brief Change the deviation that freezes the tracking.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @param freeze_band Deviation in ADC counts above which an event is considered active.
+ */
+void sensor_baseline_set_freeze_band(sensor_baseline_t *p_baseline, int32_t freeze_band);
+
+/**
+ * @brief Update the baseline with one reading.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @param reading The reading in ADC counts.
+ * @return bool True if the baseline tracked the reading, false if it is frozen.
+ */
+bool sensor_baseline_update(sensor_baseline_t *p_baseline, int32_t reading);
+
+/**
+ * @brief Move the baseline by a predicted change.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @param change_q16 The change in ADC counts (Q16.16).
+ */
+void sensor_baseline_shift(sensor_baseline_t *p_baseline, int32_t change_q16);
+
+/**
+ * @brief Get the baseline in ADC counts.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @return int32_t The baseline, rounded to the nearest count.
+ */
+int32_t sensor_baseline_get(const sensor_baseline_t *p_baseline);
+
+/**
+ * @brief Check whether the baseline is frozen by an active event.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @return bool True if the last reading was outside the freeze band.
+ */
+bool sensor_baseline_is_frozen(const sensor_baseline_t *p_baseline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_BASELINE_H
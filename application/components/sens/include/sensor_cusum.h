@@ -0,0 +1,94 @@
+#ifndef SENSOR_CUSUM_H
+#define SENSOR_CUSUM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Change-point event types.
+ */
+typedef enum {
+    SENSOR_CUSUM_NONE = 0,   // No change on this sample
+    SENSOR_CUSUM_ONSET,      // The reading left the baseline
+    SENSOR_CUSUM_RELEASE     // The reading returned to the baseline
+} sensor_cusum_event_type_t;
+
+/**
+ * @brief Change-point event.
+ */
+typedef struct {
+    sensor_cusum_event_type_t type; // Onset or release
+    int8_t direction;               // +1 above the baseline, -1 below it
+    uint32_t sample_index;          // Sample on which the decision was taken
+    uint32_t change_index;          // Estimated first sample of the change
+} sensor_cusum_event_t;
+
+/**
+ * @brief Two-sided CUSUM change-point detector.
+ *
+ * Accumulates the deviation of each sample from the baseline minus a drift
+ * allowance, separately above and below it, and declares an onset when one sum
+ * exceeds the decision interval. While an event is active, a release sum
+ * accumulates how far the deviation stays below the drift allowance and ends
+ * the event when it exceeds the same interval. A shift of d counts is detected
+ * after about decision / (d - drift) samples, while noise below the drift
+ * allowance keeps the sums at zero.
+ */
+typedef struct {
+    int32_t drift;           // Allowance k subtracted per sample (counts)
+    int32_t decision;        // Decision interval h (counts)
+    int32_t sum_up;          // Upper CUSUM statistic
+    int32_t sum_down;        // Lower CUSUM statistic
+    int32_t sum_release;     // Release statistic of the active event
+    uint32_t start_up;       // First sample of the current upper accumulation
+    uint32_t start_down;     // First sample of the current lower accumulation
+    uint32_t start_release;  // First sample of the current release accumulation
+    uint32_t sample_index;   // Index of the next sample
+    int8_t state;            // Active event: +1 above, -1 below, 0 none
+} sensor_cusum_t;
+
+/**
+ * @brief Initialize a CUSUM detector.
+ *
+ * @param p_cusum Pointer to the detector.
+ * @param drift Drift allowance in counts, typically half the smallest shift of interest.
+ * @param decision Decision interval in counts, trading detection delay for false alarms.
+ */
+void sensor_cusum_init(sensor_cusum_t *p_cusum, int32_t drift, int32_t decision);
+
+/**
+ * @brief Retune the detector.
+ *
+ * @param p_cusum Pointer to the detector.
+ * @param drift Drift allowance in counts.
+ * @param decision Decision interval in counts.
+ */
+void sensor_cusum_set_parameters(sensor_cusum_t *p_cusum, int32_t drift, int32_t decision);
+
+/**
+ * @brief Feed one deviation from the baseline into the detector.
+ *
+ * @param p_cusum Pointer to the detector.
+ * @param deviation The reading minus the baseline, in counts.
+ * @param p_event Filled with the event when one is emitted.
+ * @return bool True if an onset or release was emitted on this sample.
+ */
+bool sensor_cusum_update(sensor_cusum_t *p_cusum, int32_t deviation, sensor_cusum_event_t *p_event);
+
+/**
+ * @brief Get the active event.
+ *
+ * @param p_cusum Pointer to the detector.
+ * @return int8_t +1 while the reading is above the baseline, -1 while below it, 0 otherwise.
+ */
+int8_t sensor_cusum_state(const sensor_cusum_t *p_cusum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_CUSUM_H
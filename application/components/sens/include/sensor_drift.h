@@ -0,0 +1,80 @@
+#ifndef SENSOR_DRIFT_H
+#define SENSOR_DRIFT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fixed-point formats of the model
+#define SENSOR_DRIFT_Q16_SHIFT 16    // Means, weight, co-moments and slope in Q16.16
+#define SENSOR_DRIFT_FORGET_SHIFT 15 // Forgetting factor in Q1.15
+
+/**
+ * @brief Online linear model of the baseline against the die temperature.
+ *
+ * Fits baseline = a + slope * temperature by recursive least squares with
+ * exponential forgetting (weighted means and co-moments, updated Welford
+ * style), so the model follows slow changes of the installation. The slope
+ * predicts how far the baseline moves between two temperature readings.
+ * The arithmetic is integer only; the co-moments are kept in 64 bits.
+ */
+typedef struct {
+    int32_t forget_q15;          // Forgetting factor applied per point (Q1.15, 0 < forget < 1)
+    int32_t weight_q16;          // Total weight of the points (Q16.16)
+    int32_t mean_temperature_q16; // Weighted mean temperature (Q16.16)
+    int32_t mean_baseline_q16;   // Weighted mean baseline (counts, Q16.16)
+    int64_t cov_tt_q16;          // Weighted co-moment temperature x temperature (Q16.16)
+    int64_t cov_tb_q16;          // Weighted co-moment temperature x baseline (Q16.16)
+    int32_t min_variance;        // Temperature variance needed before the slope is used (units^2)
+    int32_t max_slope;           // Largest slope magnitude accepted (counts per temperature unit)
+    int32_t last_temperature;    // Temperature of the previous reading
+    bool has_temperature;        // A previous reading exists
+} sensor_drift_t;
+
+/**
+ * @brief Initialize a drift model.
+ *
+ * @param p_drift Pointer to the model.
+ * @param forget_q15 Forgetting factor per point in Q1.15, e.g. SENSOR_Q15(0.999) for a memory of about 1000 points.
+ * @param min_variance Temperature variance (units^2) needed before the fitted slope is trusted.
+ * @param max_slope Largest slope magnitude accepted, in counts per temperature unit.
+ */
+void sensor_drift_init(sensor_drift_t *p_drift, int32_t forget_q15, int32_t min_variance, int32_t max_slope);
+
+/**
+ * @brief Process a temperature reading.
+ *
+ * Returns the baseline change predicted for the temperature change since the
+ * previous reading, from the slope fitted so far.
+ *
+ * @param p_drift Pointer to the model.
+ * @param temperature The temperature reading.
+ * @return int32_t The predicted baseline change in counts (Q16.16).
+ */
+int32_t sensor_drift_predict(sensor_drift_t *p_drift, int32_t temperature);
+
+/**
+ * @brief Add a (temperature, baseline) point to the fit.
+ *
+ * @param p_drift Pointer to the model.
+ * @param temperature The temperature reading.
+ * @param baseline The idle baseline at that temperature, in counts.
+ */
+void sensor_drift_fit(sensor_drift_t *p_drift, int32_t temperature, int32_t baseline);
+
+/**
+ * @brief Get the fitted slope.
+ *
+ * @param p_drift Pointer to the model.
+ * @return int32_t Counts per temperature unit (Q16.16), 0 until the temperature has varied enough.
+ */
+int32_t sensor_drift_slope(const sensor_drift_t *p_drift);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_DRIFT_H
@@ -7,36 +7,106 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
-#include "nrfx_saadc.h"
-#include "app_timer.h"
+#include <stddef.h>
+#include "sensor_window.h"
+#include "sensor_baseline.h"
+#include "hampel_filter.h"
+#include "mains_filter.h"
+#include "sensor_cusum.h"
+#include "sensor_zone.h"
+#include "sensor_noise.h"
+#include "sensor_quantile.h"
+#include "sensor_drift.h"
 
-// Size of the circular buffer for sensor readings
-#define SENS_BUFFER_SIZE 50  
+// Size of the circular buffer for sensor readings (set in sensor_config.h)
+#define SENS_BUFFER_SIZE SENSOR_WINDOW_SIZE
 
-// Threshold for stability checks
+// Detection threshold until the noise estimate takes over (counts)
 #define STABILITY_THRESHOLD 10 
 
+// Noise-adaptive detection threshold T = NOISE_K * sigma of the idle readings,
+// clamped so that a silent channel stays usable and the outer zone (2T) stays
+// below the inner one
+#define NOISE_K 3                 // Threshold in standard deviations
+#define NOISE_SHIFT 10            // Noise estimate time constant of 2^10 idle samples (about 1 s at 1 kHz)
+#define NOISE_MIN_THRESHOLD 4     // Lowest threshold (counts)
+#define NOISE_MAX_THRESHOLD 20    // Highest threshold (counts)
+
+// Fixed-point helpers (the conversion is folded at compile time)
+#define SENSOR_Q15_SHIFT 15
+#define SENSOR_Q16_SHIFT 16
+#define SENSOR_Q15(x) ((int32_t)((x) * (1 << SENSOR_Q15_SHIFT) + 0.5)) // Fraction to Q1.15
+
 // Constants for sensor operation
-#define INITIAL_MAX_THRESHOLD 0.1 // Threshold for maximum reading
-#define INITIAL_MIN_THRESHOLD 0.1 // Threshold for minimum reading
-#define SAADC_SAMPLES_IN_BUFFER 2  // Number of samples per SAADC buffer
+#define INITIAL_MAX_THRESHOLD SENSOR_Q15(0.1) // Threshold for maximum reading (Q15 fraction of the average)
+#define INITIAL_MIN_THRESHOLD SENSOR_Q15(0.1) // Threshold for minimum reading (Q15 fraction of the average)
+
+// Baseline tracking constants (per decimated sample)
+#define FINE_STRUCTURE 390        // Golden Reference until the initial calibration is done
+#define BASELINE_SHIFT 12         // Drift time constant of 2^12 samples (about 4 s at 1 kHz)
+#define BASELINE_FREEZE_BAND(t) ((t) * 2) // Deviation freezing the baseline during an event
+#define BASELINE_FREEZE_LIMIT 30000 // Frozen samples (30 s at 1 kHz) before the reading becomes the new baseline
+
+// Temperature drift compensation (die temperature in 0.25 degC, read about once per second)
+#define DRIFT_FORGET SENSOR_Q15(0.999) // Model memory of about 1000 readings (17 min at 1 Hz), Q15
+#define DRIFT_MIN_VARIANCE 4      // Temperature spread (0.5 degC rms) needed before compensating
+#define DRIFT_MAX_SLOPE 8         // Largest correction in counts per 0.25 degC
+
+// Spike rejection constants (window length in sensor_config.h)
+#define OUTLIER_THRESHOLD 4       // Rejection limit in running mean absolute deviations
+#define OUTLIER_SCALE_SHIFT 6     // Deviation scale time constant of 2^6 samples
+#define OUTLIER_MIN_DEVIATION 8   // Deviations up to 8 counts are never rejected
+
+// Top/low references (streaming percentiles of the readings)
+#define REFERENCE_LOW_QUANTILE SENSOR_Q15(0.01)  // low_reference is the 1st percentile (Q15)
+#define REFERENCE_TOP_QUANTILE SENSOR_Q15(0.99)  // top_reference is the 99th percentile (Q15)
+#define REFERENCE_HORIZON 4096        // Samples after which the percentile history is halved (about 4 s at 1 kHz)
 
-// Timing constants
-#define STABILITY_DURATION 10000  // Duration for checking stability in milliseconds
-#define SENSOR_READ_DELAY 100     // Delay between sensor readings in milliseconds
-#define FINE_STRUCTURE 390        // Static value for the Golden Reference
+// SAADC limit watch (SENSOR_LIMIT_WAKE). The limits see raw idle-rate samples,
+// noisier than the decimated readings T is derived from, plus any mains hum.
+#define WATCH_LIMIT_BAND(t) ((t) * 3) // Distance of the wake limits from the baseline
+
+// Mains hum rejection (SENSOR_MAINS_FILTER)
+#define MAINS_MIN_AMPLITUDE 3     // Hum amplitude in counts that enables the notch cascade
+
+// Stream discontinuity (SAADC offset calibration or buffer overrun)
+#define DISCONTINUITY_SETTLE 100  // Readings (100 ms at 1 kHz, two notch time constants) kept out of the detection
+
+// Touch onset/release detection (two-sided CUSUM on the deviation from the baseline)
+#define CUSUM_DRIFT(t) ((t) / 2)    // Allowance per sample, half the smallest shift of interest
+#define CUSUM_DECISION(t) ((t) * 4) // Decision interval, detects a 2T shift in about 3 samples
+
+// Proximity zones (deviation from the baseline in counts, dwell in samples).
+// The outer zone is the detection floor and follows T; the closer zones are
+// signal levels and stay fixed.
+#define ZONE_OUTER_ENTER(t) ((t) * 2)     // Outer proximity
+#define ZONE_OUTER_HYSTERESIS(t) ((t) / 2)
+#define ZONE_INNER_ENTER (STABILITY_THRESHOLD * 5)     // Inner proximity
+#define ZONE_INNER_HYSTERESIS STABILITY_THRESHOLD
+#define ZONE_TOUCH_ENTER (STABILITY_THRESHOLD * 10)    // Touch
+#define ZONE_TOUCH_HYSTERESIS (STABILITY_THRESHOLD * 2)
+#define ZONE_IDLE_DWELL 50        // Back to idle after 50 ms at 1 kHz
+#define ZONE_OUTER_DWELL 20       // Approaches settle slowly, ask for longer evidence
+#define ZONE_INNER_DWELL 10
+#define ZONE_TOUCH_DWELL 5        // Touches are large and must react fast
 
 /**
  * @brief Structure to hold sensor data and status.
  */
 typedef struct {
+    uint8_t channel;         // SAADC scan channel the data comes from
     int sensor_reading;      // Current sensor value
-    int golden_reference;    // Stable reference voltage for comparison
+    int golden_reference;    // Stable reference voltage for comparison (tracked baseline)
     int average_reading;     // Current calculated average sensor value
-    int top_reference;       // Maximum sensor reading observed
-    int low_reference;       // Minimum sensor reading observed
+    int top_reference;       // Upper percentile of the recent readings (REFERENCE_TOP_QUANTILE)
+    int low_reference;       // Lower percentile of the recent readings (REFERENCE_LOW_QUANTILE)
     int previous_average;    // Previous calculated average sensor value
-    bool is_voltage_stable;  // Indicates whether the sensor voltage is stable
+    bool is_voltage_stable;  // Indicates whether the sensor voltage is stable (baseline tracking)
+    int8_t change_state;     // Active event: +1 above the baseline, -1 below it, 0 none
+    uint32_t change_index;   // Estimated first sample of the last onset or release
+    uint8_t zone;            // Proximity zone (sensor_zone_id_t)
+    uint16_t noise_sigma_q8; // Standard deviation of the idle readings in counts (Q8)
+    int32_t die_temperature; // Last die temperature reading (0.25 degC)
 } sensor_data_t;
 
 /**
@@ -58,7 +128,10 @@ typedef struct {
     int buffer_index;        // Index for the circular buffer
     int current_min_value;   // Current minimum sensor value
     int current_max_value;   // Current maximum sensor value
-    float sensor_voltage;    // Sensor voltage
+    int32_t sensor_voltage_q16; // Sensor voltage in volts (Q16.16)
+    int32_t noise_threshold; // Detection threshold T derived from the noise (counts)
+    uint16_t settle_count;   // Readings left before a discontinuity stops blanking the detection
+    uint32_t log_elapsed;    // Readings since the last logged data row (SENSOR_LOG_PERIOD_MS)
 } sensor_context_t;
 
 /**
@@ -67,24 +140,107 @@ typedef struct {
 typedef void (*sensor_callback_t)(sensor_data_t* sensor_data);
 
 /**
- * @brief Initialize the sensor with a specified callback.
+ * @brief Sensor driver instance.
  *
- * Sets up the sensor driver and initializes the sensor context. The callback is used
+ * Holds everything one sensing channel needs, so several channels can be
+ * processed independently. The storage is owned by the caller; the fields are
+ * private to the driver and read through the accessors below.
+ */
+typedef struct {
+    sensor_data_t data;          // Published readings and references
+    sensor_context_t ctx;        // Calibration and conversion state
+    sensor_window_t window;      // Sliding window of the last SENS_BUFFER_SIZE readings
+    sensor_baseline_t baseline;  // Drift tracker behind golden_reference
+#if SENSOR_OUTLIER_WINDOW
+    hampel_filter_t outlier_filter; // Spike rejection in front of the statistics
+#endif
+#if SENSOR_MAINS_FILTER
+    mains_filter_t mains_filter; // 50/60 Hz hum removal in front of the statistics
+#endif
+    sensor_cusum_t detector;     // Touch onset/release decision
+    sensor_zone_t zones;         // Proximity zone classification
+    sensor_noise_t noise;        // Noise estimate behind the detection thresholds
+    sensor_quantile_t top_quantile; // Estimator behind top_reference
+    sensor_quantile_t low_quantile; // Estimator behind low_reference
+    sensor_drift_t drift;        // Baseline against die temperature model
+    sensor_callback_t callback;  // Callback invoked when the zone or the active event changes
+} sensor_instance_t;
+
+/**
+ * @brief Initialize a sensor instance with a specified callback.
+ *
+ * Sets up the instance and initializes its context. The callback is used
  * to handle sensor data once it's processed.
  *
+ * @param p_sensor Pointer to the sensor instance to initialize.
+ * @param channel SAADC scan channel feeding the instance.
  * @param callback The callback function to be called with the sensor data.
  */
-void sensor_init(sensor_callback_t callback);
+void sensor_init(sensor_instance_t *p_sensor, uint8_t channel, sensor_callback_t callback);
+
+/**
+ * @brief Process a single sensor sample.
+ *
+ * Equivalent to calling `sensor_process_block()` with a block of one sample.
+ *
+ * @param p_sensor Pointer to the sensor instance.
+ * @param samples Pointer to the SAADC sample (nrf_saadc_value_t).
+ */
+void sensor_process(sensor_instance_t *p_sensor, int16_t *samples);
 
 /**
- * @brief Process the sensor data.
+ * @brief Process a block of sensor samples.
+ *
+ * Handles the sensor data processing for every sample of the block in a single pass.
+ * This includes calibration if the sensor is not yet calibrated, and normal data
+ * processing otherwise. The callback is invoked at the end of a block in which
+ * the proximity zone or the active change event differs from the last report.
  *
- * Handles the sensor data processing. This includes calibration if the sensor is not
- * yet calibrated, and normal data processing otherwise.
+ * Samples are read `stride` entries apart, which lets every instance walk its own
+ * channel of an interleaved scan buffer without de-interleaving it first.
  *
- * @param samples Pointer to the array of SAADC samples.
+ * @param p_sensor Pointer to the sensor instance.
+ * @param samples Pointer to the first sample of the instance.
+ * @param n Number of samples for the instance.
+ * @param stride Distance between two samples of the instance (1 for a single channel).
  */
-void sensor_process(nrf_saadc_value_t *samples);
+void sensor_process_block(sensor_instance_t *p_sensor, const int16_t *samples, size_t n, size_t stride);
+
+/**
+ * @brief Feed a die temperature reading to a sensor instance.
+ *
+ * Moves the baseline by the change the drift model predicts for the
+ * temperature change since the previous reading (also while an event holds
+ * the baseline tracking), then, if the channel is idle, adds the reading and
+ * the baseline to the model fit.
+ *
+ * @param p_sensor Pointer to the sensor instance.
+ * @param temperature The die temperature in 0.25 degC.
+ */
+void sensor_temperature_update(sensor_instance_t *p_sensor, int32_t temperature);
+
+/**
+ * @brief Mark a discontinuity in the sample stream of a sensor instance.
+ *
+ * The next DISCONTINUITY_SETTLE readings still run through the spike
+ * rejection and the mains notches so they settle on the new stream, but the
+ * detection, the baseline, the noise estimate and the references skip them.
+ *
+ * @param p_sensor Pointer to the sensor instance.
+ */
+void sensor_discontinuity(sensor_instance_t *p_sensor);
+
+/**
+ * @brief Get the SAADC limits that wake the sensor from a limit watch.
+ *
+ * The limits are centred on the baseline, WATCH_LIMIT_BAND(T) plus the
+ * detected mains hum amplitude away from it, on the SADC_SCALE_BITS scale.
+ *
+ * @param p_sensor Pointer to a calibrated sensor instance.
+ * @param p_low Pointer where the low limit is stored.
+ * @param p_high Pointer where the high limit is stored.
+ */
+void sensor_watch_limits(const sensor_instance_t *p_sensor, int16_t *p_low, int16_t *p_high);
 
 /**
  * @brief Get the current status of the sensor.
@@ -92,9 +248,10 @@ void sensor_process(nrf_saadc_value_t *samples);
  * Retrieves the current status of the sensor, indicating if it's OK, in error,
  * in calibration, or in other states.
  *
+ * @param p_sensor Pointer to the sensor instance.
  * @return sensor_status_t The current status of the sensor.
  */
-sensor_status_t get_sensor_status(void);
+sensor_status_t get_sensor_status(const sensor_instance_t *p_sensor);
 
 /**
  * @brief Get the current sensor data.
@@ -102,9 +259,10 @@ sensor_status_t get_sensor_status(void);
  * Retrieves the current sensor data, including sensor readings, stability status,
  * and other relevant metrics.
  *
+ * @param p_sensor Pointer to the sensor instance.
  * @return sensor_data_t The current sensor data.
  */
-sensor_data_t get_sensor_data(void);
+sensor_data_t get_sensor_data(const sensor_instance_t *p_sensor);
 
 /**
  * @brief Get the current sensor context.
@@ -112,9 +270,10 @@ sensor_data_t get_sensor_data(void);
  * Retrieves the current context of the sensor, including calibration status and
  * min/max values.
  *
+ * @param p_sensor Pointer to the sensor instance.
  * @return sensor_context_t The current sensor context.
  */
-sensor_context_t get_sensor_context(void) ;
+sensor_context_t get_sensor_context(const sensor_instance_t *p_sensor);
 
 /**
  * @brief Log the sensor data.
@@ -126,14 +285,6 @@ sensor_context_t get_sensor_context(void) ;
  */
 extern void log_sensor_data(const sensor_data_t* data);
 
-/**
- * @brief Check and update the stability status of the sensor.
- *
- * Evaluates the stability of the sensor readings and updates the status
- * accordingly. This can involve auto-calibration if the readings are stable.
- */
-extern void sensor_stability_check(void);
-
 
 #ifdef __cplusplus
 }
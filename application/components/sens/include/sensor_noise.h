@@ -0,0 +1,58 @@
+#ifndef SENSOR_NOISE_H
+#define SENSOR_NOISE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fraction bits of the mean and variance
+#define SENSOR_NOISE_Q16_SHIFT 16
+
+/**
+ * @brief Exponentially weighted mean and variance of the idle readings.
+ *
+ * Incremental (Welford style) update in fixed point: each reading moves the
+ * mean by 1/2^shift of its difference and the variance by the same fraction
+ * of its error, so the estimate follows the last ~2^shift readings without a
+ * window or a divide.
+ */
+typedef struct {
+    int32_t mean_q16;        // Mean reading in counts (Q16.16)
+    int64_t variance_q16;    // Variance in counts^2 (Q.16)
+    uint8_t shift;           // Smoothing shift, time constant of 2^shift readings
+} sensor_noise_t;
+
+/**
+ * @brief Initialize a noise estimator.
+ *
+ * @param p_noise Pointer to the estimator.
+ * @param mean Initial mean in counts.
+ * @param sigma_q8 Initial standard deviation in counts (Q8).
+ * @param shift Smoothing shift.
+ */
+void sensor_noise_init(sensor_noise_t *p_noise, int32_t mean, uint32_t sigma_q8, uint8_t shift);
+
+/**
+ * @brief Update the estimate with one reading.
+ *
+ * @param p_noise Pointer to the estimator.
+ * @param reading The reading in counts.
+ */
+void sensor_noise_update(sensor_noise_t *p_noise, int32_t reading);
+
+/**
+ * @brief Get the standard deviation.
+ *
+ * @param p_noise Pointer to the estimator.
+ * @return uint16_t The standard deviation in counts (Q8), saturated at UINT16_MAX.
+ */
+uint16_t sensor_noise_sigma_q8(const sensor_noise_t *p_noise);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_NOISE_H
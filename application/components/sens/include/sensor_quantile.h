@@ -0,0 +1,75 @@
+#ifndef SENSOR_QUANTILE_H
+#define SENSOR_QUANTILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Markers of the P-square estimator
+#define SENSOR_QUANTILE_MARKERS 5
+
+// Fixed-point formats: heights in Q16.16 counts, positions in Q16.16 samples
+#define SENSOR_QUANTILE_HEIGHT_SHIFT 16
+#define SENSOR_QUANTILE_POSITION_SHIFT 16
+#define SENSOR_QUANTILE_MAX_HORIZON 8191  // Keeps the interpolation products within an int64_t
+
+/**
+ * @brief P-square streaming quantile estimator.
+ *
+ * Tracks one quantile of a stream with five markers (minimum, p/2, p,
+ * (1+p)/2, maximum) whose heights are adjusted by piecewise-parabolic
+ * interpolation, so memory is fixed and each sample costs a bounded number of
+ * operations. Marker positions are halved whenever the stream reaches the
+ * horizon, which ages old samples out and lets the estimate follow a
+ * slowly changing distribution. The arithmetic is integer only.
+ */
+typedef struct {
+    int32_t heights[SENSOR_QUANTILE_MARKERS];    // Marker heights, the quantile estimates (Q16.16)
+    int32_t positions[SENSOR_QUANTILE_MARKERS];  // Actual marker positions (Q16.16)
+    int32_t desired[SENSOR_QUANTILE_MARKERS];    // Desired marker positions (Q16.16)
+    int32_t increments[SENSOR_QUANTILE_MARKERS]; // Desired position increments per sample (Q16.16)
+    int32_t horizon;                             // Position of the last marker that triggers the aging (Q16.16)
+    uint8_t count;                               // Samples stored while priming (up to 5)
+} sensor_quantile_t;
+
+/**
+ * @brief Initialize a quantile estimator.
+ *
+ * @param p_quantile Pointer to the estimator.
+ * @param quantile_q15 The tracked quantile, a Q1.15 fraction between 0 and 1.
+ * @param horizon Number of samples after which the marker positions are halved (16 to SENSOR_QUANTILE_MAX_HORIZON).
+ */
+void sensor_quantile_init(sensor_quantile_t *p_quantile, int32_t quantile_q15, uint32_t horizon);
+
+/**
+ * @brief Add one sample.
+ *
+ * @param p_quantile Pointer to the estimator.
+ * @param value The sample, saturated to the int16_t range.
+ */
+void sensor_quantile_update(sensor_quantile_t *p_quantile, int32_t value);
+
+/**
+ * @brief Check whether the estimator has seen enough samples to give an estimate.
+ *
+ * @param p_quantile Pointer to the estimator.
+ * @return bool True once the five markers are initialized.
+ */
+bool sensor_quantile_is_ready(const sensor_quantile_t *p_quantile);
+
+/**
+ * @brief Get the quantile estimate.
+ *
+ * @param p_quantile Pointer to the estimator.
+ * @return int32_t The estimate rounded to the nearest count, valid once the estimator is ready.
+ */
+int32_t sensor_quantile_get(const sensor_quantile_t *p_quantile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_QUANTILE_H
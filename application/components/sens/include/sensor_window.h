@@ -0,0 +1,104 @@
+#ifndef SENSOR_WINDOW_H
+#define SENSOR_WINDOW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor_config.h"
+
+/**
+ * @brief Monotonic deque holding ring slot indices of min/max candidates.
+ */
+typedef struct {
+    uint16_t slots[SENSOR_WINDOW_SIZE];     // Ring slot indices, oldest first
+    uint16_t head;                          // Position of the oldest candidate
+    uint16_t count;                         // Number of candidates stored
+} sensor_window_deque_t;
+
+/**
+ * @brief Sliding window of sensor readings with constant time statistics.
+ *
+ * Keeps a running sum and two monotonic deques so that the total, minimum and
+ * maximum of the last SENSOR_WINDOW_SIZE readings are available without walking
+ * the window. The length is fixed at compile time (sensor_config.h), so ring
+ * wraps and the average use masks and shifts for power-of-two lengths and a
+ * precomputed reciprocal otherwise.
+ */
+typedef struct {
+    int32_t values[SENSOR_WINDOW_SIZE];     // Circular buffer of readings
+    uint16_t count;                         // Number of readings stored so far
+    uint16_t position;                      // Slot written by the next push
+    int32_t total;                          // Running sum of the stored readings
+    sensor_window_deque_t min_deque;        // Increasing values, front is the minimum
+    sensor_window_deque_t max_deque;        // Decreasing values, front is the maximum
+} sensor_window_t;
+
+/**
+ * @brief Initialize a sliding window.
+ *
+ * @param p_window Pointer to the window to initialize.
+ */
+void sensor_window_init(sensor_window_t *p_window);
+
+/**
+ * @brief Push a reading into the window.
+ *
+ * Evicts the oldest reading once the window is full. Runs in amortized
+ * constant time regardless of the window length.
+ *
+ * @param p_window Pointer to the window.
+ * @param value The reading to store.
+ */
+void sensor_window_push(sensor_window_t *p_window, int32_t value);
+
+/**
+ * @brief Check whether the window holds SENSOR_WINDOW_SIZE readings.
+ *
+ * @param p_window Pointer to the window.
+ * @return bool True if the window is full.
+ */
+bool sensor_window_is_full(const sensor_window_t *p_window);
+
+/**
+ * @brief Get the sum of the readings in the window.
+ *
+ * @param p_window Pointer to the window.
+ * @return int32_t The running total.
+ */
+int32_t sensor_window_total(const sensor_window_t *p_window);
+
+/**
+ * @brief Get the average of the window.
+ *
+ * The total is divided by the window length, truncating toward zero like a
+ * full-window walk, without a hardware divide.
+ *
+ * @param p_window Pointer to the window.
+ * @return int32_t The integer average.
+ */
+int32_t sensor_window_average(const sensor_window_t *p_window);
+
+/**
+ * @brief Get the minimum reading in the window.
+ *
+ * @param p_window Pointer to the window.
+ * @return int32_t The minimum reading, or UINT16_MAX if the window is empty.
+ */
+int32_t sensor_window_min(const sensor_window_t *p_window);
+
+/**
+ * @brief Get the maximum reading in the window.
+ *
+ * @param p_window Pointer to the window.
+ * @return int32_t The maximum reading, or 0 if the window is empty.
+ */
+int32_t sensor_window_max(const sensor_window_t *p_window);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_WINDOW_H
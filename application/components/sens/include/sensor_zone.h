@@ -0,0 +1,88 @@
+#ifndef SENSOR_ZONE_H
+#define SENSOR_ZONE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Proximity zones, nearest last.
+ *
+ * Same order as sensor_feedback_t in led_driver.h, which the application maps
+ * them onto.
+ */
+typedef enum {
+    SENSOR_ZONE_IDLE = 0,    // Nothing near the electrode
+    SENSOR_ZONE_OUTER,       // Outer proximity
+    SENSOR_ZONE_INNER,       // Inner proximity
+    SENSOR_ZONE_TOUCH,       // Touch
+    SENSOR_ZONE_COUNT
+} sensor_zone_id_t;
+
+/**
+ * @brief Thresholds of one zone.
+ */
+typedef struct {
+    int32_t enter;           // Deviation (counts) needed to enter the zone from below
+    int32_t exit;            // Deviation (counts) below which the zone is left (enter - hysteresis)
+    uint16_t dwell;          // Consecutive samples the zone must be indicated before it is reported
+} sensor_zone_level_t;
+
+/**
+ * @brief Zone classifier with per-zone hysteresis and minimum dwell time.
+ *
+ * Maps the magnitude of the deviation from the baseline onto a zone. A zone
+ * is entered once the deviation reaches its enter threshold and kept until the
+ * deviation drops below its exit threshold. A new zone is only reported after
+ * it has been indicated for its dwell time in consecutive samples, so noise
+ * around a threshold does not produce a burst of transitions.
+ */
+typedef struct {
+    sensor_zone_level_t levels[SENSOR_ZONE_COUNT]; // Thresholds, levels[0] only uses dwell (time to return to idle)
+    sensor_zone_id_t zone;       // Reported zone
+    sensor_zone_id_t candidate;  // Zone indicated by the recent samples
+    uint16_t candidate_count;    // Consecutive samples indicating the candidate
+} sensor_zone_t;
+
+/**
+ * @brief Initialize a zone classifier.
+ *
+ * @param p_zone Pointer to the classifier.
+ * @param p_levels Thresholds of the SENSOR_ZONE_COUNT zones, enter thresholds increasing.
+ */
+void sensor_zone_init(sensor_zone_t *p_zone, const sensor_zone_level_t *p_levels);
+
+/**
+ * @brief Change the thresholds of one zone.
+ *
+ * @param p_zone Pointer to the classifier.
+ * @param zone The zone to change.
+ * @param p_level The new thresholds, keeping the enter thresholds increasing.
+ */
+void sensor_zone_set_level(sensor_zone_t *p_zone, sensor_zone_id_t zone, const sensor_zone_level_t *p_level);
+
+/**
+ * @brief Classify one sample.
+ *
+ * @param p_zone Pointer to the classifier.
+ * @param deviation The reading minus the baseline, in counts (either sign).
+ * @return bool True if the reported zone changed on this sample.
+ */
+bool sensor_zone_update(sensor_zone_t *p_zone, int32_t deviation);
+
+/**
+ * @brief Get the reported zone.
+ *
+ * @param p_zone Pointer to the classifier.
+ * @return sensor_zone_id_t The zone.
+ */
+sensor_zone_id_t sensor_zone_get(const sensor_zone_t *p_zone);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_ZONE_H
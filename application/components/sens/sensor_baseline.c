@@ -0,0 +1,168 @@
+/**
+ * @file sensor_baseline.c
+ * @brief Incremental baseline (drift) tracker for the sensor readings.
+ * 
+ * This module keeps the idle level of a sensing channel current with a slow
+ * exponential moving average in Q16.16 fixed point, updated on every sample.
+ * The average freezes while a touch or proximity event pulls the reading away
+ * from the baseline, so the event itself is never absorbed into the reference.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "sensor_baseline.h"
+
+/*
+ * Prototypes for internal functions:
+ */
+static int32_t reading_to_q16(int32_t reading);
+
+/**
+ * @brief Initialize a baseline tracker.
+ *
+ * Seeds the baseline with a known idle reading, typically the calibration
+ * average, clamped to the 15-bit range of the Q16.16 baseline.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @param initial Initial baseline in ADC counts.
+ * @param shift Smoothing shift, the average moves by 1/2^shift of the error per sample.
+ * @param freeze_band Deviation in ADC counts above which an event is considered active.
+ * @param freeze_limit Number of consecutive frozen samples after which the baseline is re-seeded.
+ */
+void sensor_baseline_init(sensor_baseline_t *p_baseline, int32_t initial, uint8_t shift,
+                          int32_t freeze_band, uint32_t freeze_limit)
+{
+    p_baseline->baseline_q16 = reading_to_q16(initial);
+    p_baseline->shift        = shift;
+    p_baseline->freeze_band  = freeze_band;
+    p_baseline->freeze_limit = freeze_limit;
+    p_baseline->frozen_count = 0;
+}
+
+/**
+ * @brief Change the deviation that freezes the tracking.
+ *
+ * Takes effect on the next reading; the baseline itself is kept.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @param freeze_band Deviation in ADC counts above which an event is considered active.
+ */
+void sensor_baseline_set_freeze_band(sensor_baseline_t *p_baseline, int32_t freeze_band)
+{
+    p_baseline->freeze_band = freeze_band;
+}
+
+/**
+ * @brief Update the baseline with one reading.
+ *
+ * While the reading stays within `freeze_band` of the baseline, the average
+ * moves toward it by one 2^shift-th of the error, a single subtract, shift and
+ * add. Outside the band the baseline holds. A reading that stays outside the
+ * band for `freeze_limit` samples is treated as the new idle level (e.g. an
+ * object left on the electrode) and the baseline is re-seeded to it. Readings
+ * are clamped to the 15-bit range of the Q16.16 baseline, and the error is
+ * taken on 64 bits so no reading can overflow it.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @param reading The reading in ADC counts.
+ * @return bool True if the baseline tracked the reading, false if it is frozen.
+ */
+bool sensor_baseline_update(sensor_baseline_t *p_baseline, int32_t reading)
+{
+    int32_t reading_q16 = reading_to_q16(reading);
+    int64_t error_q16 = (int64_t)reading_q16 - p_baseline->baseline_q16;
+    int64_t band_q16 = (int64_t)p_baseline->freeze_band * (1 << SENSOR_BASELINE_Q16_SHIFT);
+
+    if (error_q16 > band_q16 || error_q16 < -band_q16) {
+        // Event active: hold the reference, unless the event never ends
+        if (++p_baseline->frozen_count < p_baseline->freeze_limit) {
+            return false;
+        }
+        p_baseline->baseline_q16 = reading_q16;
+        p_baseline->frozen_count = 0;
+        return true;
+    }
+
+    // Within the band, so the step fits 32 bits
+    p_baseline->baseline_q16 += (int32_t)(error_q16 >> p_baseline->shift);
+    p_baseline->frozen_count = 0;
+    return true;
+}
+
+/**
+ * @brief Move the baseline by a predicted change.
+ *
+ * Used for feed-forward corrections (e.g. temperature drift); applies whether
+ * or not the tracking is frozen, so the reference stays right during long
+ * events.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @param change_q16 The change in ADC counts (Q16.16).
+ */
+void sensor_baseline_shift(sensor_baseline_t *p_baseline, int32_t change_q16)
+{
+    p_baseline->baseline_q16 += change_q16;
+}
+
+/**
+ * @brief Get the baseline in ADC counts.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @return int32_t The baseline, rounded to the nearest count.
+ */
+int32_t sensor_baseline_get(const sensor_baseline_t *p_baseline)
+{
+    return (p_baseline->baseline_q16 + (1 << (SENSOR_BASELINE_Q16_SHIFT - 1))) >> SENSOR_BASELINE_Q16_SHIFT;
+}
+
+/**
+ * @brief Check whether the baseline is frozen by an active event.
+ *
+ * @param p_baseline Pointer to the tracker.
+ * @return bool True if the last reading was outside the freeze band.
+ */
+bool sensor_baseline_is_frozen(const sensor_baseline_t *p_baseline)
+{
+    return p_baseline->frozen_count > 0;
+}
+
+/**
+ * @brief Convert a reading to Q16.16, clamped to the 15-bit range.
+ *
+ * @param reading The reading in ADC counts.
+ * @return int32_t The reading in Q16.16.
+ */
+static int32_t reading_to_q16(int32_t reading)
+{
+    if (reading > SENSOR_BASELINE_MAX_READING) {
+        reading = SENSOR_BASELINE_MAX_READING;
+    } else if (reading < -SENSOR_BASELINE_MAX_READING) {
+        reading = -SENSOR_BASELINE_MAX_READING;
+    }
+    return reading * (1 << SENSOR_BASELINE_Q16_SHIFT);
+}
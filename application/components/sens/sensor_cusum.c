@@ -0,0 +1,178 @@
+/**
+ * @file sensor_cusum.c
+ * @brief Sequential change-point detector for touch onset and release.
+ * 
+ * This module decides when a touch or proximity event starts and ends with a
+ * two-sided cumulative sum (CUSUM) test on the deviation of each sample from
+ * the tracked baseline. It runs incrementally, one sample at a time, and
+ * reports onset and release events with the index of the deciding sample and
+ * the estimated change point.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "sensor_cusum.h"
+
+/*
+ * Prototypes for internal functions:
+ */ 
+static int32_t cusum_step(int32_t sum, int32_t increment, uint32_t index, uint32_t *p_start);
+static void cusum_emit(sensor_cusum_t *p_cusum, sensor_cusum_event_t *p_event,
+                       sensor_cusum_event_type_t type, int8_t direction, uint32_t change_index);
+
+/**
+ * @brief Initialize a CUSUM detector.
+ *
+ * @param p_cusum Pointer to the detector.
+ * @param drift Drift allowance in counts, typically half the smallest shift of interest.
+ * @param decision Decision interval in counts, trading detection delay for false alarms.
+ */
+void sensor_cusum_init(sensor_cusum_t *p_cusum, int32_t drift, int32_t decision)
+{
+    p_cusum->drift         = drift;
+    p_cusum->decision      = decision;
+    p_cusum->sum_up        = 0;
+    p_cusum->sum_down      = 0;
+    p_cusum->sum_release   = 0;
+    p_cusum->start_up      = 0;
+    p_cusum->start_down    = 0;
+    p_cusum->start_release = 0;
+    p_cusum->sample_index  = 0;
+    p_cusum->state         = 0;
+}
+
+/**
+ * @brief Retune the detector.
+ *
+ * The running statistics and the active event are kept, so retuning never
+ * emits or loses an event by itself.
+ *
+ * @param p_cusum Pointer to the detector.
+ * @param drift Drift allowance in counts.
+ * @param decision Decision interval in counts.
+ */
+void sensor_cusum_set_parameters(sensor_cusum_t *p_cusum, int32_t drift, int32_t decision)
+{
+    p_cusum->drift    = drift;
+    p_cusum->decision = decision;
+}
+
+/**
+ * @brief Feed one deviation from the baseline into the detector.
+ *
+ * Idle: S+ = max(0, S+ + x - k) and S- = max(0, S- - x - k); an onset is
+ * declared when either exceeds h. Active: R = max(0, R + k - |x|) with |x|
+ * taken in the event direction; the release is declared when R exceeds h.
+ * The change index is the sample after the statistic last left zero.
+ *
+ * @param p_cusum Pointer to the detector.
+ * @param deviation The reading minus the baseline, in counts.
+ * @param p_event Filled with the event when one is emitted.
+ * @return bool True if an onset or release was emitted on this sample.
+ */
+bool sensor_cusum_update(sensor_cusum_t *p_cusum, int32_t deviation, sensor_cusum_event_t *p_event)
+{
+    uint32_t index = p_cusum->sample_index++;
+
+    if (p_cusum->state == 0) {
+        p_cusum->sum_up   = cusum_step(p_cusum->sum_up, deviation - p_cusum->drift, index, &p_cusum->start_up);
+        p_cusum->sum_down = cusum_step(p_cusum->sum_down, -deviation - p_cusum->drift, index, &p_cusum->start_down);
+
+        if (p_cusum->sum_up > p_cusum->decision || p_cusum->sum_down > p_cusum->decision) {
+            // Both can only cross together on a huge step; follow the larger excursion
+            int8_t direction = (p_cusum->sum_up >= p_cusum->sum_down) ? 1 : -1;
+            cusum_emit(p_cusum, p_event, SENSOR_CUSUM_ONSET, direction,
+                       (direction > 0) ? p_cusum->start_up : p_cusum->start_down);
+            return true;
+        }
+        return false;
+    }
+
+    p_cusum->sum_release = cusum_step(p_cusum->sum_release, p_cusum->drift - p_cusum->state * deviation,
+                                      index, &p_cusum->start_release);
+    if (p_cusum->sum_release > p_cusum->decision) {
+        cusum_emit(p_cusum, p_event, SENSOR_CUSUM_RELEASE, p_cusum->state, p_cusum->start_release);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Get the active event.
+ *
+ * @param p_cusum Pointer to the detector.
+ * @return int8_t +1 while the reading is above the baseline, -1 while below it, 0 otherwise.
+ */
+int8_t sensor_cusum_state(const sensor_cusum_t *p_cusum)
+{
+    return p_cusum->state;
+}
+
+/**
+ * @brief Advance one CUSUM statistic, clamped at zero.
+ *
+ * @param sum The current statistic.
+ * @param increment The increment of this sample.
+ * @param index Index of this sample.
+ * @param p_start Updated with the index of the first sample of a new accumulation.
+ * @return int32_t The new statistic.
+ */
+static int32_t cusum_step(int32_t sum, int32_t increment, uint32_t index, uint32_t *p_start)
+{
+    if (sum == 0) {
+        *p_start = index;
+    }
+    sum += increment;
+    return (sum > 0) ? sum : 0;
+}
+
+/**
+ * @brief Emit an event and switch the detector to the matching state.
+ *
+ * All statistics restart from zero so that the next decision only depends on
+ * samples taken after this one.
+ *
+ * @param p_cusum Pointer to the detector.
+ * @param p_event Event to fill.
+ * @param type Onset or release.
+ * @param direction Direction of the event.
+ * @param change_index Estimated first sample of the change.
+ */
+static void cusum_emit(sensor_cusum_t *p_cusum, sensor_cusum_event_t *p_event,
+                       sensor_cusum_event_type_t type, int8_t direction, uint32_t change_index)
+{
+    p_event->type         = type;
+    p_event->direction    = direction;
+    p_event->sample_index = p_cusum->sample_index - 1;
+    p_event->change_index = change_index;
+
+    p_cusum->state       = (type == SENSOR_CUSUM_ONSET) ? direction : 0;
+    p_cusum->sum_up      = 0;
+    p_cusum->sum_down    = 0;
+    p_cusum->sum_release = 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file sensor_drift.c
+ * @brief Temperature drift model for the sensor baseline.
+ * 
+ * This module models the baseline of a sensing channel as a linear function of
+ * the die temperature, fitted online by least squares with exponential
+ * forgetting. The driver uses the fitted slope to move the baseline as soon
+ * as the temperature changes, including while an event holds the baseline
+ * tracking, instead of waiting for the slow average or a recalibration.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "sensor_drift.h"
+
+#define DRIFT_ONE ((int32_t)1 << SENSOR_DRIFT_Q16_SHIFT) // 1.0 in Q16.16
+
+/*
+ * Prototypes for internal functions:
+ */ 
+static int64_t forget_apply(int64_t value, int32_t forget_q15);
+
+/**
+ * @brief Initialize a drift model.
+ *
+ * @param p_drift Pointer to the model.
+ * @param forget_q15 Forgetting factor per point in Q1.15, e.g. SENSOR_Q15(0.999) for a memory of about 1000 points.
+ * @param min_variance Temperature variance (units^2) needed before the fitted slope is trusted.
+ * @param max_slope Largest slope magnitude accepted, in counts per temperature unit.
+ */
+void sensor_drift_init(sensor_drift_t *p_drift, int32_t forget_q15, int32_t min_variance, int32_t max_slope)
+{
+    p_drift->forget_q15           = forget_q15;
+    p_drift->weight_q16           = 0;
+    p_drift->mean_temperature_q16 = 0;
+    p_drift->mean_baseline_q16    = 0;
+    p_drift->cov_tt_q16           = 0;
+    p_drift->cov_tb_q16           = 0;
+    p_drift->min_variance         = min_variance;
+    p_drift->max_slope            = max_slope;
+    p_drift->last_temperature     = 0;
+    p_drift->has_temperature      = false;
+}
+
+/**
+ * @brief Process a temperature reading.
+ *
+ * @param p_drift Pointer to the model.
+ * @param temperature The temperature reading.
+ * @return int32_t The predicted baseline change in counts (Q16.16).
+ */
+int32_t sensor_drift_predict(sensor_drift_t *p_drift, int32_t temperature)
+{
+    int64_t change = 0;
+
+    if (p_drift->has_temperature) {
+        change = (int64_t)sensor_drift_slope(p_drift) * (temperature - p_drift->last_temperature);
+        if (change > INT32_MAX) {
+            change = INT32_MAX;
+        } else if (change < -INT32_MAX) {
+            change = -INT32_MAX;
+        }
+    }
+    p_drift->last_temperature = temperature;
+    p_drift->has_temperature  = true;
+    return (int32_t)change;
+}
+
+/**
+ * @brief Add a (temperature, baseline) point to the fit.
+ *
+ * Weighted Welford update: with w' = forget * w + 1, the means move by 1/w'
+ * of the differences and the co-moments decay by `forget` before adding the
+ * new point's contribution.
+ *
+ * @param p_drift Pointer to the model.
+ * @param temperature The temperature reading.
+ * @param baseline The idle baseline at that temperature, in counts.
+ */
+void sensor_drift_fit(sensor_drift_t *p_drift, int32_t temperature, int32_t baseline)
+{
+    int64_t t = (int64_t)temperature * DRIFT_ONE;
+    int64_t b = (int64_t)baseline * DRIFT_ONE;
+
+    p_drift->weight_q16 = (int32_t)forget_apply(p_drift->weight_q16, p_drift->forget_q15) + DRIFT_ONE;
+    int64_t dt = t - p_drift->mean_temperature_q16;
+    int64_t db = b - p_drift->mean_baseline_q16;
+    p_drift->mean_temperature_q16 += (int32_t)(dt * DRIFT_ONE / p_drift->weight_q16);
+    p_drift->mean_baseline_q16    += (int32_t)(db * DRIFT_ONE / p_drift->weight_q16);
+    p_drift->cov_tt_q16 = forget_apply(p_drift->cov_tt_q16, p_drift->forget_q15) +
+                          ((dt * (t - p_drift->mean_temperature_q16)) >> SENSOR_DRIFT_Q16_SHIFT);
+    p_drift->cov_tb_q16 = forget_apply(p_drift->cov_tb_q16, p_drift->forget_q15) +
+                          ((dt * (b - p_drift->mean_baseline_q16)) >> SENSOR_DRIFT_Q16_SHIFT);
+}
+
+/**
+ * @brief Get the fitted slope.
+ *
+ * The slope is only used once the temperature has spread enough for the fit
+ * to be meaningful, and is clamped to `max_slope` so a poor fit can never
+ * push the baseline far. The clamp is decided on the co-moments, before the
+ * division, and the quotient is formed in two steps so the shifted remainder
+ * stays within 64 bits.
+ *
+ * @param p_drift Pointer to the model.
+ * @return int32_t Counts per temperature unit (Q16.16), 0 until the temperature has varied enough.
+ */
+int32_t sensor_drift_slope(const sensor_drift_t *p_drift)
+{
+    int64_t cov_tt = p_drift->cov_tt_q16;
+    int64_t cov_tb = p_drift->cov_tb_q16;
+
+    if (p_drift->weight_q16 <= DRIFT_ONE || cov_tt <= 0 ||
+        cov_tt < (int64_t)p_drift->min_variance * p_drift->weight_q16) {
+        return 0;
+    }
+
+    int64_t limit = (int64_t)p_drift->max_slope * cov_tt;
+    if (cov_tb >= limit) {
+        return p_drift->max_slope * DRIFT_ONE;
+    } else if (cov_tb <= -limit) {
+        return -p_drift->max_slope * DRIFT_ONE;
+    }
+    int64_t quotient = cov_tb / cov_tt;
+    int64_t remainder = cov_tb % cov_tt;
+    return (int32_t)(quotient * DRIFT_ONE + remainder * DRIFT_ONE / cov_tt);
+}
+
+/**
+ * @brief Scale a Q16.16 quantity by the forgetting factor.
+ *
+ * Subtracts value * (1 - forget), which keeps the product small even for
+ * large co-moments.
+ *
+ * @param value The quantity to decay.
+ * @param forget_q15 The forgetting factor (Q1.15).
+ * @return int64_t The decayed quantity.
+ */
+static int64_t forget_apply(int64_t value, int32_t forget_q15)
+{
+    return value - ((value * ((1 << SENSOR_DRIFT_FORGET_SHIFT) - forget_q15)) >> SENSOR_DRIFT_FORGET_SHIFT);
+}
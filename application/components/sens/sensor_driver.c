@@ -38,120 +38,260 @@
 #include <stdio.h>
 #include <string.h>
 
-#include "boards.h"
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
 #include "app_error.h"
 
 #include "sensor_driver.h"
+#include "sensor_window.h"
+#include "sadc_driver.h"
+
+// Rate of the decimated stream handed to the sensor instances
+#define SENSOR_SAMPLE_RATE_HZ (SAADC_SAMPLE_FREQUENCY / SENSOR_DECIMATION_RATIO)
+
+// Readings between two data rows logged while the state is steady
+#define SENSOR_LOG_PERIOD_SAMPLES (((uint32_t)SENSOR_SAMPLE_RATE_HZ * SENSOR_LOG_PERIOD_MS) / 1000)
+
+// Volts per full-scale reading in Q16.16, derived from the SAADC gain and reference
+#define SENSOR_FULL_SCALE_Q16 ((((int64_t)SADC_FULL_SCALE_MV << SENSOR_Q16_SHIFT) + 500) / 1000)
 
 /*
  * Global variables:
  */ 
 static bool debug = true;  // Flag to enable or disable debug logging
-static int sensor_readings[SENS_BUFFER_SIZE] = {0}; // Circular buffer to store sensor readings
-static sensor_status_t sensor_status; // Object holding the status of the sensor
-static sensor_callback_t sensor_callback_ref = NULL; // Callback function to handle sensor reading events:
-static sensor_data_t sensor_data; // Object holding the sensor readings and stability data
-static sensor_context_t sensor_ctx; // Object holding the sensor driver context data
+
+// Zone thresholds, indexed by sensor_zone_id_t
+static const sensor_zone_level_t zone_levels[SENSOR_ZONE_COUNT] = {
+    [SENSOR_ZONE_IDLE]  = { 0, 0, ZONE_IDLE_DWELL },
+    [SENSOR_ZONE_OUTER] = { ZONE_OUTER_ENTER(STABILITY_THRESHOLD),
+                            ZONE_OUTER_ENTER(STABILITY_THRESHOLD) - ZONE_OUTER_HYSTERESIS(STABILITY_THRESHOLD), ZONE_OUTER_DWELL },
+    [SENSOR_ZONE_INNER] = { ZONE_INNER_ENTER, ZONE_INNER_ENTER - ZONE_INNER_HYSTERESIS, ZONE_INNER_DWELL },
+    [SENSOR_ZONE_TOUCH] = { ZONE_TOUCH_ENTER, ZONE_TOUCH_ENTER - ZONE_TOUCH_HYSTERESIS, ZONE_TOUCH_DWELL },
+};
 
 /*
  * Prototypes for internal functions:
  */ 
-static void calibration_process(nrf_saadc_value_t *samples);
-static void operation_process(nrf_saadc_value_t *samples);
-static sensor_status_t process_results(nrf_saadc_value_t *samples);
-static void sensor_initialization();
-static void auto_calibrate(int sensor_value, int average, int min_reading, int max_reading);
-static float convert_to_voltage(uint16_t adc_value);
+static size_t calibration_process(sensor_instance_t *p_sensor, const int16_t *samples, size_t n, size_t stride);
+static void operation_process(sensor_instance_t *p_sensor, const int16_t *samples, size_t n, size_t stride);
+static sensor_status_t process_results(sensor_instance_t *p_sensor, const int16_t *samples, size_t n, size_t stride);
+static void sensor_initialization(sensor_instance_t *p_sensor, uint8_t channel);
+static uint16_t sensor_input(sensor_instance_t *p_sensor, int16_t sample);
+static int32_t convert_to_voltage(uint16_t adc_value);
+static int32_t apply_margin(int32_t value, int32_t fraction_q15);
+static void apply_noise_threshold(sensor_instance_t *p_sensor);
 
 /**
  * @brief Initialize the sensor.
  *
- * Initializes the sensor driver and stores the provided callback function.
- * This function must be called before performing any sensor operations.
+ * Initializes a sensor instance and stores the provided callback function.
+ * This function must be called before performing any operations on the instance.
  *
+ * @param p_sensor Pointer to the sensor instance (storage owned by the caller).
+ * @param channel SAADC scan channel feeding the instance.
  * @param callback The callback function to be called on sensor event.
  */
-void sensor_init(sensor_callback_t callback) 
+void sensor_init(sensor_instance_t *p_sensor, uint8_t channel, sensor_callback_t callback) 
 {
     // Store the function callback reference
-    sensor_callback_ref = callback;
+    p_sensor->callback = callback;
     // Perform sensor initialization
-    sensor_initialization();
+    sensor_initialization(p_sensor, channel);
 }
 
 /**
- * @brief Process sensor data.
+ * @brief Process a single sensor sample.
  *
- * Processes sensor data based on the current state (calibration or operation).
- * Calls the appropriate processing function for the current state.
+ * Convenience wrapper running one sample through `sensor_process_block()`.
  *
- * @param samples Pointer to the buffer containing sensor samples.
+ * @param p_sensor Pointer to the sensor instance.
+ * @param samples Pointer to the sensor sample.
  */
-void sensor_process(nrf_saadc_value_t *samples) {
+void sensor_process(sensor_instance_t *p_sensor, int16_t *samples) {
 
-    if (sensor_ctx.is_calibrated) {
-        // Process sensor data in operational mode
-        operation_process(samples);
-    } else {
-        // Perform sensor calibration
-        calibration_process(samples);
+    sensor_process_block(p_sensor, samples, 1, 1);
+}
+
+/**
+ * @brief Process a block of sensor samples.
+ *
+ * Runs every sample of the block through calibration (until the sliding window
+ * is filled) and then through operational processing, in a single pass.
+ * The samples of the instance are read `stride` entries apart, so an
+ * interleaved multi-channel scan buffer is consumed in place.
+ *
+ * @param p_sensor Pointer to the sensor instance.
+ * @param samples Pointer to the first sample of the instance.
+ * @param n Number of samples for the instance.
+ * @param stride Distance between two consecutive samples (the scan channel count).
+ */
+void sensor_process_block(sensor_instance_t *p_sensor, const int16_t *samples, size_t n, size_t stride) {
+
+    if (p_sensor == NULL || samples == NULL || n == 0 || stride == 0) {
+        return;
+    }
+
+    if (!p_sensor->ctx.is_calibrated) {
+        // Perform sensor calibration with the leading samples of the block
+        size_t consumed = calibration_process(p_sensor, samples, n, stride);
+        samples += consumed * stride;
+        n -= consumed;
+    }
+
+    if (p_sensor->ctx.is_calibrated && n > 0) {
+        // Process the remaining sensor data in operational mode
+        operation_process(p_sensor, samples, n, stride);
+    }
+}
+
+/**
+ * @brief Feed a die temperature reading to a sensor instance.
+ *
+ * Moves the baseline by the change the drift model predicts for the
+ * temperature change since the previous reading (also while an event holds
+ * the baseline tracking), then, if the channel is idle, adds the reading and
+ * the baseline to the model fit.
+ *
+ * @param p_sensor Pointer to the sensor instance.
+ * @param temperature The die temperature in 0.25 degC.
+ */
+void sensor_temperature_update(sensor_instance_t *p_sensor, int32_t temperature)
+{
+    if (p_sensor == NULL) {
+        return;
+    }
+
+    int32_t change_q16 = sensor_drift_predict(&p_sensor->drift, temperature);
+    p_sensor->data.die_temperature = temperature;
+    if (!p_sensor->ctx.is_calibrated) {
+        return;
+    }
+
+    sensor_baseline_shift(&p_sensor->baseline, change_q16);
+    p_sensor->data.golden_reference = sensor_baseline_get(&p_sensor->baseline);
+
+    bool idle = !sensor_baseline_is_frozen(&p_sensor->baseline) &&
+                p_sensor->data.change_state == 0 && p_sensor->data.zone == SENSOR_ZONE_IDLE;
+    if (idle) {
+        sensor_drift_fit(&p_sensor->drift, temperature, p_sensor->data.golden_reference);
+    }
+}
+
+/**
+ * @brief Mark a discontinuity in the sample stream of a sensor instance.
+ *
+ * Before the initial calibration the readings are only averaged, so the
+ * discontinuity is ignored.
+ *
+ * @param p_sensor Pointer to the sensor instance.
+ */
+void sensor_discontinuity(sensor_instance_t *p_sensor)
+{
+    if (p_sensor->ctx.is_calibrated) {
+        p_sensor->ctx.settle_count = DISCONTINUITY_SETTLE;
     }
 }
 
+/**
+ * @brief Get the SAADC limits that wake the sensor from a limit watch.
+ *
+ * The limits are centred on the baseline, WATCH_LIMIT_BAND(T) plus the
+ * detected mains hum amplitude away from it, on the SADC_SCALE_BITS scale the
+ * decimated readings share. They are clamped to the int16_t range.
+ *
+ * @param p_sensor Pointer to a calibrated sensor instance.
+ * @param p_low Pointer where the low limit is stored.
+ * @param p_high Pointer where the high limit is stored.
+ */
+void sensor_watch_limits(const sensor_instance_t *p_sensor, int16_t *p_low, int16_t *p_high)
+{
+    int32_t band = WATCH_LIMIT_BAND(p_sensor->ctx.noise_threshold);
+#if SENSOR_MAINS_FILTER
+    band += mains_filter_amplitude(&p_sensor->mains_filter);
+#endif
+    int32_t low  = p_sensor->data.golden_reference - band;
+    int32_t high = p_sensor->data.golden_reference + band;
+
+    *p_low  = (int16_t)((low < INT16_MIN) ? INT16_MIN : low);
+    *p_high = (int16_t)((high > INT16_MAX) ? INT16_MAX : high);
+}
+
 /**
  * @brief Calibration process for sensor data.
  *
  * Performs initial calibration of the sensor using the provided samples.
- * Calculates the average, minimum, and maximum readings for calibration.
+ * Samples are collected into the sliding window, possibly across several
+ * blocks, and once SENS_BUFFER_SIZE samples are available the average,
+ * minimum, and maximum readings are used for calibration.
  *
+ * @param p_sensor Pointer to the sensor instance.
  * @param samples Pointer to the buffer containing sensor samples.
+ * @param n Number of samples in the buffer.
+ * @param stride Distance between two consecutive samples.
+ * @return size_t Number of samples consumed by the calibration.
  */
-static void calibration_process(nrf_saadc_value_t *samples)
+static size_t calibration_process(sensor_instance_t *p_sensor, const int16_t *samples, size_t n, size_t stride)
 {
-    int total = 0;
-    uint16_t min_reading = UINT16_MAX;
-    uint16_t max_reading = 0;
+    size_t consumed = 0;
 
-    NRF_LOG_INFO("Starting initial calibration...");
+    if (p_sensor->window.count == 0) {
+        NRF_LOG_INFO("Starting initial calibration...");
+    }
 
-    for(int i = 0; i < SENS_BUFFER_SIZE; i++)
+    while (consumed < n && !sensor_window_is_full(&p_sensor->window))
     {
-        // Cache the raw ADC value
-        uint16_t sensor_reading = (uint16_t)samples[i];
-        // Store the current reading in the buffer at the current buffer index
-        sensor_readings[i] = sensor_reading;
-
-        total += sensor_reading;
-        min_reading = (sensor_reading < min_reading) ? sensor_reading : min_reading;
-        max_reading = (sensor_reading > max_reading) ? sensor_reading : max_reading;       
+        // Cache the raw ADC value and store it in the sliding window
+        uint16_t sensor_reading = sensor_input(p_sensor, samples[consumed++ * stride]);
+        sensor_window_push(&p_sensor->window, sensor_reading);
+    }
 
+    if (!sensor_window_is_full(&p_sensor->window)) {
+        // Wait for more samples
+        return consumed;
     }
 
-    int average = total / SENS_BUFFER_SIZE;
+    int min_reading = sensor_window_min(&p_sensor->window);
+    int max_reading = sensor_window_max(&p_sensor->window);
+
+    int average = sensor_window_average(&p_sensor->window);
     // Sets the sensor's data initial averages values.
-    sensor_data.average_reading   = average;
-    sensor_data.previous_average  = average; 
-    sensor_data.sensor_reading    = average;
-    sensor_data.golden_reference  = FINE_STRUCTURE;
+    p_sensor->data.average_reading   = average;
+    p_sensor->data.previous_average  = average; 
+    p_sensor->data.sensor_reading    = average;
+    p_sensor->data.golden_reference  = average;
+    p_sensor->data.is_voltage_stable = true;
+
+    // Start tracking the drift and the noise from the calibrated idle level
+    sensor_baseline_init(&p_sensor->baseline, average, BASELINE_SHIFT,
+                         BASELINE_FREEZE_BAND(p_sensor->ctx.noise_threshold), BASELINE_FREEZE_LIMIT);
+    sensor_noise_init(&p_sensor->noise, average,
+                      ((uint32_t)p_sensor->ctx.noise_threshold << 8) / NOISE_K, NOISE_SHIFT);
     
-    // Set the reference boundaries with a margin of < 10% > for stability.
-    sensor_data.low_reference = min_reading - (INITIAL_MIN_THRESHOLD * average);
-    sensor_data.top_reference = max_reading + (INITIAL_MAX_THRESHOLD * average);
+    // Prime the percentile references with the calibration readings
+    sensor_quantile_init(&p_sensor->top_quantile, REFERENCE_TOP_QUANTILE, REFERENCE_HORIZON);
+    sensor_quantile_init(&p_sensor->low_quantile, REFERENCE_LOW_QUANTILE, REFERENCE_HORIZON);
+    for (int i = 0; i < SENSOR_WINDOW_SIZE; i++) {
+        sensor_quantile_update(&p_sensor->top_quantile, p_sensor->window.values[i]);
+        sensor_quantile_update(&p_sensor->low_quantile, p_sensor->window.values[i]);
+    }
+
+    // Until the first block, set the reference boundaries with a margin of < 10% > for stability.
+    p_sensor->data.low_reference = min_reading - apply_margin(average, INITIAL_MIN_THRESHOLD);
+    p_sensor->data.top_reference = max_reading + apply_margin(average, INITIAL_MAX_THRESHOLD);
 
-    // Move to the next position in the circular buffer
-    sensor_ctx.buffer_index = (sensor_ctx.buffer_index + 1) % SENS_BUFFER_SIZE;
+    // The window is full, the next reading replaces the oldest one
+    p_sensor->ctx.buffer_index = p_sensor->window.position;
 
-    sensor_ctx.current_min_value  = min_reading;
-    sensor_ctx.current_max_value  = max_reading;
-    sensor_ctx.sensor_voltage     = convert_to_voltage(average);
+    p_sensor->ctx.current_min_value  = min_reading;
+    p_sensor->ctx.current_max_value  = max_reading;
+    p_sensor->ctx.sensor_voltage_q16 = convert_to_voltage(average);
 
-    log_sensor_data(&sensor_data);
-    sensor_ctx.is_calibrated = true;
+    log_sensor_data(&p_sensor->data);
+    p_sensor->ctx.is_calibrated = true;
 
     NRF_LOG_INFO("The initial calibration is finished!");
 
+    return consumed;
 }
 
 /**
@@ -161,12 +301,15 @@ static void calibration_process(nrf_saadc_value_t *samples)
  * Calls `process_results` to handle the sensor data which evaluates 
  * the sensor readings and updates the sensor data accordingly.
  *
+ * @param p_sensor Pointer to the sensor instance.
  * @param samples Pointer to the array of ADC samples to process.
+ * @param n Number of samples in the array.
+ * @param stride Distance between two consecutive samples.
  */
-static void operation_process(nrf_saadc_value_t *samples)
+static void operation_process(sensor_instance_t *p_sensor, const int16_t *samples, size_t n, size_t stride)
 {
     // Process the ADC result
-    sensor_status_t status = process_results(samples);
+    sensor_status_t status = process_results(p_sensor, samples, n, stride);
 
     if(status == SENSOR_ERROR) {
         NRF_LOG_WARNING("Error processing the ADC results.");
@@ -178,65 +321,102 @@ static void operation_process(nrf_saadc_value_t *samples)
 /**
  * @brief Process and analyze the sensor results.
  *
- * Analyzes the ADC samples to update sensor readings and status. Checks for
- * calibration status and computes statistics like average, min, and max readings.
+ * Analyzes every ADC sample of the block to update the sliding window, the
+ * reference values and the baseline tracker, so the golden reference follows
+ * the drift continuously. The averaged results are published once per block, so
+ * the per-block overhead does not grow with the number of samples. The data row
+ * is logged and the callback runs only when the block changed the zone or the
+ * active event, so the log backend and the feedback (UART, LEDs) are idle while
+ * the state is steady (SENSOR_LOG_PERIOD_MS adds a periodic row).
  * Returns the status of the sensor based on the analysis.
  *
+ * @param p_sensor Pointer to the sensor instance.
  * @param samples Pointer to the array of ADC samples to analyze.
+ * @param n Number of samples in the array.
+ * @param stride Distance between two consecutive samples.
  * @return sensor_status_t The status of the sensor after processing the results.
  */
-static sensor_status_t process_results(nrf_saadc_value_t *samples) 
+static sensor_status_t process_results(sensor_instance_t *p_sensor, const int16_t *samples, size_t n, size_t stride) 
 {
     // Check if sensor context has been initialized
-    if (!sensor_ctx.is_calibrated) {
+    if (!p_sensor->ctx.is_calibrated) {
         return SENSOR_ERROR;
     }
 
-    // Initialize stats variables
-    int total = 0;
-    int min_value = UINT16_MAX;
-    int max_value = 0;
+    uint16_t sensor_reading = 0;
+    sensor_cusum_event_t event;
+    uint8_t reported_zone = p_sensor->data.zone;
+    int8_t reported_change = p_sensor->data.change_state;
 
-    // Cache the raw ADC value
-    uint16_t sensor_reading = (uint16_t)samples[0];
-    // Store the current reading in the buffer at the current buffer index
-    sensor_readings[sensor_ctx.buffer_index ] = sensor_reading;
-
-    // Compute buffer statistics: total, min, and max readings
-    for (int i = 0; i < SENS_BUFFER_SIZE; i++)
+    for (size_t i = 0; i < n; i++)
     {
-        total += sensor_readings[i];
-        if (sensor_readings[i] < min_value)
-            min_value = sensor_readings[i];
-        
-        if (sensor_readings[i] > max_value)
-            max_value = sensor_readings[i];
-    }
+        // Cache the ADC value, with spikes replaced by the running median
+        sensor_reading = sensor_input(p_sensor, samples[i * stride]);
+        // Push the current reading, evicting the oldest one from the window
+        sensor_window_push(&p_sensor->window, sensor_reading);
+        if (p_sensor->ctx.settle_count > 0) {
+            // The filters are still ringing from a discontinuity
+            p_sensor->ctx.settle_count--;
+            continue;
+        }
+        // Decide onset/release and the zone on the deviation from the baseline before it absorbs this reading
+        int32_t deviation = sensor_reading - sensor_baseline_get(&p_sensor->baseline);
+        if (sensor_zone_update(&p_sensor->zones, deviation)) {
+            p_sensor->data.zone = sensor_zone_get(&p_sensor->zones);
+        }
+        if (sensor_cusum_update(&p_sensor->detector, deviation, &event)) {
+            p_sensor->data.change_state = sensor_cusum_state(&p_sensor->detector);
+            p_sensor->data.change_index = event.change_index;
+            NRF_LOG_DEBUG("CH%d %s %s at sample %u (decided at %u)", p_sensor->data.channel,
+                          (event.type == SENSOR_CUSUM_ONSET) ? "onset" : "release",
+                          (event.direction > 0) ? "up" : "down",
+                          event.change_index, event.sample_index);
+        }
+        // Follow the drift of the idle level (held while an event is active), and
+        // its noise while nothing at all is going on
+        bool tracked = sensor_baseline_update(&p_sensor->baseline, sensor_reading);
+        if (tracked && p_sensor->data.change_state == 0 && p_sensor->data.zone == SENSOR_ZONE_IDLE) {
+            sensor_noise_update(&p_sensor->noise, sensor_reading);
+        }
 
-    // Calculate average sensor reading
-    int average = total / SENS_BUFFER_SIZE;
+        // Update the percentile references (a glitch only nudges them)
+        sensor_quantile_update(&p_sensor->top_quantile, sensor_reading);
+        sensor_quantile_update(&p_sensor->low_quantile, sensor_reading);
+    }
 
-    // Update min/max reference values
-    if(sensor_reading > sensor_data.top_reference) {
-        sensor_data.top_reference = sensor_reading;
+    // Update sensor data with the state at the end of the block
+    p_sensor->data.top_reference = sensor_quantile_get(&p_sensor->top_quantile);
+    p_sensor->data.low_reference = sensor_quantile_get(&p_sensor->low_quantile);
+    p_sensor->data.sensor_reading = sensor_reading;
+    p_sensor->data.previous_average = p_sensor->data.average_reading;
+    p_sensor->data.average_reading = sensor_window_average(&p_sensor->window);
+    p_sensor->data.golden_reference = sensor_baseline_get(&p_sensor->baseline);
+    p_sensor->data.is_voltage_stable = !sensor_baseline_is_frozen(&p_sensor->baseline);
+    p_sensor->data.noise_sigma_q8 = sensor_noise_sigma_q8(&p_sensor->noise);
+    apply_noise_threshold(p_sensor);
+
+    p_sensor->ctx.current_min_value = sensor_window_min(&p_sensor->window);
+    p_sensor->ctx.current_max_value = sensor_window_max(&p_sensor->window);
+    // Track the next position in the circular buffer
+    p_sensor->ctx.buffer_index = p_sensor->window.position;
+
+    // Log and provide feedback on state changes only, so a steady channel leaves the CPU and the log backend idle
+    bool changed = (p_sensor->data.zone != reported_zone || p_sensor->data.change_state != reported_change);
+    bool log_due = changed;
+#if SENSOR_LOG_PERIOD_MS
+    // Optional periodic row while the state is steady
+    p_sensor->ctx.log_elapsed += n;
+    log_due = log_due || (p_sensor->ctx.log_elapsed >= SENSOR_LOG_PERIOD_SAMPLES);
+#endif
+    if (log_due) {
+        p_sensor->ctx.log_elapsed = 0;
+        log_sensor_data(&p_sensor->data);
     }
-    if(sensor_reading < sensor_data.low_reference) {
-        sensor_data.low_reference = sensor_reading;
+    if (!changed) {
+        return SENSOR_PROCESSED;
     }
-    // Update sensor data
-    sensor_data.sensor_reading = sensor_reading;
-    sensor_data.average_reading = average;
-
-    sensor_ctx.current_min_value = min_value;
-    sensor_ctx.current_max_value = max_value;
-    // Move to the next position in the circular buffer
-    sensor_ctx.buffer_index = (sensor_ctx.buffer_index + 1) % SENS_BUFFER_SIZE;
-
-    log_sensor_data(&sensor_data);
-
-    // Provide feedback
-    if(sensor_callback_ref != NULL) {
-        sensor_callback_ref(&sensor_data);
+    if(p_sensor->callback != NULL) {
+        p_sensor->callback(&p_sensor->data);
     } else {
         return SENSOR_ERROR;
     }
@@ -244,81 +424,83 @@ static sensor_status_t process_results(nrf_saadc_value_t *samples)
 }
 
 /**
- * @brief Check and update voltage stability status.
+ * @brief Initializes sensor context and data to default values.
+ *
+ * Sets up the initial state for the sensor context and data, preparing the sensor
+ * for operation.
  *
- * Evaluates if the sensor's voltage is stable based on the current and historical readings.
- * Performs auto-calibration if stability conditions are met.
+ * @param p_sensor Pointer to the sensor instance.
+ * @param channel SAADC scan channel feeding the instance.
  */
-void sensor_stability_check()
-{
-    int sensor_value = sensor_data.sensor_reading;
-    int current_average = sensor_data.average_reading;
-    int previous_average = sensor_data.previous_average;
-    int current_min_voltage = sensor_ctx.current_min_value;
-    int current_max_voltage = sensor_ctx.current_max_value;
-
-    // Check if the sensor value exceeds a certain threshold.
-    if(sensor_value < sensor_data.low_reference) 
-    {
-        // TODO: Take appropriate action (e.g., turn on an LED, send a BLE notification, etc.)
-        sensor_data.is_voltage_stable = false;
-        return;
-
-    } else if (sensor_value > sensor_data.top_reference)    
-    {
-        // TODO: Take appropriate action (e.g., turn on an LED, send a BLE notification, etc.)
-        sensor_data.is_voltage_stable = false;
-        return;
-
-    } else if (abs(current_average - previous_average) <= STABILITY_THRESHOLD) 
-    {
-        sensor_data.previous_average = current_average;
-        sensor_data.is_voltage_stable = true;
-        //auto_calibrate(sensor_value, current_average, current_min_voltage, current_max_voltage);
-    } 
+static void sensor_initialization(sensor_instance_t *p_sensor, uint8_t channel) {
+    
+    p_sensor->data.channel             = channel;
+    p_sensor->data.sensor_reading      = 0;
+    p_sensor->data.previous_average    = 0;
+    p_sensor->data.average_reading     = 0;
+    p_sensor->data.is_voltage_stable   = false;
+    p_sensor->data.top_reference       = 0;
+    p_sensor->data.low_reference       = 0;
+    p_sensor->data.golden_reference    = FINE_STRUCTURE;
+    p_sensor->data.change_state        = 0;
+    p_sensor->data.change_index        = 0;
+    p_sensor->data.zone                = SENSOR_ZONE_IDLE;
+    p_sensor->data.noise_sigma_q8      = (STABILITY_THRESHOLD << 8) / NOISE_K;
+    p_sensor->data.die_temperature     = 0;
+
+    p_sensor->ctx.is_calibrated        = false;
+    p_sensor->ctx.buffer_index         = 0;
+    p_sensor->ctx.current_min_value    = 0; 
+    p_sensor->ctx.current_max_value    = 0; 
+    p_sensor->ctx.sensor_voltage_q16   = 0;
+    p_sensor->ctx.noise_threshold      = STABILITY_THRESHOLD;
+    p_sensor->ctx.settle_count         = 0;
+    p_sensor->ctx.log_elapsed          = 0;
+
+    sensor_window_init(&p_sensor->window);
+    sensor_baseline_init(&p_sensor->baseline, FINE_STRUCTURE, BASELINE_SHIFT,
+                         BASELINE_FREEZE_BAND(STABILITY_THRESHOLD), BASELINE_FREEZE_LIMIT);
+    sensor_cusum_init(&p_sensor->detector, CUSUM_DRIFT(STABILITY_THRESHOLD), CUSUM_DECISION(STABILITY_THRESHOLD));
+    sensor_zone_init(&p_sensor->zones, zone_levels);
+    sensor_noise_init(&p_sensor->noise, FINE_STRUCTURE, (STABILITY_THRESHOLD << 8) / NOISE_K, NOISE_SHIFT);
+    sensor_quantile_init(&p_sensor->top_quantile, REFERENCE_TOP_QUANTILE, REFERENCE_HORIZON);
+    sensor_quantile_init(&p_sensor->low_quantile, REFERENCE_LOW_QUANTILE, REFERENCE_HORIZON);
+    sensor_drift_init(&p_sensor->drift, DRIFT_FORGET, DRIFT_MIN_VARIANCE, DRIFT_MAX_SLOPE);
+#if SENSOR_OUTLIER_WINDOW
+    hampel_filter_init(&p_sensor->outlier_filter, SENSOR_OUTLIER_WINDOW, OUTLIER_THRESHOLD,
+                       OUTLIER_SCALE_SHIFT, OUTLIER_MIN_DEVIATION);
+#endif
+#if SENSOR_MAINS_FILTER
+    if (!mains_filter_init(&p_sensor->mains_filter, SENSOR_SAMPLE_RATE_HZ, MAINS_MIN_AMPLITUDE)) {
+        APP_ERROR_CHECK(NRF_ERROR_INVALID_PARAM);
+    }
+#endif
 }
 
 /**
- * @brief Automatically calibrate the sensor based on current readings.
+ * @brief Condition one raw sample before it reaches the statistics.
  *
- * Updates the sensor's reference values based on the current sensor readings
- * to maintain accuracy and stability.
+ * Runs the sample through the spike rejection stage when it is enabled
+ * (SENSOR_OUTLIER_WINDOW), so isolated ESD or EMI spikes neither widen the
+ * top/low references nor move the window statistics, then through the mains
+ * notch cascade (SENSOR_MAINS_FILTER) so hum does not show up as a swing
+ * between the references. Spikes are removed first so they cannot ring
+ * through the notches. The readings are unsigned: a sample the filters (or
+ * the SAADC offset) leave below zero is saturated to 0 rather than wrapped.
  *
- * @param sensor_value Current sensor value.
- * @param average Current average reading.
- * @param min_reading Minimum reading in the current set.
- * @param max_reading Maximum reading in the current set.
+ * @param p_sensor Pointer to the sensor instance.
+ * @param sample The raw (decimated) ADC sample.
+ * @return uint16_t The reading handed to the statistics, 0 to INT16_MAX.
  */
-static void auto_calibrate(int sensor_value, int average, int min_reading, int max_reading)
+static uint16_t sensor_input(sensor_instance_t *p_sensor, int16_t sample)
 {
-    // Update the goldenReference value when the stability conditions are met.
-    sensor_data.golden_reference = sensor_value;
-    // Reset the reference boundaries with a margin of < 10% > for stability.
-    sensor_data.low_reference = min_reading - (INITIAL_MIN_THRESHOLD * average);
-    sensor_data.top_reference = max_reading + (INITIAL_MAX_THRESHOLD * average);
-}
-
-/**
- * @brief Initializes sensor context and data to default values.
- *
- * Sets up the initial state for the sensor context and data, preparing the sensor
- * for operation.
- */
-static void sensor_initialization() {
-    
-    sensor_data.sensor_reading      = 0;
-    sensor_data.previous_average    = 0;
-    sensor_data.average_reading     = 0;
-    sensor_data.is_voltage_stable   = false;
-    sensor_data.top_reference       = 0;
-    sensor_data.low_reference       = 0;
-    sensor_data.golden_reference    = FINE_STRUCTURE;
-
-    sensor_ctx.is_calibrated        = false;
-    sensor_ctx.buffer_index         = 0;
-    sensor_ctx.current_min_value    = 0; 
-    sensor_ctx.current_max_value    = 0; 
-    sensor_ctx.sensor_voltage       = 0.0;
+#if SENSOR_OUTLIER_WINDOW
+    sample = hampel_filter_process(&p_sensor->outlier_filter, sample);
+#endif
+#if SENSOR_MAINS_FILTER
+    sample = mains_filter_process(&p_sensor->mains_filter, sample);
+#endif
+    return (sample < 0) ? 0 : (uint16_t)sample;
 }
 
 /**
@@ -327,11 +509,12 @@ static void sensor_initialization() {
  * Retrieves the current sensor data, including sensor readings, stability status,
  * and other relevant metrics.
  *
+ * @param p_sensor Pointer to the sensor instance.
  * @return sensor_data_t The current sensor data.
  */
-sensor_data_t get_sensor_data(void) 
+sensor_data_t get_sensor_data(const sensor_instance_t *p_sensor) 
 {
-    return sensor_data;
+    return p_sensor->data;
 }
 
 /**
@@ -340,11 +523,12 @@ sensor_data_t get_sensor_data(void)
  * Retrieves the current context of the sensor, including calibration status and
  * min/max values.
  *
+ * @param p_sensor Pointer to the sensor instance.
  * @return sensor_context_t The current sensor context.
  */
-sensor_context_t get_sensor_context(void) 
+sensor_context_t get_sensor_context(const sensor_instance_t *p_sensor) 
 {
-    return sensor_ctx;
+    return p_sensor->ctx;
 }
 
 /**
@@ -353,11 +537,12 @@ sensor_context_t get_sensor_context(void)
  * Retrieves the current status of the sensor, indicating if it's OK, in error,
  * in calibration, or in other states.
  *
+ * @param p_sensor Pointer to the sensor instance.
  * @return sensor_status_t The current status of the sensor.
  */
-sensor_status_t get_sensor_status(void) 
+sensor_status_t get_sensor_status(const sensor_instance_t *p_sensor) 
 {
-    if (!sensor_ctx.is_calibrated) {
+    if (!p_sensor->ctx.is_calibrated) {
         return SENSOR_ERROR;
     } else {
         return SENSOR_OK;
@@ -367,21 +552,40 @@ sensor_status_t get_sensor_status(void)
 /**
  * @brief Convert ADC value to voltage.
  *
- * Converts a raw ADC value to its corresponding voltage value based on
- * the reference voltage.
+ * Converts an ADC value to its corresponding voltage in Q16.16 volts with a
+ * single integer multiply and shift. The scale comes from the SAADC gain,
+ * reference and SADC_SCALE_BITS in `sadc_driver.h`, which the decimator
+ * applies to every acquisition profile. Compared to a
+ * double-precision reference the error stays within 1 LSB (~15 uV): the
+ * truncating shift loses less than 1 LSB and the rounded full-scale constant
+ * adds less than 0.5 LSB.
  *
  * @param adc_value The ADC value to convert.
- * @return float The corresponding voltage value.
+ * @return int32_t The corresponding voltage value (Q16.16 volts).
+ */
+static int32_t convert_to_voltage(uint16_t adc_value) {
+    return (int32_t)(((uint64_t)adc_value * SENSOR_FULL_SCALE_Q16) >> SADC_SCALE_BITS);
+}
+
+/**
+ * @brief Scale a value by a Q15 fraction.
+ *
+ * Integer multiply-shift replacement for `value * fraction`, truncated toward zero.
+ *
+ * @param value The value to scale.
+ * @param fraction_q15 The fraction in Q1.15.
+ * @return int32_t The scaled value.
  */
-static float convert_to_voltage(uint16_t adc_value) {
-    // Vref - reference voltage of ~0.6V.
-    float voltage = (adc_value / 1023.0) * 0.6;
-    return voltage;
+static int32_t apply_margin(int32_t value, int32_t fraction_q15) {
+    int32_t product = value * fraction_q15;
+    return (product >= 0) ? (product >> SENSOR_Q15_SHIFT) : -((-product) >> SENSOR_Q15_SHIFT);
 }
+
 /**
  * @brief Log sensor data.
  *
  * Logs the sensor data for debugging purposes. Only logs if the debug flag is enabled.
+ * The rows are deferred to the log backend, which the main loop processes when idle.
  *
  * @param data Pointer to the sensor_data_t structure containing the data to log.
  */
@@ -396,29 +600,73 @@ void log_sensor_data(const sensor_data_t* data)
         // If the header hasn't been logged, log it and set the flag
         if (!header_logged) {
            /*
+            * CH       - SAADC scan channel,
             * SENSOR   - Current Sensor Value,
             * GOLDEN   - The stable voltage reference,
             * STABLE   - Is Voltage Stable ?
             * CURAVE   - Current Average value,
             * LOWREF   - Last MIN voltage,
-            * TOPREF   - Last Max voltage.
+            * TOPREF   - Last Max voltage,
+            * EVENT    - Active change event (1 above, -1 below the baseline, 0 none),
+            * ZONE     - Proximity zone (0 idle, 1 outer, 2 inner, 3 touch),
+            * SIGMA    - Idle noise standard deviation (counts, Q8).
             */
-            NRF_LOG_INFO("SENSOR, GOLDEN, STABLE, CURAVE, LOWREF, TOPREF");
+            // The logger takes at most 6 arguments, so each row is logged in two lines
+            NRF_LOG_INFO("CH, SENSOR, GOLDEN, STABLE, CURAVE");
+            NRF_LOG_INFO("CH, LOWREF, TOPREF, EVENT, ZONE, SIGMA");
             header_logged = true;
         }
 
-        NRF_LOG_INFO("%d, %d, %s, %d, %d, %d", 
+        NRF_LOG_INFO("%d, %d, %d, %s, %d", 
+                      data->channel,
                       data->sensor_reading,
                       data->golden_reference,
                       data->is_voltage_stable ? "TRUE" : "FALSE",
-                      data->average_reading,
+                      data->average_reading
+                    );
+        NRF_LOG_INFO("%d, %d, %d, %d, %d, %d", 
+                      data->channel,
                       data->low_reference,
-                      data->top_reference
+                      data->top_reference,
+                      data->change_state,
+                      data->zone,
+                      data->noise_sigma_q8
                     );
  
-        //NRF_LOG_INFO("Voltage: " NRF_LOG_FLOAT_MARKER, NRF_LOG_FLOAT(data->sensor_voltage));
+        //NRF_LOG_INFO("Voltage: %d mV", (p_sensor->ctx.sensor_voltage_q16 * 1000) >> SENSOR_Q16_SHIFT);
         //NRF_LOG_INFO("Is voltage stable? %s", data->is_voltage_stable ? "TRUE" : "FALSE")
+    }
+}
 
-        NRF_LOG_FLUSH();
+/**
+ * @brief Derive the detection thresholds from the noise estimate.
+ *
+ * T = NOISE_K * sigma, clamped to [NOISE_MIN_THRESHOLD, NOISE_MAX_THRESHOLD],
+ * sets the baseline freeze band, the CUSUM drift and decision interval and the
+ * outer zone. The stages are only retuned when T changes by a whole count.
+ *
+ * @param p_sensor Pointer to the sensor instance.
+ */
+static void apply_noise_threshold(sensor_instance_t *p_sensor)
+{
+    int32_t threshold = (NOISE_K * (int32_t)p_sensor->data.noise_sigma_q8 + (1 << 7)) >> 8;
+
+    if (threshold < NOISE_MIN_THRESHOLD) {
+        threshold = NOISE_MIN_THRESHOLD;
+    } else if (threshold > NOISE_MAX_THRESHOLD) {
+        threshold = NOISE_MAX_THRESHOLD;
     }
-}
\ No newline at end of file
+    if (threshold == p_sensor->ctx.noise_threshold) {
+        return;
+    }
+    p_sensor->ctx.noise_threshold = threshold;
+
+    sensor_zone_level_t outer = {
+        ZONE_OUTER_ENTER(threshold),
+        ZONE_OUTER_ENTER(threshold) - ZONE_OUTER_HYSTERESIS(threshold),
+        ZONE_OUTER_DWELL
+    };
+    sensor_baseline_set_freeze_band(&p_sensor->baseline, BASELINE_FREEZE_BAND(threshold));
+    sensor_cusum_set_parameters(&p_sensor->detector, CUSUM_DRIFT(threshold), CUSUM_DECISION(threshold));
+    sensor_zone_set_level(&p_sensor->zones, SENSOR_ZONE_OUTER, &outer);
+}
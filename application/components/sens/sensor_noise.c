@@ -0,0 +1,120 @@
+/**
+ * @file sensor_noise.c
+ * @brief Incremental noise (variance) estimator for the sensor readings.
+ * 
+ * This module estimates the noise of a sensing channel with an exponentially
+ * weighted Welford mean/variance recursion in fixed point. The driver feeds it
+ * the readings taken while the channel is idle and derives its detection
+ * thresholds from the resulting standard deviation, so one build adapts to
+ * quiet and noisy installations alike.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "sensor_noise.h"
+
+/*
+ * Prototypes for internal functions:
+ */ 
+static uint32_t isqrt32(uint32_t value);
+
+/**
+ * @brief Initialize a noise estimator.
+ *
+ * @param p_noise Pointer to the estimator.
+ * @param mean Initial mean in counts.
+ * @param sigma_q8 Initial standard deviation in counts (Q8).
+ * @param shift Smoothing shift.
+ */
+void sensor_noise_init(sensor_noise_t *p_noise, int32_t mean, uint32_t sigma_q8, uint8_t shift)
+{
+    p_noise->mean_q16     = mean * (1 << SENSOR_NOISE_Q16_SHIFT);
+    p_noise->variance_q16 = (int64_t)sigma_q8 * sigma_q8;
+    p_noise->shift        = shift;
+}
+
+/**
+ * @brief Update the estimate with one reading.
+ *
+ * With a = 1/2^shift and d = x - mean: mean += a*d and
+ * var = (1 - a) * (var + a*d^2), the exponentially weighted form of
+ * Welford's recursion.
+ *
+ * @param p_noise Pointer to the estimator.
+ * @param reading The reading in counts.
+ */
+void sensor_noise_update(sensor_noise_t *p_noise, int32_t reading)
+{
+    int64_t diff = (int64_t)reading * (1 << SENSOR_NOISE_Q16_SHIFT) - p_noise->mean_q16;
+    int64_t increment = diff >> p_noise->shift;
+    int64_t product = (diff * increment) >> SENSOR_NOISE_Q16_SHIFT;
+    int64_t variance = p_noise->variance_q16 + product;
+
+    p_noise->mean_q16 += (int32_t)increment;
+    p_noise->variance_q16 = variance - (variance >> p_noise->shift);
+}
+
+/**
+ * @brief Get the standard deviation.
+ *
+ * @param p_noise Pointer to the estimator.
+ * @return uint16_t The standard deviation in counts (Q8), saturated at UINT16_MAX.
+ */
+uint16_t sensor_noise_sigma_q8(const sensor_noise_t *p_noise)
+{
+    // sqrt of a Q16 variance is a Q8 deviation
+    uint32_t variance = (p_noise->variance_q16 > UINT32_MAX) ? UINT32_MAX : (uint32_t)p_noise->variance_q16;
+    uint32_t sigma = isqrt32(variance);
+    return (sigma > UINT16_MAX) ? UINT16_MAX : (uint16_t)sigma;
+}
+
+/**
+ * @brief Integer square root.
+ *
+ * @param value The value.
+ * @return uint32_t floor(sqrt(value)).
+ */
+static uint32_t isqrt32(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file sensor_quantile.c
+ * @brief Streaming quantile estimator for the sensor references.
+ * 
+ * This module implements the P-square algorithm (Jain and Chlamtac) for
+ * estimating a quantile of the sensor readings without storing them. The
+ * driver runs two instances per channel for the 1st and 99th percentiles, which
+ * replace the raw minimum and maximum as low and top references so that a
+ * single glitch no longer widens them for good.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "sensor_quantile.h"
+
+#define QUANTILE_ONE ((int32_t)1 << SENSOR_QUANTILE_POSITION_SHIFT) // One position step (Q16.16)
+
+/*
+ * Prototypes for internal functions:
+ */ 
+static int32_t parabolic(const sensor_quantile_t *p_quantile, int i, int32_t direction);
+static int32_t linear(const sensor_quantile_t *p_quantile, int i, int direction);
+
+/**
+ * @brief Initialize a quantile estimator.
+ *
+ * @param p_quantile Pointer to the estimator.
+ * @param quantile_q15 The tracked quantile, a Q1.15 fraction between 0 and 1.
+ * @param horizon Number of samples after which the marker positions are halved (16 to SENSOR_QUANTILE_MAX_HORIZON).
+ */
+void sensor_quantile_init(sensor_quantile_t *p_quantile, int32_t quantile_q15, uint32_t horizon)
+{
+    // Q1.15 to Q16.16
+    const int32_t p = quantile_q15 << (SENSOR_QUANTILE_POSITION_SHIFT - 15);
+
+    p_quantile->increments[0] = 0;
+    p_quantile->increments[1] = p / 2;
+    p_quantile->increments[2] = p;
+    p_quantile->increments[3] = (QUANTILE_ONE + p) / 2;
+    p_quantile->increments[4] = QUANTILE_ONE;
+
+    p_quantile->desired[0] = QUANTILE_ONE;
+    p_quantile->desired[1] = QUANTILE_ONE + 2 * p;
+    p_quantile->desired[2] = QUANTILE_ONE + 4 * p;
+    p_quantile->desired[3] = 3 * QUANTILE_ONE + 2 * p;
+    p_quantile->desired[4] = 5 * QUANTILE_ONE;
+
+    for (int i = 0; i < SENSOR_QUANTILE_MARKERS; i++) {
+        p_quantile->positions[i] = (i + 1) * QUANTILE_ONE;
+        p_quantile->heights[i] = 0;
+    }
+    if (horizon < 16) {
+        horizon = 16;
+    } else if (horizon > SENSOR_QUANTILE_MAX_HORIZON) {
+        horizon = SENSOR_QUANTILE_MAX_HORIZON;
+    }
+    p_quantile->horizon = (int32_t)horizon << SENSOR_QUANTILE_POSITION_SHIFT;
+    p_quantile->count = 0;
+}
+
+/**
+ * @brief Add one sample.
+ *
+ * The first five samples seed the markers. Afterwards the sample's cell moves
+ * the positions of the markers above it, and each inner marker more than one
+ * position away from its desired position is moved one step, its height
+ * following the parabola through its neighbours (or the line to the neighbour
+ * when the parabola would break the ordering).
+ *
+ * @param p_quantile Pointer to the estimator.
+ * @param value The sample, saturated to the int16_t range.
+ */
+void sensor_quantile_update(sensor_quantile_t *p_quantile, int32_t value)
+{
+    int32_t *q = p_quantile->heights;
+    int32_t *n = p_quantile->positions;
+    if (value > INT16_MAX) {
+        value = INT16_MAX;
+    } else if (value < INT16_MIN) {
+        value = INT16_MIN;
+    }
+    const int32_t x = value * (1 << SENSOR_QUANTILE_HEIGHT_SHIFT);
+
+    if (p_quantile->count < SENSOR_QUANTILE_MARKERS) {
+        // Insertion sort of the priming samples
+        int i = p_quantile->count++;
+        while (i > 0 && q[i - 1] > x) {
+            q[i] = q[i - 1];
+            i--;
+        }
+        q[i] = x;
+        return;
+    }
+
+    int cell;
+    if (x < q[0]) {
+        q[0] = x;
+        cell = 0;
+    } else if (x >= q[4]) {
+        q[4] = x;
+        cell = 3;
+    } else {
+        cell = 0;
+        while (x >= q[cell + 1]) {
+            cell++;
+        }
+    }
+
+    for (int i = cell + 1; i < SENSOR_QUANTILE_MARKERS; i++) {
+        n[i] += QUANTILE_ONE;
+    }
+    for (int i = 0; i < SENSOR_QUANTILE_MARKERS; i++) {
+        p_quantile->desired[i] += p_quantile->increments[i];
+    }
+
+    for (int i = 1; i < SENSOR_QUANTILE_MARKERS - 1; i++) {
+        int32_t d = p_quantile->desired[i] - n[i];
+        if ((d >= QUANTILE_ONE && n[i + 1] - n[i] > QUANTILE_ONE) ||
+            (d <= -QUANTILE_ONE && n[i - 1] - n[i] < -QUANTILE_ONE)) {
+            int direction = (d > 0) ? 1 : -1;
+            int32_t height = parabolic(p_quantile, i, direction * QUANTILE_ONE);
+            if (q[i - 1] < height && height < q[i + 1]) {
+                q[i] = height;
+            } else {
+                q[i] = linear(p_quantile, i, direction);
+            }
+            n[i] += direction * QUANTILE_ONE;
+        }
+    }
+
+    // Age the history: halve the distances to the first marker
+    if (n[4] >= p_quantile->horizon) {
+        for (int i = 1; i < SENSOR_QUANTILE_MARKERS; i++) {
+            n[i] = QUANTILE_ONE + (n[i] - QUANTILE_ONE) / 2;
+            p_quantile->desired[i] = QUANTILE_ONE + (p_quantile->desired[i] - QUANTILE_ONE) / 2;
+        }
+    }
+}
+
+/**
+ * @brief Check whether the estimator has seen enough samples to give an estimate.
+ *
+ * @param p_quantile Pointer to the estimator.
+ * @return bool True once the five markers are initialized.
+ */
+bool sensor_quantile_is_ready(const sensor_quantile_t *p_quantile)
+{
+    return p_quantile->count >= SENSOR_QUANTILE_MARKERS;
+}
+
+/**
+ * @brief Get the quantile estimate.
+ *
+ * @param p_quantile Pointer to the estimator.
+ * @return int32_t The estimate rounded to the nearest count, valid once the estimator is ready.
+ */
+int32_t sensor_quantile_get(const sensor_quantile_t *p_quantile)
+{
+    return (int32_t)(((int64_t)p_quantile->heights[2] + (1 << (SENSOR_QUANTILE_HEIGHT_SHIFT - 1))) >> SENSOR_QUANTILE_HEIGHT_SHIFT);
+}
+
+/**
+ * @brief Piecewise-parabolic (P-square) height of a marker moved by one position.
+ *
+ * Height differences and their products with position differences are
+ * formed in 64 bits before the division by a position difference.
+ *
+ * @param p_quantile Pointer to the estimator.
+ * @param i Index of the inner marker.
+ * @param direction +1 or -1 position (Q16.16).
+ * @return int32_t The interpolated height (Q16.16).
+ */
+static int32_t parabolic(const sensor_quantile_t *p_quantile, int i, int32_t direction)
+{
+    const int32_t *q = p_quantile->heights;
+    const int32_t *n = p_quantile->positions;
+
+    int64_t above = (int64_t)(n[i] - n[i - 1] + direction) * ((int64_t)q[i + 1] - q[i]) / (n[i + 1] - n[i]);
+    int64_t below = (int64_t)(n[i + 1] - n[i] - direction) * ((int64_t)q[i] - q[i - 1]) / (n[i] - n[i - 1]);
+
+    return (int32_t)(q[i] + direction * (above + below) / (n[i + 1] - n[i - 1]));
+}
+
+/**
+ * @brief Linear height of a marker moved by one position toward a neighbour.
+ *
+ * @param p_quantile Pointer to the estimator.
+ * @param i Index of the inner marker.
+ * @param direction +1 or -1.
+ * @return int32_t The interpolated height (Q16.16).
+ */
+static int32_t linear(const sensor_quantile_t *p_quantile, int i, int direction)
+{
+    const int32_t *q = p_quantile->heights;
+    const int32_t *n = p_quantile->positions;
+
+    return (int32_t)(q[i] + direction * ((int64_t)q[i + direction] - q[i]) * QUANTILE_ONE /
+                            (n[i + direction] - n[i]));
+}
@@ -0,0 +1,257 @@
+/**
+ * @file sensor_window.c
+ * @brief Sliding window statistics for sensor readings.
+ * 
+ * This module keeps a running sum and monotonic deques over the last N sensor
+ * readings so that the window statistics are updated in constant time per
+ * sample instead of walking the whole window.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "sensor_window.h"
+
+/*
+ * Prototypes for internal functions:
+ */ 
+static inline uint16_t ring_wrap(uint16_t index);
+static void deque_reset(sensor_window_deque_t *p_deque);
+static uint16_t deque_front(const sensor_window_deque_t *p_deque);
+static uint16_t deque_back(const sensor_window_deque_t *p_deque);
+static void deque_pop_front(sensor_window_deque_t *p_deque);
+static void deque_push_back(sensor_window_deque_t *p_deque, uint16_t slot);
+
+/**
+ * @brief Initialize a sliding window.
+ *
+ * Clears the stored readings and statistics.
+ *
+ * @param p_window Pointer to the window to initialize.
+ */
+void sensor_window_init(sensor_window_t *p_window)
+{
+    p_window->count    = 0;
+    p_window->position = 0;
+    p_window->total    = 0;
+    deque_reset(&p_window->min_deque);
+    deque_reset(&p_window->max_deque);
+}
+
+/**
+ * @brief Push a reading into the window.
+ *
+ * Evicts the oldest reading once the window is full and keeps the min/max
+ * deques monotonic. Every slot index enters and leaves each deque at most once,
+ * so the cost per push is constant on average regardless of the window length.
+ *
+ * @param p_window Pointer to the window.
+ * @param value The reading to store.
+ */
+void sensor_window_push(sensor_window_t *p_window, int32_t value)
+{
+    uint16_t slot = p_window->position;
+    sensor_window_deque_t *p_min = &p_window->min_deque;
+    sensor_window_deque_t *p_max = &p_window->max_deque;
+
+    if (p_window->count == SENSOR_WINDOW_SIZE) {
+        // Evict the oldest reading, which lives in the slot about to be overwritten
+        p_window->total -= p_window->values[slot];
+        if (p_min->count > 0 && deque_front(p_min) == slot) {
+            deque_pop_front(p_min);
+        }
+        if (p_max->count > 0 && deque_front(p_max) == slot) {
+            deque_pop_front(p_max);
+        }
+    } else {
+        p_window->count++;
+    }
+
+    p_window->values[slot] = value;
+    p_window->total += value;
+
+    // Drop candidates that can no longer be the minimum or maximum
+    while (p_min->count > 0 && p_window->values[deque_back(p_min)] >= value) {
+        p_min->count--;
+    }
+    deque_push_back(p_min, slot);
+
+    while (p_max->count > 0 && p_window->values[deque_back(p_max)] <= value) {
+        p_max->count--;
+    }
+    deque_push_back(p_max, slot);
+
+    // Move to the next position in the circular buffer
+    p_window->position = ring_wrap(slot + 1);
+}
+
+/**
+ * @brief Check whether the window holds SENSOR_WINDOW_SIZE readings.
+ *
+ * @param p_window Pointer to the window.
+ * @return bool True if the window is full.
+ */
+bool sensor_window_is_full(const sensor_window_t *p_window)
+{
+    return p_window->count == SENSOR_WINDOW_SIZE;
+}
+
+/**
+ * @brief Get the sum of the readings in the window.
+ *
+ * @param p_window Pointer to the window.
+ * @return int32_t The running total.
+ */
+int32_t sensor_window_total(const sensor_window_t *p_window)
+{
+    return p_window->total;
+}
+
+/**
+ * @brief Get the average of the window.
+ *
+ * The total is divided by the window length, truncating toward zero like a
+ * full-window walk. A power-of-two length rounds negative totals up before the
+ * arithmetic shift; other lengths multiply the magnitude by the reciprocal from
+ * sensor_config.h, which is exact for any total the window can hold.
+ *
+ * @param p_window Pointer to the window.
+ * @return int32_t The integer average.
+ */
+int32_t sensor_window_average(const sensor_window_t *p_window)
+{
+    int32_t total = p_window->total;
+#if SENSOR_WINDOW_IS_POW2
+    return (total + ((total >> 31) & SENSOR_WINDOW_MASK)) >> SENSOR_WINDOW_LOG2;
+#else
+    uint32_t magnitude = (total < 0) ? (uint32_t)-total : (uint32_t)total;
+    int32_t quotient = (int32_t)(((uint64_t)magnitude * SENSOR_WINDOW_RECIPROCAL) >> SENSOR_WINDOW_RECIPROCAL_SHIFT);
+    return (total < 0) ? -quotient : quotient;
+#endif
+}
+
+/**
+ * @brief Get the minimum reading in the window.
+ *
+ * @param p_window Pointer to the window.
+ * @return int32_t The minimum reading, or UINT16_MAX if the window is empty.
+ */
+int32_t sensor_window_min(const sensor_window_t *p_window)
+{
+    if (p_window->min_deque.count == 0) {
+        return UINT16_MAX;
+    }
+    return p_window->values[deque_front(&p_window->min_deque)];
+}
+
+/**
+ * @brief Get the maximum reading in the window.
+ *
+ * @param p_window Pointer to the window.
+ * @return int32_t The maximum reading, or 0 if the window is empty.
+ */
+int32_t sensor_window_max(const sensor_window_t *p_window)
+{
+    if (p_window->max_deque.count == 0) {
+        return 0;
+    }
+    return p_window->values[deque_front(&p_window->max_deque)];
+}
+
+/**
+ * @brief Wrap a ring index that may have run one window length past the end.
+ *
+ * @param index Ring index below 2 * SENSOR_WINDOW_SIZE.
+ * @return uint16_t The index folded into the window.
+ */
+static inline uint16_t ring_wrap(uint16_t index)
+{
+#if SENSOR_WINDOW_IS_POW2
+    return index & SENSOR_WINDOW_MASK;
+#else
+    return (index >= SENSOR_WINDOW_SIZE) ? index - SENSOR_WINDOW_SIZE : index;
+#endif
+}
+
+/**
+ * @brief Empty a deque.
+ *
+ * @param p_deque Pointer to the deque.
+ */
+static void deque_reset(sensor_window_deque_t *p_deque)
+{
+    p_deque->head  = 0;
+    p_deque->count = 0;
+}
+
+/**
+ * @brief Get the slot index at the front (oldest end) of a deque.
+ *
+ * @param p_deque Pointer to a non-empty deque.
+ * @return uint16_t The slot index.
+ */
+static uint16_t deque_front(const sensor_window_deque_t *p_deque)
+{
+    return p_deque->slots[p_deque->head];
+}
+
+/**
+ * @brief Get the slot index at the back (newest end) of a deque.
+ *
+ * @param p_deque Pointer to a non-empty deque.
+ * @return uint16_t The slot index.
+ */
+static uint16_t deque_back(const sensor_window_deque_t *p_deque)
+{
+    return p_deque->slots[ring_wrap((uint16_t)(p_deque->head + p_deque->count - 1))];
+}
+
+/**
+ * @brief Remove the front (oldest) element of a deque.
+ *
+ * @param p_deque Pointer to a non-empty deque.
+ */
+static void deque_pop_front(sensor_window_deque_t *p_deque)
+{
+    p_deque->head = ring_wrap(p_deque->head + 1);
+    p_deque->count--;
+}
+
+/**
+ * @brief Append a slot index at the back (newest end) of a deque.
+ *
+ * The deque never holds more than SENSOR_WINDOW_SIZE entries because every
+ * entry refers to a distinct slot of the window.
+ *
+ * @param p_deque Pointer to the deque.
+ * @param slot Slot index to append.
+ */
+static void deque_push_back(sensor_window_deque_t *p_deque, uint16_t slot)
+{
+    p_deque->slots[ring_wrap(p_deque->head + p_deque->count)] = slot;
+    p_deque->count++;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file sensor_zone.c
+ * @brief Proximity zone classifier for the sensor readings.
+ * 
+ * This module turns the deviation of a sensing channel from its baseline into
+ * the proximity zones the feedback reacts to (outer, inner, touch), with a
+ * hysteresis band and a minimum dwell time per zone. It only reports
+ * transitions, so the work downstream of it runs on state changes instead of
+ * on every sample.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+#include <string.h>
+
+#include "sensor_zone.h"
+
+/*
+ * Prototypes for internal functions:
+ */ 
+static sensor_zone_id_t zone_indicated(const sensor_zone_t *p_zone, int32_t magnitude);
+
+/**
+ * @brief Initialize a zone classifier.
+ *
+ * @param p_zone Pointer to the classifier.
+ * @param p_levels Thresholds of the SENSOR_ZONE_COUNT zones, enter thresholds increasing.
+ */
+void sensor_zone_init(sensor_zone_t *p_zone, const sensor_zone_level_t *p_levels)
+{
+    memcpy(p_zone->levels, p_levels, sizeof(p_zone->levels));
+    p_zone->zone            = SENSOR_ZONE_IDLE;
+    p_zone->candidate       = SENSOR_ZONE_IDLE;
+    p_zone->candidate_count = 0;
+}
+
+/**
+ * @brief Change the thresholds of one zone.
+ *
+ * The reported zone is kept; the new thresholds apply from the next sample.
+ *
+ * @param p_zone Pointer to the classifier.
+ * @param zone The zone to change.
+ * @param p_level The new thresholds, keeping the enter thresholds increasing.
+ */
+void sensor_zone_set_level(sensor_zone_t *p_zone, sensor_zone_id_t zone, const sensor_zone_level_t *p_level)
+{
+    if (zone < SENSOR_ZONE_COUNT) {
+        p_zone->levels[zone] = *p_level;
+    }
+}
+
+/**
+ * @brief Classify one sample.
+ *
+ * The sample indicates a zone through the hysteresis thresholds of the
+ * reported zone. A differing indication must then persist for the dwell time
+ * of the indicated zone; any other indication restarts the count.
+ *
+ * @param p_zone Pointer to the classifier.
+ * @param deviation The reading minus the baseline, in counts (either sign).
+ * @return bool True if the reported zone changed on this sample.
+ */
+bool sensor_zone_update(sensor_zone_t *p_zone, int32_t deviation)
+{
+    sensor_zone_id_t indicated = zone_indicated(p_zone, (deviation < 0) ? -deviation : deviation);
+
+    if (indicated == p_zone->zone) {
+        p_zone->candidate_count = 0;
+        return false;
+    }
+
+    if (indicated != p_zone->candidate || p_zone->candidate_count == 0) {
+        p_zone->candidate = indicated;
+        p_zone->candidate_count = 0;
+    }
+    if (++p_zone->candidate_count < p_zone->levels[indicated].dwell) {
+        return false;
+    }
+
+    p_zone->zone = indicated;
+    p_zone->candidate_count = 0;
+    return true;
+}
+
+/**
+ * @brief Get the reported zone.
+ *
+ * @param p_zone Pointer to the classifier.
+ * @return sensor_zone_id_t The zone.
+ */
+sensor_zone_id_t sensor_zone_get(const sensor_zone_t *p_zone)
+{
+    return p_zone->zone;
+}
+
+/**
+ * @brief Zone indicated by one sample.
+ *
+ * Moves up from the reported zone while the next enter threshold is reached,
+ * and down while the exit threshold of the zone is not.
+ *
+ * @param p_zone Pointer to the classifier.
+ * @param magnitude Absolute deviation from the baseline.
+ * @return sensor_zone_id_t The indicated zone.
+ */
+static sensor_zone_id_t zone_indicated(const sensor_zone_t *p_zone, int32_t magnitude)
+{
+    int zone = p_zone->zone;
+
+    while (zone + 1 < SENSOR_ZONE_COUNT && magnitude >= p_zone->levels[zone + 1].enter) {
+        zone++;
+    }
+    while (zone > SENSOR_ZONE_IDLE && magnitude < p_zone->levels[zone].exit) {
+        zone--;
+    }
+    return (sensor_zone_id_t)zone;
+}
@@ -0,0 +1,37 @@
+#ifndef TEMP_DRIVER_H
+#define TEMP_DRIVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Resolution of the die temperature readings
+#define TEMP_UNITS_PER_DEGREE 4   // Readings are in 0.25 degC steps
+
+/**
+ * @brief Initialize the die temperature sensor and start the first measurement.
+ */
+void temp_init(void);
+
+/**
+ * @brief Collect a finished measurement and start the next one.
+ *
+ * Never waits for the sensor: the measurement started on the previous call
+ * (about 36 us of conversion) is read if it is done, and a new one is started.
+ * While the SoftDevice is enabled, TEMP is only reachable through
+ * sd_temp_get(), which waits for the conversion. Call it periodically from
+ * the main loop, e.g. once per second.
+ *
+ * @param p_temperature Filled with the die temperature in 0.25 degC when available.
+ * @return bool True if a new reading was written.
+ */
+bool temp_poll(int32_t *p_temperature);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEMP_DRIVER_H
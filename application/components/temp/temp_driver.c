@@ -0,0 +1,120 @@
+/**
+ * @file temp_driver.c
+ * @brief Non-blocking die temperature readings.
+ * 
+ * This module reads the nRF52840 die temperature without blocking the main
+ * loop. Measurements are started and collected on successive polls through
+ * the TEMP peripheral; when the SoftDevice owns the peripheral
+ * (SOFTDEVICE_PRESENT), the reading goes through sd_temp_get() instead.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "temp_driver.h"
+#include "nrf_temp.h"
+
+#ifdef SOFTDEVICE_PRESENT
+#include "nrf_sdm.h"
+#include "nrf_soc.h"
+#endif
+
+/*
+ * Global variables:
+ */
+static bool measuring = false; // A measurement has been started and not collected yet
+
+/*
+ * Prototypes for internal functions:
+ */
+static bool softdevice_owns_temp(void);
+
+/**
+ * @brief Initialize the die temperature sensor and start the first measurement.
+ */
+void temp_init(void)
+{
+    if (softdevice_owns_temp()) {
+        return;
+    }
+    nrf_temp_event_clear(NRF_TEMP, NRF_TEMP_EVENT_DATARDY);
+    nrf_temp_task_trigger(NRF_TEMP, NRF_TEMP_TASK_START);
+    measuring = true;
+}
+
+/**
+ * @brief Collect a finished measurement and start the next one.
+ *
+ * The TEMP peripheral is read directly, through its DATARDY event, unless the
+ * SoftDevice is enabled: TEMP is then restricted to sd_temp_get(), which
+ * performs the whole measurement in one call and waits its ~36 us. The
+ * application only polls from the main loop (scheduler context), about once
+ * per second, never from an interrupt.
+ *
+ * @param p_temperature Filled with the die temperature in 0.25 degC when available.
+ * @return bool True if a new reading was written.
+ */
+bool temp_poll(int32_t *p_temperature)
+{
+#ifdef SOFTDEVICE_PRESENT
+    if (softdevice_owns_temp()) {
+        measuring = false;
+        return sd_temp_get(p_temperature) == NRF_SUCCESS;
+    }
+#endif
+    bool ready = measuring && nrf_temp_event_check(NRF_TEMP, NRF_TEMP_EVENT_DATARDY);
+
+    if (ready) {
+        *p_temperature = nrf_temp_result_get(NRF_TEMP);
+        measuring = false;
+    }
+    if (!measuring) {
+        // Also clears a DATARDY left over from before the SoftDevice was disabled
+        nrf_temp_event_clear(NRF_TEMP, NRF_TEMP_EVENT_DATARDY);
+        nrf_temp_task_trigger(NRF_TEMP, NRF_TEMP_TASK_START);
+        measuring = true;
+    }
+    return ready;
+}
+
+/**
+ * @brief Check whether the TEMP peripheral belongs to the SoftDevice.
+ *
+ * A flashed but disabled SoftDevice leaves TEMP to the application. The
+ * SoftDevice itself is asked rather than nrf_sdh, which is not enabled in
+ * sdk_config.h for this application.
+ *
+ * @return bool True while the SoftDevice is enabled.
+ */
+static bool softdevice_owns_temp(void)
+{
+#ifdef SOFTDEVICE_PRESENT
+    uint8_t enabled = 0;
+
+    return sd_softdevice_is_enabled(&enabled) == NRF_SUCCESS && enabled != 0;
+#else
+    return false;
+#endif
+}
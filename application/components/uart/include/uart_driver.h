@@ -9,6 +9,7 @@ extern "C" {
 #include <stdbool.h>
 #include "nrf_drv_uart.h"
 #include "nrf_gpio.h"
+#include "uart_frame.h"
 
 /**
  * @brief Error codes for UART operations.
@@ -32,15 +33,6 @@ typedef uart_error_t uart_ret_code_t;
 // UART configuration constants
 #define UART_MAX_BUFFER_SIZE 256   // Maximum buffer size for transmission/reception
 
-// Special byte definitions for enhanced communication protocol
-#define START_BYTE 0xAA            // Start byte for frame
-#define STOP_BYTE  0x55            // Stop byte for frame
-
-// Definitions for Arduino's checksum and framing errors handling
-#define ACK 0x06   // Acknowledgment byte if the checksum is correct
-#define NAK 0x15   // Negative acknowledgment byte if the checksum is incorrect
-#define REJ 0x21   // Rejection byte for framing error
-
 // UART PIN definitions
 #define TX_PIN_NUMBER NRF_GPIO_PIN_MAP(0,6)   // TX Pin
 #define RX_PIN_NUMBER NRF_GPIO_PIN_MAP(0,8)   // RX Pin
@@ -0,0 +1,47 @@
+#ifndef UART_FRAME_H
+#define UART_FRAME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Special byte definitions for enhanced communication protocol
+#define START_BYTE 0xAA            // Start byte for frame
+#define STOP_BYTE  0x55            // Stop byte for frame
+
+// Definitions for Arduino's checksum and framing errors handling
+#define ACK 0x06   // Acknowledgment byte if the checksum is correct
+#define NAK 0x15   // Negative acknowledgment byte if the checksum is incorrect
+#define REJ 0x21   // Rejection byte for framing error
+
+// Size of an RGB frame: start, red, green, blue, checksum, stop
+#define UART_FRAME_RGB_SIZE 6
+
+/**
+ * @brief Calculate checksum for a given set of data.
+ *
+ * @param p_data Pointer to the data array.
+ * @param length Length of the data array.
+ * @return uint8_t The sum of the bytes, modulo 256.
+ */
+uint8_t uart_frame_checksum(const uint8_t *p_data, uint8_t length);
+
+/**
+ * @brief Build an RGB intensity frame.
+ *
+ * @param p_frame Pointer to a buffer of at least UART_FRAME_RGB_SIZE bytes.
+ * @param red Intensity of the red LED component.
+ * @param green Intensity of the green LED component.
+ * @param blue Intensity of the blue LED component.
+ * @return size_t Number of bytes written (UART_FRAME_RGB_SIZE).
+ */
+size_t uart_frame_rgb_build(uint8_t *p_frame, uint8_t red, uint8_t green, uint8_t blue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UART_FRAME_H
@@ -36,6 +36,7 @@
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
 #include "app_error.h"
+#include "app_scheduler.h"
 #include "nrf_delay.h"
 
 // UART instance and configuration 
@@ -50,6 +51,7 @@ static volatile bool uart_tx_complete = true;
  * Prototypes for internal functions.
  */ 
 static void uart_event_handler(nrf_drv_uart_event_t * p_event, void* p_context);
+static void uart_rx_scheduled_handler(void * p_event_data, uint16_t event_size);
 
 /**
  * @brief Initialize the UART module.
@@ -162,14 +164,10 @@ static void uart_event_handler(nrf_drv_uart_event_t * p_event, void* p_context)
             break;
 
         case NRF_DRV_UART_EVT_RX_DONE:
-            // Handle incoming ACK/NAK/REJ signals from the connected device
-            uint8_t received_byte = p_event->data.rxtx.p_data[0];
-            if (received_byte == ACK) {
-                // Handle ACK received
-                NRF_LOG_INFO("ACK received: %d", received_byte); 
-            } else if (received_byte == NAK || received_byte == REJ) {
-                // Handle NAK or REJ received
-                NRF_LOG_WARNING("NAK or REJ received: %d", received_byte); 
+            // Defer the ACK/NAK/REJ handling to the main loop
+            if (app_sched_event_put(p_event->data.rxtx.p_data, sizeof(uint8_t),
+                                    uart_rx_scheduled_handler) != NRF_SUCCESS) {
+                NRF_LOG_WARNING("UART RX event dropped: scheduler queue full");
             }
             break;
 
@@ -196,6 +194,27 @@ static void uart_event_handler(nrf_drv_uart_event_t * p_event, void* p_context)
     }
 }
 
+/**
+ * @brief Scheduled handler for received UART data.
+ *
+ * Runs in the main loop context and handles incoming ACK/NAK/REJ signals from
+ * the connected device.
+ *
+ * @param p_event_data Pointer to the received byte.
+ * @param event_size Size of the event data (unused).
+ */
+static void uart_rx_scheduled_handler(void * p_event_data, uint16_t event_size) {
+    uint8_t received_byte = *(uint8_t *)p_event_data;
+
+    if (received_byte == ACK) {
+        // Handle ACK received
+        NRF_LOG_INFO("ACK received: %d", received_byte); 
+    } else if (received_byte == NAK || received_byte == REJ) {
+        // Handle NAK or REJ received
+        NRF_LOG_WARNING("NAK or REJ received: %d", received_byte); 
+    }
+}
+
 /**
  * @brief Set the 'can_send_data' flag state.
  *
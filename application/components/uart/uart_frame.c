@@ -0,0 +1,77 @@
+/**
+ * @file uart_frame.c
+ * @brief Framing of the RGB messages sent over UART.
+ * 
+ * This module builds the byte frames sent to the Arduino over UART: start byte,
+ * payload, additive checksum and stop byte. It has no SDK dependency, so the
+ * framing can be compiled and checked on any host.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-16
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "uart_frame.h"
+
+/**
+ * @brief Calculate checksum for a given set of data.
+ *
+ * Computes a checksum by summing all the bytes in the data array. This checksum
+ * is used for error-checking in communications.
+ *
+ * @param p_data Pointer to the data array.
+ * @param length Length of the data array.
+ * @return uint8_t The calculated checksum value.
+ */
+uint8_t uart_frame_checksum(const uint8_t *p_data, uint8_t length)
+{
+    uint8_t checksum = 0;
+    for (uint8_t i = 0; i < length; ++i) {
+        checksum += p_data[i];
+    }
+    return checksum;
+}
+
+/**
+ * @brief Build an RGB intensity frame.
+ *
+ * Writes the start byte, the three 8-bit intensities, the checksum of the
+ * intensities and the stop byte.
+ *
+ * @param p_frame Pointer to a buffer of at least UART_FRAME_RGB_SIZE bytes.
+ * @param red Intensity of the red LED component.
+ * @param green Intensity of the green LED component.
+ * @param blue Intensity of the blue LED component.
+ * @return size_t Number of bytes written (UART_FRAME_RGB_SIZE).
+ */
+size_t uart_frame_rgb_build(uint8_t *p_frame, uint8_t red, uint8_t green, uint8_t blue)
+{
+    p_frame[0] = START_BYTE;
+    p_frame[1] = red;
+    p_frame[2] = green;
+    p_frame[3] = blue;
+    p_frame[4] = uart_frame_checksum(&p_frame[1], 3); // checksum of RGB values
+    p_frame[5] = STOP_BYTE;
+    return UART_FRAME_RGB_SIZE;
+}
@@ -0,0 +1,331 @@
+/**
+ * @file sensor_bench.c
+ * @brief Host benchmark of the sensor pipeline and the feedback path.
+ * 
+ * Times sensor_process(), sensor_process_block(), sensor_feedback() and
+ * set_rgb_intensity() built from the firmware sources against the host
+ * stand-ins of the SDK, and reports the time per sample or call, the
+ * throughput and the heap allocations made while timing. The input is
+ * synthetic (idle electrode, proximity events over mains hum) and, with
+ * --trace, a recorded trace. The exit status is non-zero if any timed code
+ * allocated, since the firmware has no heap.
+ *
+ * Usage: sensor_bench [--samples N] [--trace FILE]
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "sensor_driver.h"
+#include "feedback_driver.h"
+#include "uart_driver.h"
+#include "sadc_driver.h"
+#include "app_error.h"
+#include "host_alloc.h"
+#include "host_signal.h"
+#include "host_stubs.h"
+#include "host_timer.h"
+
+#define BENCH_DEFAULT_SAMPLES 1000000
+#define BENCH_MAX_SAMPLES     4000000
+#define BENCH_RATE_HZ         (SAADC_SAMPLE_FREQUENCY / SENSOR_DECIMATION_RATIO) // Sensor sample rate
+#define BENCH_BLOCK           (SAADC_BUF_FRAMES / SENSOR_DECIMATION_RATIO)      // Decimated samples per SAADC buffer
+#define BENCH_LEVEL           430.0 // Idle level in counts (about 1.5 V on the SADC_SCALE_BITS scale)
+
+/**
+ * @brief Result of one timed run.
+ */
+typedef struct {
+    const char *name;   // What was timed
+    const char *unit;   // What one iteration is
+    uint64_t count;     // Iterations
+    uint64_t ns;        // Total time
+    uint64_t allocs;    // Heap allocations made while timing
+} bench_result_t;
+
+/*
+ * Global variables:
+ */
+static int16_t samples[BENCH_MAX_SAMPLES];
+static sensor_instance_t sensor;
+static uint32_t callback_count = 0;
+static bool allocation_seen = false;
+
+/*
+ * Prototypes for internal functions:
+ */
+static void counting_callback(sensor_data_t *sensor_data);
+static void bench_report(const bench_result_t *p_result);
+static void bench_input(const char *name, size_t n);
+static bench_result_t bench_sensor_process(sensor_callback_t callback, size_t n);
+static bench_result_t bench_sensor_process_block(size_t n);
+static bench_result_t bench_sensor_feedback(size_t n);
+static bench_result_t bench_set_rgb_intensity(size_t n);
+static void synthetic_idle(size_t n);
+static void synthetic_events(size_t n);
+
+int main(int argc, char **argv)
+{
+    size_t n = BENCH_DEFAULT_SAMPLES;
+    const char *p_trace = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            n = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            p_trace = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--samples N] [--trace FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (n < 2 * SENSOR_WINDOW_SIZE || n > BENCH_MAX_SAMPLES) {
+        fprintf(stderr, "--samples must be within %d..%d\n", 2 * SENSOR_WINDOW_SIZE, BENCH_MAX_SAMPLES);
+        return 2;
+    }
+
+    APP_ERROR_CHECK(uart_init());
+    printf("sensor rate %d Hz, block %d samples, window %d, %zu samples per input\n",
+           BENCH_RATE_HZ, BENCH_BLOCK, SENSOR_WINDOW_SIZE, n);
+
+    synthetic_idle(n);
+    bench_input("synthetic idle", n);
+
+    synthetic_events(n);
+    bench_input("synthetic events", n);
+
+    if (p_trace != NULL) {
+        long loaded = host_trace_load(p_trace, samples, BENCH_MAX_SAMPLES);
+        if (loaded < 2 * SENSOR_WINDOW_SIZE) {
+            fprintf(stderr, "%s: no usable trace (%ld samples)\n", p_trace, loaded);
+            return 1;
+        }
+        bench_input(p_trace, (size_t)loaded);
+    }
+
+    printf("\nfeedback\n");
+    bench_report(&(bench_result_t){ 0 });
+    bench_result_t result = bench_sensor_feedback(n);
+    bench_report(&result);
+    result = bench_set_rgb_intensity(n);
+    bench_report(&result);
+
+    if (allocation_seen) {
+        fprintf(stderr, "heap allocations in the timed code\n");
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Time the sensor pipeline on the samples loaded for an input.
+ *
+ * @param name Name of the input.
+ * @param n Number of samples.
+ */
+static void bench_input(const char *name, size_t n)
+{
+    bench_result_t result;
+
+    printf("\n%s\n", name);
+    bench_report(&(bench_result_t){ 0 });
+    result = bench_sensor_process(counting_callback, n);
+    bench_report(&result);
+    printf("  %" PRIu32 " state changes\n", callback_count);
+    result = bench_sensor_process(sensor_feedback, n);
+    result.name = "sensor_process + feedback";
+    bench_report(&result);
+    result = bench_sensor_process_block(n);
+    bench_report(&result);
+}
+
+/**
+ * @brief Print a result line, or the column header for an empty result.
+ *
+ * @param p_result The result.
+ */
+static void bench_report(const bench_result_t *p_result)
+{
+    if (p_result->count == 0) {
+        printf("  %-28s %12s %20s %8s\n", "", "time", "throughput", "allocs");
+        return;
+    }
+    double ns = (double)p_result->ns / (double)p_result->count;
+    printf("  %-28s %9.1f ns %12.0f %-7s %8" PRIu64 "\n", p_result->name, ns,
+           (ns > 0.0) ? 1e9 / ns : 0.0, p_result->unit, p_result->allocs);
+    if (p_result->allocs > 0) {
+        allocation_seen = true;
+    }
+}
+
+/**
+ * @brief Time sensor_process(), one call per sample.
+ *
+ * The instance is re-initialized first, so every run includes the initial
+ * calibration over the first SENSOR_WINDOW_SIZE samples.
+ *
+ * @param callback Callback run on state changes.
+ * @param n Number of samples.
+ * @return bench_result_t The result.
+ */
+static bench_result_t bench_sensor_process(sensor_callback_t callback, size_t n)
+{
+    bench_result_t result = { "sensor_process", "samp/s", n, 0, 0 };
+
+    sensor_init(&sensor, 0, callback);
+    callback_count = 0;
+    host_alloc_reset();
+    uint64_t start = host_time_ns();
+    for (size_t i = 0; i < n; i++) {
+        sensor_process(&sensor, &samples[i]);
+    }
+    result.ns = host_time_ns() - start;
+    result.allocs = host_alloc_count();
+    return result;
+}
+
+/**
+ * @brief Time sensor_process_block(), one call per decimated SAADC buffer.
+ *
+ * @param n Number of samples.
+ * @return bench_result_t The result, per sample.
+ */
+static bench_result_t bench_sensor_process_block(size_t n)
+{
+    bench_result_t result = { "sensor_process_block", "samp/s", n, 0, 0 };
+
+    sensor_init(&sensor, 0, counting_callback);
+    host_alloc_reset();
+    uint64_t start = host_time_ns();
+    for (size_t i = 0; i < n; i += BENCH_BLOCK) {
+        size_t block = (n - i < BENCH_BLOCK) ? n - i : BENCH_BLOCK;
+        sensor_process_block(&sensor, &samples[i], block, 1);
+    }
+    result.ns = host_time_ns() - start;
+    result.allocs = host_alloc_count();
+    return result;
+}
+
+/**
+ * @brief Time sensor_feedback() over every zone and direction.
+ *
+ * @param n Number of calls.
+ * @return bench_result_t The result.
+ */
+static bench_result_t bench_sensor_feedback(size_t n)
+{
+    bench_result_t result = { "sensor_feedback", "call/s", n, 0, 0 };
+    sensor_data_t states[2 * SENSOR_ZONE_COUNT];
+
+    for (uint8_t i = 0; i < 2 * SENSOR_ZONE_COUNT; i++) {
+        memset(&states[i], 0, sizeof(states[i]));
+        states[i].channel = FEEDBACK_CHANNEL;
+        states[i].zone = i % SENSOR_ZONE_COUNT;
+        states[i].change_state = (i < SENSOR_ZONE_COUNT) ? 1 : -1;
+        states[i].golden_reference = (int)BENCH_LEVEL;
+        states[i].sensor_reading = (int)BENCH_LEVEL + states[i].change_state * 100;
+    }
+    host_alloc_reset();
+    uint64_t start = host_time_ns();
+    for (size_t i = 0; i < n; i++) {
+        sensor_feedback(&states[i % (2 * SENSOR_ZONE_COUNT)]);
+    }
+    result.ns = host_time_ns() - start;
+    result.allocs = host_alloc_count();
+    return result;
+}
+
+/**
+ * @brief Time set_rgb_intensity(), frame building and UART hand-over.
+ *
+ * @param n Number of calls.
+ * @return bench_result_t The result.
+ */
+static bench_result_t bench_set_rgb_intensity(size_t n)
+{
+    bench_result_t result = { "set_rgb_intensity", "call/s", n, 0, 0 };
+
+    host_alloc_reset();
+    uint64_t start = host_time_ns();
+    for (size_t i = 0; i < n; i++) {
+        set_rgb_intensity((uint16_t)(i & 0xFF), (uint16_t)((i >> 8) & 0xFF), HIGH_INTENSITY);
+    }
+    result.ns = host_time_ns() - start;
+    result.allocs = host_alloc_count();
+    return result;
+}
+
+/**
+ * @brief Count the state changes reported by the sensor driver.
+ *
+ * @param sensor_data Pointer to the sensor data (unused).
+ */
+static void counting_callback(sensor_data_t *sensor_data)
+{
+    (void)sensor_data;
+    callback_count++;
+}
+
+/**
+ * @brief Idle electrode: noise and a little mains hum, no event.
+ *
+ * @param n Number of samples.
+ */
+static void synthetic_idle(size_t n)
+{
+    host_signal_t signal;
+
+    host_signal_init(&signal, BENCH_RATE_HZ, BENCH_LEVEL, 1.5, 1);
+    signal.hum_amplitude = 2.0;
+    host_signal_generate(&signal, samples, n);
+}
+
+/**
+ * @brief Proximity events of every zone, both directions, over mains hum.
+ *
+ * One event every 2.5 s, cycling through outer, inner and touch amplitudes
+ * above and below the idle level.
+ *
+ * @param n Number of samples.
+ */
+static void synthetic_events(size_t n)
+{
+    static const double amplitudes[] = { 40.0, 80.0, 160.0, -40.0, -80.0, -160.0 };
+    host_signal_t signal;
+    uint32_t spacing = 5 * BENCH_RATE_HZ / 2;
+
+    host_signal_init(&signal, BENCH_RATE_HZ, BENCH_LEVEL, 1.5, 2);
+    signal.hum_amplitude = 6.0;
+    signal.event_period = spacing * (sizeof(amplitudes) / sizeof(amplitudes[0]));
+    for (uint32_t i = 0; i < sizeof(amplitudes) / sizeof(amplitudes[0]); i++) {
+        host_signal_event_add(&signal, i * spacing + spacing / 2, BENCH_RATE_HZ / 10, BENCH_RATE_HZ, amplitudes[i]);
+    }
+    host_signal_generate(&signal, samples, n);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file window_bench.c
+ * @brief Host benchmark of the sliding-window statistics.
+ * 
+ * Times the per-sample cost of sensor_window (push, then average, minimum
+ * and maximum, as the sensor driver reads them) against a walk over the whole
+ * window, which is what the driver did before. The host build compiles it
+ * once per window length; the window engine should cost the same at every
+ * length while the walk grows with it.
+ *
+ * Usage: window_bench_<length> [--samples N]
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sensor_window.h"
+#include "host_timer.h"
+
+#define BENCH_DEFAULT_SAMPLES 2000000
+#define BENCH_SIGNAL_SIZE     4096 // Samples cycled through, a power of two
+
+/*
+ * Global variables:
+ */
+static int32_t signal[BENCH_SIGNAL_SIZE];
+static int32_t ring[SENSOR_WINDOW_SIZE];
+static sensor_window_t window;
+static volatile int32_t sink;
+
+int main(int argc, char **argv)
+{
+    size_t n = BENCH_DEFAULT_SAMPLES;
+
+    if (argc == 3 && strcmp(argv[1], "--samples") == 0) {
+        n = strtoul(argv[2], NULL, 10);
+    }
+    for (int i = 0; i < BENCH_SIGNAL_SIZE; i++) {
+        signal[i] = 430 + (rand() % 9) - 4;
+    }
+
+    // Window engine: constant work per sample
+    sensor_window_init(&window);
+    uint64_t start = host_time_ns();
+    for (size_t i = 0; i < n; i++) {
+        sensor_window_push(&window, signal[i & (BENCH_SIGNAL_SIZE - 1)]);
+        sink = sensor_window_average(&window) + sensor_window_min(&window) + sensor_window_max(&window);
+    }
+    double engine_ns = (double)(host_time_ns() - start) / (double)n;
+
+    // Full walk over the window after every sample
+    memset(ring, 0, sizeof(ring));
+    start = host_time_ns();
+    for (size_t i = 0; i < n; i++) {
+        ring[i % SENSOR_WINDOW_SIZE] = signal[i & (BENCH_SIGNAL_SIZE - 1)];
+        int32_t total = 0;
+        int32_t min = ring[0];
+        int32_t max = ring[0];
+        for (int k = 0; k < SENSOR_WINDOW_SIZE; k++) {
+            total += ring[k];
+            min = (ring[k] < min) ? ring[k] : min;
+            max = (ring[k] > max) ? ring[k] : max;
+        }
+        sink = total / SENSOR_WINDOW_SIZE + min + max;
+    }
+    double walk_ns = (double)(host_time_ns() - start) / (double)n;
+
+    printf("window %4d: sensor_window %6.1f ns/sample, full walk %8.1f ns/sample\n",
+           SENSOR_WINDOW_SIZE, engine_ns, walk_ns);
+    return 0;
+}
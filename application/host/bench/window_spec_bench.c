@@ -0,0 +1,166 @@
+/**
+ * @file window_spec_bench.c
+ * @brief Host benchmark of the window length specializations.
+ * 
+ * sensor_config.h fixes the window length at compile time, so ring wraps use
+ * a mask and the average a shift when the length is a power of two, and a
+ * precomputed reciprocal multiply otherwise. This benchmark first checks the
+ * specialized average against a division for every total the window can
+ * hold, then times the wrap and the average against the generic path, which
+ * takes the length at run time and uses % and /. The constant-divisor column
+ * shows what the compiler makes of / SENSOR_WINDOW_SIZE on its own. The host
+ * build compiles it once per window length.
+ *
+ * Usage: window_spec_bench_<length> [--samples N]
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sensor_window.h"
+#include "host_timer.h"
+
+#define BENCH_DEFAULT_SAMPLES 10000000
+#define BENCH_TOTALS          4096 // Window totals cycled through, a power of two
+
+/*
+ * Global variables:
+ */
+static int32_t totals[BENCH_TOTALS];
+static sensor_window_t window;
+static volatile uint16_t runtime_length = SENSOR_WINDOW_SIZE; // Length of the generic path, unknown to the compiler
+static volatile int32_t sink;
+
+/*
+ * Prototypes for internal functions:
+ */
+static uint32_t check_average(void);
+static double time_average(int32_t (*average)(const sensor_window_t *p_window), size_t n);
+static int32_t average_constant(const sensor_window_t *p_window);
+static int32_t average_generic(const sensor_window_t *p_window);
+static double time_wrap_specialized(size_t n);
+static double time_wrap_generic(size_t n);
+
+int main(int argc, char **argv)
+{
+    size_t n = BENCH_DEFAULT_SAMPLES;
+
+    if (argc == 3 && strcmp(argv[1], "--samples") == 0) {
+        n = strtoul(argv[2], NULL, 10);
+    }
+    // Totals of full windows of 14-bit readings, both signs
+    for (int i = 0; i < BENCH_TOTALS; i++) {
+        totals[i] = ((rand() % 32768) - 16384) * SENSOR_WINDOW_SIZE + (rand() % SENSOR_WINDOW_SIZE);
+    }
+
+    uint32_t mismatches = check_average();
+    printf("window %4d (%s): average %5.2f ns specialized, %5.2f ns constant divisor, %5.2f ns generic; "
+           "wrap %5.2f ns specialized, %5.2f ns generic; %u mismatches\n",
+           SENSOR_WINDOW_SIZE, SENSOR_WINDOW_IS_POW2 ? "mask and shift" : "reciprocal",
+           time_average(sensor_window_average, n), time_average(average_constant, n), time_average(average_generic, n),
+           time_wrap_specialized(n), time_wrap_generic(n), mismatches);
+    return (mismatches == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Compare the specialized average with a division for every possible total.
+ *
+ * @return uint32_t Number of totals where they differ.
+ */
+static uint32_t check_average(void)
+{
+    const int32_t limit = (1 << SENSOR_WINDOW_DIVIDEND_BITS) - 1;
+    uint32_t mismatches = 0;
+
+    sensor_window_init(&window);
+    for (int32_t total = -limit; total <= limit; total++) {
+        window.total = total;
+        mismatches += (sensor_window_average(&window) != total / runtime_length) ? 1 : 0;
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Time an average through a function pointer, so every variant pays the same call.
+ *
+ * @param average Average of a window.
+ * @param n Number of averages.
+ * @return double Nanoseconds per average.
+ */
+static double time_average(int32_t (*average)(const sensor_window_t *p_window), size_t n)
+{
+    int32_t (*volatile call)(const sensor_window_t *p_window) = average;
+    int32_t accumulator = 0;
+    uint64_t start = host_time_ns();
+    for (size_t i = 0; i < n; i++) {
+        window.total = totals[i & (BENCH_TOTALS - 1)];
+        accumulator += call(&window);
+    }
+    sink = accumulator;
+    return (double)(host_time_ns() - start) / (double)n;
+}
+
+static int32_t average_constant(const sensor_window_t *p_window)
+{
+    return p_window->total / SENSOR_WINDOW_SIZE;
+}
+
+static int32_t average_generic(const sensor_window_t *p_window)
+{
+    return p_window->total / runtime_length;
+}
+
+// Ring positions advanced by one to four slots, each wrap depending on the previous one
+static double time_wrap_specialized(size_t n)
+{
+    uint32_t position = 0;
+    uint64_t start = host_time_ns();
+    for (size_t i = 0; i < n; i++) {
+        position += 1 + (totals[i & (BENCH_TOTALS - 1)] & 3);
+#if SENSOR_WINDOW_IS_POW2
+        position &= SENSOR_WINDOW_MASK;
+#else
+        position = (position >= SENSOR_WINDOW_SIZE) ? position - SENSOR_WINDOW_SIZE : position;
+#endif
+    }
+    sink = (int32_t)position;
+    return (double)(host_time_ns() - start) / (double)n;
+}
+
+static double time_wrap_generic(size_t n)
+{
+    const uint32_t length = runtime_length;
+    uint32_t position = 0;
+    uint64_t start = host_time_ns();
+    for (size_t i = 0; i < n; i++) {
+        position = (position + 1 + (totals[i & (BENCH_TOTALS - 1)] & 3)) % length;
+    }
+    sink = (int32_t)position;
+    return (double)(host_time_ns() - start) / (double)n;
+}
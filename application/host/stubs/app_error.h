@@ -0,0 +1,37 @@
+#ifndef HOST_APP_ERROR_H
+#define HOST_APP_ERROR_H
+
+// Host stand-in for app_error.h: a failed check reports where and aborts.
+
+#include <stdint.h>
+#include "sdk_errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void app_error_handler(ret_code_t error_code, uint32_t line_num, const uint8_t *p_file_name);
+
+#define APP_ERROR_HANDLER(err_code) \
+    app_error_handler((err_code), __LINE__, (const uint8_t *)__FILE__)
+
+#define APP_ERROR_CHECK(err_code)                   \
+    do {                                            \
+        const uint32_t local_err_code = (err_code); \
+        if (local_err_code != NRF_SUCCESS) {        \
+            APP_ERROR_HANDLER(local_err_code);      \
+        }                                           \
+    } while (0)
+
+#define APP_ERROR_CHECK_BOOL(boolean_value)         \
+    do {                                            \
+        if (!(boolean_value)) {                     \
+            APP_ERROR_HANDLER(0);                   \
+        }                                           \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_APP_ERROR_H
@@ -0,0 +1,34 @@
+#ifndef HOST_APP_SCHEDULER_H
+#define HOST_APP_SCHEDULER_H
+
+// Host stand-in for app_scheduler.h: a fixed FIFO of work items run by
+// app_sched_execute(), like the SDK scheduler.
+
+#include <stdint.h>
+#include "sdk_errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_SCHED_QUEUE_SIZE     32 // Work items queued at most
+#define HOST_SCHED_MAX_EVENT_SIZE 8  // Largest event payload in bytes
+
+typedef void (*app_sched_event_handler_t)(void *p_event_data, uint16_t event_size);
+
+#define APP_SCHED_INIT(EVENT_SIZE, QUEUE_SIZE) \
+    APP_ERROR_CHECK(app_sched_init((EVENT_SIZE), (QUEUE_SIZE), NULL))
+
+uint32_t app_sched_init(uint16_t max_event_size, uint16_t queue_size, void *p_evt_buffer);
+
+uint32_t app_sched_event_put(void const *p_event_data, uint16_t event_size, app_sched_event_handler_t handler);
+
+void app_sched_execute(void);
+
+uint16_t app_sched_queue_utilization_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_APP_SCHEDULER_H
@@ -0,0 +1,17 @@
+#ifndef HOST_APP_UTIL_PLATFORM_H
+#define HOST_APP_UTIL_PLATFORM_H
+
+// Host stand-in for app_util_platform.h. The host has no interrupts: the
+// simulated peripherals call their handlers from the thread driving them, so
+// a critical region is only a compiler barrier.
+
+#define APP_IRQ_PRIORITY_HIGHEST 0
+#define APP_IRQ_PRIORITY_HIGH    2
+#define APP_IRQ_PRIORITY_MID     4
+#define APP_IRQ_PRIORITY_LOW     6
+#define APP_IRQ_PRIORITY_LOWEST  7
+
+#define CRITICAL_REGION_ENTER() __asm__ volatile("" ::: "memory")
+#define CRITICAL_REGION_EXIT()  __asm__ volatile("" ::: "memory")
+
+#endif // HOST_APP_UTIL_PLATFORM_H
@@ -0,0 +1,90 @@
+/**
+ * @file host_alloc.c
+ * @brief Heap allocation counters of the host build.
+ * 
+ * The firmware never allocates: every buffer is static or owned by the caller.
+ * The host build checks it by linking its benchmarks with --wrap for the C
+ * allocator, so every allocation made while they run is counted here.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "host_alloc.h"
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *p, size_t size);
+void __real_free(void *p);
+
+/*
+ * Global variables:
+ */
+static uint64_t alloc_count = 0;
+static uint64_t alloc_bytes = 0;
+
+void *__wrap_malloc(size_t size)
+{
+    alloc_count++;
+    alloc_bytes += size;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    alloc_count++;
+    alloc_bytes += (uint64_t)count * size;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *p, size_t size)
+{
+    alloc_count++;
+    alloc_bytes += size;
+    return __real_realloc(p, size);
+}
+
+void __wrap_free(void *p)
+{
+    __real_free(p);
+}
+
+uint64_t host_alloc_count(void)
+{
+    return alloc_count;
+}
+
+uint64_t host_alloc_bytes(void)
+{
+    return alloc_bytes;
+}
+
+void host_alloc_reset(void)
+{
+    alloc_count = 0;
+    alloc_bytes = 0;
+}
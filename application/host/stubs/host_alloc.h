@@ -0,0 +1,36 @@
+#ifndef HOST_ALLOC_H
+#define HOST_ALLOC_H
+
+// Heap use of the host build: executables linked with the host_alloc library
+// route malloc, calloc, realloc and free through counting wrappers.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the number of allocations (malloc, calloc, realloc) since the last reset.
+ *
+ * @return uint64_t The allocation count.
+ */
+uint64_t host_alloc_count(void);
+
+/**
+ * @brief Get the number of bytes requested by those allocations.
+ *
+ * @return uint64_t The byte count.
+ */
+uint64_t host_alloc_bytes(void);
+
+/**
+ * @brief Reset the counters.
+ */
+void host_alloc_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_ALLOC_H
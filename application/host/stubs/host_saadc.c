@@ -0,0 +1,1103 @@
+/**
+ * @file host_saadc.c
+ * @brief Host simulation of the SAADC, LPCOMP, TIMER and PPI peripherals.
+ * 
+ * The nrfx_saadc.h, nrfx_lpcomp.h, nrfx_timer.h and nrfx_ppi.h stand-ins are
+ * implemented here on top of a small register model, so sadc_driver.c and
+ * lpcomp_driver.c run unchanged on the host. The SAADC converts the inputs set with host_saadc_input_set() on
+ * every SAMPLE task, writes them through EasyDMA and compares them with the
+ * channel limits; the nrfx layer follows the advanced mode of nrfx 2.x with
+ * double buffering and START on END. TIMERs count the simulated time or their
+ * COUNT tasks and PPI channels connect events to tasks. The LPCOMP compares
+ * the input set with host_lpcomp_input_set() with its supply fraction.
+ * Interrupts are only taken between two simulation steps, never from inside a
+ * call of the code under test, and are counted so a test can tell how often
+ * the CPU was woken.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <string.h>
+
+#include "host_saadc.h"
+
+#define SAADC_CHANNELS    8
+#define TICKS_PER_US      16 // The simulated time runs on the 16 MHz TIMER clock
+
+// Event and task addresses handed to PPI: kind, instance and index
+#define ADDR_SAADC_TASK   1
+#define ADDR_SAADC_EVENT  2
+#define ADDR_TIMER_TASK   3
+#define ADDR_TIMER_EVENT  4
+#define ADDR_LPCOMP_EVENT 5
+#define ADDR(kind, instance, index) (((uint32_t)(kind) << 16) | ((uint32_t)(instance) << 8) | (uint32_t)(index))
+#define ADDR_KIND(address)     ((address) >> 16)
+#define ADDR_INSTANCE(address) (((address) >> 8) & 0xFF)
+#define ADDR_INDEX(address)    ((address) & 0xFF)
+
+typedef struct {
+    bool initialized;
+    bool running;
+    nrf_timer_mode_t mode;
+    nrf_timer_frequency_t frequency;
+    uint32_t mask;                      // Counter range of the bit width
+    uint64_t ticks;                     // 16 MHz ticks since the last clear, timer mode
+    uint32_t counter;                   // COUNT tasks since the last clear, counter modes
+    uint32_t cc[HOST_TIMER_CC_COUNT];
+    uint32_t shorts;
+    uint32_t inten;                     // Bit per compare channel
+    uint32_t events;                    // Bit per compare channel
+    nrfx_timer_event_handler_t handler;
+    void *p_context;
+} sim_timer_t;
+
+typedef struct {
+    bool initialized;
+    bool running;
+    bool above;                         // Comparator output
+    bool hysteresis;
+    uint8_t sixteenths;                 // Reference in sixteenths of the supply
+    uint32_t events;                    // Bit per nrf_lpcomp_event_t
+    uint32_t inten;                     // Bit per nrf_lpcomp_event_t
+    int32_t input_mv;
+    nrfx_lpcomp_event_handler_t handler;
+} sim_lpcomp_t;
+
+typedef struct {
+    bool allocated;
+    bool enabled;
+    uint32_t eep;
+    uint32_t tep;
+    uint32_t fork_tep;
+} sim_ppi_t;
+
+typedef struct {
+    // Registers
+    uint32_t events;                          // Bit per nrf_saadc_event_t
+    uint32_t inten;                           // NRF_SAADC_INT_* mask
+    uint8_t limit_events[SAADC_CHANNELS];     // Bit per nrf_saadc_limit_t
+    uint8_t limit_inten[SAADC_CHANNELS];      // Bit per nrf_saadc_limit_t
+    int16_t limit_low[SAADC_CHANNELS];
+    int16_t limit_high[SAADC_CHANNELS];
+    nrf_saadc_resolution_t resolution;
+    nrf_saadc_value_t *p_ptr;                 // RESULT.PTR
+    uint32_t maxcnt;                          // RESULT.MAXCNT
+    // EasyDMA transfer latched by START
+    nrf_saadc_value_t *p_dma;
+    uint32_t dma_size;
+    uint32_t amount;
+    bool dma_busy;
+    bool calibrating;
+    int16_t inputs[SAADC_CHANNELS];
+    // nrfx driver
+    bool initialized;
+    bool advanced;
+    bool sampling;
+    bool start_on_end;
+    uint32_t channel_mask;
+    nrf_saadc_value_t *p_primary;
+    nrf_saadc_value_t *p_secondary;
+    uint16_t primary_size;
+    uint16_t secondary_size;
+    nrfx_saadc_event_handler_t handler;
+    nrfx_saadc_event_handler_t calib_handler;
+} sim_saadc_t;
+
+/*
+ * Global variables:
+ */
+static sim_saadc_t saadc;
+static sim_timer_t timers[HOST_TIMER_COUNT];
+static sim_ppi_t ppi[HOST_PPI_CHANNEL_COUNT];
+static sim_lpcomp_t lpcomp;
+static uint64_t now_ticks = 0;
+static bool in_irq = false;
+static host_saadc_stats_t stats;
+
+/*
+ * Prototypes for internal functions:
+ */
+static void saadc_event_raise(nrf_saadc_event_t event);
+static void saadc_sample(void);
+static bool saadc_irq_pending(void);
+static void saadc_irq(void);
+static void saadc_evt_send(nrfx_saadc_evt_type_t type);
+static void lpcomp_event_raise(nrf_lpcomp_event_t event);
+static void lpcomp_compare(void);
+static void lpcomp_irq(void);
+static void timer_compare_raise(uint8_t id, uint8_t channel);
+static void timer_count(uint8_t id);
+static uint32_t timer_value(const sim_timer_t *p_timer);
+static bool timer_irq(void);
+static sim_timer_t *pacing_timer(uint64_t *p_remaining);
+static void time_advance(uint64_t ticks);
+static void ppi_event(uint32_t eep);
+static void task_run(uint32_t tep);
+static void irq_dispatch(void);
+
+void host_saadc_reset(void)
+{
+    memset(&saadc, 0, sizeof(saadc));
+    for (uint8_t ch = 0; ch < SAADC_CHANNELS; ch++) {
+        saadc.limit_low[ch] = INT16_MIN;
+        saadc.limit_high[ch] = INT16_MAX;
+    }
+    memset(timers, 0, sizeof(timers));
+    memset(ppi, 0, sizeof(ppi));
+    memset(&lpcomp, 0, sizeof(lpcomp));
+    memset(&stats, 0, sizeof(stats));
+    now_ticks = 0;
+    in_irq = false;
+}
+
+void host_saadc_input_set(uint8_t channel, int16_t level)
+{
+    if (channel < SAADC_CHANNELS) {
+        saadc.inputs[channel] = level;
+    }
+}
+
+void host_lpcomp_input_set(int32_t level_mv)
+{
+    lpcomp.input_mv = level_mv;
+    lpcomp_compare();
+    irq_dispatch();
+}
+
+void host_saadc_advance_us(uint32_t us)
+{
+    time_advance((uint64_t)us * TICKS_PER_US);
+}
+
+uint32_t host_saadc_run(uint32_t periods)
+{
+    uint32_t done;
+
+    for (done = 0; done < periods; done++) {
+        if (saadc.calibrating) {
+            // The offset calibration takes less than a scan period
+            saadc.calibrating = false;
+            saadc_event_raise(NRF_SAADC_EVENT_CALIBRATEDONE);
+        }
+        irq_dispatch();
+
+        uint64_t remaining = 0;
+        sim_timer_t *p_pacing = pacing_timer(&remaining);
+        if (p_pacing == NULL) {
+            break;
+        }
+        time_advance(remaining);
+        p_pacing->ticks = 0;
+        timer_compare_raise((uint8_t)(p_pacing - timers), 0);
+        irq_dispatch();
+    }
+    return done;
+}
+
+void host_saadc_irq_flush(void)
+{
+    irq_dispatch();
+}
+
+host_saadc_stats_t host_saadc_stats(void)
+{
+    return stats;
+}
+
+bool host_saadc_limits_get(uint8_t channel, int16_t *p_low, int16_t *p_high)
+{
+    if (channel >= SAADC_CHANNELS) {
+        return false;
+    }
+    *p_low = saadc.limit_low[channel];
+    *p_high = saadc.limit_high[channel];
+    return saadc.limit_inten[channel] != 0;
+}
+
+uint64_t host_saadc_time_us(void)
+{
+    return now_ticks / TICKS_PER_US;
+}
+
+/*
+ * nrfx_saadc.h, advanced mode
+ */
+
+nrfx_err_t nrfx_saadc_init(uint8_t interrupt_priority)
+{
+    (void)interrupt_priority;
+    if (saadc.initialized) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    saadc.initialized = true;
+    return NRFX_SUCCESS;
+}
+
+void nrfx_saadc_uninit(void)
+{
+    nrfx_saadc_abort();
+    saadc.initialized = false;
+    saadc.advanced = false;
+}
+
+nrfx_err_t nrfx_saadc_channels_config(nrfx_saadc_channel_t const *p_channels, uint32_t channel_count)
+{
+    if (!saadc.initialized || saadc.sampling) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    for (uint32_t i = 0; i < channel_count; i++) {
+        if (p_channels[i].channel_index >= SAADC_CHANNELS) {
+            return NRFX_ERROR_INVALID_PARAM;
+        }
+    }
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_saadc_advanced_mode_set(uint32_t channel_mask, nrf_saadc_resolution_t resolution,
+                                        nrfx_saadc_adv_config_t const *p_config,
+                                        nrfx_saadc_event_handler_t event_handler)
+{
+    if (!saadc.initialized) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    if (saadc.sampling || saadc.calibrating) {
+        return NRFX_ERROR_BUSY;
+    }
+    saadc.channel_mask = channel_mask;
+    saadc.resolution = resolution;
+    saadc.start_on_end = p_config->start_on_end;
+    saadc.handler = event_handler;
+    saadc.p_primary = NULL;
+    saadc.p_secondary = NULL;
+    saadc.advanced = true;
+    saadc.inten |= NRF_SAADC_INT_STARTED | NRF_SAADC_INT_END | NRF_SAADC_INT_STOPPED;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_saadc_buffer_set(nrf_saadc_value_t *p_buffer, uint16_t size)
+{
+    if (!saadc.advanced) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    if (saadc.p_secondary != NULL) {
+        return NRFX_ERROR_ALREADY_INITIALIZED;
+    }
+    if (saadc.p_primary == NULL) {
+        saadc.p_primary = p_buffer;
+        saadc.primary_size = size;
+    } else {
+        // While sampling EasyDMA takes the next buffer on START
+        saadc.p_secondary = p_buffer;
+        saadc.secondary_size = size;
+        if (saadc.sampling) {
+            nrf_saadc_buffer_init(p_buffer, size);
+        }
+    }
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_saadc_mode_trigger(void)
+{
+    if (!saadc.advanced || saadc.p_primary == NULL) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    if (saadc.sampling) {
+        return NRFX_ERROR_BUSY;
+    }
+    saadc.sampling = true;
+    nrf_saadc_buffer_init(saadc.p_primary, saadc.primary_size);
+    nrf_saadc_task_trigger(NRF_SAADC_TASK_START);
+    return NRFX_SUCCESS;
+}
+
+void nrfx_saadc_abort(void)
+{
+    nrf_saadc_task_trigger(NRF_SAADC_TASK_STOP);
+    nrf_saadc_event_clear(NRF_SAADC_EVENT_STOPPED);
+    saadc.sampling = false;
+    saadc.p_primary = NULL;
+    saadc.p_secondary = NULL;
+}
+
+nrfx_err_t nrfx_saadc_limits_set(uint8_t channel, int16_t limit_low, int16_t limit_high)
+{
+    if (channel >= SAADC_CHANNELS) {
+        return NRFX_ERROR_INVALID_PARAM;
+    }
+    saadc.limit_low[channel] = limit_low;
+    saadc.limit_high[channel] = limit_high;
+    // A limit at the end of the range is disabled; an armed one starts from a cleared event
+    saadc.limit_inten[channel] = 0;
+    if (limit_low != INT16_MIN) {
+        saadc.limit_events[channel] &= (uint8_t)~(1u << NRF_SAADC_LIMIT_LOW);
+        saadc.limit_inten[channel] |= 1u << NRF_SAADC_LIMIT_LOW;
+    }
+    if (limit_high != INT16_MAX) {
+        saadc.limit_events[channel] &= (uint8_t)~(1u << NRF_SAADC_LIMIT_HIGH);
+        saadc.limit_inten[channel] |= 1u << NRF_SAADC_LIMIT_HIGH;
+    }
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_saadc_offset_calibrate(nrfx_saadc_event_handler_t calib_event_handler)
+{
+    if (!saadc.initialized) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    if (saadc.sampling || saadc.calibrating) {
+        return NRFX_ERROR_BUSY;
+    }
+    saadc.calib_handler = calib_event_handler;
+    saadc.inten |= NRF_SAADC_INT_CALIBRATEDONE;
+    nrf_saadc_task_trigger(NRF_SAADC_TASK_CALIBRATEOFFSET);
+    return NRFX_SUCCESS;
+}
+
+/*
+ * SAADC HAL
+ */
+
+void nrf_saadc_task_trigger(nrf_saadc_task_t task)
+{
+    switch (task) {
+        case NRF_SAADC_TASK_START:
+            if (saadc.calibrating) {
+                break;
+            }
+            saadc.p_dma = saadc.p_ptr;
+            saadc.dma_size = saadc.maxcnt;
+            saadc.amount = 0;
+            saadc.dma_busy = true;
+            saadc_event_raise(NRF_SAADC_EVENT_STARTED);
+            break;
+
+        case NRF_SAADC_TASK_SAMPLE:
+            saadc_sample();
+            break;
+
+        case NRF_SAADC_TASK_STOP:
+            saadc.dma_busy = false;
+            saadc_event_raise(NRF_SAADC_EVENT_STOPPED);
+            break;
+
+        case NRF_SAADC_TASK_CALIBRATEOFFSET:
+            saadc.calibrating = true;
+            break;
+    }
+}
+
+uint32_t nrf_saadc_task_address_get(nrf_saadc_task_t task)
+{
+    return ADDR(ADDR_SAADC_TASK, 0, task);
+}
+
+bool nrf_saadc_event_check(nrf_saadc_event_t event)
+{
+    return (saadc.events & (1u << event)) != 0;
+}
+
+void nrf_saadc_event_clear(nrf_saadc_event_t event)
+{
+    saadc.events &= ~(1u << event);
+}
+
+uint32_t nrf_saadc_event_address_get(nrf_saadc_event_t event)
+{
+    return ADDR(ADDR_SAADC_EVENT, 0, event);
+}
+
+void nrf_saadc_int_enable(uint32_t mask)
+{
+    saadc.inten |= mask;
+}
+
+uint32_t nrf_saadc_int_enable_check(uint32_t mask)
+{
+    return saadc.inten & mask;
+}
+
+void nrf_saadc_int_disable(uint32_t mask)
+{
+    saadc.inten &= ~mask;
+}
+
+void nrf_saadc_buffer_init(nrf_saadc_value_t *p_buffer, uint32_t size)
+{
+    saadc.p_ptr = p_buffer;
+    saadc.maxcnt = size;
+}
+
+void nrf_saadc_resolution_set(nrf_saadc_resolution_t resolution)
+{
+    saadc.resolution = resolution;
+}
+
+void nrf_saadc_oversample_set(nrf_saadc_oversample_t oversample)
+{
+    // A constant input averages to itself
+    (void)oversample;
+}
+
+/*
+ * nrfx_lpcomp.h
+ */
+
+nrfx_err_t nrfx_lpcomp_init(nrfx_lpcomp_config_t const *p_config, nrfx_lpcomp_event_handler_t event_handler)
+{
+    // Sixteenths of the supply per nrf_lpcomp_ref_t, 0 for the external references
+    static const uint8_t sixteenths[] = { 2, 4, 6, 8, 10, 12, 14, 0, 1, 3, 5, 7, 9, 11, 13, 15 };
+    static const uint32_t detection_inten[] = {
+        1u << NRF_LPCOMP_EVENT_CROSS, 1u << NRF_LPCOMP_EVENT_UP, 1u << NRF_LPCOMP_EVENT_DOWN
+    };
+
+    if (lpcomp.initialized) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    int32_t input_mv = lpcomp.input_mv;
+    memset(&lpcomp, 0, sizeof(lpcomp));
+    lpcomp.initialized = true;
+    lpcomp.input_mv = input_mv;
+    lpcomp.sixteenths = sixteenths[p_config->hal.reference];
+    lpcomp.hysteresis = (p_config->hal.hyst == NRF_LPCOMP_HYST_50mV);
+    lpcomp.inten = detection_inten[p_config->hal.detection];
+    lpcomp.handler = event_handler;
+    return NRFX_SUCCESS;
+}
+
+void nrfx_lpcomp_uninit(void)
+{
+    nrfx_lpcomp_disable();
+    lpcomp.initialized = false;
+}
+
+void nrfx_lpcomp_enable(void)
+{
+    // START: the output settles on the side of the input, READY without interrupt
+    lpcomp.running = true;
+    lpcomp.above = (lpcomp.input_mv * 16 > (int32_t)lpcomp.sixteenths * HOST_LPCOMP_VDD_MV);
+    lpcomp_event_raise(NRF_LPCOMP_EVENT_READY);
+}
+
+void nrfx_lpcomp_disable(void)
+{
+    lpcomp.running = false;
+    lpcomp.events = 0;
+}
+
+uint32_t nrf_lpcomp_event_address_get(nrf_lpcomp_event_t event)
+{
+    return ADDR(ADDR_LPCOMP_EVENT, 0, event);
+}
+
+/*
+ * nrfx_timer.h
+ */
+
+nrfx_err_t nrfx_timer_init(nrfx_timer_t const *p_instance, nrfx_timer_config_t const *p_config,
+                           nrfx_timer_event_handler_t timer_event_handler)
+{
+    static const uint32_t masks[] = { UINT16_MAX, UINT8_MAX, 0xFFFFFFu, UINT32_MAX };
+    sim_timer_t *p_timer = &timers[p_instance->instance_id];
+
+    if (p_timer->initialized) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    memset(p_timer, 0, sizeof(*p_timer));
+    p_timer->initialized = true;
+    p_timer->mode = p_config->mode;
+    p_timer->frequency = p_config->frequency;
+    p_timer->mask = masks[p_config->bit_width];
+    p_timer->handler = timer_event_handler;
+    p_timer->p_context = p_config->p_context;
+    return NRFX_SUCCESS;
+}
+
+void nrfx_timer_uninit(nrfx_timer_t const *p_instance)
+{
+    timers[p_instance->instance_id].initialized = false;
+    timers[p_instance->instance_id].running = false;
+}
+
+void nrfx_timer_enable(nrfx_timer_t const *p_instance)
+{
+    task_run(nrfx_timer_task_address_get(p_instance, NRF_TIMER_TASK_START));
+}
+
+void nrfx_timer_disable(nrfx_timer_t const *p_instance)
+{
+    task_run(nrfx_timer_task_address_get(p_instance, NRF_TIMER_TASK_SHUTDOWN));
+}
+
+void nrfx_timer_pause(nrfx_timer_t const *p_instance)
+{
+    task_run(nrfx_timer_task_address_get(p_instance, NRF_TIMER_TASK_STOP));
+}
+
+void nrfx_timer_resume(nrfx_timer_t const *p_instance)
+{
+    task_run(nrfx_timer_task_address_get(p_instance, NRF_TIMER_TASK_START));
+}
+
+void nrfx_timer_clear(nrfx_timer_t const *p_instance)
+{
+    task_run(nrfx_timer_task_address_get(p_instance, NRF_TIMER_TASK_CLEAR));
+}
+
+uint32_t nrfx_timer_capture(nrfx_timer_t const *p_instance, nrf_timer_cc_channel_t cc_channel)
+{
+    task_run(nrfx_timer_capture_task_address_get(p_instance, cc_channel));
+    return timers[p_instance->instance_id].cc[cc_channel];
+}
+
+uint32_t nrfx_timer_capture_get(nrfx_timer_t const *p_instance, nrf_timer_cc_channel_t cc_channel)
+{
+    return timers[p_instance->instance_id].cc[cc_channel];
+}
+
+void nrfx_timer_compare(nrfx_timer_t const *p_instance, nrf_timer_cc_channel_t cc_channel,
+                        uint32_t cc_value, bool enable_int)
+{
+    sim_timer_t *p_timer = &timers[p_instance->instance_id];
+
+    p_timer->cc[cc_channel] = cc_value;
+    p_timer->events &= ~(1u << cc_channel);
+    if (enable_int) {
+        p_timer->inten |= 1u << cc_channel;
+    } else {
+        p_timer->inten &= ~(1u << cc_channel);
+    }
+}
+
+void nrfx_timer_extended_compare(nrfx_timer_t const *p_instance, nrf_timer_cc_channel_t cc_channel,
+                                 uint32_t cc_value, nrf_timer_short_mask_t timer_short_mask, bool enable_int)
+{
+    sim_timer_t *p_timer = &timers[p_instance->instance_id];
+    uint32_t channel_shorts = (NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK | NRF_TIMER_SHORT_COMPARE0_STOP_MASK) << cc_channel;
+
+    p_timer->shorts = (p_timer->shorts & ~channel_shorts) | ((uint32_t)timer_short_mask & channel_shorts);
+    nrfx_timer_compare(p_instance, cc_channel, cc_value, enable_int);
+}
+
+uint32_t nrfx_timer_task_address_get(nrfx_timer_t const *p_instance, nrf_timer_task_t timer_task)
+{
+    return ADDR(ADDR_TIMER_TASK, p_instance->instance_id, timer_task);
+}
+
+uint32_t nrfx_timer_capture_task_address_get(nrfx_timer_t const *p_instance, uint32_t channel)
+{
+    return ADDR(ADDR_TIMER_TASK, p_instance->instance_id, NRF_TIMER_TASK_CAPTURE0 + channel);
+}
+
+uint32_t nrfx_timer_compare_event_address_get(nrfx_timer_t const *p_instance, uint32_t channel)
+{
+    return ADDR(ADDR_TIMER_EVENT, p_instance->instance_id, channel);
+}
+
+/*
+ * nrfx_ppi.h
+ */
+
+nrfx_err_t nrfx_ppi_channel_alloc(nrf_ppi_channel_t *p_channel)
+{
+    for (uint8_t ch = 0; ch < HOST_PPI_CHANNEL_COUNT; ch++) {
+        if (!ppi[ch].allocated) {
+            memset(&ppi[ch], 0, sizeof(ppi[ch]));
+            ppi[ch].allocated = true;
+            *p_channel = (nrf_ppi_channel_t)ch;
+            return NRFX_SUCCESS;
+        }
+    }
+    return NRFX_ERROR_NO_MEM;
+}
+
+nrfx_err_t nrfx_ppi_channel_free(nrf_ppi_channel_t channel)
+{
+    if (channel >= HOST_PPI_CHANNEL_COUNT || !ppi[channel].allocated) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    ppi[channel].allocated = false;
+    ppi[channel].enabled = false;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_channel_assign(nrf_ppi_channel_t channel, uint32_t eep, uint32_t tep)
+{
+    if (channel >= HOST_PPI_CHANNEL_COUNT || !ppi[channel].allocated) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    ppi[channel].eep = eep;
+    ppi[channel].tep = tep;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_channel_fork_assign(nrf_ppi_channel_t channel, uint32_t fork_tep)
+{
+    if (channel >= HOST_PPI_CHANNEL_COUNT || !ppi[channel].allocated) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    ppi[channel].fork_tep = fork_tep;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_channel_enable(nrf_ppi_channel_t channel)
+{
+    if (channel >= HOST_PPI_CHANNEL_COUNT || !ppi[channel].allocated) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    ppi[channel].enabled = true;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_channel_disable(nrf_ppi_channel_t channel)
+{
+    if (channel >= HOST_PPI_CHANNEL_COUNT || !ppi[channel].allocated) {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+    ppi[channel].enabled = false;
+    return NRFX_SUCCESS;
+}
+
+/**
+ * @brief Raise a SAADC event and pass it on to PPI.
+ *
+ * @param event The event.
+ */
+static void saadc_event_raise(nrf_saadc_event_t event)
+{
+    saadc.events |= 1u << event;
+    ppi_event(nrf_saadc_event_address_get(event));
+}
+
+/**
+ * @brief Convert every enabled channel once, as a SAMPLE task does with burst mode.
+ *
+ * A channel at or above its high limit raises LIMITH, at or below its low
+ * limit LIMITL, whether the limit interrupt is enabled or not. The END event
+ * follows the conversion that fills the EasyDMA buffer.
+ */
+static void saadc_sample(void)
+{
+    uint8_t bits = (uint8_t)(8 + 2 * saadc.resolution);
+    int32_t top = (1 << bits) - 1;
+
+    if (!saadc.dma_busy) {
+        return;
+    }
+    stats.scans++;
+    for (uint8_t ch = 0; ch < SAADC_CHANNELS; ch++) {
+        if ((saadc.channel_mask & (1u << ch)) == 0) {
+            continue;
+        }
+        int32_t raw = saadc.inputs[ch] >> (HOST_SAADC_INPUT_BITS - bits);
+        nrf_saadc_value_t value = (nrf_saadc_value_t)((raw > top) ? top : raw);
+
+        if (value >= saadc.limit_high[ch]) {
+            saadc.limit_events[ch] |= 1u << NRF_SAADC_LIMIT_HIGH;
+            stats.limit_events++;
+        }
+        if (value <= saadc.limit_low[ch]) {
+            saadc.limit_events[ch] |= 1u << NRF_SAADC_LIMIT_LOW;
+            stats.limit_events++;
+        }
+        if (saadc.amount < saadc.dma_size) {
+            saadc.p_dma[saadc.amount++] = value;
+        }
+    }
+    if (saadc.amount >= saadc.dma_size) {
+        saadc.dma_busy = false;
+        saadc_event_raise(NRF_SAADC_EVENT_END);
+    }
+}
+
+/**
+ * @brief Check for a SAADC event whose interrupt is enabled.
+ *
+ * @return bool True if the SAADC interrupt is pending.
+ */
+static bool saadc_irq_pending(void)
+{
+    if ((saadc.events & saadc.inten) != 0) {
+        return true;
+    }
+    for (uint8_t ch = 0; ch < SAADC_CHANNELS; ch++) {
+        if ((saadc.limit_events[ch] & saadc.limit_inten[ch]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief SAADC interrupt handler of the nrfx driver in advanced mode.
+ *
+ * An event is only handled while its interrupt is enabled, so the events of a
+ * loop the application runs with the interrupts disabled are left alone.
+ */
+static void saadc_irq(void)
+{
+    stats.saadc_irqs++;
+
+    if ((saadc.events & saadc.inten & NRF_SAADC_INT_CALIBRATEDONE) != 0) {
+        nrf_saadc_event_clear(NRF_SAADC_EVENT_CALIBRATEDONE);
+        saadc.inten &= ~NRF_SAADC_INT_CALIBRATEDONE;
+        // The calibration leaves the driver idle, out of advanced mode
+        saadc.advanced = false;
+        if (saadc.calib_handler != NULL) {
+            nrfx_saadc_evt_t evt = { .type = NRFX_SAADC_EVT_CALIBRATEDONE };
+            saadc.calib_handler(&evt);
+        }
+    }
+    if ((saadc.events & saadc.inten & NRF_SAADC_INT_STOPPED) != 0) {
+        nrf_saadc_event_clear(NRF_SAADC_EVENT_STOPPED);
+    }
+    if ((saadc.events & saadc.inten & NRF_SAADC_INT_STARTED) != 0) {
+        nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+        if (saadc.sampling) {
+            if (saadc.p_secondary != NULL) {
+                nrf_saadc_buffer_init(saadc.p_secondary, saadc.secondary_size);
+            } else {
+                saadc_evt_send(NRFX_SAADC_EVT_BUF_REQ);
+            }
+        }
+    }
+    if ((saadc.events & saadc.inten & NRF_SAADC_INT_END) != 0) {
+        nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+        if (saadc.sampling) {
+            nrfx_saadc_evt_t done = {
+                .type = NRFX_SAADC_EVT_DONE,
+                .data.done = { .p_buffer = saadc.p_primary, .size = saadc.primary_size },
+            };
+            saadc.p_primary = saadc.p_secondary;
+            saadc.primary_size = saadc.secondary_size;
+            saadc.p_secondary = NULL;
+            bool finished = (saadc.p_primary == NULL);
+            if (finished) {
+                saadc.sampling = false;
+            } else if (saadc.start_on_end) {
+                nrf_saadc_task_trigger(NRF_SAADC_TASK_START);
+            }
+            saadc.handler(&done);
+            if (finished) {
+                saadc_evt_send(NRFX_SAADC_EVT_FINISHED);
+            }
+        }
+    }
+    for (uint8_t ch = 0; ch < SAADC_CHANNELS; ch++) {
+        for (uint8_t limit = NRF_SAADC_LIMIT_LOW; limit <= NRF_SAADC_LIMIT_HIGH; limit++) {
+            // Checked again for every limit, the handler may disarm the others
+            if ((saadc.limit_events[ch] & saadc.limit_inten[ch] & (1u << limit)) == 0) {
+                continue;
+            }
+            saadc.limit_events[ch] &= (uint8_t)~(1u << limit);
+            nrfx_saadc_evt_t evt = {
+                .type = NRFX_SAADC_EVT_LIMIT,
+                .data.limit = { .channel = ch, .limit_type = (nrf_saadc_limit_t)limit },
+            };
+            saadc.handler(&evt);
+        }
+    }
+}
+
+/**
+ * @brief Send an event without data to the advanced mode handler.
+ *
+ * @param type The event type.
+ */
+static void saadc_evt_send(nrfx_saadc_evt_type_t type)
+{
+    nrfx_saadc_evt_t evt = { .type = type };
+    saadc.handler(&evt);
+}
+
+/**
+ * @brief Raise an LPCOMP event and pass it on to PPI.
+ *
+ * @param event The event.
+ */
+static void lpcomp_event_raise(nrf_lpcomp_event_t event)
+{
+    lpcomp.events |= 1u << event;
+    ppi_event(nrf_lpcomp_event_address_get(event));
+}
+
+/**
+ * @brief Compare the LPCOMP input with the reference and raise the crossing.
+ *
+ * The comparison runs in sixteenths of a millivolt, so the reference is exact.
+ */
+static void lpcomp_compare(void)
+{
+    if (!lpcomp.running) {
+        return;
+    }
+    int32_t input = lpcomp.input_mv * 16;
+    int32_t reference = (int32_t)lpcomp.sixteenths * HOST_LPCOMP_VDD_MV;
+    int32_t half_hysteresis = lpcomp.hysteresis ? 25 * 16 : 0;
+
+    if (!lpcomp.above && input > reference + half_hysteresis) {
+        lpcomp.above = true;
+        lpcomp_event_raise(NRF_LPCOMP_EVENT_UP);
+        lpcomp_event_raise(NRF_LPCOMP_EVENT_CROSS);
+    } else if (lpcomp.above && input < reference - half_hysteresis) {
+        lpcomp.above = false;
+        lpcomp_event_raise(NRF_LPCOMP_EVENT_DOWN);
+        lpcomp_event_raise(NRF_LPCOMP_EVENT_CROSS);
+    }
+}
+
+/**
+ * @brief LPCOMP interrupt handler of the nrfx driver.
+ *
+ * Clears the events whose interrupt is enabled and hands each to the handler.
+ */
+static void lpcomp_irq(void)
+{
+    stats.lpcomp_irqs++;
+
+    for (uint8_t event = NRF_LPCOMP_EVENT_DOWN; event <= NRF_LPCOMP_EVENT_CROSS; event++) {
+        // Checked again for every event, the handler may stop the comparator
+        if ((lpcomp.events & lpcomp.inten & (1u << event)) == 0) {
+            continue;
+        }
+        lpcomp.events &= ~(1u << event);
+        if (lpcomp.handler != NULL) {
+            lpcomp.handler((nrf_lpcomp_event_t)event);
+        }
+    }
+}
+
+/**
+ * @brief Raise a TIMER compare event, pass it on to PPI and apply its shorts.
+ *
+ * @param id The TIMER instance.
+ * @param channel The compare channel.
+ */
+static void timer_compare_raise(uint8_t id, uint8_t channel)
+{
+    sim_timer_t *p_timer = &timers[id];
+
+    p_timer->events |= 1u << channel;
+    if (p_timer->shorts & (NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK << channel)) {
+        p_timer->ticks = 0;
+        p_timer->counter = 0;
+    }
+    if (p_timer->shorts & (NRF_TIMER_SHORT_COMPARE0_STOP_MASK << channel)) {
+        p_timer->running = false;
+    }
+    ppi_event(ADDR(ADDR_TIMER_EVENT, id, channel));
+}
+
+/**
+ * @brief Run the COUNT task of a TIMER in counter mode.
+ *
+ * @param id The TIMER instance.
+ */
+static void timer_count(uint8_t id)
+{
+    sim_timer_t *p_timer = &timers[id];
+
+    if (!p_timer->running || p_timer->mode == NRF_TIMER_MODE_TIMER) {
+        return;
+    }
+    p_timer->counter = (p_timer->counter + 1) & p_timer->mask;
+    for (uint8_t channel = 0; channel < HOST_TIMER_CC_COUNT; channel++) {
+        if (p_timer->counter == p_timer->cc[channel]) {
+            timer_compare_raise(id, channel);
+        }
+    }
+}
+
+/**
+ * @brief Get the counter of a TIMER.
+ *
+ * @param p_timer The TIMER.
+ * @return uint32_t The counter value within the bit width.
+ */
+static uint32_t timer_value(const sim_timer_t *p_timer)
+{
+    if (p_timer->mode == NRF_TIMER_MODE_TIMER) {
+        return (uint32_t)(p_timer->ticks >> p_timer->frequency) & p_timer->mask;
+    }
+    return p_timer->counter;
+}
+
+/**
+ * @brief Take one TIMER compare interrupt, if one is pending.
+ *
+ * @return bool True if a handler ran.
+ */
+static bool timer_irq(void)
+{
+    for (uint8_t id = 0; id < HOST_TIMER_COUNT; id++) {
+        sim_timer_t *p_timer = &timers[id];
+        uint32_t pending = p_timer->events & p_timer->inten;
+
+        for (uint8_t channel = 0; channel < HOST_TIMER_CC_COUNT; channel++) {
+            if ((pending & (1u << channel)) == 0) {
+                continue;
+            }
+            p_timer->events &= ~(1u << channel);
+            stats.timer_irqs++;
+            if (p_timer->handler != NULL) {
+                p_timer->handler((nrf_timer_event_t)channel, p_timer->p_context);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Find the running TIMER whose compare comes next.
+ *
+ * Only timer-mode TIMERs cleared by their CC0 compare are periodic; the
+ * compares of the others are not simulated.
+ *
+ * @param p_remaining Receives the 16 MHz ticks until that compare.
+ * @return sim_timer_t* The TIMER, NULL if none is pacing.
+ */
+static sim_timer_t *pacing_timer(uint64_t *p_remaining)
+{
+    sim_timer_t *p_next = NULL;
+
+    for (uint8_t id = 0; id < HOST_TIMER_COUNT; id++) {
+        sim_timer_t *p_timer = &timers[id];
+        if (!p_timer->running || p_timer->mode != NRF_TIMER_MODE_TIMER ||
+            (p_timer->shorts & NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK) == 0 || p_timer->cc[0] == 0) {
+            continue;
+        }
+        uint64_t period = (uint64_t)p_timer->cc[0] << p_timer->frequency;
+        uint64_t remaining = (p_timer->ticks < period) ? period - p_timer->ticks : 0;
+        if (p_next == NULL || remaining < *p_remaining) {
+            p_next = p_timer;
+            *p_remaining = remaining;
+        }
+    }
+    return p_next;
+}
+
+/**
+ * @brief Advance the simulated time and the running timer-mode TIMERs.
+ *
+ * @param ticks 16 MHz ticks to add.
+ */
+static void time_advance(uint64_t ticks)
+{
+    now_ticks += ticks;
+    for (uint8_t id = 0; id < HOST_TIMER_COUNT; id++) {
+        if (timers[id].running && timers[id].mode == NRF_TIMER_MODE_TIMER) {
+            timers[id].ticks += ticks;
+        }
+    }
+}
+
+/**
+ * @brief Run the tasks of the enabled PPI channels connected to an event.
+ *
+ * @param eep The event address.
+ */
+static void ppi_event(uint32_t eep)
+{
+    for (uint8_t ch = 0; ch < HOST_PPI_CHANNEL_COUNT; ch++) {
+        if (!ppi[ch].enabled || ppi[ch].eep != eep) {
+            continue;
+        }
+        if (ppi[ch].tep != 0) {
+            task_run(ppi[ch].tep);
+        }
+        if (ppi[ch].fork_tep != 0) {
+            task_run(ppi[ch].fork_tep);
+        }
+    }
+}
+
+/**
+ * @brief Run a task given by its address.
+ *
+ * @param tep The task address.
+ */
+static void task_run(uint32_t tep)
+{
+    uint8_t id = (uint8_t)ADDR_INSTANCE(tep);
+    uint32_t index = ADDR_INDEX(tep);
+
+    if (ADDR_KIND(tep) == ADDR_SAADC_TASK) {
+        nrf_saadc_task_trigger((nrf_saadc_task_t)index);
+        return;
+    }
+    if (ADDR_KIND(tep) != ADDR_TIMER_TASK || id >= HOST_TIMER_COUNT) {
+        return;
+    }
+    sim_timer_t *p_timer = &timers[id];
+    switch (index) {
+        case NRF_TIMER_TASK_START:
+            p_timer->running = true;
+            break;
+        case NRF_TIMER_TASK_STOP:
+            p_timer->running = false;
+            break;
+        case NRF_TIMER_TASK_COUNT:
+            timer_count(id);
+            break;
+        case NRF_TIMER_TASK_CLEAR:
+            p_timer->ticks = 0;
+            p_timer->counter = 0;
+            break;
+        case NRF_TIMER_TASK_SHUTDOWN:
+            p_timer->running = false;
+            p_timer->ticks = 0;
+            p_timer->counter = 0;
+            break;
+        default:
+            if (index >= NRF_TIMER_TASK_CAPTURE0 && index < NRF_TIMER_TASK_CAPTURE0 + HOST_TIMER_CC_COUNT) {
+                p_timer->cc[index - NRF_TIMER_TASK_CAPTURE0] = timer_value(p_timer);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Take the pending interrupts until none is left.
+ *
+ * Handlers raising new events are served by the same loop, never nested.
+ */
+static void irq_dispatch(void)
+{
+    if (in_irq) {
+        return;
+    }
+    in_irq = true;
+    for (;;) {
+        if (saadc_irq_pending()) {
+            saadc_irq();
+        } else if ((lpcomp.events & lpcomp.inten) != 0) {
+            lpcomp_irq();
+        } else if (!timer_irq()) {
+            break;
+        }
+    }
+    in_irq = false;
+}
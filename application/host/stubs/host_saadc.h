@@ -0,0 +1,115 @@
+#ifndef HOST_SAADC_H
+#define HOST_SAADC_H
+
+// Simulation of the SAADC, LPCOMP, TIMER and PPI peripherals behind the
+// nrfx_saadc.h, nrfx_lpcomp.h, nrfx_timer.h and nrfx_ppi.h stand-ins: inputs,
+// simulated time and the interrupts taken.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrfx_saadc.h"
+#include "nrfx_lpcomp.h"
+#include "nrfx_timer.h"
+#include "nrfx_ppi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_SAADC_INPUT_BITS 14 // Scale of the simulated inputs, the finest resolution
+#define HOST_LPCOMP_VDD_MV 3000  // Supply the LPCOMP references are fractions of
+
+/**
+ * @brief Interrupts and conversions since the last reset.
+ */
+typedef struct {
+    uint32_t saadc_irqs;   // SAADC interrupt entries
+    uint32_t timer_irqs;   // TIMER compare interrupts, all instances
+    uint32_t scans;        // SAMPLE tasks that converted the enabled channels
+    uint32_t limit_events; // LIMITH and LIMITL events raised, delivered or not
+    uint32_t lpcomp_irqs;  // LPCOMP interrupt entries
+} host_saadc_stats_t;
+
+/**
+ * @brief Put the SAADC, the LPCOMP, the TIMERs and the PPI channels back to their reset state.
+ */
+void host_saadc_reset(void);
+
+/**
+ * @brief Set the input of a SAADC channel.
+ *
+ * A conversion at an N-bit resolution reads the input shifted right by
+ * HOST_SAADC_INPUT_BITS - N.
+ *
+ * @param channel The SAADC channel.
+ * @param level The input on the HOST_SAADC_INPUT_BITS scale.
+ */
+void host_saadc_input_set(uint8_t channel, int16_t level);
+
+/**
+ * @brief Set the input of the LPCOMP and deliver the crossing it causes.
+ *
+ * While the comparator runs, its output goes up once the input exceeds the
+ * reference by half the hysteresis and down once it falls as far below it.
+ *
+ * @param level_mv The input in millivolts, the same for every LPCOMP input pin.
+ */
+void host_lpcomp_input_set(int32_t level_mv);
+
+/**
+ * @brief Let the time pass without any compare event.
+ *
+ * Only the timer-mode TIMERs that are running advance; the periodic compares
+ * of host_saadc_run() are not raised, so nothing may be pacing meanwhile.
+ *
+ * @param us Microseconds to add to the simulated time.
+ */
+void host_saadc_advance_us(uint32_t us);
+
+/**
+ * @brief Run the scans paced by the periodic TIMERs.
+ *
+ * Each step delivers the pending interrupts, advances the simulated time to
+ * the next compare of a timer-mode TIMER cleared by its CC0 and raises that
+ * compare event, then delivers the interrupts it caused. The run stops early
+ * when no such TIMER is running.
+ *
+ * @param periods Number of compare periods to run.
+ * @return uint32_t Number of periods run.
+ */
+uint32_t host_saadc_run(uint32_t periods);
+
+/**
+ * @brief Deliver the pending interrupts without advancing the time.
+ */
+void host_saadc_irq_flush(void);
+
+/**
+ * @brief Get the interrupt and conversion counters.
+ *
+ * @return host_saadc_stats_t The counters since the last reset.
+ */
+host_saadc_stats_t host_saadc_stats(void);
+
+/**
+ * @brief Get the limits programmed on a SAADC channel.
+ *
+ * @param channel The SAADC channel.
+ * @param p_low Receives the low limit.
+ * @param p_high Receives the high limit.
+ * @return bool True if at least one of the limit interrupts is enabled.
+ */
+bool host_saadc_limits_get(uint8_t channel, int16_t *p_low, int16_t *p_high);
+
+/**
+ * @brief Get the simulated time.
+ *
+ * @return uint64_t The time in microseconds since the last reset.
+ */
+uint64_t host_saadc_time_us(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_SAADC_H
@@ -0,0 +1,264 @@
+/**
+ * @file host_stubs.c
+ * @brief Host implementation of the SDK stand-ins.
+ * 
+ * The firmware components are compiled unchanged against the headers of
+ * this directory. This file provides what those headers declare: the logger,
+ * the error handler, the scheduler, the GPIO latches, the PWM, the UART and
+ * the TEMP sensor.
+ * None of them allocates or blocks.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_stubs.h"
+#include "app_error.h"
+#include "app_scheduler.h"
+
+/*
+ * Global variables:
+ */
+uint64_t host_gpio_out = 0;
+uint64_t host_gpio_dir = 0;
+nrf_pwm_values_individual_t host_pwm_values;
+uint32_t host_pwm_playbacks = 0;
+uint8_t host_uart_tx[HOST_UART_TX_CAPTURE_SIZE];
+size_t host_uart_tx_count = 0;
+NRF_TEMP_Type host_temp;
+
+static uint32_t log_counts[NRF_LOG_SEVERITY_COUNT];
+static int log_verbose = -1; // Unknown until the first message
+
+// Scheduler queue, one slot kept free to tell a full queue from an empty one
+typedef struct {
+    app_sched_event_handler_t handler;
+    uint16_t size;
+    uint8_t data[HOST_SCHED_MAX_EVENT_SIZE];
+} sched_item_t;
+
+static sched_item_t sched_queue[HOST_SCHED_QUEUE_SIZE + 1];
+static uint16_t sched_head = 0;
+static uint16_t sched_tail = 0;
+
+static nrf_uart_event_handler_t uart_handler = NULL;
+static void *uart_context = NULL;
+
+static const int16_t *p_temp_trace = NULL;
+static size_t temp_trace_length = 0;
+static size_t temp_trace_position = 0;
+
+/**
+ * @brief Reset the state kept by the stand-ins.
+ */
+void host_stubs_reset(void)
+{
+    memset(log_counts, 0, sizeof(log_counts));
+    sched_head = 0;
+    sched_tail = 0;
+    host_gpio_out = 0;
+    host_gpio_dir = 0;
+    memset(&host_pwm_values, 0, sizeof(host_pwm_values));
+    host_pwm_playbacks = 0;
+    host_uart_tx_count = 0;
+    memset(&host_temp, 0, sizeof(host_temp));
+    p_temp_trace = NULL;
+    temp_trace_length = 0;
+    temp_trace_position = 0;
+}
+
+/**
+ * @brief Count a log message and print it when HOST_LOG is set.
+ *
+ * @param severity The severity of the message.
+ * @param p_format The printf-style format.
+ */
+void host_log_emit(nrf_log_severity_t severity, const char *p_format, ...)
+{
+    static const char *const prefixes[NRF_LOG_SEVERITY_COUNT] = { "", "<error>", "<warning>", "<info>", "<debug>" };
+
+    log_counts[severity]++;
+    if (log_verbose < 0) {
+        log_verbose = (getenv("HOST_LOG") != NULL);
+    }
+    if (!log_verbose) {
+        return;
+    }
+    va_list args;
+    va_start(args, p_format);
+    printf("%s ", prefixes[severity]);
+    vprintf(p_format, args);
+    putchar('\n');
+    va_end(args);
+}
+
+uint32_t host_log_count(nrf_log_severity_t severity)
+{
+    return log_counts[severity];
+}
+
+/**
+ * @brief Report a failed APP_ERROR_CHECK and abort, as the target resets.
+ */
+void app_error_handler(ret_code_t error_code, uint32_t line_num, const uint8_t *p_file_name)
+{
+    fprintf(stderr, "APP_ERROR 0x%08x at %s:%u\n", (unsigned)error_code, (const char *)p_file_name, (unsigned)line_num);
+    abort();
+}
+
+uint32_t app_sched_init(uint16_t max_event_size, uint16_t queue_size, void *p_evt_buffer)
+{
+    (void)p_evt_buffer;
+    if (max_event_size > HOST_SCHED_MAX_EVENT_SIZE || queue_size > HOST_SCHED_QUEUE_SIZE) {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    sched_head = 0;
+    sched_tail = 0;
+    return NRF_SUCCESS;
+}
+
+uint32_t app_sched_event_put(void const *p_event_data, uint16_t event_size, app_sched_event_handler_t handler)
+{
+    uint16_t next = (uint16_t)((sched_tail + 1) % (HOST_SCHED_QUEUE_SIZE + 1));
+
+    if (event_size > HOST_SCHED_MAX_EVENT_SIZE) {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+    if (next == sched_head) {
+        return NRF_ERROR_NO_MEM;
+    }
+    sched_queue[sched_tail].handler = handler;
+    sched_queue[sched_tail].size = event_size;
+    if (p_event_data != NULL && event_size > 0) {
+        memcpy(sched_queue[sched_tail].data, p_event_data, event_size);
+    }
+    sched_tail = next;
+    return NRF_SUCCESS;
+}
+
+void app_sched_execute(void)
+{
+    while (sched_head != sched_tail) {
+        sched_item_t item = sched_queue[sched_head];
+        sched_head = (uint16_t)((sched_head + 1) % (HOST_SCHED_QUEUE_SIZE + 1));
+        item.handler(item.size > 0 ? item.data : NULL, item.size);
+    }
+}
+
+uint16_t app_sched_queue_utilization_get(void)
+{
+    return (uint16_t)((sched_tail + HOST_SCHED_QUEUE_SIZE + 1 - sched_head) % (HOST_SCHED_QUEUE_SIZE + 1));
+}
+
+nrfx_err_t nrfx_pwm_init(nrfx_pwm_t const *p_instance, nrfx_pwm_config_t const *p_config, nrfx_pwm_handler_t handler)
+{
+    (void)p_instance;
+    (void)handler;
+    for (uint8_t ch = 0; ch < NRF_PWM_CHANNEL_COUNT; ch++) {
+        if (p_config->output_pins[ch] != NRFX_PWM_PIN_NOT_USED) {
+            nrf_gpio_cfg_output(p_config->output_pins[ch]);
+        }
+    }
+    return NRFX_SUCCESS;
+}
+
+uint32_t nrfx_pwm_simple_playback(nrfx_pwm_t const *p_instance, nrf_pwm_sequence_t const *p_sequence,
+                                  uint16_t playback_count, uint32_t flags)
+{
+    (void)p_instance;
+    (void)playback_count;
+    (void)flags;
+    host_pwm_values = *p_sequence->values.p_individual;
+    host_pwm_playbacks++;
+    return 0;
+}
+
+bool nrfx_pwm_stop(nrfx_pwm_t const *p_instance, bool wait_until_stopped)
+{
+    (void)p_instance;
+    (void)wait_until_stopped;
+    return true;
+}
+
+ret_code_t nrf_drv_uart_init(nrf_drv_uart_t const *p_instance, nrf_drv_uart_config_t const *p_config,
+                             nrf_uart_event_handler_t event_handler)
+{
+    (void)p_instance;
+    uart_handler = event_handler;
+    uart_context = p_config->p_context;
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_drv_uart_tx(nrf_drv_uart_t const *p_instance, uint8_t const *p_data, uint8_t length)
+{
+    (void)p_instance;
+    for (uint8_t i = 0; i < length; i++) {
+        host_uart_tx[host_uart_tx_count % HOST_UART_TX_CAPTURE_SIZE] = p_data[i];
+        host_uart_tx_count++;
+    }
+    if (uart_handler != NULL) {
+        nrf_drv_uart_event_t event = { .type = NRF_DRV_UART_EVT_TX_DONE };
+        event.data.rxtx.p_data = (uint8_t *)p_data;
+        event.data.rxtx.bytes = length;
+        uart_handler(&event, uart_context);
+    }
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_drv_uart_rx(nrf_drv_uart_t const *p_instance, uint8_t *p_data, uint8_t length)
+{
+    (void)p_instance;
+    (void)p_data;
+    (void)length;
+    return NRF_SUCCESS;
+}
+
+uint32_t nrf_drv_uart_errorsrc_get(nrf_drv_uart_t const *p_instance)
+{
+    (void)p_instance;
+    return 0;
+}
+
+void host_temp_trace_set(const int16_t *p_trace, size_t n)
+{
+    p_temp_trace = p_trace;
+    temp_trace_length = n;
+    temp_trace_position = 0;
+}
+
+void host_temp_convert(NRF_TEMP_Type *p_reg)
+{
+    if (temp_trace_length > 0) {
+        size_t position = (temp_trace_position < temp_trace_length) ? temp_trace_position : temp_trace_length - 1;
+        p_reg->temp = p_temp_trace[position];
+        temp_trace_position++;
+    }
+    p_reg->datardy = true;
+}
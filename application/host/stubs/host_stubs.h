@@ -0,0 +1,47 @@
+#ifndef HOST_STUBS_H
+#define HOST_STUBS_H
+
+// Inspection and reset of the state kept by the host stand-ins of the SDK.
+
+#include <stdint.h>
+#include <stddef.h>
+#include "nrf_log.h"
+#include "nrf_gpio.h"
+#include "nrfx_pwm.h"
+#include "nrf_drv_uart.h"
+#include "nrf_temp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Reset the log counters, the scheduler queue, the GPIO latches, the
+ *        PWM record, the UART capture and the TEMP trace.
+ */
+void host_stubs_reset(void);
+
+/**
+ * @brief Get the number of messages logged at a severity since the last reset.
+ *
+ * @param severity The severity.
+ * @return uint32_t The message count.
+ */
+uint32_t host_log_count(nrf_log_severity_t severity);
+
+/**
+ * @brief Set the readings the TEMP stand-in converts, one per START task.
+ *
+ * The trace is not copied. Once it is exhausted the last reading repeats;
+ * without a trace the TEMP stand-in reads 0.
+ *
+ * @param p_trace Readings in 0.25 degC.
+ * @param n Number of readings.
+ */
+void host_temp_trace_set(const int16_t *p_trace, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_STUBS_H
@@ -0,0 +1,57 @@
+#ifndef HOST_NRF_H
+#define HOST_NRF_H
+
+// Host stand-in for nrf.h: the CMSIS SIMD intrinsics used by the block kernels,
+// emulated in C so their DSP path can be compared with the portable one. The
+// APSR.GE flags set by __SSUB16 and read by __SEL live in a static variable.
+
+#include <stdint.h>
+
+// APSR.GE, one bit per byte lane as on the core
+static inline uint32_t *host_apsr_ge(void)
+{
+    static uint32_t ge;
+    return &ge;
+}
+
+// Two signed 16-bit subtractions; GE[1:0] and GE[3:2] are set where the exact difference is >= 0
+static inline uint32_t __SSUB16(uint32_t op1, uint32_t op2)
+{
+    int32_t low = (int32_t)(int16_t)(op1 & 0xFFFF) - (int16_t)(op2 & 0xFFFF);
+    int32_t high = (int32_t)(int16_t)(op1 >> 16) - (int16_t)(op2 >> 16);
+
+    *host_apsr_ge() = ((low >= 0) ? 0x3u : 0u) | ((high >= 0) ? 0xCu : 0u);
+    return ((uint32_t)high << 16) | ((uint32_t)low & 0xFFFF);
+}
+
+// Byte-wise select: op1 where the GE bit of the byte is set, op2 elsewhere
+static inline uint32_t __SEL(uint32_t op1, uint32_t op2)
+{
+    uint32_t ge = *host_apsr_ge();
+    uint32_t mask = 0;
+
+    for (int byte = 0; byte < 4; byte++) {
+        mask |= (ge & (1u << byte)) ? (0xFFu << (8 * byte)) : 0u;
+    }
+    return (op1 & mask) | (op2 & ~mask);
+}
+
+// Dual signed 16-bit multiply, both products added to a 32-bit accumulator (wraps as on the core)
+static inline uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3)
+{
+    int32_t low = (int32_t)(int16_t)(op1 & 0xFFFF) * (int16_t)(op2 & 0xFFFF);
+    int32_t high = (int32_t)(int16_t)(op1 >> 16) * (int16_t)(op2 >> 16);
+
+    return op3 + (uint32_t)low + (uint32_t)high;
+}
+
+// Dual signed 16-bit multiply, both products added to a 64-bit accumulator
+static inline uint64_t __SMLALD(uint32_t op1, uint32_t op2, uint64_t acc)
+{
+    int64_t low = (int64_t)(int16_t)(op1 & 0xFFFF) * (int16_t)(op2 & 0xFFFF);
+    int64_t high = (int64_t)(int16_t)(op1 >> 16) * (int16_t)(op2 >> 16);
+
+    return acc + (uint64_t)low + (uint64_t)high;
+}
+
+#endif // HOST_NRF_H
@@ -0,0 +1,12 @@
+#ifndef HOST_NRF_DELAY_H
+#define HOST_NRF_DELAY_H
+
+// Host stand-in for nrf_delay.h: busy waits are skipped, the simulated
+// peripherals do not advance with wall time.
+
+#include <stdint.h>
+
+static inline void nrf_delay_ms(uint32_t ms_time) { (void)ms_time; }
+static inline void nrf_delay_us(uint32_t us_time) { (void)us_time; }
+
+#endif // HOST_NRF_DELAY_H
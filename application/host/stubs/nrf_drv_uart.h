@@ -0,0 +1,91 @@
+#ifndef HOST_NRF_DRV_UART_H
+#define HOST_NRF_DRV_UART_H
+
+// Host stand-in for nrf_drv_uart.h. A transmission completes at once: the
+// bytes are appended to host_uart_tx and TX_DONE is reported before
+// nrf_drv_uart_tx() returns.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "sdk_errors.h"
+#include "app_util_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_UART_TX_CAPTURE_SIZE 1024 // Transmitted bytes kept for inspection
+
+typedef struct {
+    uint8_t inst_idx;
+} nrf_drv_uart_t;
+
+#define NRF_DRV_UART_INSTANCE(id) { .inst_idx = (id) }
+
+typedef enum { NRF_UART_BAUDRATE_9600, NRF_UART_BAUDRATE_115200, NRF_UART_BAUDRATE_1000000 } nrf_uart_baudrate_t;
+typedef enum { NRF_UART_HWFC_DISABLED, NRF_UART_HWFC_ENABLED } nrf_uart_hwfc_t;
+typedef enum { NRF_UART_PARITY_EXCLUDED, NRF_UART_PARITY_INCLUDED } nrf_uart_parity_t;
+
+#define NRF_UART_ERROR_OVERRUN_MASK 0x01
+#define NRF_UART_ERROR_PARITY_MASK  0x02
+#define NRF_UART_ERROR_FRAMING_MASK 0x04
+#define NRF_UART_ERROR_BREAK_MASK   0x08
+
+typedef struct {
+    uint32_t pseltxd;
+    uint32_t pselrxd;
+    uint32_t pselcts;
+    uint32_t pselrts;
+    void *p_context;
+    nrf_uart_hwfc_t hwfc;
+    nrf_uart_parity_t parity;
+    nrf_uart_baudrate_t baudrate;
+    uint8_t interrupt_priority;
+} nrf_drv_uart_config_t;
+
+#define NRF_DRV_UART_DEFAULT_CONFIG { .baudrate = NRF_UART_BAUDRATE_115200 }
+
+typedef enum {
+    NRF_DRV_UART_EVT_TX_DONE,
+    NRF_DRV_UART_EVT_RX_DONE,
+    NRF_DRV_UART_EVT_ERROR
+} nrf_drv_uart_evt_type_t;
+
+typedef struct {
+    uint8_t *p_data;
+    size_t bytes;
+} nrf_drv_uart_xfer_evt_t;
+
+typedef struct {
+    nrf_drv_uart_xfer_evt_t rxtx;
+    uint32_t error_mask;
+} nrf_drv_uart_error_evt_t;
+
+typedef struct {
+    nrf_drv_uart_evt_type_t type;
+    union {
+        nrf_drv_uart_xfer_evt_t rxtx;
+        nrf_drv_uart_error_evt_t error;
+    } data;
+} nrf_drv_uart_event_t;
+
+typedef void (*nrf_uart_event_handler_t)(nrf_drv_uart_event_t *p_event, void *p_context);
+
+extern uint8_t host_uart_tx[HOST_UART_TX_CAPTURE_SIZE]; // Bytes transmitted since the last reset (wraps)
+extern size_t host_uart_tx_count;                       // Bytes transmitted since the last reset
+
+ret_code_t nrf_drv_uart_init(nrf_drv_uart_t const *p_instance, nrf_drv_uart_config_t const *p_config,
+                             nrf_uart_event_handler_t event_handler);
+
+ret_code_t nrf_drv_uart_tx(nrf_drv_uart_t const *p_instance, uint8_t const *p_data, uint8_t length);
+
+ret_code_t nrf_drv_uart_rx(nrf_drv_uart_t const *p_instance, uint8_t *p_data, uint8_t length);
+
+uint32_t nrf_drv_uart_errorsrc_get(nrf_drv_uart_t const *p_instance);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NRF_DRV_UART_H
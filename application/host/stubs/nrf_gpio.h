@@ -0,0 +1,27 @@
+#ifndef HOST_NRF_GPIO_H
+#define HOST_NRF_GPIO_H
+
+// Host stand-in for nrf_gpio.h: the output latches of both ports are kept in
+// host_gpio_out, bit NRF_GPIO_PIN_MAP(port, pin).
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NRF_GPIO_PIN_MAP(port, pin) (((port) << 5) | ((pin) & 0x1F))
+
+extern uint64_t host_gpio_out; // Output latch of every pin
+extern uint64_t host_gpio_dir; // Pins configured as outputs
+
+static inline void nrf_gpio_cfg_output(uint32_t pin_number) { host_gpio_dir |= (uint64_t)1 << pin_number; }
+static inline void nrf_gpio_pin_set(uint32_t pin_number)    { host_gpio_out |= (uint64_t)1 << pin_number; }
+static inline void nrf_gpio_pin_clear(uint32_t pin_number)  { host_gpio_out &= ~((uint64_t)1 << pin_number); }
+static inline uint32_t nrf_gpio_pin_out_read(uint32_t pin_number) { return (uint32_t)(host_gpio_out >> pin_number) & 1u; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NRF_GPIO_H
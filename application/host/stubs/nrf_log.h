@@ -0,0 +1,50 @@
+#ifndef HOST_NRF_LOG_H
+#define HOST_NRF_LOG_H
+
+// Host stand-in for nrf_log.h. Messages are counted per severity and printed
+// when HOST_LOG is set in the environment. Like the SDK logger, a message
+// takes at most NRF_LOG_MAX_NUM_OF_ARGS format arguments: a longer one fails
+// to compile here, where the SDK would fail on the target.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NRF_LOG_MAX_NUM_OF_ARGS 6
+
+typedef enum {
+    NRF_LOG_SEVERITY_NONE,
+    NRF_LOG_SEVERITY_ERROR,
+    NRF_LOG_SEVERITY_WARNING,
+    NRF_LOG_SEVERITY_INFO,
+    NRF_LOG_SEVERITY_DEBUG,
+    NRF_LOG_SEVERITY_COUNT
+} nrf_log_severity_t;
+
+void host_log_emit(nrf_log_severity_t severity, const char *p_format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+// Number of format arguments, 7 standing for "more than NRF_LOG_MAX_NUM_OF_ARGS"
+#define HOST_LOG_NARGS(...) \
+    HOST_LOG_NARGS_(__VA_ARGS__, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 6, 5, 4, 3, 2, 1, 0, ~)
+#define HOST_LOG_NARGS_(fmt, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, n, ...) n
+
+#define HOST_LOG(severity, ...)                                                   \
+    do {                                                                          \
+        _Static_assert(HOST_LOG_NARGS(__VA_ARGS__) <= NRF_LOG_MAX_NUM_OF_ARGS,    \
+                       "nrf_log takes at most 6 format arguments");               \
+        host_log_emit((severity), __VA_ARGS__);                                   \
+    } while (0)
+
+#define NRF_LOG_ERROR(...)   HOST_LOG(NRF_LOG_SEVERITY_ERROR, __VA_ARGS__)
+#define NRF_LOG_WARNING(...) HOST_LOG(NRF_LOG_SEVERITY_WARNING, __VA_ARGS__)
+#define NRF_LOG_INFO(...)    HOST_LOG(NRF_LOG_SEVERITY_INFO, __VA_ARGS__)
+#define NRF_LOG_DEBUG(...)   HOST_LOG(NRF_LOG_SEVERITY_DEBUG, __VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NRF_LOG_H
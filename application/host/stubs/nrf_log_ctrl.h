@@ -0,0 +1,14 @@
+#ifndef HOST_NRF_LOG_CTRL_H
+#define HOST_NRF_LOG_CTRL_H
+
+// Host stand-in for nrf_log_ctrl.h: messages are printed as they are logged,
+// so there is nothing deferred to process or flush.
+
+#include <stdbool.h>
+#include "sdk_errors.h"
+
+#define NRF_LOG_INIT(timestamp_func) NRF_SUCCESS
+#define NRF_LOG_PROCESS()            false
+#define NRF_LOG_FLUSH()              do { } while (0)
+
+#endif // HOST_NRF_LOG_CTRL_H
@@ -0,0 +1,8 @@
+#ifndef HOST_NRF_LOG_DEFAULT_BACKENDS_H
+#define HOST_NRF_LOG_DEFAULT_BACKENDS_H
+
+// Host stand-in for nrf_log_default_backends.h: the host log goes to stdout.
+
+#define NRF_LOG_DEFAULT_BACKENDS_INIT() do { } while (0)
+
+#endif // HOST_NRF_LOG_DEFAULT_BACKENDS_H
@@ -0,0 +1,44 @@
+#ifndef HOST_NRF_TEMP_H
+#define HOST_NRF_TEMP_H
+
+// Host stand-in for nrf_temp.h: each START task converts the next reading of
+// the temperature trace set with host_temp_trace_set() and raises DATARDY at
+// once, as the 36 us conversion has always finished by the next poll.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum { NRF_TEMP_TASK_START, NRF_TEMP_TASK_STOP } nrf_temp_task_t;
+typedef enum { NRF_TEMP_EVENT_DATARDY } nrf_temp_event_t;
+
+typedef struct {
+    bool datardy;  // EVENTS_DATARDY
+    int32_t temp;  // TEMP result in 0.25 degC
+} NRF_TEMP_Type;
+
+extern NRF_TEMP_Type host_temp;
+#define NRF_TEMP (&host_temp)
+
+// Conversion of the next trace reading, in host_stubs.c
+void host_temp_convert(NRF_TEMP_Type *p_reg);
+
+static inline void nrf_temp_task_trigger(NRF_TEMP_Type *p_reg, nrf_temp_task_t task)
+{
+    if (task == NRF_TEMP_TASK_START) {
+        host_temp_convert(p_reg);
+    }
+}
+
+static inline void nrf_temp_event_clear(NRF_TEMP_Type *p_reg, nrf_temp_event_t event) { (void)event; p_reg->datardy = false; }
+static inline bool nrf_temp_event_check(NRF_TEMP_Type const *p_reg, nrf_temp_event_t event) { (void)event; return p_reg->datardy; }
+static inline int32_t nrf_temp_result_get(NRF_TEMP_Type const *p_reg) { return p_reg->temp; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NRF_TEMP_H
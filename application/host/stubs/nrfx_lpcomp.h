@@ -0,0 +1,75 @@
+#ifndef HOST_NRFX_LPCOMP_H
+#define HOST_NRFX_LPCOMP_H
+
+// Host stand-in for nrfx_lpcomp.h, simulated by host_saadc.c: the comparator
+// follows the input set with host_lpcomp_input_set() against its supply
+// fraction reference, raises DOWN, UP and CROSS to PPI and calls the handler
+// for the crossings its detection selects.
+
+#include <stdint.h>
+#include "sdk_errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    NRF_LPCOMP_INPUT_0 = 0, NRF_LPCOMP_INPUT_1, NRF_LPCOMP_INPUT_2, NRF_LPCOMP_INPUT_3,
+    NRF_LPCOMP_INPUT_4, NRF_LPCOMP_INPUT_5, NRF_LPCOMP_INPUT_6, NRF_LPCOMP_INPUT_7
+} nrf_lpcomp_input_t;
+
+typedef enum {
+    NRF_LPCOMP_REF_SUPPLY_1_8 = 0, NRF_LPCOMP_REF_SUPPLY_2_8, NRF_LPCOMP_REF_SUPPLY_3_8,
+    NRF_LPCOMP_REF_SUPPLY_4_8, NRF_LPCOMP_REF_SUPPLY_5_8, NRF_LPCOMP_REF_SUPPLY_6_8,
+    NRF_LPCOMP_REF_SUPPLY_7_8, NRF_LPCOMP_REF_EXT_REF0,
+    NRF_LPCOMP_REF_SUPPLY_1_16, NRF_LPCOMP_REF_SUPPLY_3_16, NRF_LPCOMP_REF_SUPPLY_5_16,
+    NRF_LPCOMP_REF_SUPPLY_7_16, NRF_LPCOMP_REF_SUPPLY_9_16, NRF_LPCOMP_REF_SUPPLY_11_16,
+    NRF_LPCOMP_REF_SUPPLY_13_16, NRF_LPCOMP_REF_SUPPLY_15_16
+} nrf_lpcomp_ref_t;
+
+typedef enum {
+    NRF_LPCOMP_DETECT_CROSS = 0, NRF_LPCOMP_DETECT_UP, NRF_LPCOMP_DETECT_DOWN
+} nrf_lpcomp_detect_t;
+
+typedef enum {
+    NRF_LPCOMP_HYST_NOHYST = 0, NRF_LPCOMP_HYST_50mV
+} nrf_lpcomp_hysteresis_t;
+
+typedef enum {
+    NRF_LPCOMP_EVENT_READY = 0, NRF_LPCOMP_EVENT_DOWN, NRF_LPCOMP_EVENT_UP, NRF_LPCOMP_EVENT_CROSS
+} nrf_lpcomp_event_t;
+
+typedef struct {
+    nrf_lpcomp_ref_t reference;
+    nrf_lpcomp_detect_t detection;
+    nrf_lpcomp_hysteresis_t hyst;
+} nrf_lpcomp_config_t;
+
+typedef struct {
+    nrf_lpcomp_config_t hal;
+    nrf_lpcomp_input_t input;
+    uint8_t interrupt_priority;
+} nrfx_lpcomp_config_t;
+
+#define NRFX_LPCOMP_DEFAULT_CONFIG                          \
+{                                                           \
+    .hal                = { NRF_LPCOMP_REF_SUPPLY_4_8,      \
+                            NRF_LPCOMP_DETECT_CROSS,        \
+                            NRF_LPCOMP_HYST_50mV },         \
+    .input              = NRF_LPCOMP_INPUT_0,               \
+    .interrupt_priority = 6,                                \
+}
+
+typedef void (*nrfx_lpcomp_event_handler_t)(nrf_lpcomp_event_t event);
+
+nrfx_err_t nrfx_lpcomp_init(nrfx_lpcomp_config_t const *p_config, nrfx_lpcomp_event_handler_t event_handler);
+void nrfx_lpcomp_uninit(void);
+void nrfx_lpcomp_enable(void);
+void nrfx_lpcomp_disable(void);
+uint32_t nrf_lpcomp_event_address_get(nrf_lpcomp_event_t event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NRFX_LPCOMP_H
@@ -0,0 +1,34 @@
+#ifndef HOST_NRFX_PPI_H
+#define HOST_NRFX_PPI_H
+
+// Host stand-in for nrfx_ppi.h, simulated by host_saadc.c: an enabled channel
+// runs its task and its fork task whenever its event is raised.
+
+#include <stdint.h>
+#include "sdk_errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_PPI_CHANNEL_COUNT 20 // Programmable channels of the nRF52840
+
+typedef enum {
+    NRF_PPI_CHANNEL0 = 0, NRF_PPI_CHANNEL1, NRF_PPI_CHANNEL2, NRF_PPI_CHANNEL3, NRF_PPI_CHANNEL4,
+    NRF_PPI_CHANNEL5, NRF_PPI_CHANNEL6, NRF_PPI_CHANNEL7, NRF_PPI_CHANNEL8, NRF_PPI_CHANNEL9,
+    NRF_PPI_CHANNEL10, NRF_PPI_CHANNEL11, NRF_PPI_CHANNEL12, NRF_PPI_CHANNEL13, NRF_PPI_CHANNEL14,
+    NRF_PPI_CHANNEL15, NRF_PPI_CHANNEL16, NRF_PPI_CHANNEL17, NRF_PPI_CHANNEL18, NRF_PPI_CHANNEL19
+} nrf_ppi_channel_t;
+
+nrfx_err_t nrfx_ppi_channel_alloc(nrf_ppi_channel_t *p_channel);
+nrfx_err_t nrfx_ppi_channel_free(nrf_ppi_channel_t channel);
+nrfx_err_t nrfx_ppi_channel_assign(nrf_ppi_channel_t channel, uint32_t eep, uint32_t tep);
+nrfx_err_t nrfx_ppi_channel_fork_assign(nrf_ppi_channel_t channel, uint32_t fork_tep);
+nrfx_err_t nrfx_ppi_channel_enable(nrf_ppi_channel_t channel);
+nrfx_err_t nrfx_ppi_channel_disable(nrf_ppi_channel_t channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NRFX_PPI_H
@@ -0,0 +1,80 @@
+#ifndef HOST_NRFX_PWM_H
+#define HOST_NRFX_PWM_H
+
+// Host stand-in for nrfx_pwm.h: the last sequence played back is recorded in
+// host_pwm_values, nothing is generated.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_errors.h"
+#include "app_util_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NRF_PWM_CHANNEL_COUNT 4
+#define NRFX_PWM_PIN_NOT_USED 0xFF
+#define NRFX_PWM_FLAG_LOOP    0x01
+
+typedef struct {
+    uint8_t drv_inst_idx;
+} nrfx_pwm_t;
+
+#define NRFX_PWM_INSTANCE(id) { .drv_inst_idx = (id) }
+
+typedef enum { NRF_PWM_CLK_16MHz, NRF_PWM_CLK_8MHz, NRF_PWM_CLK_4MHz, NRF_PWM_CLK_2MHz,
+               NRF_PWM_CLK_1MHz, NRF_PWM_CLK_500kHz, NRF_PWM_CLK_250kHz, NRF_PWM_CLK_125kHz } nrf_pwm_clk_t;
+typedef enum { NRF_PWM_MODE_UP, NRF_PWM_MODE_UP_AND_DOWN } nrf_pwm_mode_t;
+typedef enum { NRF_PWM_LOAD_COMMON, NRF_PWM_LOAD_GROUPED, NRF_PWM_LOAD_INDIVIDUAL, NRF_PWM_LOAD_WAVE_FORM } nrf_pwm_dec_load_t;
+typedef enum { NRF_PWM_STEP_AUTO, NRF_PWM_STEP_TRIGGERED } nrf_pwm_dec_step_t;
+typedef enum { NRFX_PWM_EVT_FINISHED, NRFX_PWM_EVT_END_SEQ0, NRFX_PWM_EVT_END_SEQ1, NRFX_PWM_EVT_STOPPED } nrfx_pwm_evt_type_t;
+
+typedef struct {
+    uint16_t channel_0;
+    uint16_t channel_1;
+    uint16_t channel_2;
+    uint16_t channel_3;
+} nrf_pwm_values_individual_t;
+
+typedef union {
+    uint16_t const *p_raw;
+    nrf_pwm_values_individual_t const *p_individual;
+} nrf_pwm_values_t;
+
+typedef struct {
+    nrf_pwm_values_t values;
+    uint16_t length;
+    uint32_t repeats;
+    uint32_t end_delay;
+} nrf_pwm_sequence_t;
+
+#define NRF_PWM_VALUES_LENGTH(array) (sizeof(array) / sizeof(uint16_t))
+
+typedef struct {
+    uint8_t output_pins[NRF_PWM_CHANNEL_COUNT];
+    uint8_t irq_priority;
+    nrf_pwm_clk_t base_clock;
+    nrf_pwm_mode_t count_mode;
+    uint16_t top_value;
+    nrf_pwm_dec_load_t load_mode;
+    nrf_pwm_dec_step_t step_mode;
+} nrfx_pwm_config_t;
+
+typedef void (*nrfx_pwm_handler_t)(nrfx_pwm_evt_type_t event_type);
+
+extern nrf_pwm_values_individual_t host_pwm_values; // Duty cycles of the last playback
+extern uint32_t host_pwm_playbacks;                 // Playbacks started since reset
+
+nrfx_err_t nrfx_pwm_init(nrfx_pwm_t const *p_instance, nrfx_pwm_config_t const *p_config, nrfx_pwm_handler_t handler);
+
+uint32_t nrfx_pwm_simple_playback(nrfx_pwm_t const *p_instance, nrf_pwm_sequence_t const *p_sequence,
+                                  uint16_t playback_count, uint32_t flags);
+
+bool nrfx_pwm_stop(nrfx_pwm_t const *p_instance, bool wait_until_stopped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NRFX_PWM_H
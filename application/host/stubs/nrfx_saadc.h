@@ -0,0 +1,170 @@
+#ifndef HOST_NRFX_SAADC_H
+#define HOST_NRFX_SAADC_H
+
+// Host stand-in for nrfx_saadc.h (advanced mode, API v2) and the parts of the
+// SAADC HAL the driver touches. The configuration constants come from the
+// application sdk_config.h, as on the target.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_errors.h"
+#include "sdk_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int16_t nrf_saadc_value_t;
+
+typedef enum {
+    NRF_SAADC_INPUT_DISABLED, NRF_SAADC_INPUT_AIN0, NRF_SAADC_INPUT_AIN1, NRF_SAADC_INPUT_AIN2,
+    NRF_SAADC_INPUT_AIN3, NRF_SAADC_INPUT_AIN4, NRF_SAADC_INPUT_AIN5, NRF_SAADC_INPUT_AIN6,
+    NRF_SAADC_INPUT_AIN7, NRF_SAADC_INPUT_VDD
+} nrf_saadc_input_t;
+
+typedef enum {
+    NRF_SAADC_RESOLUTION_8BIT, NRF_SAADC_RESOLUTION_10BIT, NRF_SAADC_RESOLUTION_12BIT, NRF_SAADC_RESOLUTION_14BIT
+} nrf_saadc_resolution_t;
+
+typedef enum {
+    NRF_SAADC_OVERSAMPLE_DISABLED, NRF_SAADC_OVERSAMPLE_2X, NRF_SAADC_OVERSAMPLE_4X, NRF_SAADC_OVERSAMPLE_8X,
+    NRF_SAADC_OVERSAMPLE_16X, NRF_SAADC_OVERSAMPLE_32X, NRF_SAADC_OVERSAMPLE_64X, NRF_SAADC_OVERSAMPLE_128X,
+    NRF_SAADC_OVERSAMPLE_256X
+} nrf_saadc_oversample_t;
+
+typedef enum {
+    NRF_SAADC_GAIN1_6, NRF_SAADC_GAIN1_5, NRF_SAADC_GAIN1_4, NRF_SAADC_GAIN1_3,
+    NRF_SAADC_GAIN1_2, NRF_SAADC_GAIN1, NRF_SAADC_GAIN2, NRF_SAADC_GAIN4
+} nrf_saadc_gain_t;
+
+typedef enum { NRF_SAADC_REFERENCE_INTERNAL, NRF_SAADC_REFERENCE_VDD4 } nrf_saadc_reference_t;
+typedef enum { NRF_SAADC_ACQTIME_3US, NRF_SAADC_ACQTIME_5US, NRF_SAADC_ACQTIME_10US,
+               NRF_SAADC_ACQTIME_15US, NRF_SAADC_ACQTIME_20US, NRF_SAADC_ACQTIME_40US } nrf_saadc_acqtime_t;
+typedef enum { NRF_SAADC_MODE_SINGLE_ENDED, NRF_SAADC_MODE_DIFFERENTIAL } nrf_saadc_mode_t;
+typedef enum { NRF_SAADC_BURST_DISABLED, NRF_SAADC_BURST_ENABLED } nrf_saadc_burst_t;
+typedef enum { NRF_SAADC_RESISTOR_DISABLED, NRF_SAADC_RESISTOR_PULLDOWN,
+               NRF_SAADC_RESISTOR_PULLUP, NRF_SAADC_RESISTOR_VDD1_2 } nrf_saadc_resistor_t;
+typedef enum { NRF_SAADC_LIMIT_LOW, NRF_SAADC_LIMIT_HIGH } nrf_saadc_limit_t;
+
+typedef enum {
+    NRF_SAADC_TASK_START, NRF_SAADC_TASK_SAMPLE, NRF_SAADC_TASK_STOP, NRF_SAADC_TASK_CALIBRATEOFFSET
+} nrf_saadc_task_t;
+
+typedef enum {
+    NRF_SAADC_EVENT_STARTED, NRF_SAADC_EVENT_END, NRF_SAADC_EVENT_DONE, NRF_SAADC_EVENT_RESULTDONE,
+    NRF_SAADC_EVENT_CALIBRATEDONE, NRF_SAADC_EVENT_STOPPED
+} nrf_saadc_event_t;
+
+#define NRF_SAADC_INT_STARTED       (1u << 0)
+#define NRF_SAADC_INT_END           (1u << 1)
+#define NRF_SAADC_INT_DONE          (1u << 2)
+#define NRF_SAADC_INT_RESULTDONE    (1u << 3)
+#define NRF_SAADC_INT_CALIBRATEDONE (1u << 4)
+#define NRF_SAADC_INT_STOPPED       (1u << 5)
+
+typedef struct {
+    nrf_saadc_resistor_t resistor_p;
+    nrf_saadc_resistor_t resistor_n;
+    nrf_saadc_gain_t gain;
+    nrf_saadc_reference_t reference;
+    nrf_saadc_acqtime_t acq_time;
+    nrf_saadc_mode_t mode;
+    nrf_saadc_burst_t burst;
+} nrf_saadc_channel_config_t;
+
+typedef struct {
+    nrf_saadc_channel_config_t channel_config;
+    nrf_saadc_input_t pin_p;
+    nrf_saadc_input_t pin_n;
+    uint8_t channel_index;
+} nrfx_saadc_channel_t;
+
+#define NRFX_SAADC_DEFAULT_CHANNEL_SE(_pin_p, _index)       \
+{                                                           \
+    .channel_config = {                                     \
+        .resistor_p = NRF_SAADC_RESISTOR_DISABLED,          \
+        .resistor_n = NRF_SAADC_RESISTOR_DISABLED,          \
+        .gain       = NRF_SAADC_GAIN1_6,                    \
+        .reference  = NRF_SAADC_REFERENCE_INTERNAL,         \
+        .acq_time   = NRF_SAADC_ACQTIME_10US,               \
+        .mode       = NRF_SAADC_MODE_SINGLE_ENDED,          \
+        .burst      = NRF_SAADC_BURST_DISABLED,             \
+    },                                                      \
+    .pin_p         = (_pin_p),                              \
+    .pin_n         = NRF_SAADC_INPUT_DISABLED,              \
+    .channel_index = (_index),                              \
+}
+
+typedef struct {
+    nrf_saadc_oversample_t oversampling;
+    nrf_saadc_burst_t burst;
+    uint16_t internal_timer_cc;
+    bool start_on_end;
+} nrfx_saadc_adv_config_t;
+
+#define NRFX_SAADC_DEFAULT_ADV_CONFIG                       \
+{                                                           \
+    .oversampling      = NRF_SAADC_OVERSAMPLE_DISABLED,     \
+    .burst             = NRF_SAADC_BURST_DISABLED,          \
+    .internal_timer_cc = 0,                                 \
+    .start_on_end      = false,                             \
+}
+
+typedef enum {
+    NRFX_SAADC_EVT_DONE,
+    NRFX_SAADC_EVT_LIMIT,
+    NRFX_SAADC_EVT_CALIBRATEDONE,
+    NRFX_SAADC_EVT_BUF_REQ,
+    NRFX_SAADC_EVT_READY,
+    NRFX_SAADC_EVT_FINISHED
+} nrfx_saadc_evt_type_t;
+
+typedef struct {
+    nrf_saadc_value_t *p_buffer;
+    uint16_t size;
+} nrfx_saadc_done_evt_t;
+
+typedef struct {
+    uint8_t channel;
+    nrf_saadc_limit_t limit_type;
+} nrfx_saadc_limit_evt_t;
+
+typedef struct {
+    nrfx_saadc_evt_type_t type;
+    union {
+        nrfx_saadc_done_evt_t done;
+        nrfx_saadc_limit_evt_t limit;
+    } data;
+} nrfx_saadc_evt_t;
+
+typedef void (*nrfx_saadc_event_handler_t)(nrfx_saadc_evt_t const *p_event);
+
+nrfx_err_t nrfx_saadc_init(uint8_t interrupt_priority);
+void nrfx_saadc_uninit(void);
+nrfx_err_t nrfx_saadc_channels_config(nrfx_saadc_channel_t const *p_channels, uint32_t channel_count);
+nrfx_err_t nrfx_saadc_advanced_mode_set(uint32_t channel_mask, nrf_saadc_resolution_t resolution,
+                                        nrfx_saadc_adv_config_t const *p_config,
+                                        nrfx_saadc_event_handler_t event_handler);
+nrfx_err_t nrfx_saadc_buffer_set(nrf_saadc_value_t *p_buffer, uint16_t size);
+nrfx_err_t nrfx_saadc_mode_trigger(void);
+void nrfx_saadc_abort(void);
+nrfx_err_t nrfx_saadc_limits_set(uint8_t channel, int16_t limit_low, int16_t limit_high);
+nrfx_err_t nrfx_saadc_offset_calibrate(nrfx_saadc_event_handler_t calib_event_handler);
+
+void nrf_saadc_task_trigger(nrf_saadc_task_t task);
+uint32_t nrf_saadc_task_address_get(nrf_saadc_task_t task);
+bool nrf_saadc_event_check(nrf_saadc_event_t event);
+void nrf_saadc_event_clear(nrf_saadc_event_t event);
+uint32_t nrf_saadc_event_address_get(nrf_saadc_event_t event);
+void nrf_saadc_int_enable(uint32_t mask);
+uint32_t nrf_saadc_int_enable_check(uint32_t mask);
+void nrf_saadc_int_disable(uint32_t mask);
+void nrf_saadc_buffer_init(nrf_saadc_value_t *p_buffer, uint32_t size);
+void nrf_saadc_resolution_set(nrf_saadc_resolution_t resolution);
+void nrf_saadc_oversample_set(nrf_saadc_oversample_t oversample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NRFX_SAADC_H
@@ -0,0 +1,113 @@
+#ifndef HOST_NRFX_TIMER_H
+#define HOST_NRFX_TIMER_H
+
+// Host stand-in for nrfx_timer.h, simulated by host_saadc.c along with the
+// SAADC and PPI. A timer in timer mode counts the simulated time, one in
+// counter mode its COUNT tasks; compare events reach PPI and, when their
+// interrupt is enabled, the event handler.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "sdk_errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_TIMER_COUNT    5 // TIMER0 to TIMER4
+#define HOST_TIMER_CC_COUNT 6
+
+typedef enum {
+    NRF_TIMER_FREQ_16MHz = 0, NRF_TIMER_FREQ_8MHz, NRF_TIMER_FREQ_4MHz, NRF_TIMER_FREQ_2MHz,
+    NRF_TIMER_FREQ_1MHz, NRF_TIMER_FREQ_500kHz, NRF_TIMER_FREQ_250kHz, NRF_TIMER_FREQ_125kHz,
+    NRF_TIMER_FREQ_62500Hz, NRF_TIMER_FREQ_31250Hz
+} nrf_timer_frequency_t;
+
+typedef enum {
+    NRF_TIMER_MODE_TIMER = 0, NRF_TIMER_MODE_COUNTER, NRF_TIMER_MODE_LOW_POWER_COUNTER
+} nrf_timer_mode_t;
+
+typedef enum {
+    NRF_TIMER_BIT_WIDTH_16 = 0, NRF_TIMER_BIT_WIDTH_8, NRF_TIMER_BIT_WIDTH_24, NRF_TIMER_BIT_WIDTH_32
+} nrf_timer_bit_width_t;
+
+typedef enum {
+    NRF_TIMER_CC_CHANNEL0 = 0, NRF_TIMER_CC_CHANNEL1, NRF_TIMER_CC_CHANNEL2,
+    NRF_TIMER_CC_CHANNEL3, NRF_TIMER_CC_CHANNEL4, NRF_TIMER_CC_CHANNEL5
+} nrf_timer_cc_channel_t;
+
+typedef enum {
+    NRF_TIMER_TASK_START, NRF_TIMER_TASK_STOP, NRF_TIMER_TASK_COUNT, NRF_TIMER_TASK_CLEAR,
+    NRF_TIMER_TASK_SHUTDOWN, NRF_TIMER_TASK_CAPTURE0 = 16
+} nrf_timer_task_t;
+
+typedef enum {
+    NRF_TIMER_EVENT_COMPARE0 = 0, NRF_TIMER_EVENT_COMPARE1, NRF_TIMER_EVENT_COMPARE2,
+    NRF_TIMER_EVENT_COMPARE3, NRF_TIMER_EVENT_COMPARE4, NRF_TIMER_EVENT_COMPARE5
+} nrf_timer_event_t;
+
+typedef enum {
+    NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK = 1u << 0,
+    NRF_TIMER_SHORT_COMPARE1_CLEAR_MASK = 1u << 1,
+    NRF_TIMER_SHORT_COMPARE2_CLEAR_MASK = 1u << 2,
+    NRF_TIMER_SHORT_COMPARE3_CLEAR_MASK = 1u << 3,
+    NRF_TIMER_SHORT_COMPARE4_CLEAR_MASK = 1u << 4,
+    NRF_TIMER_SHORT_COMPARE5_CLEAR_MASK = 1u << 5,
+    NRF_TIMER_SHORT_COMPARE0_STOP_MASK  = 1u << 8,
+    NRF_TIMER_SHORT_COMPARE1_STOP_MASK  = 1u << 9,
+    NRF_TIMER_SHORT_COMPARE2_STOP_MASK  = 1u << 10,
+    NRF_TIMER_SHORT_COMPARE3_STOP_MASK  = 1u << 11,
+    NRF_TIMER_SHORT_COMPARE4_STOP_MASK  = 1u << 12,
+    NRF_TIMER_SHORT_COMPARE5_STOP_MASK  = 1u << 13
+} nrf_timer_short_mask_t;
+
+typedef struct {
+    uint8_t instance_id;
+    uint8_t cc_channel_count;
+} nrfx_timer_t;
+
+#define NRFX_TIMER_INSTANCE(id) { .instance_id = (id), .cc_channel_count = HOST_TIMER_CC_COUNT }
+
+typedef struct {
+    nrf_timer_frequency_t frequency;
+    nrf_timer_mode_t mode;
+    nrf_timer_bit_width_t bit_width;
+    uint8_t interrupt_priority;
+    void *p_context;
+} nrfx_timer_config_t;
+
+#define NRFX_TIMER_DEFAULT_CONFIG                           \
+{                                                           \
+    .frequency          = NRF_TIMER_FREQ_16MHz,             \
+    .mode               = NRF_TIMER_MODE_TIMER,             \
+    .bit_width          = NRF_TIMER_BIT_WIDTH_16,           \
+    .interrupt_priority = 6,                                \
+    .p_context          = NULL,                             \
+}
+
+typedef void (*nrfx_timer_event_handler_t)(nrf_timer_event_t event_type, void *p_context);
+
+nrfx_err_t nrfx_timer_init(nrfx_timer_t const *p_instance, nrfx_timer_config_t const *p_config,
+                           nrfx_timer_event_handler_t timer_event_handler);
+void nrfx_timer_uninit(nrfx_timer_t const *p_instance);
+void nrfx_timer_enable(nrfx_timer_t const *p_instance);
+void nrfx_timer_disable(nrfx_timer_t const *p_instance);
+void nrfx_timer_pause(nrfx_timer_t const *p_instance);
+void nrfx_timer_resume(nrfx_timer_t const *p_instance);
+void nrfx_timer_clear(nrfx_timer_t const *p_instance);
+uint32_t nrfx_timer_capture(nrfx_timer_t const *p_instance, nrf_timer_cc_channel_t cc_channel);
+uint32_t nrfx_timer_capture_get(nrfx_timer_t const *p_instance, nrf_timer_cc_channel_t cc_channel);
+void nrfx_timer_compare(nrfx_timer_t const *p_instance, nrf_timer_cc_channel_t cc_channel,
+                        uint32_t cc_value, bool enable_int);
+void nrfx_timer_extended_compare(nrfx_timer_t const *p_instance, nrf_timer_cc_channel_t cc_channel,
+                                 uint32_t cc_value, nrf_timer_short_mask_t timer_short_mask, bool enable_int);
+uint32_t nrfx_timer_task_address_get(nrfx_timer_t const *p_instance, nrf_timer_task_t timer_task);
+uint32_t nrfx_timer_capture_task_address_get(nrfx_timer_t const *p_instance, uint32_t channel);
+uint32_t nrfx_timer_compare_event_address_get(nrfx_timer_t const *p_instance, uint32_t channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NRFX_TIMER_H
@@ -0,0 +1,43 @@
+#ifndef HOST_SDK_ERRORS_H
+#define HOST_SDK_ERRORS_H
+
+// Host stand-in for the SDK error codes (nrf_error.h, sdk_errors.h, nrfx_errors.h).
+
+#include <stdint.h>
+
+typedef uint32_t ret_code_t;
+
+#define NRF_SUCCESS                 0
+#define NRF_ERROR_INTERNAL          3
+#define NRF_ERROR_NO_MEM            4
+#define NRF_ERROR_NOT_FOUND         5
+#define NRF_ERROR_NOT_SUPPORTED     6
+#define NRF_ERROR_INVALID_PARAM     7
+#define NRF_ERROR_INVALID_STATE     8
+#define NRF_ERROR_INVALID_LENGTH    9
+#define NRF_ERROR_TIMEOUT           13
+#define NRF_ERROR_NULL              14
+#define NRF_ERROR_FORBIDDEN         15
+#define NRF_ERROR_INVALID_ADDR      16
+#define NRF_ERROR_BUSY              17
+#define NRF_ERROR_MODULE_ALREADY_INITIALIZED 0x8005
+
+// The nRF5 SDK flavour of nrfx_errors.h maps the nrfx codes onto the SDK ones,
+// so an nrfx result can go through APP_ERROR_CHECK.
+typedef enum {
+    NRFX_SUCCESS                = NRF_SUCCESS,
+    NRFX_ERROR_INTERNAL         = NRF_ERROR_INTERNAL,
+    NRFX_ERROR_NO_MEM           = NRF_ERROR_NO_MEM,
+    NRFX_ERROR_NOT_SUPPORTED    = NRF_ERROR_NOT_SUPPORTED,
+    NRFX_ERROR_INVALID_PARAM    = NRF_ERROR_INVALID_PARAM,
+    NRFX_ERROR_INVALID_STATE    = NRF_ERROR_INVALID_STATE,
+    NRFX_ERROR_INVALID_LENGTH   = NRF_ERROR_INVALID_LENGTH,
+    NRFX_ERROR_TIMEOUT          = NRF_ERROR_TIMEOUT,
+    NRFX_ERROR_FORBIDDEN        = NRF_ERROR_FORBIDDEN,
+    NRFX_ERROR_NULL             = NRF_ERROR_NULL,
+    NRFX_ERROR_INVALID_ADDR     = NRF_ERROR_INVALID_ADDR,
+    NRFX_ERROR_BUSY             = NRF_ERROR_BUSY,
+    NRFX_ERROR_ALREADY_INITIALIZED = NRF_ERROR_MODULE_ALREADY_INITIALIZED
+} nrfx_err_t;
+
+#endif // HOST_SDK_ERRORS_H
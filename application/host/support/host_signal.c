@@ -0,0 +1,166 @@
+/**
+ * @file host_signal.c
+ * @brief Synthetic and recorded sensor input for the host build.
+ * 
+ * Builds the electrode signals the host tests and benchmarks feed to the
+ * sensor pipeline: an idle level with white noise, mains hum, a slow drift and
+ * trapezoid proximity events. The noise comes from a seeded generator so every
+ * run sees the same samples. Recorded traces are loaded from text files.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_signal.h"
+
+#define SIGNAL_PI 3.14159265358979323846
+
+/*
+ * Prototypes for internal functions:
+ */
+static uint32_t rng_next(uint32_t *p_state);
+static double rng_gauss(uint32_t *p_state);
+
+void host_signal_init(host_signal_t *p_signal, double rate_hz, double level, double noise, uint32_t seed)
+{
+    memset(p_signal, 0, sizeof(*p_signal));
+    p_signal->rate_hz = rate_hz;
+    p_signal->level   = level;
+    p_signal->noise   = noise;
+    p_signal->hum_hz  = 50.0;
+    p_signal->seed    = seed;
+}
+
+int host_signal_event_add(host_signal_t *p_signal, uint32_t start, uint32_t ramp, uint32_t hold, double amplitude)
+{
+    if (p_signal->event_count >= HOST_SIGNAL_MAX_EVENTS) {
+        return -1;
+    }
+    host_signal_event_t *p_event = &p_signal->events[p_signal->event_count++];
+    p_event->start     = start;
+    p_event->ramp      = ramp;
+    p_event->hold      = hold;
+    p_event->amplitude = amplitude;
+    return 0;
+}
+
+double host_signal_clean(const host_signal_t *p_signal, uint32_t index)
+{
+    double t = index / p_signal->rate_hz;
+    double value = p_signal->level + p_signal->drift_per_sample * index;
+    uint32_t at = (p_signal->event_period > 0) ? index % p_signal->event_period : index;
+
+    if (p_signal->hum_amplitude != 0.0) {
+        double phase = 2.0 * SIGNAL_PI * p_signal->hum_hz * t;
+        value += p_signal->hum_amplitude * (sin(phase) + p_signal->hum_harmonic * sin(3.0 * phase));
+    }
+    for (uint8_t i = 0; i < p_signal->event_count; i++) {
+        const host_signal_event_t *p_event = &p_signal->events[i];
+        if (at < p_event->start) {
+            continue;
+        }
+        uint32_t offset = at - p_event->start;
+        uint32_t ramp = (p_event->ramp > 0) ? p_event->ramp : 1;
+        if (offset < ramp) {
+            value += p_event->amplitude * offset / ramp;
+        } else if (offset < ramp + p_event->hold) {
+            value += p_event->amplitude;
+        } else if (offset < 2 * ramp + p_event->hold) {
+            value += p_event->amplitude * (2 * ramp + p_event->hold - offset) / ramp;
+        }
+    }
+    return value;
+}
+
+void host_signal_generate(const host_signal_t *p_signal, int16_t *p_samples, size_t n)
+{
+    uint32_t state = p_signal->seed ? p_signal->seed : 1;
+
+    for (size_t i = 0; i < n; i++) {
+        double value = host_signal_clean(p_signal, (uint32_t)i) + p_signal->noise * rng_gauss(&state);
+        value = floor(value + 0.5);
+        if (value > INT16_MAX) {
+            value = INT16_MAX;
+        } else if (value < INT16_MIN) {
+            value = INT16_MIN;
+        }
+        p_samples[i] = (int16_t)value;
+    }
+}
+
+long host_trace_load(const char *p_path, int16_t *p_samples, size_t capacity)
+{
+    FILE *p_file = fopen(p_path, "r");
+    char line[256];
+    size_t count = 0;
+
+    if (p_file == NULL) {
+        return -1;
+    }
+    while (count < capacity && fgets(line, sizeof(line), p_file) != NULL) {
+        char *p_end;
+        long value = strtol(line, &p_end, 10);
+        if (p_end == line) {
+            continue;
+        }
+        p_samples[count++] = (int16_t)((value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : value);
+    }
+    fclose(p_file);
+    return (long)count;
+}
+
+/**
+ * @brief Advance a xorshift32 generator.
+ *
+ * @param p_state Generator state, never 0.
+ * @return uint32_t The next value.
+ */
+static uint32_t rng_next(uint32_t *p_state)
+{
+    uint32_t x = *p_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *p_state = x;
+    return x;
+}
+
+/**
+ * @brief Draw a standard normal value (Box-Muller).
+ *
+ * @param p_state Generator state.
+ * @return double The value.
+ */
+static double rng_gauss(uint32_t *p_state)
+{
+    double u1 = (rng_next(p_state) + 1.0) / 4294967297.0;
+    double u2 = rng_next(p_state) / 4294967296.0;
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * SIGNAL_PI * u2);
+}
@@ -0,0 +1,102 @@
+#ifndef HOST_SIGNAL_H
+#define HOST_SIGNAL_H
+
+// Sensor input for the host build: synthetic electrode signals at the sensor
+// sample rate, and recorded traces loaded from text files.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_SIGNAL_MAX_EVENTS 16
+
+/**
+ * @brief A proximity event: a trapezoid added to the idle level.
+ */
+typedef struct {
+    uint32_t start;     // First sample of the rising edge
+    uint32_t ramp;      // Samples of each edge
+    uint32_t hold;      // Samples at full amplitude
+    double amplitude;   // Deviation from the idle level in counts
+} host_signal_event_t;
+
+/**
+ * @brief Description of a synthetic signal.
+ */
+typedef struct {
+    double rate_hz;           // Sample rate
+    double level;             // Idle level in counts
+    double noise;             // Standard deviation of the white noise in counts
+    double hum_amplitude;     // Mains hum amplitude in counts (0: none)
+    double hum_hz;            // Mains frequency
+    double hum_harmonic;      // Third harmonic amplitude, relative to the fundamental
+    double drift_per_sample;  // Linear drift of the idle level in counts per sample
+    uint32_t seed;            // Noise seed, the same seed gives the same signal
+    uint32_t event_period;    // Samples after which the events repeat (0: once)
+    uint8_t event_count;
+    host_signal_event_t events[HOST_SIGNAL_MAX_EVENTS];
+} host_signal_t;
+
+/**
+ * @brief Initialize a signal: idle level and white noise, no hum, drift or events.
+ *
+ * @param p_signal Pointer to the signal description.
+ * @param rate_hz Sample rate.
+ * @param level Idle level in counts.
+ * @param noise Standard deviation of the noise in counts.
+ * @param seed Noise seed.
+ */
+void host_signal_init(host_signal_t *p_signal, double rate_hz, double level, double noise, uint32_t seed);
+
+/**
+ * @brief Add a proximity event.
+ *
+ * @param p_signal Pointer to the signal description.
+ * @param start First sample of the rising edge.
+ * @param ramp Samples of each edge.
+ * @param hold Samples at full amplitude.
+ * @param amplitude Deviation from the idle level in counts.
+ * @return int 0 on success, -1 if the event table is full.
+ */
+int host_signal_event_add(host_signal_t *p_signal, uint32_t start, uint32_t ramp, uint32_t hold, double amplitude);
+
+/**
+ * @brief Get the noiseless value of the signal at a sample index.
+ *
+ * @param p_signal Pointer to the signal description.
+ * @param index Sample index.
+ * @return double The level, hum, drift and events at that sample.
+ */
+double host_signal_clean(const host_signal_t *p_signal, uint32_t index);
+
+/**
+ * @brief Generate samples, rounded and saturated to int16_t.
+ *
+ * @param p_signal Pointer to the signal description.
+ * @param p_samples Array receiving the samples.
+ * @param n Number of samples.
+ */
+void host_signal_generate(const host_signal_t *p_signal, int16_t *p_samples, size_t n);
+
+/**
+ * @brief Load a recorded trace.
+ *
+ * One sample per line: the first integer of the line is taken, so a column
+ * of readings or a CSV with the readings first can be used as is. Lines
+ * without a leading integer (headers, '#' comments) are skipped.
+ *
+ * @param p_path Path of the trace file.
+ * @param p_samples Array receiving the samples.
+ * @param capacity Size of the array.
+ * @return long Number of samples loaded, -1 if the file cannot be read.
+ */
+long host_trace_load(const char *p_path, int16_t *p_samples, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_SIGNAL_H
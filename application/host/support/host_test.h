@@ -0,0 +1,63 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// Minimal checks for the host tests: a failed check is reported with its
+// location and the test keeps running; host_test_result() gives the exit status.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint32_t host_test_checks;   // Checks evaluated
+extern uint32_t host_test_failures; // Checks failed
+
+#define HOST_CHECK(condition)                                                          \
+    do {                                                                               \
+        host_test_checks++;                                                            \
+        if (!(condition)) {                                                            \
+            host_test_failures++;                                                      \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        }                                                                              \
+    } while (0)
+
+#define HOST_CHECK_EQ(actual, expected)                                                \
+    do {                                                                               \
+        long long host_actual = (long long)(actual);                                   \
+        long long host_expected = (long long)(expected);                               \
+        host_test_checks++;                                                            \
+        if (host_actual != host_expected) {                                            \
+            host_test_failures++;                                                      \
+            fprintf(stderr, "%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__,  \
+                    #actual, host_actual, host_expected);                              \
+        }                                                                              \
+    } while (0)
+
+#define HOST_CHECK_NEAR(actual, expected, tolerance)                                   \
+    do {                                                                               \
+        double host_actual = (double)(actual);                                         \
+        double host_expected = (double)(expected);                                     \
+        double host_error = host_actual - host_expected;                               \
+        host_test_checks++;                                                            \
+        if (host_error > (tolerance) || host_error < -(tolerance)) {                   \
+            host_test_failures++;                                                      \
+            fprintf(stderr, "%s:%d: %s is %g, expected %g +/- %g\n", __FILE__, __LINE__, \
+                    #actual, host_actual, host_expected, (double)(tolerance));         \
+        }                                                                              \
+    } while (0)
+
+/**
+ * @brief Print the summary of a test program.
+ *
+ * @param p_name Name of the test program.
+ * @return int Exit status: 0 if every check passed, 1 otherwise.
+ */
+int host_test_result(const char *p_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_TEST_H
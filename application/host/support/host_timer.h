@@ -0,0 +1,31 @@
+#ifndef HOST_TIMER_H
+#define HOST_TIMER_H
+
+// Wall clock and cycle counter of the host, for the benchmarks. Host cycles
+// only compare implementations with each other; they are not Cortex-M4 cycles.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get a monotonic time.
+ *
+ * @return uint64_t Nanoseconds since an arbitrary origin.
+ */
+uint64_t host_time_ns(void);
+
+/**
+ * @brief Read the CPU cycle counter.
+ *
+ * @return uint64_t Cycles since an arbitrary origin, 0 where the host has no readable counter.
+ */
+uint64_t host_cycles(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_TIMER_H
@@ -0,0 +1,14 @@
+/**
+ * @file log_argument_limit.c
+ * @brief Must not compile: a log message with more than 6 format arguments.
+ *
+ * The nRF5 logger stores at most 6 arguments per message. The host build
+ * compiles this file with -fsyntax-only and expects the nrf_log stand-in to
+ * reject it, which keeps every message of the firmware within the limit.
+ */
+#include "nrf_log.h"
+
+void log_argument_limit(void)
+{
+    NRF_LOG_INFO("%d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7);
+}
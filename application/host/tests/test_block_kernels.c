@@ -0,0 +1,272 @@
+/**
+ * @file test_block_kernels.c
+ * @brief Host test of the block kernels: DSP path against the portable path.
+ * 
+ * Builds the block kernels twice, once with BLOCK_KERNELS_DSP set and the
+ * SIMD intrinsics emulated by the host nrf.h, once with the portable C loops,
+ * and runs both on random and extreme blocks of every length up to a few
+ * hundred samples, starting at every halfword offset of a word. For every
+ * kernel (sum, minimum/maximum, sum of squares and decimation at each ratio)
+ * both paths must give the same result as a plain walk of the block, so they
+ * are identical to each other. The sum is also checked at its longest block
+ * of extremes. The cost of a 100-sample block is reported in host cycles for
+ * each kernel; the DSP column times the emulation and only shows the path
+ * runs, Cortex-M4 cycles have to be read on the target.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdlib.h>
+
+#include "block_kernels.h"
+#include "host_test.h"
+#include "host_timer.h"
+
+#define TEST_MAX_LENGTH    300    // Longest block checked
+#define TEST_OFFSETS       4      // Halfword offsets of the first sample within two words
+#define TEST_RANDOM_BLOCKS 20     // Random blocks per length and offset
+#define TEST_BLOCK_LENGTH  100    // Samples per timed block
+#define TEST_BLOCK_REPEATS 100000 // Timed blocks per kernel and path
+#define TEST_TIMED_RATIO   3      // Decimation ratio timed (2^3, as the sensor decimation)
+
+// The same kernels compiled with the DSP path (symbols renamed by the build)
+int32_t block_sum_dsp(const int16_t *p_samples, size_t n);
+void block_min_max_dsp(const int16_t *p_samples, size_t n, int16_t *p_min, int16_t *p_max);
+int64_t block_sum_squares_dsp(const int16_t *p_samples, size_t n);
+size_t block_decimate_dsp(const int16_t *p_input, size_t n, uint8_t ratio_log2, int16_t *p_output);
+
+// One build of the kernels
+typedef struct {
+    int32_t (*sum)(const int16_t *p_samples, size_t n);
+    void (*min_max)(const int16_t *p_samples, size_t n, int16_t *p_min, int16_t *p_max);
+    int64_t (*sum_squares)(const int16_t *p_samples, size_t n);
+    size_t (*decimate)(const int16_t *p_input, size_t n, uint8_t ratio_log2, int16_t *p_output);
+} kernels_t;
+
+// Host cycles per block of each kernel
+typedef struct {
+    double sum;
+    double min_max;
+    double sum_squares;
+    double decimate;
+} kernel_cycles_t;
+
+/*
+ * Global variables:
+ */
+static const kernels_t paths[] = {
+    { block_sum, block_min_max, block_sum_squares, block_decimate },
+    { block_sum_dsp, block_min_max_dsp, block_sum_squares_dsp, block_decimate_dsp },
+};
+static int16_t samples[BLOCK_KERNELS_MAX_SUM_LENGTH + TEST_OFFSETS];
+static int16_t decimated[TEST_MAX_LENGTH];
+static volatile int64_t sink;
+
+/*
+ * Prototypes for internal functions:
+ */
+static void check_block(const int16_t *p_samples, size_t n);
+static void check_random(void);
+static void check_extremes(void);
+static void check_sum_limit(void);
+static kernel_cycles_t time_kernels(const kernels_t *p_kernels);
+
+int main(void)
+{
+    check_random();
+    check_extremes();
+    check_sum_limit();
+
+    kernel_cycles_t portable = time_kernels(&paths[0]);
+    kernel_cycles_t dsp = time_kernels(&paths[1]);
+    printf("Host cycles per %d-sample block (DSP path emulated):\n", TEST_BLOCK_LENGTH);
+    printf("  %-20s %8s %8s\n", "kernel", "portable", "DSP");
+    printf("  %-20s %8.0f %8.0f\n", "block_sum", portable.sum, dsp.sum);
+    printf("  %-20s %8.0f %8.0f\n", "block_min_max", portable.min_max, dsp.min_max);
+    printf("  %-20s %8.0f %8.0f\n", "block_sum_squares", portable.sum_squares, dsp.sum_squares);
+    printf("  block_decimate (2^%d) %8.0f %8.0f\n", TEST_TIMED_RATIO, portable.decimate, dsp.decimate);
+    return host_test_result("test_block_kernels");
+}
+
+/**
+ * @brief Compare every kernel of both paths with a plain walk on one block.
+ *
+ * @param p_samples Pointer to the block.
+ * @param n Number of samples.
+ */
+static void check_block(const int16_t *p_samples, size_t n)
+{
+    int32_t sum = 0;
+    int64_t sum_squares = 0;
+    int16_t min = INT16_MAX;
+    int16_t max = INT16_MIN;
+
+    for (size_t i = 0; i < n; i++) {
+        sum += p_samples[i];
+        sum_squares += (int32_t)p_samples[i] * p_samples[i];
+        min = (p_samples[i] < min) ? p_samples[i] : min;
+        max = (p_samples[i] > max) ? p_samples[i] : max;
+    }
+
+    for (size_t path = 0; path < sizeof(paths) / sizeof(paths[0]); path++) {
+        const kernels_t *p_kernels = &paths[path];
+        int16_t path_min, path_max;
+
+        HOST_CHECK_EQ(p_kernels->sum(p_samples, n), sum);
+        p_kernels->min_max(p_samples, n, &path_min, &path_max);
+        HOST_CHECK_EQ(path_min, min);
+        HOST_CHECK_EQ(path_max, max);
+        HOST_CHECK_EQ(p_kernels->sum_squares(p_samples, n), sum_squares);
+
+        for (uint8_t ratio_log2 = 0; ratio_log2 <= BLOCK_KERNELS_MAX_DECIMATION_LOG2 + 1; ratio_log2++) {
+            size_t outputs = p_kernels->decimate(p_samples, n, ratio_log2, decimated);
+            size_t mismatches = 0;
+
+            if (ratio_log2 > BLOCK_KERNELS_MAX_DECIMATION_LOG2) {
+                HOST_CHECK_EQ(outputs, 0);
+                continue;
+            }
+            HOST_CHECK_EQ(outputs, n >> ratio_log2);
+            for (size_t out = 0; out < outputs; out++) {
+                int32_t group = 0;
+                for (size_t i = 0; i < ((size_t)1 << ratio_log2); i++) {
+                    group += p_samples[(out << ratio_log2) + i];
+                }
+                mismatches += (decimated[out] != (int16_t)(group >> ratio_log2)) ? 1 : 0;
+            }
+            HOST_CHECK_EQ(mismatches, 0);
+        }
+    }
+}
+
+/**
+ * @brief Random blocks over the full 16-bit range and over a narrow one, every length and offset.
+ */
+static void check_random(void)
+{
+    for (size_t n = 0; n <= TEST_MAX_LENGTH; n++) {
+        for (size_t offset = 0; offset < TEST_OFFSETS; offset++) {
+            for (int block = 0; block < TEST_RANDOM_BLOCKS; block++) {
+                // Odd blocks stay near one level, like a quiet SAADC buffer
+                int spread = (block & 1) ? 16 : 65536;
+                for (size_t i = 0; i < n; i++) {
+                    samples[offset + i] = (int16_t)((rand() % spread) - spread / 2);
+                }
+                check_block(&samples[offset], n);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Extremes in either lane, at the ends and in the odd tail, and the 16-bit limits.
+ *
+ * SSUB16 compares on the exact difference, so INT16_MIN against INT16_MAX
+ * must not wrap; SMLAD and SMLALD must sign-extend both lanes.
+ */
+static void check_extremes(void)
+{
+    const int16_t extremes[] = { INT16_MIN, INT16_MAX, -1, 0 };
+
+    for (size_t n = 1; n <= 9; n++) {
+        for (size_t position = 0; position < n; position++) {
+            for (size_t e = 0; e < sizeof(extremes) / sizeof(extremes[0]); e++) {
+                for (size_t i = 0; i < n; i++) {
+                    samples[i] = (int16_t)((i & 1) ? 7 : -7);
+                }
+                samples[position] = extremes[e];
+                check_block(samples, n);
+                samples[(position + 1) % n] = (extremes[e] == INT16_MIN) ? INT16_MAX : INT16_MIN;
+                check_block(samples, n);
+            }
+        }
+    }
+}
+
+/**
+ * @brief The sum of the longest accepted block of either 16-bit limit fits its 32-bit total.
+ */
+static void check_sum_limit(void)
+{
+    const int16_t limits[] = { INT16_MIN, INT16_MAX };
+
+    for (size_t l = 0; l < sizeof(limits) / sizeof(limits[0]); l++) {
+        for (size_t i = 0; i < BLOCK_KERNELS_MAX_SUM_LENGTH; i++) {
+            samples[i] = limits[l];
+        }
+        for (size_t path = 0; path < sizeof(paths) / sizeof(paths[0]); path++) {
+            HOST_CHECK_EQ(paths[path].sum(samples, BLOCK_KERNELS_MAX_SUM_LENGTH),
+                          (int32_t)((int64_t)limits[l] * BLOCK_KERNELS_MAX_SUM_LENGTH));
+            HOST_CHECK_EQ(paths[path].sum_squares(samples, BLOCK_KERNELS_MAX_SUM_LENGTH),
+                          (int64_t)limits[l] * limits[l] * BLOCK_KERNELS_MAX_SUM_LENGTH);
+        }
+    }
+}
+
+/**
+ * @brief Time each kernel of one path on a 100-sample block, through function pointers.
+ *
+ * @param p_kernels The kernels of the path.
+ * @return kernel_cycles_t Host cycles per block of each kernel.
+ */
+static kernel_cycles_t time_kernels(const kernels_t *p_kernels)
+{
+    const kernels_t *volatile p_call = p_kernels;
+    kernel_cycles_t cycles;
+    uint64_t start;
+    int16_t min, max;
+
+    for (int i = 0; i < TEST_BLOCK_LENGTH; i++) {
+        samples[i] = (int16_t)((rand() % 65536) - 32768);
+    }
+
+    start = host_cycles();
+    for (int repeat = 0; repeat < TEST_BLOCK_REPEATS; repeat++) {
+        sink = p_call->sum(samples, TEST_BLOCK_LENGTH);
+    }
+    cycles.sum = (double)(host_cycles() - start) / TEST_BLOCK_REPEATS;
+
+    start = host_cycles();
+    for (int repeat = 0; repeat < TEST_BLOCK_REPEATS; repeat++) {
+        p_call->min_max(samples, TEST_BLOCK_LENGTH, &min, &max);
+        sink = min ^ max;
+    }
+    cycles.min_max = (double)(host_cycles() - start) / TEST_BLOCK_REPEATS;
+
+    start = host_cycles();
+    for (int repeat = 0; repeat < TEST_BLOCK_REPEATS; repeat++) {
+        sink = p_call->sum_squares(samples, TEST_BLOCK_LENGTH);
+    }
+    cycles.sum_squares = (double)(host_cycles() - start) / TEST_BLOCK_REPEATS;
+
+    start = host_cycles();
+    for (int repeat = 0; repeat < TEST_BLOCK_REPEATS; repeat++) {
+        sink = (int64_t)p_call->decimate(samples, TEST_BLOCK_LENGTH, TEST_TIMED_RATIO, decimated) + decimated[0];
+    }
+    cycles.decimate = (double)(host_cycles() - start) / TEST_BLOCK_REPEATS;
+
+    return cycles;
+}
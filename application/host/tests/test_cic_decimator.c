@@ -0,0 +1,343 @@
+/**
+ * @file test_cic_decimator.c
+ * @brief Host test of the CIC decimator: frequency response and block cost.
+ * 
+ * Feeds tones through cic_decimator at the SAADC rate and fits the amplitude
+ * of the decimated tone. The measured gain must follow the order 3 CIC
+ * response, times the compensating FIR when it is enabled: unity at DC, a
+ * compensated passband flat to 1 % up to an eighth of the output rate, and
+ * alias bands around multiples of the output rate rejected by 48 dB or more
+ * (from ratio 4; ratio 2 has too few samples per output for either).
+ * White noise must come out with the variance reduction the impulse response
+ * predicts. The cost of one DMA block at the firmware settings is reported
+ * in host cycles and nanoseconds.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cic_decimator.h"
+#include "sadc_driver.h"
+#include "host_test.h"
+#include "host_timer.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define TEST_AMPLITUDE     10000.0 // Tone amplitude in input counts
+#define TEST_OUTPUTS       2048    // Decimated samples fitted per tone
+#define TEST_SETTLE        8       // Decimated samples skipped while the filter fills
+#define TEST_MAX_INPUT     ((TEST_OUTPUTS + TEST_SETTLE) * CIC_DECIMATOR_MAX_RATIO)
+#define TEST_BLOCK_REPEATS 20000   // DMA blocks timed per configuration
+
+// Tolerances, in units of the DC gain
+#define TEST_RESPONSE_TOLERANCE 0.002 // Measured against theoretical gain
+#define TEST_PASSBAND_RIPPLE    0.01  // Compensated gain up to an eighth of the output rate
+#define TEST_ALIAS_REJECTION    0.004 // Gain within an eighth of the output rate around its multiples (-48 dB)
+#define TEST_SPEC_MIN_RATIO     4     // Smallest ratio held to the passband and alias limits
+
+/*
+ * Global variables:
+ */
+static int16_t input[TEST_MAX_INPUT];
+static int16_t output[TEST_MAX_INPUT];
+static cic_decimator_t decimator;
+
+/*
+ * Prototypes for internal functions:
+ */
+static void check_response(uint16_t ratio, bool compensate);
+static void check_noise_gain(uint16_t ratio, bool compensate);
+static void check_constant_and_blocks(void);
+static void report_block_cost(bool compensate);
+static double theoretical_gain(double frequency, uint16_t ratio, bool compensate);
+static double measured_gain(double frequency, uint16_t ratio, bool compensate);
+
+int main(void)
+{
+    check_constant_and_blocks();
+    for (uint16_t ratio = 2; ratio <= CIC_DECIMATOR_MAX_RATIO; ratio *= 2) {
+        check_response(ratio, false);
+        check_response(ratio, true);
+        check_noise_gain(ratio, false);
+        check_noise_gain(ratio, true);
+    }
+    report_block_cost(false);
+    report_block_cost(true);
+    return host_test_result("test_cic_decimator");
+}
+
+/**
+ * @brief Check DC gain, pass-through at ratio 1, channel independence and block splitting.
+ */
+static void check_constant_and_blocks(void)
+{
+    int16_t frame[2] = { 1234, -4321 };
+    int16_t reference[TEST_MAX_INPUT];
+
+    // Constants come out unchanged, channel by channel, once the filter is full
+    HOST_CHECK(cic_decimator_init(&decimator, SENSOR_DECIMATION_RATIO, 2, true));
+    for (int i = 0; i < 64 * SENSOR_DECIMATION_RATIO; i++) {
+        input[2 * i] = frame[0];
+        input[2 * i + 1] = frame[1];
+    }
+    size_t frames = cic_decimator_process(&decimator, input, 2 * 64 * SENSOR_DECIMATION_RATIO, output);
+    HOST_CHECK_EQ(frames, 64);
+    HOST_CHECK_EQ(output[2 * 63], frame[0]);
+    HOST_CHECK_EQ(output[2 * 63 + 1], frame[1]);
+
+    // Ratio 1 without compensation is the identity
+    HOST_CHECK(cic_decimator_init(&decimator, 1, 1, false));
+    for (int i = 0; i < 1000; i++) {
+        input[i] = (int16_t)((rand() % 65536) - 32768);
+    }
+    HOST_CHECK_EQ(cic_decimator_process(&decimator, input, 1000, output), 1000);
+    HOST_CHECK_EQ(memcmp(input, output, 1000 * sizeof(int16_t)), 0);
+
+    // Splitting the stream into blocks of any size changes nothing
+    size_t n = 2 * 100 * SENSOR_DECIMATION_RATIO;
+    HOST_CHECK(cic_decimator_init(&decimator, SENSOR_DECIMATION_RATIO, 2, true));
+    frames = cic_decimator_process(&decimator, input, n, reference);
+    HOST_CHECK(cic_decimator_init(&decimator, SENSOR_DECIMATION_RATIO, 2, true));
+    size_t produced = 0;
+    for (size_t offset = 0, block = 2; offset < n; offset += block, block = (block % 14) + 2) {
+        size_t length = (offset + block <= n) ? block : n - offset;
+        produced += cic_decimator_process(&decimator, &input[offset], length, &output[produced * 2]);
+    }
+    HOST_CHECK_EQ(produced, frames);
+    HOST_CHECK_EQ(memcmp(reference, output, frames * 2 * sizeof(int16_t)), 0);
+}
+
+/**
+ * @brief Compare the measured gain with theory over the passband and the alias bands.
+ *
+ * @param ratio Decimation ratio.
+ * @param compensate True with the compensating FIR.
+ */
+static void check_response(uint16_t ratio, bool compensate)
+{
+    const double output_rate = (double)SAADC_SAMPLE_FREQUENCY / ratio;
+    // Offsets from the multiples of the output rate, as fractions of it
+    static const double offsets[] = { 0.01, 0.03, 0.0625, 0.1, 0.125, 0.2, 0.25, 0.35 };
+    uint32_t failures = host_test_failures;
+
+    for (unsigned m = 0; m < 4 && m < ratio / 2u; m++) {
+        for (unsigned i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+            for (int side = (m == 0) ? 1 : -1; side <= 1; side += 2) {
+                double frequency = output_rate * (m + side * offsets[i]);
+                double expected = theoretical_gain(frequency, ratio, compensate);
+                double gain = measured_gain(frequency, ratio, compensate);
+
+                HOST_CHECK_NEAR(gain, expected, TEST_RESPONSE_TOLERANCE);
+                if (ratio < TEST_SPEC_MIN_RATIO || offsets[i] > 0.125) {
+                    continue;
+                }
+                if (m == 0 && compensate) {
+                    HOST_CHECK_NEAR(gain, 1.0, TEST_PASSBAND_RIPPLE);
+                }
+                if (m > 0) {
+                    HOST_CHECK_NEAR(gain, 0, TEST_ALIAS_REJECTION);
+                }
+            }
+        }
+    }
+    if (host_test_failures != failures) {
+        fprintf(stderr, "  in the response at ratio %u, compensation %s\n", ratio, compensate ? "on" : "off");
+    }
+}
+
+/**
+ * @brief Check the output variance of white noise against the impulse response.
+ *
+ * The decimated noise variance is the input variance times sum(g^2) / sum(g)^2,
+ * where g is the impulse response at the input rate: the order 3 CIC kernel,
+ * combined with the FIR taps spaced `ratio` input samples apart.
+ *
+ * @param ratio Decimation ratio.
+ * @param compensate True with the compensating FIR.
+ */
+static void check_noise_gain(uint16_t ratio, bool compensate)
+{
+    double kernel[CIC_DECIMATOR_ORDER * CIC_DECIMATOR_MAX_RATIO] = { 0 };
+    double response[(CIC_DECIMATOR_ORDER + 2) * CIC_DECIMATOR_MAX_RATIO] = { 0 };
+    double taps[3] = { 1.0, 0.0, 0.0 };
+    int length = 1;
+
+    // Order 3 CIC kernel: three boxcars of `ratio` samples convolved
+    kernel[0] = 1.0;
+    for (int stage = 0; stage < CIC_DECIMATOR_ORDER; stage++) {
+        double next[CIC_DECIMATOR_ORDER * CIC_DECIMATOR_MAX_RATIO] = { 0 };
+        for (int k = 0; k < length; k++) {
+            for (int j = 0; j < ratio; j++) {
+                next[k + j] += kernel[k];
+            }
+        }
+        length += ratio - 1;
+        memcpy(kernel, next, sizeof(kernel));
+    }
+    if (compensate) {
+        taps[0] = CIC_COMPENSATOR_EDGE_Q15 / 32768.0;
+        taps[1] = CIC_COMPENSATOR_CENTER_Q15 / 32768.0;
+        taps[2] = CIC_COMPENSATOR_EDGE_Q15 / 32768.0;
+    }
+    double sum = 0.0;
+    double squares = 0.0;
+    for (int j = 0; j < 3; j++) {
+        for (int k = 0; k < length; k++) {
+            response[k + j * ratio] += taps[j] * kernel[k];
+        }
+    }
+    for (int k = 0; k < length + 2 * ratio; k++) {
+        sum += response[k];
+        squares += response[k] * response[k];
+    }
+    double expected = squares / (sum * sum);
+
+    // Gaussian noise large enough for the output rounding to be negligible
+    const double sigma = 2000.0;
+    size_t n = (size_t)(TEST_OUTPUTS + TEST_SETTLE) * ratio;
+    srand(ratio);
+    for (size_t i = 0; i < n; i += 2) {
+        double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+        double u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+        double r = sigma * sqrt(-2.0 * log(u1));
+        input[i] = (int16_t)lrint(r * cos(2.0 * M_PI * u2));
+        input[i + 1] = (int16_t)lrint(r * sin(2.0 * M_PI * u2));
+    }
+    double input_variance = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        input_variance += (double)input[i] * input[i];
+    }
+    input_variance /= (double)n;
+
+    HOST_CHECK(cic_decimator_init(&decimator, ratio, 1, compensate));
+    size_t frames = cic_decimator_process(&decimator, input, n, output);
+    double mean = 0.0;
+    double variance = 0.0;
+    for (size_t i = TEST_SETTLE; i < frames; i++) {
+        mean += output[i];
+    }
+    mean /= (double)(frames - TEST_SETTLE);
+    for (size_t i = TEST_SETTLE; i < frames; i++) {
+        variance += (output[i] - mean) * (output[i] - mean);
+    }
+    variance /= (double)(frames - TEST_SETTLE);
+
+    // Relative error of a variance estimated over TEST_OUTPUTS correlated samples
+    HOST_CHECK_NEAR(variance / input_variance / expected, 1.0, 0.1);
+}
+
+/**
+ * @brief Time the decimation of one DMA block at the firmware settings.
+ *
+ * @param compensate True with the compensating FIR.
+ */
+static void report_block_cost(bool compensate)
+{
+    for (int i = 0; i < SAADC_BUF_SIZE; i++) {
+        input[i] = (int16_t)(430 + (rand() % 9) - 4);
+    }
+    HOST_CHECK(cic_decimator_init(&decimator, SENSOR_DECIMATION_RATIO, SADC_CHANNEL_COUNT, compensate));
+
+    volatile size_t sink = 0;
+    uint64_t start_ns = host_time_ns();
+    uint64_t start_cycles = host_cycles();
+    for (int i = 0; i < TEST_BLOCK_REPEATS; i++) {
+        sink += cic_decimator_process(&decimator, input, SAADC_BUF_SIZE, output);
+    }
+    double cycles = (double)(host_cycles() - start_cycles) / TEST_BLOCK_REPEATS;
+    double ns = (double)(host_time_ns() - start_ns) / TEST_BLOCK_REPEATS;
+    HOST_CHECK_EQ(sink, (size_t)TEST_BLOCK_REPEATS * SAADC_BUF_FRAMES / SENSOR_DECIMATION_RATIO);
+
+    printf("block of %d samples (%d channel(s), ratio %d, compensation %s): %.0f host cycles, %.0f ns, %.2f cycles/sample\n",
+           SAADC_BUF_SIZE, SADC_CHANNEL_COUNT, SENSOR_DECIMATION_RATIO, compensate ? "on" : "off",
+           cycles, ns, cycles / SAADC_BUF_SIZE);
+}
+
+/**
+ * @brief Theoretical gain of the decimator at a frequency.
+ *
+ * |H(f)| = |sin(pi f R / fs) / (R sin(pi f / fs))|^3, times the FIR response
+ * |c + 2 e cos(2 pi f R / fs)| at the output rate when compensating.
+ *
+ * @param frequency Input frequency in Hz.
+ * @param ratio Decimation ratio.
+ * @param compensate True with the compensating FIR.
+ * @return double Gain relative to DC.
+ */
+static double theoretical_gain(double frequency, uint16_t ratio, bool compensate)
+{
+    double x = M_PI * frequency / SAADC_SAMPLE_FREQUENCY;
+    double gain = fabs(pow(sin(x * ratio) / (ratio * sin(x)), CIC_DECIMATOR_ORDER));
+
+    if (compensate) {
+        gain *= fabs((CIC_COMPENSATOR_CENTER_Q15 + 2.0 * CIC_COMPENSATOR_EDGE_Q15 * cos(2.0 * x * ratio)) / 32768.0);
+    }
+    return gain;
+}
+
+/**
+ * @brief Measure the gain of the decimator at a frequency.
+ *
+ * Decimates a tone and fits a sinusoid at its aliased frequency to the
+ * output, after the filter has filled.
+ *
+ * @param frequency Input frequency in Hz.
+ * @param ratio Decimation ratio.
+ * @param compensate True with the compensating FIR.
+ * @return double Output amplitude over input amplitude.
+ */
+static double measured_gain(double frequency, uint16_t ratio, bool compensate)
+{
+    size_t n = (size_t)(TEST_OUTPUTS + TEST_SETTLE) * ratio;
+    double step = 2.0 * M_PI * frequency / SAADC_SAMPLE_FREQUENCY;
+
+    for (size_t i = 0; i < n; i++) {
+        input[i] = (int16_t)lrint(TEST_AMPLITUDE * sin(step * (double)i));
+    }
+    HOST_CHECK(cic_decimator_init(&decimator, ratio, 1, compensate));
+    size_t frames = cic_decimator_process(&decimator, input, n, output);
+    HOST_CHECK_EQ(frames, TEST_OUTPUTS + TEST_SETTLE);
+
+    // Correlate with the tone as seen at the output rate (aliasing is implicit)
+    double in_phase = 0.0;
+    double quadrature = 0.0;
+    double mean = 0.0;
+    for (size_t m = TEST_SETTLE; m < frames; m++) {
+        mean += output[m];
+    }
+    mean /= TEST_OUTPUTS;
+    for (size_t m = TEST_SETTLE; m < frames; m++) {
+        double phase = step * (double)((m + 1) * ratio - 1);
+        in_phase += (output[m] - mean) * sin(phase);
+        quadrature += (output[m] - mean) * cos(phase);
+    }
+    return 2.0 * sqrt(in_phase * in_phase + quadrature * quadrature) / TEST_OUTPUTS / TEST_AMPLITUDE;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file test_hampel_filter.c
+ * @brief Host test of the Hampel spike filter.
+ * 
+ * Checks the two-heap running median against a sorted copy of the window
+ * for every odd window length from 1 to HAMPEL_FILTER_MAX_WINDOW, on random
+ * samples with many ties. At the sensor settings it then checks that single
+ * spikes are replaced by the median while the samples around them pass
+ * unchanged, that a step passes once (N+1)/2 samples of it fill the window,
+ * and that a start-up transient in the first sample is passed through rather
+ * than held: nothing is rejected before a full window of real samples.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "hampel_filter.h"
+#include "sensor_driver.h"
+#include "host_signal.h"
+#include "host_test.h"
+
+#define TEST_MEDIAN_SAMPLES 5000
+#define TEST_LEVEL          400   // Idle input in counts
+#define TEST_NOISE          1.0   // Standard deviation of the idle input
+#define TEST_SPIKE          200   // Spike height, far beyond the rejection limit
+#define TEST_SPIKE_SPACING  97    // Samples between two spikes
+#define TEST_STEP           100   // Step height
+#define TEST_SAMPLES        4000
+
+/*
+ * Global variables:
+ */
+static int16_t input[TEST_SAMPLES];
+
+/*
+ * Prototypes for internal functions:
+ */
+static void filter_init(hampel_filter_t *p_filter, uint8_t window);
+static int compare_int16(const void *p_a, const void *p_b);
+static void check_median(uint8_t window);
+static void check_spikes(uint8_t window);
+static void check_step(uint8_t window);
+static void check_startup(uint8_t window);
+
+int main(void)
+{
+    host_signal_t signal;
+
+    host_signal_init(&signal, 1000.0, TEST_LEVEL, TEST_NOISE, 5);
+    host_signal_generate(&signal, input, TEST_SAMPLES);
+
+    for (uint8_t window = 1; window <= HAMPEL_FILTER_MAX_WINDOW; window += 2) {
+        check_median(window);
+        check_step(window);
+    }
+    check_spikes(SENSOR_OUTLIER_WINDOW);
+    check_startup(SENSOR_OUTLIER_WINDOW);
+    return host_test_result("test_hampel_filter");
+}
+
+/**
+ * @brief Initialize a filter with the spike rejection settings of the sensor driver.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param window Running median length.
+ */
+static void filter_init(hampel_filter_t *p_filter, uint8_t window)
+{
+    HOST_CHECK(hampel_filter_init(p_filter, window, OUTLIER_THRESHOLD, OUTLIER_SCALE_SHIFT, OUTLIER_MIN_DEVIATION));
+}
+
+static int compare_int16(const void *p_a, const void *p_b)
+{
+    return *(const int16_t *)p_a - *(const int16_t *)p_b;
+}
+
+/**
+ * @brief The running median is the middle of the sorted window after every sample.
+ *
+ * The reference window starts full of the first sample, as the filter does.
+ *
+ * @param window Running median length.
+ */
+static void check_median(uint8_t window)
+{
+    hampel_filter_t filter;
+    int16_t ring[HAMPEL_FILTER_MAX_WINDOW];
+    int16_t sorted[HAMPEL_FILTER_MAX_WINDOW];
+    uint32_t mismatches = 0;
+
+    filter_init(&filter, window);
+    srand(window);
+    for (uint32_t i = 0; i < TEST_MEDIAN_SAMPLES; i++) {
+        // Narrow range for ties, with a wide sample now and then
+        int16_t sample = (int16_t)((rand() % 16 == 0) ? (rand() % 65536) - 32768 : (rand() % 21) - 10);
+        if (i == 0) {
+            for (uint8_t slot = 0; slot < window; slot++) {
+                ring[slot] = sample;
+            }
+        } else {
+            ring[i % window] = sample;
+        }
+        hampel_filter_process(&filter, sample);
+
+        memcpy(sorted, ring, window * sizeof(sorted[0]));
+        qsort(sorted, window, sizeof(sorted[0]), compare_int16);
+        mismatches += (hampel_filter_median(&filter) != sorted[window / 2]) ? 1 : 0;
+    }
+    HOST_CHECK_EQ(mismatches, 0);
+}
+
+/**
+ * @brief Single spikes are replaced by the median, the samples around them pass unchanged.
+ *
+ * @param window Running median length.
+ */
+static void check_spikes(uint8_t window)
+{
+    hampel_filter_t filter;
+    uint32_t spikes = 0;
+    uint32_t spikes_passed = 0;
+    uint32_t clean_changed = 0;
+    int32_t worst = 0;
+
+    filter_init(&filter, window);
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        bool spike = (i > (uint32_t)window) && (i % TEST_SPIKE_SPACING == 0);
+        int16_t sample = input[i] + ((spike && (i & 1)) ? -TEST_SPIKE : spike ? TEST_SPIKE : 0);
+        int16_t output = hampel_filter_process(&filter, sample);
+        int32_t error = abs(output - TEST_LEVEL);
+
+        if (spike) {
+            spikes++;
+            spikes_passed += (output == sample) ? 1 : 0;
+            worst = (error > worst) ? error : worst;
+        } else {
+            clean_changed += (output != sample) ? 1 : 0;
+        }
+    }
+    HOST_CHECK(spikes > 0);
+    HOST_CHECK_EQ(spikes_passed, 0);
+    HOST_CHECK_EQ(hampel_filter_rejected(&filter), spikes);
+    HOST_CHECK_EQ(clean_changed, 0);
+    HOST_CHECK(worst <= 4 * TEST_NOISE);
+    printf("window %2d: %u spikes of +/-%d replaced (worst output %d counts off the level), %u clean samples changed\n",
+           window, spikes, TEST_SPIKE, (int)worst, clean_changed);
+}
+
+/**
+ * @brief A step passes unchanged once (N+1)/2 samples of it fill the window.
+ *
+ * Before that the step samples are either passed or replaced by the old level.
+ *
+ * @param window Running median length.
+ */
+static void check_step(uint8_t window)
+{
+    const uint32_t start = TEST_SAMPLES / 2;
+    const uint32_t majority = (window + 1u) / 2u;
+    hampel_filter_t filter;
+    uint32_t late_changed = 0;
+    uint32_t early_wrong = 0;
+
+    filter_init(&filter, window);
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        int16_t step = (i >= start) ? TEST_STEP : 0;
+        int16_t sample = input[i] + step;
+        int16_t output = hampel_filter_process(&filter, sample);
+
+        if (i >= start + majority - 1) {
+            late_changed += (output != sample) ? 1 : 0;
+        } else if (i >= start) {
+            early_wrong += (output != sample && abs(output - TEST_LEVEL) > 4 * TEST_NOISE) ? 1 : 0;
+        }
+    }
+    HOST_CHECK_EQ(late_changed, 0);
+    HOST_CHECK_EQ(early_wrong, 0);
+}
+
+/**
+ * @brief A start-up transient passes through and is not held while the window fills.
+ *
+ * The first samples ramp up from below zero, as an unsettled decimator would
+ * deliver them; every sample of the first window passes unchanged, nothing is
+ * rejected on the steady input that follows, and spikes are rejected again
+ * once the deviation scale has forgotten the transient.
+ *
+ * @param window Running median length.
+ */
+static void check_startup(uint8_t window)
+{
+    static const int16_t transient[] = { -13, 67, 376 };
+    const uint32_t spike_at = TEST_SAMPLES / 2;
+    hampel_filter_t filter;
+    uint32_t first_changed = 0;
+    uint32_t rejected_before_spike = 0;
+
+    filter_init(&filter, window);
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        int16_t sample = (i < sizeof(transient) / sizeof(transient[0])) ? transient[i] : input[i];
+        sample += (i == spike_at) ? TEST_SPIKE : 0;
+        int16_t output = hampel_filter_process(&filter, sample);
+
+        if (i < window) {
+            first_changed += (output != sample) ? 1 : 0;
+        } else if (i == spike_at) {
+            HOST_CHECK(abs(output - TEST_LEVEL) <= 4 * TEST_NOISE);
+        } else if (i == spike_at - 1) {
+            rejected_before_spike = hampel_filter_rejected(&filter);
+        }
+    }
+    HOST_CHECK_EQ(first_changed, 0);
+    HOST_CHECK_EQ(rejected_before_spike, 0);
+    HOST_CHECK_EQ(hampel_filter_rejected(&filter), 1);
+}
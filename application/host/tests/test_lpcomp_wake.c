@@ -0,0 +1,232 @@
+/**
+ * @file test_lpcomp_wake.c
+ * @brief Host test of the one-sided LPCOMP wake on the simulated LPCOMP.
+ * 
+ * Runs lpcomp_driver.c unchanged on the LPCOMP, TIMER and PPI simulation of
+ * host_saadc.c. The reference selected for an idle level is checked against
+ * every k/16 VDD step on both sides: the nearest one beyond the margin and the
+ * hysteresis, none past the reach, and always one when the reach leaves room
+ * for a step. Armed on one side, the comparator must ignore the noise around
+ * the idle level and any move to the other side, wake once on the first
+ * crossing towards its side, and start the wake TIMER with the crossing.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "lpcomp_driver.h"
+#include "host_saadc.h"
+#include "host_test.h"
+
+#define TEST_MARGIN_MV 105 // Watch limits of the calibrated baseline, 30 counts at 10 bits
+#define TEST_REACH_MV  351 // Touch zone entry, 100 counts at 10 bits
+#define TEST_LEVEL_MV  1000
+#define TEST_NOISE_MV  (TEST_MARGIN_MV - 5) // Idle excursions, inside the watch limits
+#define TEST_AWAY_MV   500  // Excursion to the side that is not watched
+#define TEST_WAKE_US   250  // Time let pass after the crossing
+
+/*
+ * Global variables:
+ */
+static uint32_t wakes = 0;
+
+/*
+ * Prototypes for internal functions:
+ */
+static int expected_step(int32_t level_mv, int32_t margin_mv, int32_t reach_mv, lpcomp_wake_side_t side);
+static int32_t crossing_mv(int step, lpcomp_wake_side_t side);
+static void check_reference_step(void);
+static void check_wake(lpcomp_wake_side_t side);
+static void check_arm_refused(void);
+static void wake_handler(void);
+
+int main(void)
+{
+    host_saadc_reset();
+    host_lpcomp_input_set(TEST_LEVEL_MV);
+    HOST_CHECK_EQ(lpcomp_init(), NRF_SUCCESS);
+
+    check_reference_step();
+    check_wake(LPCOMP_WAKE_UP);
+    check_wake(LPCOMP_WAKE_DOWN);
+    check_arm_refused();
+    return host_test_result("test_lpcomp_wake");
+}
+
+/**
+ * @brief Walk every k/16 VDD step for the reference the driver should select.
+ *
+ * @param level_mv Idle level in millivolts.
+ * @param margin_mv Smallest distance between the idle level and the crossing.
+ * @param reach_mv Largest distance between the idle level and the crossing.
+ * @param side Side of the idle level that is watched.
+ * @return int The nearest step on that side, 0 if none fits.
+ */
+static int expected_step(int32_t level_mv, int32_t margin_mv, int32_t reach_mv, lpcomp_wake_side_t side)
+{
+    int best = 0;
+
+    for (int k = 1; k < LPCOMP_REFERENCE_STEPS; k++) {
+        // Distance of the step from the idle level, in sixteenths of a millivolt
+        int32_t distance = side * (k * LPCOMP_SUPPLY_MV - level_mv * LPCOMP_REFERENCE_STEPS);
+        if (distance < (margin_mv + LPCOMP_HYSTERESIS_MV / 2) * LPCOMP_REFERENCE_STEPS ||
+            distance > (reach_mv - LPCOMP_HYSTERESIS_MV / 2) * LPCOMP_REFERENCE_STEPS) {
+            continue;
+        }
+        if (best == 0 || (side == LPCOMP_WAKE_UP) == (k < best)) {
+            best = k;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Get the first whole millivolt that crosses a reference towards a side.
+ *
+ * @param step The step k of the reference.
+ * @param side Direction of the crossing.
+ * @return int32_t The input that flips the comparator, half the hysteresis past the reference.
+ */
+static int32_t crossing_mv(int step, lpcomp_wake_side_t side)
+{
+    int32_t edge = step * LPCOMP_SUPPLY_MV + side * (LPCOMP_HYSTERESIS_MV / 2) * LPCOMP_REFERENCE_STEPS;
+
+    if (side == LPCOMP_WAKE_UP) {
+        return edge / LPCOMP_REFERENCE_STEPS + 1;
+    }
+    return (edge + LPCOMP_REFERENCE_STEPS - 1) / LPCOMP_REFERENCE_STEPS - 1;
+}
+
+/**
+ * @brief The selected reference is the nearest fitting step on the watched side, and one fits when there is room.
+ */
+static void check_reference_step(void)
+{
+    static const int32_t margins[] = { 0, 35, TEST_MARGIN_MV, 200 };
+    static const int32_t reaches[] = { 100, 200, TEST_REACH_MV, 600 };
+    const int32_t room_mv = LPCOMP_SUPPLY_MV / LPCOMP_REFERENCE_STEPS + LPCOMP_HYSTERESIS_MV + 1;
+    uint32_t mismatches = 0;
+    uint32_t missing = 0;
+    uint32_t levels = 0;
+
+    for (int side = LPCOMP_WAKE_DOWN; side <= LPCOMP_WAKE_UP; side += 2) {
+        for (size_t m = 0; m < sizeof(margins) / sizeof(margins[0]); m++) {
+            for (size_t r = 0; r < sizeof(reaches) / sizeof(reaches[0]); r++) {
+                for (int32_t level = 0; level <= LPCOMP_SUPPLY_MV; level++) {
+                    int step = lpcomp_reference_step(level, margins[m], reaches[r], (lpcomp_wake_side_t)side);
+                    mismatches += (step != expected_step(level, margins[m], reaches[r], (lpcomp_wake_side_t)side)) ? 1 : 0;
+                    // A reach a step plus the hysteresis beyond the margin always finds one inside the supply range
+                    int32_t far_mv = level + side * reaches[r];
+                    if (reaches[r] - margins[m] >= room_mv &&
+                        far_mv <= LPCOMP_SUPPLY_MV * (LPCOMP_REFERENCE_STEPS - 1) / LPCOMP_REFERENCE_STEPS &&
+                        far_mv >= LPCOMP_SUPPLY_MV / LPCOMP_REFERENCE_STEPS) {
+                        levels++;
+                        missing += (step == 0) ? 1 : 0;
+                    }
+                }
+            }
+        }
+    }
+    HOST_CHECK_EQ(mismatches, 0);
+    HOST_CHECK(levels > 0);
+    HOST_CHECK_EQ(missing, 0);
+    // The driver picks the watched side only
+    HOST_CHECK(lpcomp_reference_step(LPCOMP_SUPPLY_MV - 100, TEST_MARGIN_MV, TEST_REACH_MV, LPCOMP_WAKE_UP) == 0);
+    HOST_CHECK(lpcomp_reference_step(LPCOMP_SUPPLY_MV - 100, TEST_MARGIN_MV, TEST_REACH_MV, LPCOMP_WAKE_DOWN) != 0);
+}
+
+/**
+ * @brief Armed on one side, only the first crossing towards that side wakes, and starts the wake TIMER.
+ *
+ * @param side Side of the idle level that is watched.
+ */
+static void check_wake(lpcomp_wake_side_t side)
+{
+    int step = lpcomp_reference_step(TEST_LEVEL_MV, TEST_MARGIN_MV, TEST_REACH_MV, side);
+    HOST_CHECK(step != 0);
+    int32_t wake_mv = crossing_mv(step, side);
+    HOST_CHECK(side * (wake_mv - TEST_LEVEL_MV) <= TEST_REACH_MV);
+
+    host_lpcomp_input_set(TEST_LEVEL_MV);
+    uint32_t wakes_before = wakes;
+    uint32_t irqs_before = host_saadc_stats().lpcomp_irqs;
+    HOST_CHECK_EQ(lpcomp_wake_arm(NRF_LPCOMP_INPUT_0, step, side, wake_handler), NRF_SUCCESS);
+
+    // Idle noise within the watch limits, then a move to the other side
+    for (int32_t offset = -TEST_NOISE_MV; offset <= TEST_NOISE_MV; offset++) {
+        host_lpcomp_input_set(TEST_LEVEL_MV + offset);
+    }
+    host_lpcomp_input_set(TEST_LEVEL_MV - side * TEST_AWAY_MV);
+    host_lpcomp_input_set(TEST_LEVEL_MV);
+    host_saadc_advance_us(1000);
+    HOST_CHECK_EQ(wakes, wakes_before);
+    HOST_CHECK_EQ(host_saadc_stats().lpcomp_irqs, irqs_before);
+    HOST_CHECK_EQ(lpcomp_wake_elapsed_us(), 0);
+
+    // Up to the hysteresis edge, then one millivolt past it
+    host_lpcomp_input_set(wake_mv - side);
+    HOST_CHECK_EQ(wakes, wakes_before);
+    host_lpcomp_input_set(wake_mv);
+    HOST_CHECK_EQ(wakes, wakes_before + 1);
+    HOST_CHECK_EQ(host_saadc_stats().lpcomp_irqs, irqs_before + 1);
+    host_saadc_advance_us(TEST_WAKE_US);
+    HOST_CHECK_EQ(lpcomp_wake_elapsed_us(), TEST_WAKE_US);
+
+    // Disarmed by the wake: later crossings are not reported
+    host_lpcomp_input_set(TEST_LEVEL_MV);
+    host_lpcomp_input_set(wake_mv);
+    HOST_CHECK_EQ(wakes, wakes_before + 1);
+
+    printf("wake %-4s: reference %2d/16 VDD, crossing at %4d mV for an idle level of %d mV\n",
+           (side == LPCOMP_WAKE_UP) ? "up" : "down", step, (int)wake_mv, TEST_LEVEL_MV);
+}
+
+/**
+ * @brief Arming is refused without a reference and while the comparator runs.
+ */
+static void check_arm_refused(void)
+{
+    host_lpcomp_input_set(TEST_LEVEL_MV);
+    HOST_CHECK_EQ(lpcomp_wake_arm(NRF_LPCOMP_INPUT_0, 0, LPCOMP_WAKE_UP, wake_handler), NRF_ERROR_INVALID_PARAM);
+    HOST_CHECK_EQ(lpcomp_wake_arm(NRF_LPCOMP_INPUT_0, LPCOMP_REFERENCE_STEPS, LPCOMP_WAKE_UP, wake_handler),
+                  NRF_ERROR_INVALID_PARAM);
+
+    int step = lpcomp_reference_step(TEST_LEVEL_MV, TEST_MARGIN_MV, TEST_REACH_MV, LPCOMP_WAKE_UP);
+    HOST_CHECK_EQ(lpcomp_wake_arm(NRF_LPCOMP_INPUT_0, step, LPCOMP_WAKE_UP, wake_handler), NRF_SUCCESS);
+    HOST_CHECK_EQ(lpcomp_wake_arm(NRF_LPCOMP_INPUT_0, step, LPCOMP_WAKE_UP, wake_handler), NRF_ERROR_INVALID_PARAM);
+    lpcomp_wake_disarm();
+
+    uint32_t wakes_before = wakes;
+    host_lpcomp_input_set(crossing_mv(step, LPCOMP_WAKE_UP));
+    HOST_CHECK_EQ(wakes, wakes_before);
+}
+
+/**
+ * @brief Count the wakes.
+ */
+static void wake_handler(void)
+{
+    wakes++;
+}
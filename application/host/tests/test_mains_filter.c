@@ -0,0 +1,257 @@
+/**
+ * @file test_mains_filter.c
+ * @brief Host test of the mains hum detector and notch cascade.
+ * 
+ * Synthetic sensor-rate signals carry 50 or 60 Hz hum with a third harmonic
+ * over white noise. The filter must detect the right frequency and amplitude,
+ * attenuate the fundamental and the harmonic by 40 dB or more and bring the
+ * output spread back to the noise floor, while passing slow proximity
+ * signals and leaving hum-free signals bit for bit unchanged. The cost per
+ * SAADC block (the sensor samples one DMA block decimates to) is reported in
+ * host cycles.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <math.h>
+#include <stdlib.h>
+
+#include "mains_filter.h"
+#include "sensor_driver.h"
+#include "sadc_driver.h"
+#include "host_signal.h"
+#include "host_test.h"
+#include "host_timer.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define TEST_RATE_HZ      (SAADC_SAMPLE_FREQUENCY / SENSOR_DECIMATION_RATIO) // Sensor sample rate
+#define TEST_SAMPLES      (6 * TEST_RATE_HZ)  // Six seconds of signal
+#define TEST_SETTLE       (2 * TEST_RATE_HZ)  // Detection and notch settling, excluded from the measurements
+#define TEST_LEVEL        430.0
+#define TEST_NOISE        1.5
+#define TEST_HUM          40.0                // Fundamental amplitude in counts
+#define TEST_HARMONIC     0.3                 // Third harmonic relative to the fundamental
+#define TEST_BLOCK        (SAADC_BUF_FRAMES / SENSOR_DECIMATION_RATIO) // Sensor samples per SAADC block
+#define TEST_BLOCK_REPEATS 200000
+
+// Attenuation of a hum component of at least 40 dB, as an amplitude ratio
+#define TEST_MIN_ATTENUATION 100.0
+
+/*
+ * Global variables:
+ */
+static int16_t input[TEST_SAMPLES];
+static int16_t output[TEST_SAMPLES];
+static mains_filter_t filter;
+
+/*
+ * Prototypes for internal functions:
+ */
+static void check_hum(double hum_hz);
+static void check_no_hum(void);
+static void check_slow_signal(void);
+static void report_block_cost(void);
+static void filter_run(size_t n);
+static double tone_amplitude(const int16_t *p_samples, size_t first, size_t n, double frequency);
+static double spread(const int16_t *p_samples, size_t first, size_t n);
+
+int main(void)
+{
+    check_hum(50.0);
+    check_hum(60.0);
+    check_no_hum();
+    check_slow_signal();
+    report_block_cost();
+    return host_test_result("test_mains_filter");
+}
+
+/**
+ * @brief Check detection and attenuation of one mains frequency.
+ *
+ * @param hum_hz Mains frequency of the synthetic hum.
+ */
+static void check_hum(double hum_hz)
+{
+    host_signal_t signal;
+
+    host_signal_init(&signal, TEST_RATE_HZ, TEST_LEVEL, TEST_NOISE, 7);
+    signal.hum_amplitude = TEST_HUM;
+    signal.hum_hz = hum_hz;
+    signal.hum_harmonic = TEST_HARMONIC;
+    host_signal_generate(&signal, input, TEST_SAMPLES);
+    filter_run(TEST_SAMPLES);
+
+    HOST_CHECK_EQ(mains_filter_frequency(&filter), hum_hz);
+    HOST_CHECK_NEAR(mains_filter_amplitude(&filter), TEST_HUM, 0.1 * TEST_HUM);
+
+    size_t n = TEST_SAMPLES - TEST_SETTLE;
+    for (int harmonic = 1; harmonic <= 3; harmonic += 2) {
+        double before = tone_amplitude(input, TEST_SETTLE, n, harmonic * hum_hz);
+        double after = tone_amplitude(output, TEST_SETTLE, n, harmonic * hum_hz);
+        HOST_CHECK(before > TEST_MIN_ATTENUATION * after);
+        printf("%.0f Hz hum, harmonic %d: %6.2f counts in, %5.3f out (%.1f dB)\n",
+               hum_hz, harmonic, before, after, 20.0 * log10(before / after));
+    }
+
+    // What remains is the noise, slightly shaped by the notches
+    double spread_in = spread(input, TEST_SETTLE, n);
+    double spread_out = spread(output, TEST_SETTLE, n);
+    HOST_CHECK(spread_out < 1.2 * TEST_NOISE);
+    printf("%.0f Hz hum: standard deviation %.2f counts in, %.2f out (noise %.2f)\n",
+           hum_hz, spread_in, spread_out, TEST_NOISE);
+}
+
+/**
+ * @brief Without hum the notches stay off and samples pass unchanged.
+ */
+static void check_no_hum(void)
+{
+    host_signal_t signal;
+
+    host_signal_init(&signal, TEST_RATE_HZ, TEST_LEVEL, TEST_NOISE, 11);
+    host_signal_event_add(&signal, TEST_RATE_HZ, 200, 1000, 80.0);
+    host_signal_generate(&signal, input, TEST_SAMPLES);
+    filter_run(TEST_SAMPLES);
+
+    HOST_CHECK_EQ(mains_filter_frequency(&filter), 0);
+    size_t differences = 0;
+    for (size_t i = 0; i < TEST_SAMPLES; i++) {
+        differences += (output[i] != input[i]) ? 1 : 0;
+    }
+    HOST_CHECK_EQ(differences, 0);
+}
+
+/**
+ * @brief A proximity event under hum keeps its level and shape.
+ *
+ * The event ramps over 200 ms, well below the notched band; once the hum is
+ * gone the output must follow the clean event within the noise.
+ */
+static void check_slow_signal(void)
+{
+    host_signal_t signal;
+
+    host_signal_init(&signal, TEST_RATE_HZ, TEST_LEVEL, 0.0, 13);
+    signal.hum_amplitude = TEST_HUM;
+    signal.hum_hz = 50.0;
+    signal.hum_harmonic = TEST_HARMONIC;
+    host_signal_event_add(&signal, TEST_SETTLE + TEST_RATE_HZ, 200, 1000, 120.0);
+    host_signal_generate(&signal, input, TEST_SAMPLES);
+    filter_run(TEST_SAMPLES);
+
+    double worst = 0.0;
+    for (size_t i = TEST_SETTLE; i < TEST_SAMPLES; i++) {
+        signal.hum_amplitude = 0.0;
+        double error = fabs(output[i] - host_signal_clean(&signal, (uint32_t)i));
+        worst = (error > worst) ? error : worst;
+    }
+    HOST_CHECK(worst < 3.0);
+    printf("50 Hz hum over a 120-count event: largest deviation from the clean event %.2f counts\n", worst);
+}
+
+/**
+ * @brief Time the filter over the sensor samples of one SAADC block, notches active.
+ */
+static void report_block_cost(void)
+{
+    host_signal_t signal;
+
+    host_signal_init(&signal, TEST_RATE_HZ, TEST_LEVEL, TEST_NOISE, 17);
+    signal.hum_amplitude = TEST_HUM;
+    host_signal_generate(&signal, input, TEST_SAMPLES);
+    filter_run(TEST_SAMPLES);
+    HOST_CHECK(mains_filter_frequency(&filter) != 0);
+
+    volatile int32_t sink = 0;
+    uint64_t start_ns = host_time_ns();
+    uint64_t start_cycles = host_cycles();
+    for (size_t i = 0; i < TEST_BLOCK_REPEATS; i++) {
+        const int16_t *p_block = &input[(i * TEST_BLOCK) % (TEST_SAMPLES - TEST_BLOCK)];
+        for (int k = 0; k < TEST_BLOCK; k++) {
+            sink += mains_filter_process(&filter, p_block[k]);
+        }
+    }
+    double cycles = (double)(host_cycles() - start_cycles) / TEST_BLOCK_REPEATS;
+    double ns = (double)(host_time_ns() - start_ns) / TEST_BLOCK_REPEATS;
+    printf("block of %d sensor samples, %d notches: %.0f host cycles, %.0f ns, %.1f cycles/sample\n",
+           TEST_BLOCK, filter.section_count, cycles, ns, cycles / TEST_BLOCK);
+}
+
+/**
+ * @brief Run the input through a freshly initialized filter.
+ *
+ * @param n Number of samples.
+ */
+static void filter_run(size_t n)
+{
+    HOST_CHECK(mains_filter_init(&filter, TEST_RATE_HZ, MAINS_MIN_AMPLITUDE));
+    for (size_t i = 0; i < n; i++) {
+        output[i] = mains_filter_process(&filter, input[i]);
+    }
+}
+
+/**
+ * @brief Amplitude of a tone, by correlation over whole seconds.
+ *
+ * @param p_samples The samples.
+ * @param first First sample of the measurement.
+ * @param n Number of samples, a whole number of periods of the tone.
+ * @param frequency Tone frequency in Hz.
+ * @return double Amplitude in counts.
+ */
+static double tone_amplitude(const int16_t *p_samples, size_t first, size_t n, double frequency)
+{
+    double in_phase = 0.0;
+    double quadrature = 0.0;
+
+    for (size_t i = first; i < first + n; i++) {
+        double phase = 2.0 * M_PI * frequency * (double)i / TEST_RATE_HZ;
+        in_phase += p_samples[i] * sin(phase);
+        quadrature += p_samples[i] * cos(phase);
+    }
+    return 2.0 * sqrt(in_phase * in_phase + quadrature * quadrature) / (double)n;
+}
+
+/**
+ * @brief Standard deviation of a stretch of samples.
+ */
+static double spread(const int16_t *p_samples, size_t first, size_t n)
+{
+    double mean = 0.0;
+    double variance = 0.0;
+
+    for (size_t i = first; i < first + n; i++) {
+        mean += p_samples[i];
+    }
+    mean /= (double)n;
+    for (size_t i = first; i < first + n; i++) {
+        variance += (p_samples[i] - mean) * (p_samples[i] - mean);
+    }
+    return sqrt(variance / (double)n);
+}
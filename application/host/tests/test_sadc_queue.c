@@ -0,0 +1,247 @@
+/**
+ * @file test_sadc_queue.c
+ * @brief Two-thread stress test of the SAADC buffer queue and pool.
+ * 
+ * A producer thread plays the SAADC interrupt: it takes a buffer from the
+ * pool, fills it with a pattern derived from its sequence number and pushes
+ * its descriptor. A consumer thread plays the main loop: it pops, checks
+ * the samples and the sequence, and releases the buffer. Both run as fast
+ * as the host allows, many times the rate of the SAADC.
+ *
+ * Every TEST_STALL_PERIOD buffers the consumer stalls, like a late main loop.
+ * The lossless run gives the pool no more buffers than the queue holds and
+ * stalls until the pool is exhausted: back-pressure stops the producer and
+ * every buffer must arrive, in order. The overrun run gives the pool more
+ * buffers than the queue holds and stalls until the queue overflows: the
+ * missing sequence numbers must match the overrun counter exactly.
+ *
+ * Usage: test_sadc_queue [--buffers N]
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "sadc_driver.h"
+#include "sadc_pool.h"
+#include "sadc_queue.h"
+#include "host_test.h"
+#include "host_timer.h"
+
+#define TEST_DEFAULT_BUFFERS 2000000
+#define TEST_STALL_PERIOD    1024 // Buffers between two stalls of the consumer
+
+/**
+ * @brief State shared by the producer and consumer threads.
+ */
+typedef struct {
+    uint32_t buffers;           // Buffers the producer completes
+    bool force_overruns;        // Stalls of the consumer last until an overrun rather than until the pool is exhausted
+    atomic_bool producer_done;  // Set once the producer has completed its last buffer
+    bool producer_owned;        // Producer still holds a buffer (dropped by the last overrun)
+    uint8_t producer_index;     // That buffer
+    uint32_t received;          // Buffers popped by the consumer
+    uint32_t expected;          // Sequence number following the last one popped
+    uint32_t gaps;              // Sequence numbers missing at the consumer
+    uint32_t reordered;         // Sequence numbers not greater than the previous one
+    uint32_t corrupted;         // Buffers whose size or samples do not match their sequence number
+} stress_t;
+
+/*
+ * Global variables:
+ */
+static int16_t samples[SADC_POOL_MAX_BUFFERS][SAADC_BUF_SIZE];
+static sadc_pool_t pool;
+static sadc_queue_t queue;
+
+/*
+ * Prototypes for internal functions:
+ */
+static void stress_run(const char *p_name, uint32_t buffers, uint8_t pool_buffers, bool force_overruns);
+static void *producer_thread(void *p_arg);
+static void *consumer_thread(void *p_arg);
+static int16_t pattern(uint32_t sequence, uint32_t k);
+
+int main(int argc, char **argv)
+{
+    uint32_t buffers = TEST_DEFAULT_BUFFERS;
+
+    if (argc == 3 && strcmp(argv[1], "--buffers") == 0) {
+        buffers = (uint32_t)strtoul(argv[2], NULL, 10);
+    }
+    // Back-pressure only: the queue can hold every buffer of the pool
+    stress_run("lossless", buffers, SADC_QUEUE_SIZE, false);
+    // The pool outnumbers the queue and the consumer stalls: buffers are dropped
+    stress_run("overrun", buffers, SADC_POOL_MAX_BUFFERS, true);
+    return host_test_result("test_sadc_queue");
+}
+
+/**
+ * @brief Run the producer and consumer threads and check what the consumer saw.
+ *
+ * @param p_name Name of the run, for the report.
+ * @param buffers Number of buffers the producer completes.
+ * @param pool_buffers Number of buffers in the pool.
+ * @param force_overruns True to stall the consumer until the queue overflows, false until the pool is exhausted.
+ */
+static void stress_run(const char *p_name, uint32_t buffers, uint8_t pool_buffers, bool force_overruns)
+{
+    stress_t stress = { .buffers = buffers, .force_overruns = force_overruns };
+    pthread_t producer;
+    pthread_t consumer;
+
+    atomic_init(&stress.producer_done, false);
+    sadc_queue_init(&queue);
+    HOST_CHECK(sadc_pool_init(&pool, pool_buffers));
+
+    uint64_t start = host_time_ns();
+    HOST_CHECK_EQ(pthread_create(&consumer, NULL, consumer_thread, &stress), 0);
+    HOST_CHECK_EQ(pthread_create(&producer, NULL, producer_thread, &stress), 0);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+    double seconds = (double)(host_time_ns() - start) * 1e-9;
+
+    if (stress.producer_owned) {
+        // Both threads have stopped, the pool has a single user again
+        sadc_pool_release(&pool, stress.producer_index);
+    }
+
+    uint32_t overruns = sadc_queue_overruns(&queue);
+    HOST_CHECK_EQ(stress.received + overruns, buffers);
+    // Every drop shows as a gap, or as missing buffers after the last one received
+    HOST_CHECK_EQ(stress.gaps + (buffers - stress.expected), overruns);
+    HOST_CHECK_EQ(stress.reordered, 0);
+    HOST_CHECK_EQ(stress.corrupted, 0);
+    HOST_CHECK_EQ(sadc_queue_pending(&queue), 0);
+    HOST_CHECK_EQ(sadc_pool_available(&pool), pool_buffers);
+    if (force_overruns) {
+        HOST_CHECK(overruns > 0);
+    } else {
+        HOST_CHECK_EQ(overruns, 0);
+        HOST_CHECK(sadc_pool_exhausted(&pool) > 0);
+    }
+
+    // The SAADC completes a buffer every SAADC_BUF_FRAMES scans
+    double real_rate = (double)SAADC_SAMPLE_FREQUENCY / SAADC_BUF_FRAMES;
+    printf("%-8s: %u buffers, %u received, %u overruns, %u underruns, %u exhausted, %.0fx the SAADC rate\n",
+           p_name, buffers, stress.received, overruns, sadc_queue_underruns(&queue),
+           sadc_pool_exhausted(&pool), (double)buffers / seconds / real_rate);
+}
+
+/**
+ * @brief Producer: acquire, fill and push buffers, like the SAADC interrupt.
+ *
+ * A buffer whose descriptor was dropped stays with the producer and is filled
+ * again, so only the consumer ever releases into the pool.
+ */
+static void *producer_thread(void *p_arg)
+{
+    stress_t *p_stress = p_arg;
+    uint8_t index = 0;
+    bool owned = false;
+
+    for (uint32_t sequence = 0; sequence < p_stress->buffers; sequence++) {
+        while (!owned && !sadc_pool_acquire(&pool, &index)) {
+            // Back-pressure: wait for the consumer to release a buffer
+            sched_yield();
+        }
+        owned = true;
+
+        for (uint32_t k = 0; k < SAADC_BUF_SIZE; k++) {
+            samples[index][k] = pattern(sequence, k);
+        }
+        sadc_buffer_desc_t desc = { .p_buffer = samples[index], .size = SAADC_BUF_SIZE };
+        if (sadc_queue_push(&queue, &desc)) {
+            owned = false;
+        }
+        // Give the consumer a chance to run between two buffers even on a single core
+        sched_yield();
+    }
+    p_stress->producer_owned = owned;
+    p_stress->producer_index = index;
+    atomic_store(&p_stress->producer_done, true);
+    return NULL;
+}
+
+/**
+ * @brief Consumer: pop, check and release buffers, like the main loop.
+ */
+static void *consumer_thread(void *p_arg)
+{
+    stress_t *p_stress = p_arg;
+    sadc_buffer_desc_t desc;
+
+    for (;;) {
+        // Read the flag before popping so the last buffers are never missed
+        bool done = atomic_load(&p_stress->producer_done);
+        if (!sadc_queue_pop(&queue, &desc)) {
+            if (done) {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+
+        if (desc.sequence < p_stress->expected) {
+            p_stress->reordered++;
+        } else {
+            p_stress->gaps += desc.sequence - p_stress->expected;
+        }
+        p_stress->expected = desc.sequence + 1;
+
+        bool intact = desc.size == SAADC_BUF_SIZE;
+        for (uint32_t k = 0; k < SAADC_BUF_SIZE && intact; k++) {
+            intact = desc.p_buffer[k] == pattern(desc.sequence, k);
+        }
+        p_stress->corrupted += intact ? 0 : 1;
+        p_stress->received++;
+
+        if ((p_stress->received % TEST_STALL_PERIOD) == 0) {
+            // Late main loop: hold the buffer until the producer has dropped one,
+            // or, when it may not drop, until it has run out of buffers
+            uint32_t overruns = sadc_queue_overruns(&queue);
+            uint32_t exhausted = sadc_pool_exhausted(&pool);
+            while (!atomic_load(&p_stress->producer_done) &&
+                   (p_stress->force_overruns ? sadc_queue_overruns(&queue) == overruns
+                                             : sadc_pool_exhausted(&pool) == exhausted)) {
+                sched_yield();
+            }
+        }
+        sadc_pool_release(&pool, (uint8_t)((desc.p_buffer - &samples[0][0]) / SAADC_BUF_SIZE));
+    }
+    return NULL;
+}
+
+/**
+ * @brief Sample k of the buffer with the given sequence number.
+ */
+static int16_t pattern(uint32_t sequence, uint32_t k)
+{
+    return (int16_t)((sequence * 2654435761u) ^ (k * 40503u));
+}
@@ -0,0 +1,404 @@
+/**
+ * @file test_sadc_watch.c
+ * @brief Host test of the SAADC limit watch on the simulated SAADC.
+ * 
+ * Runs sadc_driver.c unchanged on the SAADC, TIMER and PPI simulation of
+ * host_saadc.c. A quiet stream at the idle rate is handed over to the limit
+ * watch, which must take no SAADC interrupt at all, only the refresh compare
+ * once per SADC_WATCH_REFRESH_FRAMES scans. The limits programmed in the
+ * SAADC are checked against the levels for every acquisition profile, and the
+ * watch must wake on the first scan reaching a limit, the SAADC limit events
+ * firing on equality, and not one count earlier. Re-centred limits, a watch
+ * started on a stopped stream, suspension and the calibration refusal are
+ * covered as well.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "sadc_driver.h"
+#include "host_saadc.h"
+#include "host_test.h"
+
+#define TEST_CC_FULL     (16000000 / SAADC_SAMPLE_FREQUENCY) // 16 MHz ticks per full-rate scan
+#define TEST_LEVEL       400   // Quiet input, on the SADC_SCALE_BITS scale
+#define TEST_MARGIN      20    // Watch limits either side of the quiet level
+#define TEST_SETTLE      (4 * SAADC_BUF_FRAMES) // Scans to reach a state, a few buffers
+#define TEST_WATCH_SCANS (5 * SADC_WATCH_REFRESH_FRAMES + 123)
+
+// Input on the simulation scale for a level on the SADC_SCALE_BITS scale
+#define TEST_INPUT(level) ((int16_t)((level) * (1 << (HOST_SAADC_INPUT_BITS - SADC_SCALE_BITS))))
+
+/*
+ * Global variables:
+ */
+static sadc_buffer_desc_t last_desc;
+static uint32_t buffers_consumed = 0;
+static uint32_t watch_refreshes = 0;
+static uint32_t watch_wakes = 0;
+
+/*
+ * Prototypes for internal functions:
+ */
+static uint32_t run(uint32_t scans);
+static bool run_until_armed(void);
+static void drain(void);
+static void idle_rate_enter(void);
+static void watch_enter(int16_t low, int16_t high);
+static void profile_enter(sadc_profile_id_t profile);
+static void check_quiet_watch(void);
+static void check_limits(sadc_profile_id_t profile);
+static void check_recentre(void);
+static void check_stopped_stream(void);
+static void check_suspend(void);
+static void watch_handler(sadc_watch_evt_t event);
+
+int main(void)
+{
+    host_saadc_reset();
+    host_saadc_input_set(0, TEST_INPUT(TEST_LEVEL));
+    HOST_CHECK_EQ(sadc_init(NULL), NRF_SUCCESS);
+    HOST_CHECK_EQ(sadc_start(TEST_CC_FULL), NRF_SUCCESS);
+
+    check_quiet_watch();
+    for (int profile = 0; profile < SADC_PROFILE_COUNT; profile++) {
+        check_limits((sadc_profile_id_t)profile);
+    }
+    check_recentre();
+    check_stopped_stream();
+    check_suspend();
+    return host_test_result("test_sadc_watch");
+}
+
+/**
+ * @brief Run scans and consume the completed buffers after each one, as the main loop does.
+ *
+ * @param scans Number of scans.
+ * @return uint32_t Number of scans run, fewer if the scan TIMER stopped.
+ */
+static uint32_t run(uint32_t scans)
+{
+    uint32_t done = 0;
+
+    while (done < scans && host_saadc_run(1) == 1) {
+        done++;
+        drain();
+    }
+    return done;
+}
+
+/**
+ * @brief Run scans until the watch has armed the SAADC limits.
+ *
+ * @return bool True if the limits were armed within TEST_SETTLE scans.
+ */
+static bool run_until_armed(void)
+{
+    int16_t low, high;
+
+    for (int scan = 0; scan < TEST_SETTLE; scan++) {
+        if (host_saadc_limits_get(0, &low, &high)) {
+            return true;
+        }
+        run(1);
+    }
+    return host_saadc_limits_get(0, &low, &high);
+}
+
+/**
+ * @brief Consume and release every completed buffer.
+ */
+static void drain(void)
+{
+    sadc_buffer_desc_t desc;
+
+    while (sadc_buffer_get(&desc)) {
+        last_desc = desc;
+        buffers_consumed++;
+        sadc_buffer_release(desc.p_buffer);
+    }
+}
+
+/**
+ * @brief Switch to the idle rate and wait for its first buffer.
+ */
+static void idle_rate_enter(void)
+{
+    sadc_rate_set(SADC_RATE_IDLE);
+    for (int scan = 0; scan < TEST_SETTLE && last_desc.rate != SADC_RATE_IDLE; scan++) {
+        run(1);
+    }
+    HOST_CHECK_EQ(last_desc.rate, SADC_RATE_IDLE);
+}
+
+/**
+ * @brief Start a watch from the buffered stream and wait until it runs.
+ *
+ * @param low Low limit on the SADC_SCALE_BITS scale.
+ * @param high High limit on the SADC_SCALE_BITS scale.
+ */
+static void watch_enter(int16_t low, int16_t high)
+{
+    idle_rate_enter();
+    HOST_CHECK_EQ(sadc_watch_start(&low, &high, watch_handler), NRF_SUCCESS);
+    HOST_CHECK(sadc_watch_active());
+    HOST_CHECK(run_until_armed());
+}
+
+/**
+ * @brief Request a profile and wait for its first buffer.
+ *
+ * @param profile The acquisition profile.
+ */
+static void profile_enter(sadc_profile_id_t profile)
+{
+    HOST_CHECK_EQ(sadc_profile_set(profile), NRF_SUCCESS);
+    for (int scan = 0; scan < TEST_SETTLE && last_desc.profile != profile; scan++) {
+        run(1);
+    }
+    HOST_CHECK_EQ(last_desc.profile, profile);
+}
+
+/**
+ * @brief A quiet watch takes the refresh compare once per refresh period and nothing else.
+ */
+static void check_quiet_watch(void)
+{
+    run(TEST_SETTLE);
+    HOST_CHECK(buffers_consumed >= 3);
+    HOST_CHECK_EQ(last_desc.rate, SADC_RATE_FULL);
+
+    // Buffered sampling at the idle rate: interrupts on every buffer
+    idle_rate_enter();
+    host_saadc_stats_t before = host_saadc_stats();
+    uint32_t buffers_before = buffers_consumed;
+    run(SADC_WATCH_REFRESH_FRAMES);
+    host_saadc_stats_t after = host_saadc_stats();
+    uint32_t buffered_irqs = after.saadc_irqs - before.saadc_irqs;
+    HOST_CHECK(buffered_irqs >= buffers_consumed - buffers_before);
+
+    watch_enter(TEST_LEVEL - TEST_MARGIN, TEST_LEVEL + TEST_MARGIN);
+    // The armed buffers ran out before the watch took over; nothing is queued behind it
+    HOST_CHECK_EQ(sadc_calibrate(), NRF_ERROR_INVALID_STATE);
+    uint64_t start_us = host_saadc_time_us();
+    before = host_saadc_stats();
+    buffers_before = buffers_consumed;
+    HOST_CHECK_EQ(run(TEST_WATCH_SCANS), TEST_WATCH_SCANS);
+    after = host_saadc_stats();
+
+    HOST_CHECK_EQ(after.saadc_irqs - before.saadc_irqs, 0);
+    HOST_CHECK_EQ(after.timer_irqs - before.timer_irqs, TEST_WATCH_SCANS / SADC_WATCH_REFRESH_FRAMES);
+    HOST_CHECK_EQ(watch_refreshes, TEST_WATCH_SCANS / SADC_WATCH_REFRESH_FRAMES);
+    HOST_CHECK_EQ(after.scans - before.scans, TEST_WATCH_SCANS);
+    HOST_CHECK_EQ(after.limit_events - before.limit_events, 0);
+    HOST_CHECK_EQ(buffers_consumed, buffers_before);
+    HOST_CHECK_EQ(host_saadc_time_us() - start_us, (uint64_t)TEST_WATCH_SCANS * 1000000 / SAADC_IDLE_FREQUENCY);
+    HOST_CHECK(sadc_watch_active());
+    HOST_CHECK_EQ(watch_wakes, 0);
+
+    printf("idle rate: %u SAADC interrupts per second buffered, %u in the limit watch (%u refresh compares)\n",
+           (unsigned)buffered_irqs, (unsigned)(after.saadc_irqs - before.saadc_irqs),
+           (unsigned)(after.timer_irqs - before.timer_irqs));
+
+    // Leave through the high limit; the watch time covers the quiet scans
+    uint32_t watch_ms = get_sadc_watch_time_ms();
+    host_saadc_input_set(0, TEST_INPUT(TEST_LEVEL + TEST_MARGIN));
+    HOST_CHECK_EQ(run(1), 1);
+    HOST_CHECK_EQ(watch_wakes, 1);
+    HOST_CHECK(!sadc_watch_active());
+    HOST_CHECK_NEAR(get_sadc_watch_time_ms() - watch_ms, (TEST_WATCH_SCANS * 1000.0) / SAADC_IDLE_FREQUENCY, 2);
+    host_saadc_input_set(0, TEST_INPUT(TEST_LEVEL));
+}
+
+/**
+ * @brief The programmed limits follow the profile and wake exactly on the limit, on both sides.
+ *
+ * @param profile The acquisition profile.
+ */
+static void check_limits(sadc_profile_id_t profile)
+{
+    const int16_t low = TEST_LEVEL - TEST_MARGIN;
+    const int16_t high = TEST_LEVEL + TEST_MARGIN;
+    const int shift = sadc_profile_get(profile)->scale_shift;
+    int16_t raw_low, raw_high;
+
+    for (int side = 0; side < 2; side++) {
+        int16_t limit = (side == 0) ? high : low;
+        int16_t inside = (int16_t)((side == 0) ? TEST_INPUT(limit) - 1 : TEST_INPUT(limit) + (1 << (HOST_SAADC_INPUT_BITS - SADC_SCALE_BITS - shift)));
+        uint32_t wakes = watch_wakes;
+
+        // Back at the full rate after the last wake
+        host_saadc_input_set(0, TEST_INPUT(TEST_LEVEL));
+        sadc_rate_set(SADC_RATE_FULL);
+        profile_enter(profile);
+        watch_enter(low, high);
+        HOST_CHECK(host_saadc_limits_get(0, &raw_low, &raw_high));
+        HOST_CHECK_EQ(raw_low, low * (1 << shift));
+        HOST_CHECK_EQ(raw_high, high * (1 << shift));
+        HOST_CHECK_EQ(raw_low, sadc_level_to_raw(low, profile));
+        HOST_CHECK_EQ(raw_high, sadc_level_to_raw(high, profile));
+
+        // One count of the profile short of the limit: still quiet
+        host_saadc_input_set(0, inside);
+        run(SAADC_BUF_FRAMES);
+        HOST_CHECK_EQ(watch_wakes, wakes);
+        HOST_CHECK(sadc_watch_active());
+
+        // On the limit: the first scan wakes, the limits are disarmed and the full rate resumes
+        host_saadc_input_set(0, TEST_INPUT(limit));
+        HOST_CHECK_EQ(run(1), 1);
+        HOST_CHECK_EQ(watch_wakes, wakes + 1);
+        HOST_CHECK(!sadc_watch_active());
+        HOST_CHECK(!host_saadc_limits_get(0, &raw_low, &raw_high));
+        host_saadc_input_set(0, TEST_INPUT(TEST_LEVEL));
+        run(2 * SAADC_BUF_FRAMES);
+        HOST_CHECK_EQ(last_desc.rate, SADC_RATE_FULL);
+        HOST_CHECK_EQ(last_desc.profile, profile);
+    }
+    HOST_CHECK_EQ(get_sadc_watch_wake_count(), watch_wakes);
+}
+
+/**
+ * @brief Limits re-centred on a running watch are programmed at once.
+ */
+static void check_recentre(void)
+{
+    int16_t low = TEST_LEVEL - TEST_MARGIN;
+    int16_t high = TEST_LEVEL + TEST_MARGIN;
+    int16_t raw_low, raw_high;
+    uint32_t wakes = watch_wakes;
+
+    profile_enter(SADC_PROFILE_FAST);
+    watch_enter(low, high);
+
+    // The baseline drifts up by half the margin: follow it
+    low += TEST_MARGIN / 2;
+    high += TEST_MARGIN / 2;
+    HOST_CHECK_EQ(sadc_watch_limits_set(&low, &high), NRF_SUCCESS);
+    HOST_CHECK(host_saadc_limits_get(0, &raw_low, &raw_high));
+    HOST_CHECK_EQ(raw_low, low);
+    HOST_CHECK_EQ(raw_high, high);
+
+    // Above the old high limit but within the new one: still quiet
+    host_saadc_input_set(0, TEST_INPUT(TEST_LEVEL + TEST_MARGIN));
+    run(SAADC_BUF_FRAMES);
+    HOST_CHECK_EQ(watch_wakes, wakes);
+
+    // The old low limit is no longer one
+    host_saadc_input_set(0, TEST_INPUT(low));
+    HOST_CHECK_EQ(run(1), 1);
+    HOST_CHECK_EQ(watch_wakes, wakes + 1);
+    HOST_CHECK_EQ(sadc_watch_limits_set(&low, &high), NRF_ERROR_INVALID_STATE);
+    host_saadc_input_set(0, TEST_INPUT(TEST_LEVEL));
+    run(2 * SAADC_BUF_FRAMES);
+}
+
+/**
+ * @brief A watch requested while the stream stopped for lack of buffers starts at once.
+ */
+static void check_stopped_stream(void)
+{
+    sadc_buffer_desc_t held[SAADC_BUF_COUNT];
+    uint8_t count = 0;
+    int16_t low = TEST_LEVEL - TEST_MARGIN;
+    int16_t high = TEST_LEVEL + TEST_MARGIN;
+    int16_t raw_low, raw_high;
+
+    idle_rate_enter();
+    // The consumer holds every buffer: the pool runs dry and the sampling finishes
+    for (int scan = 0; scan < 2 * SAADC_BUF_COUNT * SAADC_BUF_FRAMES; scan++) {
+        host_saadc_run(1);
+        while (count < SAADC_BUF_COUNT && sadc_buffer_get(&held[count])) {
+            count++;
+        }
+    }
+    HOST_CHECK_EQ(count, SAADC_BUF_COUNT);
+    host_saadc_stats_t before = host_saadc_stats();
+    host_saadc_run(SAADC_BUF_FRAMES);
+    HOST_CHECK_EQ(host_saadc_stats().scans, before.scans);
+
+    HOST_CHECK_EQ(sadc_watch_start(&low, &high, watch_handler), NRF_SUCCESS);
+    HOST_CHECK(host_saadc_limits_get(0, &raw_low, &raw_high));
+    for (uint8_t i = 0; i < count; i++) {
+        sadc_buffer_release(held[i].p_buffer);
+    }
+    // The released buffers wait in the pool, the watch is not disturbed
+    before = host_saadc_stats();
+    run(SAADC_BUF_FRAMES);
+    HOST_CHECK_EQ(host_saadc_stats().scans - before.scans, SAADC_BUF_FRAMES);
+    HOST_CHECK_EQ(host_saadc_stats().saadc_irqs, before.saadc_irqs);
+    HOST_CHECK(sadc_watch_active());
+}
+
+/**
+ * @brief A suspended watch stops the scans until the sampling resumes at the full rate.
+ */
+static void check_suspend(void)
+{
+    int16_t raw_low, raw_high;
+    uint32_t wakes = watch_wakes;
+
+    HOST_CHECK(sadc_watch_active());
+    HOST_CHECK_EQ(sadc_suspend(), NRF_SUCCESS);
+    HOST_CHECK(!sadc_watch_active());
+    HOST_CHECK(!host_saadc_limits_get(0, &raw_low, &raw_high));
+    HOST_CHECK_EQ(sadc_calibrate(), NRF_ERROR_INVALID_STATE);
+
+    // Nothing paces the SAADC any more, whatever its input
+    host_saadc_input_set(0, TEST_INPUT(TEST_LEVEL + 2 * TEST_MARGIN));
+    HOST_CHECK_EQ(host_saadc_run(SAADC_BUF_FRAMES), 0);
+    HOST_CHECK_EQ(sadc_suspend(), NRF_ERROR_INVALID_STATE);
+
+    uint32_t buffers_before = buffers_consumed;
+    HOST_CHECK_EQ(sadc_resume(), NRF_SUCCESS);
+    HOST_CHECK_EQ(sadc_resume(), NRF_ERROR_INVALID_STATE);
+    HOST_CHECK_EQ(run(2 * SAADC_BUF_FRAMES), 2 * SAADC_BUF_FRAMES);
+    HOST_CHECK(buffers_consumed - buffers_before >= 1);
+    HOST_CHECK_EQ(last_desc.rate, SADC_RATE_FULL);
+    HOST_CHECK_EQ(watch_wakes, wakes);
+
+    // The calibration is accepted again and the stream continues behind it
+    uint32_t calibrations = get_sadc_calibration_count();
+    HOST_CHECK_EQ(sadc_calibrate(), NRF_SUCCESS);
+    run(4 * SAADC_BUF_FRAMES);
+    HOST_CHECK_EQ(get_sadc_calibration_count(), calibrations + 1);
+    buffers_before = buffers_consumed;
+    run(2 * SAADC_BUF_FRAMES);
+    HOST_CHECK(buffers_consumed - buffers_before >= 1);
+}
+
+/**
+ * @brief Count the limit watch events.
+ *
+ * @param event The watch event.
+ */
+static void watch_handler(sadc_watch_evt_t event)
+{
+    if (event == SADC_WATCH_REFRESH) {
+        watch_refreshes++;
+    } else {
+        watch_wakes++;
+    }
+}
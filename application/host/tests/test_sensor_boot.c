@@ -0,0 +1,172 @@
+/**
+ * @file test_sensor_boot.c
+ * @brief Host test of the sensor start-up on a constant input.
+ * 
+ * Boots the decimation stage the way main.c does and feeds a steady input,
+ * one SAADC buffer at a time, through sensor_process_block(). Nothing is
+ * near the electrode, so the calibration must settle on the input level and
+ * the sensor must never leave the idle zone nor report a change, for every
+ * acquisition profile. The same run with a decimator that starts from zero
+ * instead of the first scan frame is reported for comparison. An idle level
+of 0 checks that the samples the filters leave below zero are saturated,
+not wrapped to the top of the reading range.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <math.h>
+#include <stdlib.h>
+
+#include "cic_decimator.h"
+#include "sensor_driver.h"
+#include "sadc_driver.h"
+#include "host_signal.h"
+#include "host_test.h"
+
+#define TEST_RATIO       SENSOR_DECIMATION_RATIO
+#define TEST_SECONDS     40                      // Past BASELINE_FREEZE_LIMIT, so a false event would re-seed the baseline
+#define TEST_BUFFERS     (TEST_SECONDS * SAADC_SAMPLE_FREQUENCY / SAADC_BUF_FRAMES)
+#define TEST_LEVEL       390                     // Idle input on the SADC_SCALE_BITS scale
+#define TEST_NOISE       1.0                     // Standard deviation on the same scale
+#define TEST_FIRST       (CIC_DECIMATOR_ORDER + 2) // Decimated samples checked for a start-up transient
+
+/**
+ * @brief Outcome of one boot.
+ */
+typedef struct {
+    uint32_t reports;        // Callbacks: zone or change state reported
+    int16_t first_min;       // Extremes of the first TEST_FIRST decimated samples
+    int16_t first_max;
+    sensor_data_t data;      // Sensor data at the end of the run
+} boot_t;
+
+/*
+ * Global variables:
+ */
+static int16_t raw[SAADC_BUF_FRAMES];
+static int16_t decimated[SAADC_BUF_FRAMES / TEST_RATIO + 1];
+static uint32_t reports = 0;
+
+/*
+ * Prototypes for internal functions:
+ */
+static boot_t boot(int32_t level, const sadc_profile_t *p_profile, bool settle);
+static void sensor_callback(sensor_data_t *p_data);
+
+int main(void)
+{
+    for (int profile = 0; profile < SADC_PROFILE_COUNT; profile++) {
+        const sadc_profile_t *p_profile = sadc_profile_get((sadc_profile_id_t)profile);
+        boot_t result = boot(TEST_LEVEL, p_profile, true);
+
+        HOST_CHECK(abs(result.first_min - TEST_LEVEL) <= 4 * TEST_NOISE);
+        HOST_CHECK(abs(result.first_max - TEST_LEVEL) <= 4 * TEST_NOISE);
+        HOST_CHECK_EQ(result.reports, 0);
+        HOST_CHECK_EQ(result.data.zone, SENSOR_ZONE_IDLE);
+        HOST_CHECK_EQ(result.data.change_state, 0);
+        HOST_CHECK(abs(result.data.golden_reference - TEST_LEVEL) <= 2);
+        HOST_CHECK(result.data.noise_sigma_q8 < (4 << 8));
+        printf("profile %d: first samples %d to %d, golden reference %d, sigma %.2f, %u reports\n",
+               profile, result.first_min, result.first_max, (int)result.data.golden_reference,
+               result.data.noise_sigma_q8 / 256.0, result.reports);
+
+        boot_t unsettled = boot(TEST_LEVEL, p_profile, false);
+        printf("  from zero: first samples %d to %d, golden reference %d, sigma %.2f, %u reports\n",
+               unsettled.first_min, unsettled.first_max, (int)unsettled.data.golden_reference,
+               unsettled.data.noise_sigma_q8 / 256.0, unsettled.reports);
+    }
+
+    // Idle input at the bottom of the range: the filters leave about half the
+    // samples below zero, which must not wrap to the top of the reading range
+    boot_t bottom = boot(0, sadc_profile_get(SADC_PROFILE_FAST), true);
+    HOST_CHECK_EQ(bottom.reports, 0);
+    HOST_CHECK_EQ(bottom.data.zone, SENSOR_ZONE_IDLE);
+    HOST_CHECK_EQ(bottom.data.change_state, 0);
+    HOST_CHECK(bottom.data.golden_reference >= 0 && bottom.data.golden_reference <= 2);
+    HOST_CHECK(bottom.data.top_reference <= 8);
+    HOST_CHECK(bottom.data.noise_sigma_q8 < (4 << 8));
+    printf("level 0: first samples %d to %d, golden reference %d, top reference %d, sigma %.2f, %u reports\n",
+           bottom.first_min, bottom.first_max, (int)bottom.data.golden_reference, (int)bottom.data.top_reference,
+           bottom.data.noise_sigma_q8 / 256.0, bottom.reports);
+    return host_test_result("test_sensor_boot");
+}
+
+/**
+ * @brief Boot a decimator and a sensor on a steady input and run them.
+ *
+ * The decimator is configured as decimation_update() in main.c does for the
+ * first buffer: reconfigured for the profile on a frame of zeros, then
+ * settled on the first scan frame.
+ *
+ * @param level Idle input on the SADC_SCALE_BITS scale.
+ * @param p_profile Acquisition profile of the SAADC buffers.
+ * @param settle False to leave out the settling on the first scan frame.
+ * @return boot_t The outcome.
+ */
+static boot_t boot(int32_t level, const sadc_profile_t *p_profile, bool settle)
+{
+    static const int16_t zeros[1] = { 0 };
+    const double scale = ldexp(1.0, p_profile->scale_shift); // Raw counts per SADC_SCALE_BITS count
+    cic_decimator_t decimator;
+    sensor_instance_t sensor;
+    host_signal_t input;
+    boot_t result = { .first_min = INT16_MAX, .first_max = INT16_MIN };
+    uint32_t seen = 0;
+
+    HOST_CHECK(cic_decimator_init(&decimator, TEST_RATIO, 1, true));
+    sensor_init(&sensor, 0, sensor_callback);
+    reports = 0;
+
+    host_signal_init(&input, SAADC_SAMPLE_FREQUENCY, level * scale, TEST_NOISE * scale, 11);
+    for (uint32_t b = 0; b < TEST_BUFFERS; b++) {
+        host_signal_generate(&input, raw, SAADC_BUF_FRAMES);
+        if (b == 0) {
+            HOST_CHECK(cic_decimator_reconfigure(&decimator, TEST_RATIO, p_profile->scale_shift, zeros));
+            if (settle) {
+                cic_decimator_settle(&decimator, raw);
+            }
+        }
+        size_t frames = cic_decimator_process(&decimator, raw, SAADC_BUF_FRAMES, decimated);
+        for (size_t i = 0; i < frames && seen < TEST_FIRST; i++, seen++) {
+            result.first_min = (decimated[i] < result.first_min) ? decimated[i] : result.first_min;
+            result.first_max = (decimated[i] > result.first_max) ? decimated[i] : result.first_max;
+        }
+        sensor_process_block(&sensor, decimated, frames, 1);
+    }
+    result.reports = reports;
+    result.data = get_sensor_data(&sensor);
+    return result;
+}
+
+/**
+ * @brief Count the reports.
+ *
+ * @param p_data The reported sensor data (unused).
+ */
+static void sensor_callback(sensor_data_t *p_data)
+{
+    reports++;
+}
@@ -0,0 +1,274 @@
+/**
+ * @file test_sensor_cusum.c
+ * @brief Host evaluation of the CUSUM change detector against the threshold logic.
+ * 
+ * Runs the two-sided CUSUM of the sensor driver and the single-reading
+ * threshold decision it replaced (idle within STABILITY_THRESHOLD of the
+ * golden reference, below it under golden - T, above it over golden + 2T)
+ * on traces with proximity events at known samples. Both use the same
+ * threshold T and the same calibrated reference, and are scored on:
+ * - false alarms: onsets outside the events, per minute;
+ * - detection: events with at least one onset, and the delay of the first
+ *   from the start of the approach;
+ * - chatter: onsets per detected event (one is ideal).
+ * The synthetic traces cover three noise levels. A recorded idle trace can
+ * be given instead: the same events are added onto it, so delays and false
+ * alarms are measured on real noise. The checks hold the CUSUM to no more
+ * false alarms than the threshold logic, detection of every event of 2T or
+ * more with a single onset each, no false alarm on the synthetic traces,
+ * and exact sample indices on its events.
+ *
+ * Usage: test_sensor_cusum [--trace FILE]
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sensor_cusum.h"
+#include "sensor_driver.h"
+#include "sadc_driver.h"
+#include "host_signal.h"
+#include "host_test.h"
+
+#define TEST_RATE_HZ       (SAADC_SAMPLE_FREQUENCY / SENSOR_DECIMATION_RATIO) // Sensor sample rate
+#define TEST_SAMPLES       (72 * TEST_RATE_HZ) // 72 s per trace
+#define TEST_CALIBRATION   TEST_RATE_HZ        // Idle samples averaged into the reference
+#define TEST_THRESHOLD     STABILITY_THRESHOLD
+#define TEST_LEVEL         430.0
+
+// Events: one every 3 s, six amplitudes repeating every 18 s
+#define EVENT_FIRST        1500
+#define EVENT_SPACING      3000
+#define EVENT_RAMP         100                 // Approach and retreat, 100 ms each
+#define EVENT_HOLD         800
+#define EVENT_SETTLE       300                 // Samples after the retreat still counted as the event
+#define EVENT_KINDS        6
+#define EVENT_PERIOD       (EVENT_KINDS * EVENT_SPACING)
+#define EVENT_COUNT        ((TEST_SAMPLES - EVENT_FIRST) / EVENT_SPACING)
+
+/**
+ * @brief Decision rule under evaluation.
+ */
+typedef enum {
+    RULE_THRESHOLD,    // Single reading against golden - T / golden + 2T
+    RULE_CUSUM,        // Two-sided CUSUM with the driver's drift and decision
+    RULE_COUNT
+} rule_t;
+
+/**
+ * @brief Score of one rule on one trace.
+ */
+typedef struct {
+    uint32_t false_alarms;      // Onsets outside every event
+    uint32_t detected;          // Events with at least one onset
+    uint32_t detected_large;    // Of those, events of at least 2T
+    uint32_t onsets_in_events;  // Onsets inside events
+    uint64_t delay_total;       // Sum of the first-onset delays of detected events
+    uint32_t index_errors;      // CUSUM events whose sample index is not the sample fed
+} score_t;
+
+/*
+ * Global variables:
+ */
+static const double event_amplitude[EVENT_KINDS] = {
+    1.5 * TEST_THRESHOLD, -1.5 * TEST_THRESHOLD,
+    3.0 * TEST_THRESHOLD, -3.0 * TEST_THRESHOLD,
+    8.0 * TEST_THRESHOLD, -8.0 * TEST_THRESHOLD,
+};
+static int16_t trace[TEST_SAMPLES];
+static int16_t events[TEST_SAMPLES];
+static const char *rule_name[RULE_COUNT] = { "threshold", "cusum" };
+
+/*
+ * Prototypes for internal functions:
+ */
+static void evaluate(const char *p_name, size_t n, bool check);
+static void score_rule(rule_t rule, size_t n, int32_t reference, score_t *p_score);
+static int event_at(size_t index);
+
+int main(int argc, char **argv)
+{
+    host_signal_t signal;
+
+    // Event component alone, added to every trace
+    host_signal_init(&signal, TEST_RATE_HZ, 0.0, 0.0, 1);
+    signal.event_period = EVENT_PERIOD;
+    for (int k = 0; k < EVENT_KINDS; k++) {
+        host_signal_event_add(&signal, EVENT_FIRST + k * EVENT_SPACING, EVENT_RAMP, EVENT_HOLD, event_amplitude[k]);
+    }
+    host_signal_generate(&signal, events, TEST_SAMPLES);
+
+    if (argc == 3 && strcmp(argv[1], "--trace") == 0) {
+        long loaded = host_trace_load(argv[2], trace, TEST_SAMPLES);
+        if (loaded <= TEST_CALIBRATION) {
+            fprintf(stderr, "cannot use trace %s\n", argv[2]);
+            return 1;
+        }
+        evaluate(argv[2], (size_t)loaded, false);
+        return 0;
+    }
+
+    static const double noise[] = { 1.5, 3.0, 4.5 };
+    for (unsigned i = 0; i < sizeof(noise) / sizeof(noise[0]); i++) {
+        char name[48];
+        host_signal_init(&signal, TEST_RATE_HZ, TEST_LEVEL, noise[i], 100 + i);
+        host_signal_generate(&signal, trace, TEST_SAMPLES);
+        snprintf(name, sizeof(name), "synthetic, noise %.1f counts", noise[i]);
+        evaluate(name, TEST_SAMPLES, true);
+    }
+    return host_test_result("test_sensor_cusum");
+}
+
+/**
+ * @brief Add the events to the idle trace, score both rules and print them.
+ *
+ * @param p_name Name of the trace.
+ * @param n Number of samples in the trace.
+ * @param check True to hold the CUSUM to the expected results.
+ */
+static void evaluate(const char *p_name, size_t n, bool check)
+{
+    score_t score[RULE_COUNT];
+    int64_t sum = 0;
+
+    // Calibrated reference: the average of the first idle second
+    for (size_t i = 0; i < TEST_CALIBRATION; i++) {
+        sum += trace[i];
+    }
+    int32_t reference = (int32_t)(sum / TEST_CALIBRATION);
+    for (size_t i = 0; i < n; i++) {
+        int32_t value = trace[i] + events[i];
+        trace[i] = (int16_t)((value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : value);
+    }
+
+    uint32_t event_count = 0;
+    uint32_t large_count = 0;
+    for (size_t start = EVENT_FIRST; start + 2 * EVENT_RAMP + EVENT_HOLD <= n; start += EVENT_SPACING) {
+        int kind = (int)(((start - EVENT_FIRST) / EVENT_SPACING) % EVENT_KINDS);
+        event_count++;
+        large_count += (fabs(event_amplitude[kind]) >= 2.0 * TEST_THRESHOLD) ? 1 : 0;
+    }
+    if (EVENT_FIRST + (size_t)event_count * EVENT_SPACING < n) {
+        // Leave out an event the trace cuts short
+        n = EVENT_FIRST + (size_t)event_count * EVENT_SPACING;
+    }
+    double idle_minutes = (double)(n - TEST_CALIBRATION - event_count * (2 * EVENT_RAMP + EVENT_HOLD + EVENT_SETTLE))
+                        / TEST_RATE_HZ / 60.0;
+
+    printf("%s, T = %d counts, %u events\n", p_name, TEST_THRESHOLD, event_count);
+    printf("  rule        false alarms/min   detected   events >= 2T   mean delay   onsets/event\n");
+    for (int rule = 0; rule < RULE_COUNT; rule++) {
+        score_rule((rule_t)rule, n, reference, &score[rule]);
+        const score_t *p_score = &score[rule];
+        printf("  %-10s  %16.1f   %5u/%-3u  %9u/%-3u  %7.1f ms   %12.2f\n", rule_name[rule],
+               p_score->false_alarms / idle_minutes, p_score->detected, event_count,
+               p_score->detected_large, large_count,
+               (p_score->detected > 0) ? 1000.0 * p_score->delay_total / p_score->detected / TEST_RATE_HZ : 0.0,
+               (p_score->detected > 0) ? (double)p_score->onsets_in_events / p_score->detected : 0.0);
+    }
+
+    HOST_CHECK_EQ(score[RULE_CUSUM].index_errors, 0);
+    if (check) {
+        HOST_CHECK(score[RULE_CUSUM].false_alarms <= score[RULE_THRESHOLD].false_alarms);
+        HOST_CHECK_EQ(score[RULE_CUSUM].false_alarms, 0);
+        HOST_CHECK_EQ(score[RULE_CUSUM].detected_large, large_count);
+        HOST_CHECK_EQ(score[RULE_CUSUM].onsets_in_events, score[RULE_CUSUM].detected);
+    }
+}
+
+/**
+ * @brief Run one rule over the trace and score its onsets.
+ *
+ * @param rule The rule.
+ * @param n Number of samples.
+ * @param reference Calibrated idle level.
+ * @param p_score Filled with the score.
+ */
+static void score_rule(rule_t rule, size_t n, int32_t reference, score_t *p_score)
+{
+    sensor_cusum_t cusum;
+    sensor_cusum_event_t event;
+    int8_t state = 0;
+    int last_detected = -1;
+    uint32_t fed = 0;
+
+    memset(p_score, 0, sizeof(*p_score));
+    sensor_cusum_init(&cusum, CUSUM_DRIFT(TEST_THRESHOLD), CUSUM_DECISION(TEST_THRESHOLD));
+
+    for (size_t i = TEST_CALIBRATION; i < n; i++, fed++) {
+        int32_t deviation = trace[i] - reference;
+        bool onset = false;
+
+        if (rule == RULE_THRESHOLD) {
+            int8_t next = (deviation < -TEST_THRESHOLD) ? -1 : (deviation > 2 * TEST_THRESHOLD) ? 1 : 0;
+            onset = (next != 0 && next != state);
+            state = next;
+        } else if (sensor_cusum_update(&cusum, deviation, &event)) {
+            onset = (event.type == SENSOR_CUSUM_ONSET);
+            if (event.sample_index != fed || event.change_index > event.sample_index) {
+                p_score->index_errors++;
+            }
+        }
+        if (!onset) {
+            continue;
+        }
+
+        int k = event_at(i);
+        if (k < 0) {
+            p_score->false_alarms++;
+            continue;
+        }
+        p_score->onsets_in_events++;
+        if (k != last_detected) {
+            last_detected = k;
+            p_score->detected++;
+            p_score->delay_total += i - (EVENT_FIRST + (size_t)k * EVENT_SPACING);
+            int kind = k % EVENT_KINDS;
+            p_score->detected_large += (fabs(event_amplitude[kind]) >= 2.0 * TEST_THRESHOLD) ? 1 : 0;
+        }
+    }
+}
+
+/**
+ * @brief Find the event a sample belongs to.
+ *
+ * @param index Sample index.
+ * @return int Number of the event, or -1 for an idle sample.
+ */
+static int event_at(size_t index)
+{
+    if (index < EVENT_FIRST) {
+        return -1;
+    }
+    size_t offset = (index - EVENT_FIRST) % EVENT_SPACING;
+    if (offset >= 2 * EVENT_RAMP + EVENT_HOLD + EVENT_SETTLE) {
+        return -1;
+    }
+    return (int)((index - EVENT_FIRST) / EVENT_SPACING);
+}
@@ -0,0 +1,276 @@
+/**
+ * @file test_sensor_drift.c
+ * @brief Host test of the temperature drift compensation on temperature traces.
+ * 
+ * Feeds the same electrode signal to two sensor instances. The signal carries
+ * a baseline that follows the die temperature and long proximity events that
+ * freeze the baseline tracking. One instance gets the die temperature through
+ * temp_driver and the TEMP stand-in, polled once per second as in main.c; the
+ * other never sees it. Both are scored after the drift model has had time to
+ * learn:
+ * - fitted slope against the slope of the trace;
+ * - largest idle baseline error against the true baseline;
+ * - onsets outside the events, and time spent out of idle after an event has
+ *   ended, when a baseline that missed the drift holds the channel;
+ * - events whose release came within a second of the retreat.
+ * The synthetic temperature swings 10 degC either way over a 20 minute cycle.
+ * The compensation moves the baseline in steps of one TEMP resolution
+ * (0.25 degC) times the slope, so the trace slope is kept at 1.5 counts per
+ * step: steps beyond about T/2 trip the CUSUM by themselves (4 counts per
+ * step at T = 5 gives hundreds of false onsets). A recorded die temperature
+ * trace can be given instead, one reading in 0.25 degC per line and per
+ * second; the compensated instance must then do no worse.
+ *
+ * Usage: test_sensor_drift [--trace FILE]
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sensor_driver.h"
+#include "sadc_driver.h"
+#include "temp_driver.h"
+#include "host_signal.h"
+#include "host_stubs.h"
+#include "host_test.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define TEST_RATE_HZ      (SAADC_SAMPLE_FREQUENCY / SENSOR_DECIMATION_RATIO) // Sensor sample rate
+#define TEST_SECONDS      2400   // 40 minutes, one temperature reading per second
+#define TEST_SAMPLES      (TEST_SECONDS * TEST_RATE_HZ)
+#define TEST_BLOCK        (SAADC_BUF_FRAMES / SENSOR_DECIMATION_RATIO) // Decimated samples per SAADC buffer
+#define TEST_LEVEL        430.0
+#define TEST_NOISE        1.5
+#define TEST_SLOPE        -1.5   // Baseline counts per 0.25 degC
+#define TEST_TEMPERATURE  100.0  // 25 degC, in 0.25 degC
+#define TEST_SWING        40.0   // 10 degC either way
+#define TEST_CYCLE        1200   // Seconds per temperature cycle
+#define TEST_SLOPE_TOLERANCE 0.1 // Fitted slope, relative
+
+// Events: after 10 minutes of learning, one every 90 s held for 25 s (someone standing at the sensor)
+#define EVENT_SPACING     (90 * TEST_RATE_HZ)
+#define EVENT_FIRST       (7 * EVENT_SPACING)
+#define EVENT_RAMP        500
+#define EVENT_HOLD        (25 * TEST_RATE_HZ)
+#define EVENT_AMPLITUDE   60.0
+#define EVENT_SETTLE      TEST_RATE_HZ // Samples after the retreat still counted as the event
+
+/**
+ * @brief Score of one sensor instance.
+ */
+typedef struct {
+    double baseline_error;    // Largest idle |golden reference - true baseline|, counts
+    uint32_t false_onsets;    // Onsets outside every event
+    uint32_t held_samples;    // Samples out of idle outside every event
+    uint32_t events;          // Events that ended within the trace
+    uint32_t released;        // Of those, idle again EVENT_SETTLE samples after the retreat
+} score_t;
+
+/*
+ * Global variables:
+ */
+static int16_t samples[TEST_SAMPLES];
+static int16_t readings[TEST_SECONDS];        // TEMP readings, one per second
+static double temperature[TEST_SECONDS + 1];  // Die temperature at each second
+static sensor_instance_t compensated;
+static sensor_instance_t uncompensated;
+static host_signal_t events;
+
+/*
+ * Prototypes for internal functions:
+ */
+static void evaluate(const char *p_name, size_t seconds, bool synthetic);
+static void score_block(const sensor_instance_t *p_sensor, size_t end, int8_t *p_state, score_t *p_score);
+static bool in_event(size_t index);
+static double true_baseline(size_t index);
+static void sensor_callback(sensor_data_t *p_data);
+
+int main(int argc, char **argv)
+{
+    // Event component, repeating every EVENT_SPACING from EVENT_FIRST
+    host_signal_init(&events, TEST_RATE_HZ, 0.0, 0.0, 1);
+    events.event_period = EVENT_SPACING;
+    host_signal_event_add(&events, 0, EVENT_RAMP, EVENT_HOLD, EVENT_AMPLITUDE);
+
+    if (argc == 3 && strcmp(argv[1], "--trace") == 0) {
+        long seconds = host_trace_load(argv[2], readings, TEST_SECONDS);
+        if (seconds < 2) {
+            fprintf(stderr, "cannot read a temperature trace from %s\n", argv[2]);
+            return 1;
+        }
+        for (long s = 0; s <= seconds; s++) {
+            temperature[s] = readings[(s < seconds) ? s : seconds - 1];
+        }
+        evaluate(argv[2], (size_t)seconds, false);
+    } else {
+        for (size_t s = 0; s <= TEST_SECONDS; s++) {
+            temperature[s] = TEST_TEMPERATURE + TEST_SWING * sin(2.0 * M_PI * s / TEST_CYCLE);
+            if (s < TEST_SECONDS) {
+                readings[s] = (int16_t)floor(temperature[s] + 0.5);
+            }
+        }
+        evaluate("synthetic", TEST_SECONDS, true);
+    }
+    return host_test_result("test_sensor_drift");
+}
+
+/**
+ * @brief Run both instances over a temperature trace and score them.
+ *
+ * @param p_name Name of the trace.
+ * @param seconds Length of the trace in seconds.
+ * @param synthetic True if the trace slope is known and the events must show the drift.
+ */
+static void evaluate(const char *p_name, size_t seconds, bool synthetic)
+{
+    size_t n = seconds * TEST_RATE_HZ;
+    host_signal_t noise;
+    score_t scores[2];
+    int8_t states[2] = { 0, 0 };
+    int32_t reading;
+
+    host_signal_init(&noise, TEST_RATE_HZ, 0.0, TEST_NOISE, 7);
+    host_signal_generate(&noise, samples, n);
+    for (size_t i = 0; i < n; i++) {
+        double value = samples[i] + true_baseline(i) + ((i >= EVENT_FIRST) ? host_signal_clean(&events, (uint32_t)i) : 0.0);
+        samples[i] = (int16_t)floor(value + 0.5);
+    }
+
+    host_stubs_reset();
+    host_temp_trace_set(readings, seconds);
+    temp_init();
+    sensor_init(&compensated, 0, sensor_callback);
+    sensor_init(&uncompensated, 0, sensor_callback);
+    memset(scores, 0, sizeof(scores));
+
+    for (size_t i = 0; i < n; i += TEST_BLOCK) {
+        size_t block = (i + TEST_BLOCK <= n) ? TEST_BLOCK : n - i;
+        sensor_process_block(&compensated, &samples[i], block, 1);
+        sensor_process_block(&uncompensated, &samples[i], block, 1);
+        // Polled once per second of samples, like main.c
+        if ((i + block) % TEST_RATE_HZ == 0 && temp_poll(&reading)) {
+            sensor_temperature_update(&compensated, reading);
+        }
+        if (i + block > EVENT_FIRST) {
+            score_block(&compensated, i + block, &states[0], &scores[0]);
+            score_block(&uncompensated, i + block, &states[1], &scores[1]);
+        }
+    }
+
+    double slope = sensor_drift_slope(&compensated.drift) / (double)(1 << SENSOR_DRIFT_Q16_SHIFT);
+    printf("%s: %zu s, fitted slope %.3f counts per 0.25 degC, T %d\n", p_name, seconds, slope,
+           (int)compensated.ctx.noise_threshold);
+    for (int k = 0; k < 2; k++) {
+        printf("  %-13s baseline error %5.1f counts, %u false onsets, %6.1f s held after events, %u/%u events released\n",
+               (k == 0) ? "compensated" : "uncompensated", scores[k].baseline_error, scores[k].false_onsets,
+               (double)scores[k].held_samples / TEST_RATE_HZ, scores[k].released, scores[k].events);
+    }
+
+    HOST_CHECK(scores[0].false_onsets <= scores[1].false_onsets);
+    HOST_CHECK(scores[0].held_samples <= scores[1].held_samples);
+    HOST_CHECK(scores[0].released >= scores[1].released);
+    if (synthetic) {
+        HOST_CHECK_NEAR(slope, TEST_SLOPE, -TEST_SLOPE * TEST_SLOPE_TOLERANCE);
+        HOST_CHECK(scores[0].baseline_error < compensated.ctx.noise_threshold / 2.0);
+        HOST_CHECK_EQ(scores[0].false_onsets, 0);
+        HOST_CHECK_EQ(scores[0].held_samples, 0);
+        HOST_CHECK_EQ(scores[0].released, scores[0].events);
+        // The trace must be one where the drift matters
+        HOST_CHECK(scores[1].held_samples > 0);
+    }
+}
+
+/**
+ * @brief Score the state of an instance at the end of a block.
+ *
+ * @param p_sensor Pointer to the instance.
+ * @param end Index of the sample after the block.
+ * @param p_state Change state at the end of the previous block, updated.
+ * @param p_score Score updated.
+ */
+static void score_block(const sensor_instance_t *p_sensor, size_t end, int8_t *p_state, score_t *p_score)
+{
+    const sensor_data_t *p_data = &p_sensor->data;
+    size_t last = end - 1;
+    bool onset = (*p_state == 0 && p_data->change_state != 0);
+    bool idle = (p_data->change_state == 0 && p_data->zone == SENSOR_ZONE_IDLE);
+
+    *p_state = p_data->change_state;
+    if (!in_event(last)) {
+        p_score->false_onsets += onset ? 1 : 0;
+        p_score->held_samples += idle ? 0 : TEST_BLOCK;
+        if (idle) {
+            double error = fabs(p_data->golden_reference - true_baseline(last));
+            p_score->baseline_error = (error > p_score->baseline_error) ? error : p_score->baseline_error;
+        }
+    }
+    // EVENT_SETTLE samples after the retreat of an event
+    size_t since = (last - EVENT_FIRST) % EVENT_SPACING;
+    if (since / TEST_BLOCK == (2 * EVENT_RAMP + EVENT_HOLD + EVENT_SETTLE) / TEST_BLOCK) {
+        p_score->events++;
+        p_score->released += idle ? 1 : 0;
+    }
+}
+
+/**
+ * @brief Check whether a sample belongs to an event, its retreat settling included.
+ *
+ * @param index Sample index.
+ * @return bool True during an event.
+ */
+static bool in_event(size_t index)
+{
+    return index >= EVENT_FIRST &&
+           (index - EVENT_FIRST) % EVENT_SPACING < 2 * EVENT_RAMP + EVENT_HOLD + EVENT_SETTLE;
+}
+
+/**
+ * @brief Get the idle level the electrode sits at, from the die temperature.
+ *
+ * The temperature is interpolated between the readings of the trace.
+ *
+ * @param index Sample index.
+ * @return double The baseline in counts.
+ */
+static double true_baseline(size_t index)
+{
+    size_t second = index / TEST_RATE_HZ;
+    double fraction = (double)(index % TEST_RATE_HZ) / TEST_RATE_HZ;
+    double now = temperature[second] + (temperature[second + 1] - temperature[second]) * fraction;
+
+    return TEST_LEVEL + TEST_SLOPE * (now - temperature[0]);
+}
+
+static void sensor_callback(sensor_data_t *p_data)
+{
+    (void)p_data;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_sensor_window.c
+ * @brief Host test of the sliding-window statistics.
+ * 
+ * Checks that sensor_window gives the same total, average, minimum and
+ * maximum as a walk over the whole window after every push, for random,
+ * monotonic, constant and sawtooth input. The host build compiles this test
+ * once per window length (SENSOR_WINDOW_SIZE), power of two or not.
+ * 
+ * @author Henry Cardon <henry@cardona.se>
+ * @date Created on: 2026-10-17
+ *
+ * Copyright (c) 2017-2023 Cardona Architecture Studio <cardona-archistudio.com>
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * License: MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdlib.h>
+
+#include "sensor_window.h"
+#include "host_test.h"
+
+#define TEST_PUSHES (4 * SENSOR_WINDOW_SIZE + 1000)
+
+/*
+ * Global variables:
+ */
+static int32_t history[TEST_PUSHES];
+static sensor_window_t window;
+
+/*
+ * Prototypes for internal functions:
+ */
+static void check_sequence(const char *p_name, int32_t (*next)(uint32_t index));
+static int32_t random_value(uint32_t index);
+static int32_t rising_value(uint32_t index);
+static int32_t falling_value(uint32_t index);
+static int32_t constant_value(uint32_t index);
+static int32_t sawtooth_value(uint32_t index);
+
+int main(void)
+{
+    check_sequence("random", random_value);
+    check_sequence("rising", rising_value);
+    check_sequence("falling", falling_value);
+    check_sequence("constant", constant_value);
+    check_sequence("sawtooth", sawtooth_value);
+    return host_test_result("test_sensor_window");
+}
+
+/**
+ * @brief Push a sequence and compare the window with a full walk after every push.
+ *
+ * @param p_name Name of the sequence, for the failure report.
+ * @param next Generator of the sequence.
+ */
+static void check_sequence(const char *p_name, int32_t (*next)(uint32_t index))
+{
+    uint32_t failures = host_test_failures;
+
+    sensor_window_init(&window);
+    HOST_CHECK_EQ(sensor_window_min(&window), UINT16_MAX);
+    HOST_CHECK_EQ(sensor_window_max(&window), 0);
+
+    for (uint32_t i = 0; i < TEST_PUSHES && host_test_failures == failures; i++) {
+        history[i] = next(i);
+        sensor_window_push(&window, history[i]);
+
+        uint32_t count = (i + 1 < SENSOR_WINDOW_SIZE) ? i + 1 : SENSOR_WINDOW_SIZE;
+        int32_t total = 0;
+        int32_t min = history[i];
+        int32_t max = history[i];
+        for (uint32_t k = i + 1 - count; k <= i; k++) {
+            total += history[k];
+            min = (history[k] < min) ? history[k] : min;
+            max = (history[k] > max) ? history[k] : max;
+        }
+        HOST_CHECK_EQ(sensor_window_is_full(&window), count == SENSOR_WINDOW_SIZE);
+        HOST_CHECK_EQ(sensor_window_total(&window), total);
+        HOST_CHECK_EQ(sensor_window_min(&window), min);
+        HOST_CHECK_EQ(sensor_window_max(&window), max);
+        if (count == SENSOR_WINDOW_SIZE) {
+            HOST_CHECK_EQ(sensor_window_average(&window), total / SENSOR_WINDOW_SIZE);
+        }
+    }
+    if (host_test_failures != failures) {
+        fprintf(stderr, "  in the %s sequence, window %d\n", p_name, SENSOR_WINDOW_SIZE);
+    }
+}
+
+// Readings of up to 14 bits, both signs, with repeated values
+static int32_t random_value(uint32_t index)
+{
+    (void)index;
+    return (rand() % 24576) - 8192;
+}
+
+static int32_t rising_value(uint32_t index)
+{
+    return (int32_t)index;
+}
+
+static int32_t falling_value(uint32_t index)
+{
+    return 16383 - (int32_t)index;
+}
+
+static int32_t constant_value(uint32_t index)
+{
+    (void)index;
+    return -7;
+}
+
+// Period prime to most window lengths, so the extremes leave at every offset
+static int32_t sawtooth_value(uint32_t index)
+{
+    return (int32_t)(index % 37) * 100 - 1800;
+}
@@ -31,190 +31,622 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#include <string.h>
+
 #include "sensor_driver.h"
 #include "log_driver.h"
 #include "uart_driver.h"
+#include "feedback_driver.h"
 #include "sadc_driver.h"
+#include "sadc_governor.h"
+#include "cic_decimator.h"
+#include "block_kernels.h"
+#include "temp_driver.h"
+#include "lpcomp_driver.h"
 
 #include "app_error.h"
-#include "nrf_drv_timer.h"
-#include "nrf_delay.h"
+#include "app_scheduler.h"
+#include "nrf_pwr_mgmt.h"
+
+// Decimation between the SAADC stream and the sensor processing
+#define DECIMATION_RATIO      SENSOR_DECIMATION_RATIO // Set in sensor_config.h (8: 8 kHz SAADC stream to a 1 kHz sensor stream)
+#define DECIMATION_COMPENSATE true // Flatten the CIC passband droop with the FIR stage
+#define DECIMATION_IDLE_RATIO (DECIMATION_RATIO / SAADC_IDLE_DIVIDER) // Same sensor rate from the idle SAADC stream
+
+// Quiet time at the full SAADC rate before dropping to the idle rate
+#define GOVERNOR_QUIET_TIME_MS 2000
+
+// Quiet idle-rate buffers before the sampling is handed over to the SAADC limit events
+#define WATCH_QUIET_BUFFERS 4
+
+// The limit events compare single raw conversions, so a buffer only counts as quiet if
+// its raw extent also lies within the limits (single channel: no interleaved frames)
+#define WATCH_RAW_EXTENT (SADC_LIMIT_WATCH && (SADC_CHANNEL_COUNT == 1))
+
+// Deep idle: after a minute of limit watch the SAADC and its TIMERs stop and the
+// LPCOMP watches the electrode (single channel only, one comparator). Its single
+// reference only sees the approach side, so the polarity must be known.
+#define DEEP_IDLE (SENSOR_DEEP_IDLE && (SENSOR_PROXIMITY_POLARITY != 0) && SADC_LIMIT_WATCH && (SADC_CHANNEL_COUNT == 1))
+#define DEEP_IDLE_REFRESHES 60    // Limit watch refreshes (seconds) before the deep idle
+#define DEEP_IDLE_WAKE_SIDE ((SENSOR_PROXIMITY_POLARITY > 0) ? LPCOMP_WAKE_UP : LPCOMP_WAKE_DOWN)
+#define DEEP_IDLE_WAKE_DEVIATION ZONE_TOUCH_ENTER // Deviation that must cross the reference (steps are ~53 counts apart at 10 bits)
+#define DEEP_IDLE_WAKE_BUDGET_US ((SAADC_BUF_FRAMES * 1000000UL) / SAADC_SAMPLE_FREQUENCY + 2000) // First buffer plus processing
+
+// Die temperature polling for the drift compensation: once per second of sensor samples
+#define TEMP_POLL_SAMPLES (SAADC_SAMPLE_FREQUENCY / DECIMATION_RATIO)
+
+// SAADC offset recalibration (SENSOR_OFFSET_CALIBRATION in sensor_config.h)
+#define CALIBRATION_TEMP_STEP 40  // Die temperature change (10 degC in 0.25 degC) triggering a recalibration
+
+// Scheduler settings: largest event payload and number of queued work items
+#define SCHED_MAX_EVENT_DATA_SIZE sizeof(uint32_t)
+#define SCHED_QUEUE_SIZE          (SAADC_BUF_COUNT + 8)
+
+// Decimator state and output block carried between SAADC buffers, sized for the idle ratio.
+static cic_decimator_t decimator;
+static int16_t decimated_samples[(SAADC_BUF_FRAMES / DECIMATION_IDLE_RATIO + 1) * SADC_CHANNEL_COUNT];
+static int16_t last_decimated_frame[SADC_CHANNEL_COUNT]; // Level the decimator settles on after a rate change
+static sadc_rate_t decimator_rate = SADC_RATE_FULL;      // SAADC rate the decimation ratio matches
+static uint8_t decimator_profile = SADC_PROFILE_COUNT;   // Acquisition profile the input scale matches (none before the first buffer)
+
+// SAADC rate governor, fed once per buffer with the activity of the sensors.
+static sadc_governor_t rate_governor;
 
-#define HIGH_INTENSITY 255
-#define LOW_INTENSITY 0
+// One sensor instance per SAADC scan channel.
+static sensor_instance_t sensors[SADC_CHANNEL_COUNT];
 
-// Sets up a timer for regular stability assessments.
-const nrf_drv_timer_t STABILITY_TIMER = NRF_DRV_TIMER_INSTANCE(0);
+#if SADC_LIMIT_WATCH
+// Quiet idle-rate buffers seen since the last active one.
+static uint16_t watch_quiet_count = 0;
+#endif
+
+#if WATCH_RAW_EXTENT
+// Extent of the raw conversions of the last buffer, in counts of its profile.
+static int16_t raw_extent_low = INT16_MIN;
+static int16_t raw_extent_high = INT16_MAX;
+static sadc_profile_id_t raw_extent_profile = SADC_PROFILE_FAST;
+static bool raw_extent_valid = false;
+#endif
+
+#if DEEP_IDLE
+// Limit watch refreshes since the watch started, and the wake-up measurement.
+static uint16_t deep_idle_refresh_count = 0;
+static bool wake_latency_pending = false;  // The next processed block is the first after a wake
+static uint32_t wake_latency_max_us = 0;   // Longest wake to first classified sample
+#endif
+
+#if SADC_TIMESTAMPS
+// Longest time from the END event of a buffer to the start of its processing.
+static uint32_t buffer_latency_max_us = 0;
+#endif
+
+// Sensor samples processed since the last die temperature poll.
+static uint16_t temp_poll_count = 0;
+
+#if SENSOR_OFFSET_CALIBRATION
+// Die temperature of the last offset calibration.
+static bool calibration_done = false;
+static int32_t calibration_temperature = 0;
+#endif
 
 /*
  * Prototypes for internal functions:
  */ 
-void sensor_feedback(sensor_data_t* sensor_data);
-void set_rgb_intensity(uint16_t red, uint16_t green, uint16_t blue);
-static uint16_t map_intensity(uint16_t x, uint16_t in_min, uint16_t in_max, uint16_t out_min, uint16_t out_max);
-uint8_t calculate_checksum(uint8_t* data, uint8_t length);
-static void timer_event_handler(nrf_timer_event_t event_type, void* p_context);
-static void timer_setup(void);
+static void sadc_ready_handler(void);
+static void sensor_scheduled_handler(void * p_event_data, uint16_t event_size);
+static void idle_state_process(void);
+static void temperature_process(void);
+static void decimation_update(const sadc_buffer_desc_t *p_buffer);
+static void discontinuity_process(const sadc_buffer_desc_t *p_buffer);
+#if SENSOR_OFFSET_CALIBRATION
+static void offset_calibration_process(int32_t temperature);
+#endif
+#if SADC_TIMESTAMPS
+static void buffer_latency_process(const sadc_buffer_desc_t *p_buffer);
+#endif
+#if SADC_RATE_GOVERNOR
+static void rate_governor_process(const sadc_buffer_desc_t *p_buffer);
+#endif
+#if SADC_LIMIT_WATCH
+static void limit_watch_process(bool quiet);
+static void limit_watch_limits(int16_t *p_low, int16_t *p_high);
+#if WATCH_RAW_EXTENT
+static void raw_extent_process(const sadc_buffer_desc_t *p_buffer);
+static bool raw_extent_within(const int16_t *p_low, const int16_t *p_high);
+#endif
+static void sadc_watch_handler(sadc_watch_evt_t event);
+static void watch_scheduled_handler(void * p_event_data, uint16_t event_size);
+#endif
+#if DEEP_IDLE
+static void deep_idle_enter(void);
+static void lpcomp_wake_handler(void);
+static void deep_idle_wake_scheduled_handler(void * p_event_data, uint16_t event_size);
+static void wake_latency_process(void);
+#endif
+
+/**
+ * @brief SAADC buffer ready handler.
+ *
+ * Called from the SAADC interrupt when a completed buffer has been queued.
+ * Posts the sensor processing as a work item for the main loop.
+ */
+static void sadc_ready_handler(void)
+{
+    // If the scheduler queue is full the buffer stays queued and is drained
+    // by the next scheduled sensor work item.
+    app_sched_event_put(NULL, 0, sensor_scheduled_handler);
+}
 
 /**
- * @brief Calculate checksum for a given set of data.
+ * @brief Scheduled handler for sensor processing.
  *
- * Computes a checksum by summing all the bytes in the data array. This checksum
- * is used for error-checking in communications.
+ * Decimates every completed SAADC buffer, oldest first, feeds the decimated
+ * samples to the sensors and hands each buffer back to the SAADC pool as soon
+ * as it has been filtered. Each sensor instance reads its own channel out of the
+ * interleaved decimated frames. Buffers acquired at the idle SAADC rate are
+ * decimated by a smaller ratio, so the sensors always see the same sample rate,
+ * and every acquisition profile is decimated to the same SADC_SCALE_BITS scale.
+ * About once per second the die temperature is polled for the drift
+ * compensation. With timestamped buffers the delay from the END of each
+ * buffer to its processing is traced. Before an idle-rate buffer is released
+ * its raw extent is kept for the limit watch.
  *
- * @param data Pointer to the data array.
- * @param length Length of the data array.
- * @return uint8_t The calculated checksum value.
+ * @param p_event_data Event data (unused).
+ * @param event_size Size of the event data (unused).
  */
-uint8_t calculate_checksum(uint8_t* data, uint8_t length) {
-    uint8_t checksum = 0;
-    for (uint8_t i = 0; i < length; ++i) {
-        checksum += data[i];
+static void sensor_scheduled_handler(void * p_event_data, uint16_t event_size)
+{
+    sadc_buffer_desc_t buffer;
+
+    while ( get_data_ready_flag() ) {
+        if ( sadc_buffer_get(&buffer) ) {
+#if SADC_TIMESTAMPS
+            buffer_latency_process(&buffer);
+#endif
+            discontinuity_process(&buffer);
+            decimation_update(&buffer);
+            size_t frames = cic_decimator_process(&decimator, buffer.p_buffer, buffer.size, decimated_samples);
+#if WATCH_RAW_EXTENT
+            raw_extent_process(&buffer);
+#endif
+            sadc_buffer_release( buffer.p_buffer );
+            for (uint8_t ch = 0; ch < SADC_CHANNEL_COUNT; ch++) {
+                sensor_process_block( &sensors[ch], &decimated_samples[ch], frames, SADC_CHANNEL_COUNT );
+            }
+#if DEEP_IDLE
+            wake_latency_process();
+#endif
+            if (frames > 0) {
+                memcpy(last_decimated_frame, &decimated_samples[(frames - 1) * SADC_CHANNEL_COUNT], sizeof(last_decimated_frame));
+            }
+#if SADC_RATE_GOVERNOR
+            rate_governor_process(&buffer);
+#endif
+            temp_poll_count += frames;
+            if (temp_poll_count >= TEMP_POLL_SAMPLES) {
+                temp_poll_count = 0;
+                temperature_process();
+            }
+        }
     }
-    return checksum;
 }
 
 /**
- * @brief Set the intensity of RGB LEDs and send the data via UART.
+ * @brief Match the decimator to the rate and profile of the next SAADC buffer.
  *
- * Constructs a message with the specified RGB intensities and transmits it over UART.
- * The message format includes a start byte, RGB values, checksum, and stop byte.
+ * The ratio follows the sampling rate and the input scale the resolution of
+ * the acquisition profile. The decimator is settled on the last decimated
+ * frame, so the sensor stream continues without a step across the change.
+ * The first buffer has no decimated frame before it: the decimator is settled
+ * on its first scan frame instead, so the calibration does not average the
+ * ramp up from zero.
  *
- * @param red Intensity of the red LED component.
- * @param green Intensity of the green LED component.
- * @param blue Intensity of the blue LED component.
+ * @param p_buffer Descriptor of the buffer about to be decimated.
  */
-void set_rgb_intensity(uint16_t red, uint16_t green, uint16_t blue) {
-    uint8_t message[6];
-    message[0] = START_BYTE;
-    message[1] = (uint8_t)(red & 0xFF); // assuming 8-bit color intensity
-    message[2] = (uint8_t)(green & 0xFF);
-    message[3] = (uint8_t)(blue & 0xFF);
-    message[4] = calculate_checksum(&message[1], 3); // checksum of RGB values
-    message[5] = STOP_BYTE;
-    // TOSO: Currently we are only sensing data using the UART to Arduino
-    uart_send(message, sizeof(message));
+static void decimation_update(const sadc_buffer_desc_t *p_buffer)
+{
+    if (p_buffer->rate == decimator_rate && p_buffer->profile == decimator_profile) {
+        return;
+    }
+    const sadc_profile_t *p_profile = sadc_profile_get((sadc_profile_id_t)p_buffer->profile);
+    uint16_t ratio = (p_buffer->rate == SADC_RATE_IDLE) ? DECIMATION_IDLE_RATIO : DECIMATION_RATIO;
+    if (p_profile != NULL && cic_decimator_reconfigure(&decimator, ratio, p_profile->scale_shift, last_decimated_frame)) {
+        if (decimator_profile == SADC_PROFILE_COUNT && p_buffer->size >= SADC_CHANNEL_COUNT) {
+            cic_decimator_settle(&decimator, p_buffer->p_buffer);
+        }
+        decimator_rate = (sadc_rate_t)p_buffer->rate;
+        decimator_profile = p_buffer->profile;
+    }
 }
+
 /**
- * @brief Feedback handler for new sensor readings.
+ * @brief Blank the detection of every sensor across a gap in the SAADC stream.
  *
- * Processes new sensor data and adjusts RGB LED intensity based on sensor values.
- * This function is called as a callback from the sensor driver.
+ * The first buffer after the sampling stopped and restarted (offset
+ * calibration, exhausted pool) reports the scan frames lost in the gap.
  *
- * @param sensor_data Pointer to the latest sensor data structure.
+ * @param p_buffer Descriptor of the buffer about to be decimated.
  */
-void sensor_feedback(sensor_data_t* sensor_data)
+static void discontinuity_process(const sadc_buffer_desc_t *p_buffer)
 {
-    uint16_t sensor_value = (uint16_t)sensor_data->sensor_reading;
-    
-    uint16_t red_intensity = LOW_INTENSITY;
-    uint16_t green_intensity = LOW_INTENSITY;
-    uint16_t blue_intensity = LOW_INTENSITY;
+    if (p_buffer->skipped == 0) {
+        return;
+    }
+    for (uint8_t ch = 0; ch < SADC_CHANNEL_COUNT; ch++) {
+        sensor_discontinuity(&sensors[ch]);
+    }
+    if (p_buffer->skipped == SADC_SKIPPED_UNKNOWN) {
+        NRF_LOG_INFO("SAADC stream restarted before buffer %u", p_buffer->sequence);
+    } else {
+        NRF_LOG_INFO("SAADC stream restarted before buffer %u, %u frames skipped",
+                     p_buffer->sequence, p_buffer->skipped);
+    }
+}
 
-    // If within STABILITY_THRESHOLD of golden_reference, keep all intensities at 0.
-    if (abs(sensor_value - sensor_data->golden_reference) <= STABILITY_THRESHOLD)
-    {
-        set_rgb_intensity(LOW_INTENSITY, LOW_INTENSITY, LOW_INTENSITY);
+#if SADC_TIMESTAMPS
+/**
+ * @brief Trace the delay between the END event of a buffer and its processing.
+ *
+ * Both times are read on the SAADC buffer timebase. A delay beyond one buffer
+ * period means the main loop lags the acquisition and the pool is draining.
+ *
+ * @param p_buffer Descriptor of the buffer about to be processed.
+ */
+static void buffer_latency_process(const sadc_buffer_desc_t *p_buffer)
+{
+    uint32_t latency_us = sadc_timestamp_now() - p_buffer->timestamp;
+
+    if (latency_us <= buffer_latency_max_us) {
         return;
-    } 
+    }
+    buffer_latency_max_us = latency_us;
 
-    if (sensor_value < sensor_data->golden_reference - STABILITY_THRESHOLD)
-    {
-        // As the sensor_value decreases below the golden_reference, the blue intensity increases.
-        blue_intensity = map_intensity(sensor_value,
-                                       sensor_data->low_reference, 
-                                       sensor_data->golden_reference - STABILITY_THRESHOLD,
-                                       HIGH_INTENSITY, LOW_INTENSITY);
+    uint32_t period_us = (uint32_t)(((uint64_t)(p_buffer->size / SADC_CHANNEL_COUNT) * 1000000) /
+                                    sadc_rate_frequency((sadc_rate_t)p_buffer->rate));
+    if (latency_us > period_us) {
+        NRF_LOG_WARNING("SAADC buffer %u processed %u us after its END (buffer period %u us)",
+                        p_buffer->sequence, latency_us, period_us);
+    } else {
+        NRF_LOG_DEBUG("SAADC buffer latency %u us", latency_us);
     }
-    else if (sensor_value > sensor_data->golden_reference + (STABILITY_THRESHOLD *2)) // TODO: For stability *2 for now
-    {
-        // As the sensor_value increases over the golden_reference, the green intensity increases.
-        green_intensity = map_intensity(sensor_value,
-                                        sensor_data->golden_reference + STABILITY_THRESHOLD, 
-                                        sensor_data->top_reference,
-                                        LOW_INTENSITY, HIGH_INTENSITY);
+}
+#endif
+
+#if SADC_RATE_GOVERNOR
+/**
+ * @brief Feed the activity of the sensors to the SAADC rate governor.
+ *
+ * A channel is active while it calibrates, reports a change event or is
+ * outside the idle zone. The requested rate takes effect at the next buffer
+ * boundary; every change is logged with the time spent at each rate.
+ *
+ * @param p_buffer Descriptor of the buffer just processed.
+ */
+static void rate_governor_process(const sadc_buffer_desc_t *p_buffer)
+{
+    bool active = false;
+
+    for (uint8_t ch = 0; ch < SADC_CHANNEL_COUNT && !active; ch++) {
+        sensor_data_t data = get_sensor_data(&sensors[ch]);
+        active = (get_sensor_status(&sensors[ch]) != SENSOR_OK) ||
+                 (data.zone != SENSOR_ZONE_IDLE) || (data.change_state != 0);
     }
 
-    set_rgb_intensity(red_intensity, green_intensity, blue_intensity);
+    uint32_t switches = sadc_governor_switches(&rate_governor);
+    sadc_rate_t rate = sadc_governor_update(&rate_governor, (sadc_rate_t)p_buffer->rate,
+                                            p_buffer->size / SADC_CHANNEL_COUNT, active);
+    sadc_rate_set(rate);
+
+    if (sadc_governor_switches(&rate_governor) != switches) {
+        NRF_LOG_INFO("SAADC rate %u Hz (full rate %u ms, idle rate %u ms, limit watch %u ms)", sadc_rate_frequency(rate),
+                     sadc_governor_time_ms(&rate_governor, SADC_RATE_FULL),
+                     sadc_governor_time_ms(&rate_governor, SADC_RATE_IDLE),
+                     get_sadc_watch_time_ms());
+    }
+
+#if SADC_LIMIT_WATCH
+    limit_watch_process(!active && rate == SADC_RATE_IDLE && p_buffer->rate == SADC_RATE_IDLE);
+#endif
 }
+#endif
 
+#if SADC_LIMIT_WATCH
 /**
- * @brief Map a sensor value to a specified intensity range.
+ * @brief Hand a quiet idle-rate stream over to the SAADC limit events.
  *
- * Linearly maps a sensor reading from one range to another range, typically used
- * for mapping sensor readings to LED intensities.
+ * After WATCH_QUIET_BUFFERS quiet buffers at the idle rate the driver stops
+ * queuing buffers and only wakes the CPU when a channel leaves its limits.
+ * A buffer whose raw conversions reached beyond the limits is not quiet: the
+ * limit events would fire on the first conversions of the watch.
  *
- * @param x Sensor reading to map.
- * @param in_min Minimum value of the sensor's range.
- * @param in_max Maximum value of the sensor's range.
- * @param out_min Minimum value of the intensity range.
- * @param out_max Maximum value of the intensity range.
- * @return uint16_t Mapped intensity value.
+ * @param quiet True if the buffer just processed was quiet and at the idle rate.
  */
-static uint16_t map_intensity(uint16_t x, uint16_t in_min, uint16_t in_max, uint16_t out_min, uint16_t out_max) {
-    
-    // Ensure values are within the expected range
-    if(x < in_min) return out_min;
-    if(x > in_max) return out_max;
+static void limit_watch_process(bool quiet)
+{
+    int16_t low[SADC_CHANNEL_COUNT];
+    int16_t high[SADC_CHANNEL_COUNT];
 
-    // Map the value linearly
-    //return (uint8_t)(((x - in_min) * (out_max - out_min) / (in_max - in_min)) + out_min);
-    return (uint8_t)(x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+    if (quiet) {
+        limit_watch_limits(low, high);
+#if WATCH_RAW_EXTENT
+        quiet = raw_extent_within(low, high);
+#endif
+    }
+    if (!quiet) {
+        watch_quiet_count = 0;
+        return;
+    }
+    if (++watch_quiet_count < WATCH_QUIET_BUFFERS || sadc_watch_active()) {
+        return;
+    }
+    watch_quiet_count = 0;
+#if DEEP_IDLE
+    deep_idle_refresh_count = 0;
+#endif
+    if (sadc_watch_start(low, high, sadc_watch_handler) == NRF_SUCCESS) {
+        NRF_LOG_DEBUG("SAADC limit watch [%d, %d]", low[FEEDBACK_CHANNEL], high[FEEDBACK_CHANNEL]);
+    }
 }
 
 /**
- * @brief Timer event handler.
+ * @brief Collect the wake limits of every sensor instance.
  *
- * Handles timer events. When the timer event occurs, it triggers the sensor stability
- * check function.
+ * @param p_low Array receiving the low limit of each channel.
+ * @param p_high Array receiving the high limit of each channel.
+ */
+static void limit_watch_limits(int16_t *p_low, int16_t *p_high)
+{
+    for (uint8_t ch = 0; ch < SADC_CHANNEL_COUNT; ch++) {
+        sensor_watch_limits(&sensors[ch], &p_low[ch], &p_high[ch]);
+    }
+}
+
+#if WATCH_RAW_EXTENT
+/**
+ * @brief Keep the raw extent of an idle-rate buffer before it is released.
  *
- * @param event_type Type of the timer event.
- * @param p_context Context for the timer event (unused).
+ * The minimum and maximum conversions are found with the block kernels and
+ * kept in the raw counts of the buffer's profile, the units the SAADC compares
+ * against its limits.
+ *
+ * @param p_buffer Descriptor of the buffer just decimated.
  */
-static void timer_event_handler(nrf_timer_event_t event_type, void* p_context)
+static void raw_extent_process(const sadc_buffer_desc_t *p_buffer)
 {
-    switch (event_type)
-    {
-        case NRF_TIMER_EVENT_COMPARE0:
-            // Perform sensor's stability check.
-            sensor_stability_check();
-            break;
-
-        default:
-            // Do nothing.
-            break;
+    raw_extent_valid = false;
+    if (p_buffer->rate != SADC_RATE_IDLE || p_buffer->size == 0) {
+        return;
     }
+    block_min_max(p_buffer->p_buffer, p_buffer->size, &raw_extent_low, &raw_extent_high);
+    raw_extent_profile = (sadc_profile_id_t)p_buffer->profile;
+    raw_extent_valid = true;
 }
 
 /**
- * @brief Setup the timer for sensor stability checks.
+ * @brief Check the raw extent of the last buffer against the wake limits.
  *
- * Initializes and configures a timer to periodically trigger sensor stability checks.
- * The timer generates events at a defined interval.
+ * The limits are converted to raw counts the way the driver programs them.
+ * The SAADC raises LIMITH on a conversion equal to or above the high limit
+ * and LIMITL on one equal to or below the low limit, so a conversion sitting
+ * on a limit is outside it.
+ *
+ * @param p_low Low limit of the channel.
+ * @param p_high High limit of the channel.
+ * @return bool True if every raw conversion lay strictly within the limits.
  */
-static void timer_setup(void)
+static bool raw_extent_within(const int16_t *p_low, const int16_t *p_high)
 {
-    uint32_t err_code;
-
-    // Configure and initialize the timer
-    nrf_drv_timer_config_t timer_cfg = NRF_DRV_TIMER_DEFAULT_CONFIG;
-    err_code = nrf_drv_timer_init(&STABILITY_TIMER, &timer_cfg, timer_event_handler);
-    APP_ERROR_CHECK(err_code);
-
-    // Convert the desired time interval to timer ticks
-    uint32_t time_ms = STABILITY_DURATION; // Time(in miliseconds) between consecutive compare events.
-    uint32_t time_ticks = nrf_drv_timer_ms_to_ticks(&STABILITY_TIMER, time_ms);
-
-    // Configure the timer to generate a compare event after the interval has passed
-    nrf_drv_timer_extended_compare(
-         &STABILITY_TIMER, 
-         NRF_TIMER_CC_CHANNEL0, 
-         time_ticks, 
-         NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK, 
-         true);
-
-    // Start the timer
-    nrf_drv_timer_enable(&STABILITY_TIMER);
+    if (!raw_extent_valid) {
+        return false;
+    }
+    return raw_extent_low > sadc_level_to_raw(p_low[0], raw_extent_profile) &&
+           raw_extent_high < sadc_level_to_raw(p_high[0], raw_extent_profile);
+}
+#endif
+
+/**
+ * @brief SAADC limit watch handler.
+ *
+ * Called from interrupt context; posts the event to the main loop.
+ *
+ * @param event The limit watch event.
+ */
+static void sadc_watch_handler(sadc_watch_evt_t event)
+{
+    app_sched_event_put(&event, sizeof(event), watch_scheduled_handler);
+}
+
+/**
+ * @brief Scheduled handler for limit watch events.
+ *
+ * A refresh polls the die temperature, which buffers no longer do during the
+ * watch, and re-centres the limits on the compensated baseline; after
+ * DEEP_IDLE_REFRESHES of them the deep idle takes over. A wake hands the full
+ * rate back to the governor; the buffers that follow are processed as usual.
+ *
+ * @param p_event_data Pointer to the sadc_watch_evt_t.
+ * @param event_size Size of the event data (unused).
+ */
+static void watch_scheduled_handler(void * p_event_data, uint16_t event_size)
+{
+    sadc_watch_evt_t event = *(sadc_watch_evt_t *)p_event_data;
+    int16_t low[SADC_CHANNEL_COUNT];
+    int16_t high[SADC_CHANNEL_COUNT];
+
+    if (event == SADC_WATCH_REFRESH) {
+        temperature_process();
+        limit_watch_limits(low, high);
+        // The watch may have woken since the refresh was posted
+        if (sadc_watch_limits_set(low, high) != NRF_SUCCESS) {
+            return;
+        }
+#if DEEP_IDLE
+        if (++deep_idle_refresh_count >= DEEP_IDLE_REFRESHES) {
+            deep_idle_enter();
+        }
+#endif
+    } else {
+        sadc_governor_wake(&rate_governor);
+        watch_quiet_count = 0;
+        NRF_LOG_INFO("SAADC limit wake %u (limit watch %u ms)", get_sadc_watch_wake_count(), get_sadc_watch_time_ms());
+    }
+}
+
+#endif
+
+#if DEEP_IDLE
+/**
+ * @brief Stop the sampling and let the LPCOMP watch the electrode.
+ *
+ * The comparator reference is derived from the watch limits of the calibrated
+ * baseline, converted to millivolts, on the approach side given by
+ * SENSOR_PROXIMITY_POLARITY: beyond the limits, and close enough that an
+ * approach reaching DEEP_IDLE_WAKE_DEVIATION crosses it. If no supply fraction
+ * fits, the two-sided limit watch carries on and the deep idle is tried again
+ * after another DEEP_IDLE_REFRESHES.
+ */
+static void deep_idle_enter(void)
+{
+    int16_t low[SADC_CHANNEL_COUNT];
+    int16_t high[SADC_CHANNEL_COUNT];
+
+    limit_watch_limits(low, high);
+    int32_t level_mv = (((int32_t)low[0] + high[0]) / 2 * SADC_FULL_SCALE_MV) >> SADC_SCALE_BITS;
+    int32_t margin_mv = (((int32_t)high[0] - low[0]) / 2 * SADC_FULL_SCALE_MV) >> SADC_SCALE_BITS;
+    int32_t reach_mv = ((int32_t)DEEP_IDLE_WAKE_DEVIATION * SADC_FULL_SCALE_MV) >> SADC_SCALE_BITS;
+    int step = lpcomp_reference_step(level_mv, margin_mv, reach_mv, DEEP_IDLE_WAKE_SIDE);
+    nrf_lpcomp_input_t input = (nrf_lpcomp_input_t)(sadc_channel_input(0) - NRF_SAADC_INPUT_AIN0);
+
+    deep_idle_refresh_count = 0;
+    if (step == 0) {
+        NRF_LOG_DEBUG("No LPCOMP reference within %d mV of an idle level of %d mV", reach_mv, level_mv);
+        return;
+    }
+    if (sadc_suspend() != NRF_SUCCESS) {
+        return;
+    }
+    if (lpcomp_wake_arm(input, step, DEEP_IDLE_WAKE_SIDE, lpcomp_wake_handler) != NRF_SUCCESS) {
+        NRF_LOG_WARNING("LPCOMP wake not armed for an idle level of %d mV", level_mv);
+        APP_ERROR_CHECK(sadc_resume());
+        sadc_governor_wake(&rate_governor);
+        return;
+    }
+    NRF_LOG_INFO("Deep idle (limit watch %u ms)", get_sadc_watch_time_ms());
+}
+
+/**
+ * @brief LPCOMP crossing handler.
+ *
+ * Called from the LPCOMP interrupt; restarts the sampling at once and posts
+ * the rest of the wake-up to the main loop.
+ */
+static void lpcomp_wake_handler(void)
+{
+    APP_ERROR_CHECK(sadc_resume());
+    app_sched_event_put(NULL, 0, deep_idle_wake_scheduled_handler);
+}
+
+/**
+ * @brief Scheduled handler for the deep idle wake-up.
+ *
+ * Hands the full rate back to the governor and arms the measurement of the
+ * time to the first classified sample.
+ *
+ * @param p_event_data Event data (unused).
+ * @param event_size Size of the event data (unused).
+ */
+static void deep_idle_wake_scheduled_handler(void * p_event_data, uint16_t event_size)
+{
+    sadc_governor_wake(&rate_governor);
+    watch_quiet_count = 0;
+    wake_latency_pending = true;
+}
+
+/**
+ * @brief Measure the time from the LPCOMP crossing to the first classified sample.
+ *
+ * Called once a block has gone through every sensor instance. The crossing
+ * started the wake TIMER in hardware; the measurement covers the SAADC
+ * restart, the first buffer and its processing, and is expected within
+ * DEEP_IDLE_WAKE_BUDGET_US.
+ */
+static void wake_latency_process(void)
+{
+    if (!wake_latency_pending) {
+        return;
+    }
+    wake_latency_pending = false;
+
+    uint32_t latency_us = lpcomp_wake_elapsed_us();
+    if (latency_us > wake_latency_max_us) {
+        wake_latency_max_us = latency_us;
+    }
+    if (latency_us > DEEP_IDLE_WAKE_BUDGET_US) {
+        NRF_LOG_WARNING("Deep idle wake took %u us (budget %u us)", latency_us, DEEP_IDLE_WAKE_BUDGET_US);
+    } else {
+        NRF_LOG_INFO("Deep idle wake in %u us (max %u us)", latency_us, wake_latency_max_us);
+    }
+}
+#endif
+
+/**
+ * @brief Hand a new die temperature reading to every sensor instance.
+ *
+ * The measurement started by the previous poll is collected and the next one
+ * is started, so the main loop never waits for the TEMP peripheral.
+ */
+static void temperature_process(void)
+{
+    int32_t temperature;
+
+    if (temp_poll(&temperature)) {
+        for (uint8_t ch = 0; ch < SADC_CHANNEL_COUNT; ch++) {
+            sensor_temperature_update(&sensors[ch], temperature);
+        }
+#if SENSOR_OFFSET_CALIBRATION
+        offset_calibration_process(temperature);
+#endif
+    }
+}
+
+#if SENSOR_OFFSET_CALIBRATION
+/**
+ * @brief Recalibrate the SAADC offset when the die temperature has moved.
+ *
+ * The first reading calibrates the offset at the operating temperature, then
+ * every change of CALIBRATION_TEMP_STEP does. The calibration runs between two
+ * buffers; a request refused (limit watch, deep idle) is retried at the next
+ * reading.
+ *
+ * @param temperature The die temperature in 0.25 degC.
+ */
+static void offset_calibration_process(int32_t temperature)
+{
+    int32_t change = temperature - calibration_temperature;
+
+    if (calibration_done && change < CALIBRATION_TEMP_STEP && change > -CALIBRATION_TEMP_STEP) {
+        return;
+    }
+    if (sadc_calibrate() == NRF_SUCCESS) {
+        calibration_done = true;
+        calibration_temperature = temperature;
+        NRF_LOG_INFO("SAADC offset calibration at %d degC", temperature / 4);
+    }
+}
+#endif
+
+/**
+ * @brief Idle state handling.
+ *
+ * Processes pending log messages and puts the CPU to sleep until the next
+ * event once there is nothing left to log.
+ */
+static void idle_state_process(void)
+{
+    if (NRF_LOG_PROCESS() == false)
+    {
+        nrf_pwr_mgmt_run();
+    }
 }
 
 /**
@@ -225,15 +657,39 @@ int main(void)
 {
     // Initialize the logging module
     log_init();
+
+    // Initialize power management and the event scheduler
+    APP_ERROR_CHECK(nrf_pwr_mgmt_init());
+    APP_SCHED_INIT(SCHED_MAX_EVENT_DATA_SIZE, SCHED_QUEUE_SIZE);
     
     // Initialize UART for communication
     uart_init();
     
-    // Initialize the sensor with a callback function for processing sensor data
-    sensor_init(sensor_feedback);
+    // Initialize one sensor per scan channel with a callback function for processing sensor data
+    for (uint8_t ch = 0; ch < SADC_CHANNEL_COUNT; ch++) {
+        sensor_init(&sensors[ch], ch, sensor_feedback);
+    }
     
-    // Initialize the SAADC module
-    sadc_init();
+    // Initialize the decimation stage feeding the sensors
+    if (!cic_decimator_init(&decimator, DECIMATION_RATIO, SADC_CHANNEL_COUNT, DECIMATION_COMPENSATE))
+    {
+        NRF_LOG_ERROR("Invalid decimation ratio.");
+        APP_ERROR_CHECK(NRF_ERROR_INVALID_PARAM);
+    }
+
+    // Start at the full SAADC rate; the governor drops it once every channel is quiet
+    sadc_governor_init(&rate_governor, GOVERNOR_QUIET_TIME_MS);
+
+#if DEEP_IDLE
+    // Prepare the comparator wake-up of the deep idle
+    APP_ERROR_CHECK(lpcomp_init());
+#endif
+
+    // Start the first die temperature measurement for the drift compensation
+    temp_init();
+
+    // Initialize the SAADC module, scheduling the processing of every completed buffer
+    sadc_init(sadc_ready_handler);
 
     // Calculate the capture-compare value for SAADC sampling based on desired frequency
     uint32_t adc_cc_value = 16000000 / SAADC_SAMPLE_FREQUENCY;
@@ -244,25 +700,11 @@ int main(void)
     }
     // Starts the SAADC module  
     sadc_start(adc_cc_value);
-
-    // Setup and start a timer for regular sensor stability checks
-    timer_setup();
     
-    // Main loop
+    // Main loop: run scheduled work items, then sleep until the next event
     while (1)
     {
-        // Check if new sensor data is ready and process it
-        if ( get_data_ready_flag() ) {
-            sensor_process( get_current_buffer() );
-            set_data_ready_flag(false);
-            nrf_delay_ms(SENSOR_READ_DELAY);  // Delay to manage loop frequency
-        }
-        
-        // Process log messages
-        NRF_LOG_PROCESS();
-        while(NRF_LOG_PROCESS() != NRF_SUCCESS);
-        
-        // Wait for event
-        __WFE();
+        app_sched_execute();
+        idle_state_process();
     }  
-}
\ No newline at end of file
+}
@@ -33,7 +33,7 @@
 #define SAADC_ENABLED 1
 
 // 0=> 8 bit 256, 1=> 10 bit 1024, 2=> 12 bit 4096, 3=> 14 bit 16384
-#define SAADC_CONFIG_RESOLUTION 2
+#define SAADC_CONFIG_RESOLUTION 1
 
 // Priorities 0,1,4,5 (nRF52) are reserved for SoftDevice
 #define SAADC_CONFIG_IRQ_PRIORITY 6
@@ -45,7 +45,7 @@
 #define NRFX_SAADC_ENABLED 1 // nrfx_saadc - SAADC peripheral driver
 
 // 0=> 8 bit, 1=> 10 bit, 2=> 12 bit, 3=> 14 bit 
-#define NRFX_SAADC_CONFIG_RESOLUTION 2 // Resolution
+#define NRFX_SAADC_CONFIG_RESOLUTION 1 // Scale of the decimated samples (SADC_SCALE_BITS); the acquisition resolution follows the SAADC profile
 
 
 #define NRFX_SAADC_CONFIG_LP_MODE 0 // Enabling low power mode
@@ -61,11 +61,13 @@
 //#define APP_TIMER_CONFIG_RTC_FREQUENCY APP_TIMER_FREQ_32kHz
 
 #define NRFX_TIMER_ENABLED 1    // nrfx_timer - TIMER periperal driver
-#define NRFX_TIMER0_ENABLED 1   //  Enable TIMER0 instance
+#define NRFX_TIMER0_ENABLED 0   // TIMER0 is left to the SoftDevice
 #define NRFX_TIMER1_ENABLED 1   // Enable TIMER1 instance    
-#define NRFX_TIMER2_ENABLED 0
-#define NRFX_TIMER3_ENABLED 0
-#define NRFX_TIMER4_ENABLED 0
+#define NRFX_TIMER2_ENABLED 1   // Counts the SAADC limit watch frames
+#define NRFX_TIMER3_ENABLED 1   // Timestamps the LPCOMP wake of the deep idle
+#define NRFX_TIMER4_ENABLED 1   // Timebase timestamping the SAADC buffers
+
+#define NRFX_PPI_ENABLED 1      // nrfx_ppi - PPI allocator, wires TIMER1 to the SAADC SAMPLE task for scans, timestamps END on TIMER4 and loops the limit watch
 
 // 0=> 16 MHz 1=> 8 MHz 2=> 4 MHz 3=> 2 MHz 4=> 1 MHz 5=> 500 kHz 6=> 250 kHz 7=> 125 kHz 8=> 62.5 kHz 9=> 31.25 kHz 
 #define NRFX_TIMER_DEFAULT_CONFIG_FREQUENCY 0 // Timer frequency if in Timer mode
@@ -103,10 +105,30 @@
 // Priorities 0,1,4,5 (nRF52) are reserved for SoftDevice
 // 0=> 0 (highest) ... 7=> 7 
 #define TIMER_DEFAULT_CONFIG_IRQ_PRIORITY 6 // Interrupt priority
-#define TIMER0_ENABLED 1 // Enable TIMER0 instance
+#define TIMER0_ENABLED 0 // TIMER0 is left to the SoftDevice
 #define TIMER1_ENABLED 1 // Enable TIMER1 instance
-#define TIMER2_ENABLED 0
-#define TIMER3_ENABLED 0
-#define TIMER4_ENABLED 0
+#define TIMER2_ENABLED 1 // Enable TIMER2 instance
+#define TIMER3_ENABLED 1 // Enable TIMER3 instance
+#define TIMER4_ENABLED 1 // Enable TIMER4 instance
+
+#define NRFX_LPCOMP_ENABLED 1 // nrfx_lpcomp - LPCOMP peripheral driver, wakes the deep idle
+#define NRFX_LPCOMP_CONFIG_REFERENCE 3 // Default reference (4/8 VDD), chosen at run time from the baseline
+#define NRFX_LPCOMP_CONFIG_DETECTION 2 // 0=> Crossing up 1=> Crossing down 2=> Any crossing
+#define NRFX_LPCOMP_CONFIG_INPUT 0     // Default input (AIN0), taken from the scan channel at run time
+#define NRFX_LPCOMP_CONFIG_HYST 1      // 50 mV hysteresis
+#define NRFX_LPCOMP_CONFIG_IRQ_PRIORITY 6 // Same priority as the SAADC interrupt
+#define NRFX_LPCOMP_CONFIG_LOG_ENABLED 0
+
+#define NRF_PWR_MGMT_ENABLED 1 // nrf_pwr_mgmt - Power management module
+#define NRF_PWR_MGMT_CONFIG_DEBUG_PIN_ENABLED 0 // Enables pin debug in the module
+#define NRF_PWR_MGMT_CONFIG_CPU_USAGE_MONITOR_ENABLED 0 // Enables CPU usage monitor
+#define NRF_PWR_MGMT_CONFIG_STANDBY_TIMEOUT_ENABLED 0 // Enable standby timeout
+#define NRF_PWR_MGMT_CONFIG_FPU_SUPPORT_ENABLED 1 // Clear pending FPU interrupts before sleeping (FLOAT_ABI_HARD)
+#define NRF_PWR_MGMT_CONFIG_AUTO_SHUTDOWN_RETRY 0 // Blocked shutdown procedure will be retried every second
+#define NRF_PWR_MGMT_CONFIG_USE_SCHEDULER 0 // Module will use @ref app_scheduler
+#define NRF_PWR_MGMT_CONFIG_HANDLER_PRIORITY_COUNT 3 // The number of priorities for module handlers
+
+// 0=> NRF_SDH_DISPATCH_MODEL_INTERRUPT, 1=> NRF_SDH_DISPATCH_MODEL_APPSH, 2=> NRF_SDH_DISPATCH_MODEL_POLLING
+#define NRF_SDH_DISPATCH_MODEL 1 // SoftDevice (BLE) events are posted to the app_scheduler
 
 #endif // APP_CONFIG_H
\ No newline at end of file
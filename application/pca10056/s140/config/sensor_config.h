@@ -0,0 +1,88 @@
+#ifndef SENSOR_CONFIG_H
+#define SENSOR_CONFIG_H
+
+// Sensing pipeline dimensions, fixed at compile time.
+// Only the first block is meant to be edited (or overridden from the project
+// preprocessor definitions); everything below it is derived from these values.
+
+#ifndef SENSOR_WINDOW_SIZE
+#define SENSOR_WINDOW_SIZE 50       // Sliding window length in readings (1 to 1024)
+#endif
+#ifndef SENSOR_CHANNEL_COUNT
+#define SENSOR_CHANNEL_COUNT 1      // SAADC scan channels, one sensor instance each (1 to 8)
+#endif
+#ifndef SENSOR_DECIMATION_RATIO
+#define SENSOR_DECIMATION_RATIO 8   // SAADC samples per sensor sample (power of two, 1 to 32)
+#endif
+#ifndef SENSOR_IDLE_RATE_DIVIDER
+#define SENSOR_IDLE_RATE_DIVIDER 4  // SAADC rate divider while every channel is quiet (power of two up to the decimation ratio, 1 disables)
+#endif
+#ifndef SENSOR_LIMIT_WAKE
+#define SENSOR_LIMIT_WAKE 1         // Hand quiet idle-rate sampling to the SAADC limit events (needs SENSOR_IDLE_RATE_DIVIDER > 1)
+#endif
+#ifndef SENSOR_DEEP_IDLE
+#define SENSOR_DEEP_IDLE 1          // Stop the SAADC after a minute of limit watch and wake on the LPCOMP (single channel, needs SENSOR_PROXIMITY_POLARITY)
+#endif
+#ifndef SENSOR_PROXIMITY_POLARITY
+#define SENSOR_PROXIMITY_POLARITY 0 // Reading change on approach: 1 rises, -1 falls, 0 either (the one-sided LPCOMP wake then stays off)
+#endif
+#ifndef SENSOR_SAMPLE_TIMESTAMPS
+#define SENSOR_SAMPLE_TIMESTAMPS 1  // Pace the SAADC with a TIMER through PPI and timestamp every buffer (0 lets a single ungoverned channel use the internal timer)
+#endif
+#ifndef SENSOR_SAADC_PROFILE
+#define SENSOR_SAADC_PROFILE 0      // Acquisition profile at start: 0 fast 10-bit, 1 balanced 12-bit, 2 precise 14-bit oversampled
+#endif
+#ifndef SENSOR_OFFSET_CALIBRATION
+#define SENSOR_OFFSET_CALIBRATION 1 // Recalibrate the SAADC offset between two buffers at start and on die temperature changes
+#endif
+#ifndef SENSOR_LOG_PERIOD_MS
+#define SENSOR_LOG_PERIOD_MS 0      // Data row logged on zone/event changes, plus at most every N ms while steady (0: changes only)
+#endif
+#ifndef SENSOR_OUTLIER_WINDOW
+#define SENSOR_OUTLIER_WINDOW 7     // Running median length of the spike rejection (odd, 0 disables the stage)
+#endif
+#ifndef SENSOR_MAINS_FILTER
+#define SENSOR_MAINS_FILTER 1       // 50/60 Hz hum detection and notch cascade (0 disables the stage)
+#endif
+
+// Derived values (do not edit)
+#define SENSOR_IS_POW2(n) ((n) > 0 && ((n) & ((n) - 1)) == 0)
+#define SENSOR_CEIL_LOG2(n) ((n) <= 1 ? 0 : (n) <= 2 ? 1 : (n) <= 4 ? 2 : (n) <= 8 ? 3 : \
+                             (n) <= 16 ? 4 : (n) <= 32 ? 5 : (n) <= 64 ? 6 : (n) <= 128 ? 7 : \
+                             (n) <= 256 ? 8 : (n) <= 512 ? 9 : 10)
+
+#define SENSOR_WINDOW_IS_POW2 SENSOR_IS_POW2(SENSOR_WINDOW_SIZE)   // Ring wraps with a mask, average with a shift
+#define SENSOR_WINDOW_LOG2    SENSOR_CEIL_LOG2(SENSOR_WINDOW_SIZE) // Shift of a power-of-two window
+#define SENSOR_WINDOW_MASK    (SENSOR_WINDOW_SIZE - 1)             // Ring index mask of a power-of-two window
+
+// Reciprocal for other window lengths: |total| / SIZE == (|total| * RECIPROCAL) >> SHIFT,
+// exact for every |total| below 2^SENSOR_WINDOW_DIVIDEND_BITS.
+#define SENSOR_WINDOW_DIVIDEND_BITS    24
+#define SENSOR_WINDOW_RECIPROCAL_SHIFT (SENSOR_WINDOW_DIVIDEND_BITS + SENSOR_WINDOW_LOG2)
+#define SENSOR_WINDOW_RECIPROCAL       ((uint32_t)((((uint64_t)1 << SENSOR_WINDOW_RECIPROCAL_SHIFT) + SENSOR_WINDOW_SIZE - 1) / SENSOR_WINDOW_SIZE))
+
+#define SENSOR_DECIMATION_LOG2 SENSOR_CEIL_LOG2(SENSOR_DECIMATION_RATIO)
+
+#if (SENSOR_WINDOW_SIZE < 1) || (SENSOR_WINDOW_SIZE > 1024)
+#error "SENSOR_WINDOW_SIZE must be between 1 and 1024 (the window total of 14-bit readings must stay below 2^24)"
+#endif
+#if (SENSOR_CHANNEL_COUNT < 1) || (SENSOR_CHANNEL_COUNT > 8)
+#error "SENSOR_CHANNEL_COUNT must be between 1 and 8"
+#endif
+#if !SENSOR_IS_POW2(SENSOR_DECIMATION_RATIO) || (SENSOR_DECIMATION_RATIO > 32)
+#error "SENSOR_DECIMATION_RATIO must be a power of two from 1 to 32"
+#endif
+#if !SENSOR_IS_POW2(SENSOR_IDLE_RATE_DIVIDER) || (SENSOR_IDLE_RATE_DIVIDER > SENSOR_DECIMATION_RATIO)
+#error "SENSOR_IDLE_RATE_DIVIDER must be a power of two from 1 to SENSOR_DECIMATION_RATIO"
+#endif
+#if (SENSOR_PROXIMITY_POLARITY < -1) || (SENSOR_PROXIMITY_POLARITY > 1)
+#error "SENSOR_PROXIMITY_POLARITY must be 1 (rises), -1 (falls) or 0 (either)"
+#endif
+#if (SENSOR_SAADC_PROFILE < 0) || (SENSOR_SAADC_PROFILE > 2)
+#error "SENSOR_SAADC_PROFILE must be 0 (fast), 1 (balanced) or 2 (precise)"
+#endif
+#if (SENSOR_OUTLIER_WINDOW != 0) && (((SENSOR_OUTLIER_WINDOW & 1) == 0) || (SENSOR_OUTLIER_WINDOW > 31))
+#error "SENSOR_OUTLIER_WINDOW must be 0 or an odd length up to 31"
+#endif
+
+#endif // SENSOR_CONFIG_H